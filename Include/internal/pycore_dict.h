@@ -256,6 +256,12 @@ static inline PyDictUnicodeEntry* DK_UNICODE_ENTRIES(PyDictKeysObject *dk) {
 
 #define DK_IS_UNICODE(dk) ((dk)->dk_kind != DICT_KEYS_GENERAL)
 
+/* Tables of at least 2**DK_GROW_MIN_LOG_SIZE slots can build their next
+   table incrementally (see Objects/dictobject.c), from the size set by
+   interp->dict_state.grow_log_size.  Their entries must not be modified
+   outside of dictobject.c. */
+#define DK_GROW_MIN_LOG_SIZE 12
+
 #define DICT_VERSION_INCREMENT (1 << (DICT_MAX_WATCHERS + DICT_WATCHED_MUTATION_BITS))
 #define DICT_WATCHER_MASK ((1 << DICT_MAX_WATCHERS) - 1)
 #define DICT_WATCHER_AND_MODIFICATION_MASK ((1 << (DICT_MAX_WATCHERS + DICT_WATCHED_MUTATION_BITS)) - 1)
@@ -13,12 +13,15 @@ extern "C" {
 
 struct _Py_dict_state {
     uint32_t next_keys_version;
+    /* log2 of the smallest tables which grow incrementally */
+    uint8_t grow_log_size;
     PyDict_WatchCallback watchers[DICT_MAX_WATCHERS];
 };
 
 #define _dict_state_INIT \
     { \
         .next_keys_version = 2, \
+        .grow_log_size = 17, \
     }
 
 
@@ -241,7 +241,11 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_asyncio_future_blocking)
         STRUCT_FOR_ID(_blksize)
         STRUCT_FOR_ID(_bootstrap)
+        STRUCT_FOR_ID(_cancelled)
+        STRUCT_FOR_ID(_check_callback)
         STRUCT_FOR_ID(_check_retval_)
+        STRUCT_FOR_ID(_check_thread)
+        STRUCT_FOR_ID(_current_handle)
         STRUCT_FOR_ID(_dealloc_warn)
         STRUCT_FOR_ID(_feature_version)
         STRUCT_FOR_ID(_field_types)
@@ -264,7 +268,12 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_loop)
         STRUCT_FOR_ID(_needs_com_addref_)
         STRUCT_FOR_ID(_only_immortal)
+        STRUCT_FOR_ID(_process_events)
+        STRUCT_FOR_ID(_repr_info)
         STRUCT_FOR_ID(_restype_)
+        STRUCT_FOR_ID(_run)
+        STRUCT_FOR_ID(_scheduled)
+        STRUCT_FOR_ID(_selector)
         STRUCT_FOR_ID(_showwarnmsg)
         STRUCT_FOR_ID(_shutdown)
         STRUCT_FOR_ID(_slotnames)
@@ -272,9 +281,11 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_strptime_datetime_date)
         STRUCT_FOR_ID(_strptime_datetime_datetime)
         STRUCT_FOR_ID(_strptime_datetime_time)
+        STRUCT_FOR_ID(_timer_handle_cancelled)
         STRUCT_FOR_ID(_type_)
         STRUCT_FOR_ID(_uninitialized_submodules)
         STRUCT_FOR_ID(_warn_unawaited_coroutine)
+        STRUCT_FOR_ID(_when)
         STRUCT_FOR_ID(_xoptions)
         STRUCT_FOR_ID(abs_tol)
         STRUCT_FOR_ID(access)
@@ -331,10 +342,12 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(cadata)
         STRUCT_FOR_ID(cafile)
         STRUCT_FOR_ID(call)
+        STRUCT_FOR_ID(call_at)
         STRUCT_FOR_ID(call_exception_handler)
         STRUCT_FOR_ID(call_soon)
         STRUCT_FOR_ID(callback)
         STRUCT_FOR_ID(cancel)
+        STRUCT_FOR_ID(cancelled)
         STRUCT_FOR_ID(capath)
         STRUCT_FOR_ID(category)
         STRUCT_FOR_ID(cb_type)
@@ -388,6 +401,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(decoder)
         STRUCT_FOR_ID(default)
         STRUCT_FOR_ID(defaultaction)
+        STRUCT_FOR_ID(delay)
         STRUCT_FOR_ID(delete)
         STRUCT_FOR_ID(depth)
         STRUCT_FOR_ID(desired_access)
@@ -419,6 +433,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(end_lineno)
         STRUCT_FOR_ID(end_offset)
         STRUCT_FOR_ID(endpos)
+        STRUCT_FOR_ID(entries)
         STRUCT_FOR_ID(entrypoint)
         STRUCT_FOR_ID(env)
         STRUCT_FOR_ID(errors)
@@ -652,6 +667,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(pi_factory)
         STRUCT_FOR_ID(pid)
         STRUCT_FOR_ID(policy)
+        STRUCT_FOR_ID(popleft)
         STRUCT_FOR_ID(pos)
         STRUCT_FOR_ID(pos1)
         STRUCT_FOR_ID(pos2)
@@ -689,6 +705,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(return)
         STRUCT_FOR_ID(reverse)
         STRUCT_FOR_ID(reversed)
+        STRUCT_FOR_ID(run)
         STRUCT_FOR_ID(salt)
         STRUCT_FOR_ID(sched_priority)
         STRUCT_FOR_ID(scheduler)
@@ -697,6 +714,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(security_attributes)
         STRUCT_FOR_ID(seek)
         STRUCT_FOR_ID(seekable)
+        STRUCT_FOR_ID(select)
         STRUCT_FOR_ID(selectors)
         STRUCT_FOR_ID(self)
         STRUCT_FOR_ID(send)
@@ -717,6 +735,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(sizehint)
         STRUCT_FOR_ID(skip_file_prefixes)
         STRUCT_FOR_ID(sleep)
+        STRUCT_FOR_ID(slow_callback_duration)
         STRUCT_FOR_ID(sock)
         STRUCT_FOR_ID(sort)
         STRUCT_FOR_ID(source)
@@ -757,6 +776,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(text)
         STRUCT_FOR_ID(threading)
         STRUCT_FOR_ID(throw)
+        STRUCT_FOR_ID(time)
         STRUCT_FOR_ID(timeout)
         STRUCT_FOR_ID(timer)
         STRUCT_FOR_ID(times)
@@ -786,14 +806,17 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(volume)
         STRUCT_FOR_ID(wait_all)
         STRUCT_FOR_ID(warn_on_full_buffer)
+        STRUCT_FOR_ID(warning)
         STRUCT_FOR_ID(warnings)
         STRUCT_FOR_ID(warnoptions)
         STRUCT_FOR_ID(wbits)
         STRUCT_FOR_ID(week)
         STRUCT_FOR_ID(weekday)
+        STRUCT_FOR_ID(when)
         STRUCT_FOR_ID(which)
         STRUCT_FOR_ID(who)
         STRUCT_FOR_ID(withdata)
+        STRUCT_FOR_ID(workers)
         STRUCT_FOR_ID(writable)
         STRUCT_FOR_ID(write)
         STRUCT_FOR_ID(write_through)
@@ -748,7 +748,11 @@ extern "C" {
     INIT_ID(_asyncio_future_blocking), \
     INIT_ID(_blksize), \
     INIT_ID(_bootstrap), \
+    INIT_ID(_cancelled), \
+    INIT_ID(_check_callback), \
     INIT_ID(_check_retval_), \
+    INIT_ID(_check_thread), \
+    INIT_ID(_current_handle), \
     INIT_ID(_dealloc_warn), \
     INIT_ID(_feature_version), \
     INIT_ID(_field_types), \
@@ -771,7 +775,12 @@ extern "C" {
     INIT_ID(_loop), \
     INIT_ID(_needs_com_addref_), \
     INIT_ID(_only_immortal), \
+    INIT_ID(_process_events), \
+    INIT_ID(_repr_info), \
     INIT_ID(_restype_), \
+    INIT_ID(_run), \
+    INIT_ID(_scheduled), \
+    INIT_ID(_selector), \
     INIT_ID(_showwarnmsg), \
     INIT_ID(_shutdown), \
     INIT_ID(_slotnames), \
@@ -779,9 +788,11 @@ extern "C" {
     INIT_ID(_strptime_datetime_date), \
     INIT_ID(_strptime_datetime_datetime), \
     INIT_ID(_strptime_datetime_time), \
+    INIT_ID(_timer_handle_cancelled), \
     INIT_ID(_type_), \
     INIT_ID(_uninitialized_submodules), \
     INIT_ID(_warn_unawaited_coroutine), \
+    INIT_ID(_when), \
     INIT_ID(_xoptions), \
     INIT_ID(abs_tol), \
     INIT_ID(access), \
@@ -838,10 +849,12 @@ extern "C" {
     INIT_ID(cadata), \
     INIT_ID(cafile), \
     INIT_ID(call), \
+    INIT_ID(call_at), \
     INIT_ID(call_exception_handler), \
     INIT_ID(call_soon), \
     INIT_ID(callback), \
     INIT_ID(cancel), \
+    INIT_ID(cancelled), \
     INIT_ID(capath), \
     INIT_ID(category), \
     INIT_ID(cb_type), \
@@ -895,6 +908,7 @@ extern "C" {
     INIT_ID(decoder), \
     INIT_ID(default), \
     INIT_ID(defaultaction), \
+    INIT_ID(delay), \
     INIT_ID(delete), \
     INIT_ID(depth), \
     INIT_ID(desired_access), \
@@ -926,6 +940,7 @@ extern "C" {
     INIT_ID(end_lineno), \
     INIT_ID(end_offset), \
     INIT_ID(endpos), \
+    INIT_ID(entries), \
     INIT_ID(entrypoint), \
     INIT_ID(env), \
     INIT_ID(errors), \
@@ -1159,6 +1174,7 @@ extern "C" {
     INIT_ID(pi_factory), \
     INIT_ID(pid), \
     INIT_ID(policy), \
+    INIT_ID(popleft), \
     INIT_ID(pos), \
     INIT_ID(pos1), \
     INIT_ID(pos2), \
@@ -1196,6 +1212,7 @@ extern "C" {
     INIT_ID(return), \
     INIT_ID(reverse), \
     INIT_ID(reversed), \
+    INIT_ID(run), \
     INIT_ID(salt), \
     INIT_ID(sched_priority), \
     INIT_ID(scheduler), \
@@ -1204,6 +1221,7 @@ extern "C" {
     INIT_ID(security_attributes), \
     INIT_ID(seek), \
     INIT_ID(seekable), \
+    INIT_ID(select), \
     INIT_ID(selectors), \
     INIT_ID(self), \
     INIT_ID(send), \
@@ -1224,6 +1242,7 @@ extern "C" {
     INIT_ID(sizehint), \
     INIT_ID(skip_file_prefixes), \
     INIT_ID(sleep), \
+    INIT_ID(slow_callback_duration), \
     INIT_ID(sock), \
     INIT_ID(sort), \
     INIT_ID(source), \
@@ -1264,6 +1283,7 @@ extern "C" {
     INIT_ID(text), \
     INIT_ID(threading), \
     INIT_ID(throw), \
+    INIT_ID(time), \
     INIT_ID(timeout), \
     INIT_ID(timer), \
     INIT_ID(times), \
@@ -1293,14 +1313,17 @@ extern "C" {
     INIT_ID(volume), \
     INIT_ID(wait_all), \
     INIT_ID(warn_on_full_buffer), \
+    INIT_ID(warning), \
     INIT_ID(warnings), \
     INIT_ID(warnoptions), \
     INIT_ID(wbits), \
     INIT_ID(week), \
     INIT_ID(weekday), \
+    INIT_ID(when), \
     INIT_ID(which), \
     INIT_ID(who), \
     INIT_ID(withdata), \
+    INIT_ID(workers), \
     INIT_ID(writable), \
     INIT_ID(write), \
     INIT_ID(write_through), \
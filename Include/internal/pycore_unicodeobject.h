@@ -71,6 +71,17 @@ extern Py_UCS4 _PyUnicode_FindMaxChar (
     Py_ssize_t start,
     Py_ssize_t end);
 
+/* Return the index of the first occurrence of needle in haystack, both
+   arrays of characters of the given kind, or -1.  For the 2 and 4 byte
+   kinds, the character after the end of haystack must be readable, as
+   in the data of a string. */
+extern Py_ssize_t _PyUnicode_FindKind(
+    int kind,
+    const void *haystack,
+    Py_ssize_t len_haystack,
+    const void *needle,
+    Py_ssize_t len_needle);
+
 /* --- _PyUnicodeWriter API ----------------------------------------------- */
 
 /* Format the object based on the format_spec, as defined in PEP 3101
@@ -70,5 +70,11 @@ def __getattr__(name: str):
                 warnings._deprecated(f"asyncio.{name}", remove=(3, 16))
                 return windows_events._WindowsProactorEventLoopPolicy
             # Else fall through to the AttributeError below.
+        case "UringEventLoop" | "UringProactor":
+            # Experimental, and only imported when used.
+            if sys.platform == 'linux':
+                from . import uring_events
+                return getattr(uring_events, name)
+            # Else fall through to the AttributeError below.
 
     raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
@@ -23,10 +23,13 @@
 # The default timeout mimics lingering_time
 SSL_SHUTDOWN_TIMEOUT = 30.0
 
-# Used in sendfile fallback code.  We use fallback for platforms
-# that don't support sendfile, or for TLS connections.
+# Used in sendfile and sock_relay() fallback code.  We use fallback for
+# platforms that don't support sendfile or splice, or for TLS connections.
 SENDFILE_FALLBACK_READBUFFER_SIZE = 1024 * 256
 
+# Capacity requested for the pipe through which sock_relay() splices data.
+RELAY_PIPE_SIZE = 1024 * 1024
+
 FLOW_CONTROL_HIGH_WATER_SSL_READ = 256  # KiB
 FLOW_CONTROL_HIGH_WATER_SSL_WRITE = 512  # KiB
 
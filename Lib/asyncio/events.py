@@ -109,35 +109,6 @@ def _run(self):
             self._loop.call_exception_handler(context)
         self = None  # Needed to break cycles when an exception occurs.
 
-# _ThreadSafeHandle is used for callbacks scheduled with call_soon_threadsafe
-# and is thread safe unlike Handle which is not thread safe.
-class _ThreadSafeHandle(Handle):
-
-    __slots__ = ('_lock',)
-
-    def __init__(self, callback, args, loop, context=None):
-        super().__init__(callback, args, loop, context)
-        self._lock = threading.RLock()
-
-    def cancel(self):
-        with self._lock:
-            return super().cancel()
-
-    def cancelled(self):
-        with self._lock:
-            return super().cancelled()
-
-    def _run(self):
-        # The event loop checks for cancellation without holding the lock
-        # It is possible that the handle is cancelled after the check
-        # but before the callback is called so check it again after acquiring
-        # the lock and return without calling the callback if it is cancelled.
-        with self._lock:
-            if self._cancelled:
-                return
-            return super()._run()
-
-
 class TimerHandle(Handle):
     """Object returned by timed callback registration methods."""
 
@@ -160,27 +131,27 @@ def __hash__(self):
         return hash(self._when)
 
     def __lt__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when < other._when
         return NotImplemented
 
     def __le__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when < other._when or self.__eq__(other)
         return NotImplemented
 
     def __gt__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when > other._when
         return NotImplemented
 
     def __ge__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when > other._when or self.__eq__(other)
         return NotImplemented
 
     def __eq__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return (self._when == other._when and
                     self._callback == other._callback and
                     self._args == other._args and
@@ -623,6 +594,9 @@ async def sock_sendfile(self, sock, file, offset=0, count=None,
                             *, fallback=None):
         raise NotImplementedError
 
+    async def sock_relay(self, src, dst, count=None, *, fallback=None):
+        raise NotImplementedError
+
     # Signal handling.
 
     def add_signal_handler(self, sig, callback, *args):
@@ -867,6 +841,52 @@ def new_event_loop():
     _c_get_event_loop = get_event_loop
 
 
+# Alias pure-Python implementations for testing purposes.
+_PyHandle = Handle
+_PyTimerHandle = TimerHandle
+
+
+try:
+    # A handle is created for every callback scheduled by the event
+    # loop, see also _EventLoopCore in base_events.
+    from _asyncio import Handle, TimerHandle
+except ImportError:
+    pass
+else:
+    # Alias C implementations for testing purposes.
+    _CHandle = Handle
+    _CTimerHandle = TimerHandle
+
+
+# _ThreadSafeHandle is used for callbacks scheduled with call_soon_threadsafe
+# and is thread safe unlike Handle which is not thread safe.
+class _ThreadSafeHandle(Handle):
+
+    __slots__ = ('_lock',)
+
+    def __init__(self, callback, args, loop, context=None):
+        super().__init__(callback, args, loop, context)
+        self._lock = threading.RLock()
+
+    def cancel(self):
+        with self._lock:
+            return super().cancel()
+
+    def cancelled(self):
+        with self._lock:
+            return super().cancelled()
+
+    def _run(self):
+        # The event loop checks for cancellation without holding the lock
+        # It is possible that the handle is cancelled after the check
+        # but before the callback is called so check it again after acquiring
+        # the lock and return without calling the callback if it is cancelled.
+        with self._lock:
+            if self._cancelled:
+                return
+            return super()._run()
+
+
 if hasattr(os, 'fork'):
     def on_fork():
         # Reset the loop and wakeupfd in the forked child process.
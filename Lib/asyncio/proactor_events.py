@@ -162,7 +162,13 @@ def _call_connection_lost(self, exc):
             # just close our end.  First calling shutdown() seems to
             # cure it, but maybe using DisconnectEx() would be better.
             if hasattr(self._sock, 'shutdown') and self._sock.fileno() != -1:
-                self._sock.shutdown(socket.SHUT_RDWR)
+                try:
+                    self._sock.shutdown(socket.SHUT_RDWR)
+                except OSError:
+                    # The socket is not connected, such as a datagram
+                    # socket without a remote address or a socket reset
+                    # by the peer: it still has to be closed.
+                    pass
             self._sock.close()
             self._sock = None
             server = self._server
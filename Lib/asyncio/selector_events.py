@@ -39,6 +39,18 @@
         # Fallback to send
         _HAS_SENDMSG = False
 
+_HAS_MMSG = (hasattr(socket.socket, 'recvmmsg_into') and
+             hasattr(socket.socket, 'sendmmsg'))
+
+# Datagram transports of IP sockets receive up to _DATAGRAM_RECV_BATCH
+# datagrams with one recvmmsg_into() call, into buffers shared by the
+# transports of a loop, and send up to _DATAGRAM_SEND_BATCH buffered
+# datagrams with one sendmmsg() call.  IP datagrams are smaller than
+# _DATAGRAM_RECV_SIZE.
+_DATAGRAM_RECV_BATCH = 16
+_DATAGRAM_RECV_SIZE = 64 * 1024
+_DATAGRAM_SEND_BATCH = 64
+
 def _test_selector_event(selector, fd, event):
     # Test if the selector is monitoring 'event' events
     # for the file descriptor 'fd'.
@@ -65,6 +77,16 @@ def __init__(self, selector=None):
         self._selector = selector
         self._make_self_pipe()
         self._transports = weakref.WeakValueDictionary()
+        self._datagram_buffers = None
+
+    def _get_datagram_buffers(self):
+        buffers = self._datagram_buffers
+        if buffers is None:
+            size = _DATAGRAM_RECV_SIZE
+            view = memoryview(bytearray(_DATAGRAM_RECV_BATCH * size))
+            buffers = [view[i:i + size] for i in range(0, len(view), size)]
+            self._datagram_buffers = buffers
+        return buffers
 
     def _make_socket_transport(self, sock, protocol, waiter=None, *,
                                extra=None, server=None):
@@ -1218,6 +1240,10 @@ def __init__(self, loop, sock, protocol, address=None,
         super().__init__(loop, sock, protocol, extra)
         self._address = address
         self._buffer_size = 0
+        self._pending_datagrams = collections.deque()
+        if _HAS_MMSG and sock.family in (socket.AF_INET, socket.AF_INET6):
+            self._read_ready = self._read_ready__recvmmsg
+            self._sendto_ready = self._sendto_ready__sendmmsg
         self._loop.call_soon(self._protocol.connection_made, self)
         # only start reading when connection_made() has been called
         self._loop.call_soon(self._add_reader,
@@ -1246,6 +1272,48 @@ def _read_ready(self):
         else:
             self._protocol.datagram_received(data, addr)
 
+    def _read_ready__recvmmsg(self):
+        if self._conn_lost:
+            return
+        if self._pending_datagrams:
+            self._deliver_pending_datagrams()
+            if self._pending_datagrams:
+                return
+        buffers = self._loop._get_datagram_buffers()
+        try:
+            received = self._sock.recvmmsg_into(buffers)
+        except (BlockingIOError, InterruptedError):
+            return
+        except OSError as exc:
+            self._protocol.error_received(exc)
+            return
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            self._fatal_error(exc, 'Fatal read error on datagram transport')
+            return
+        self._pending_datagrams.extend(
+            (bytes(buf[:nbytes]), addr)
+            for buf, (nbytes, addr) in zip(buffers, received))
+        self._deliver_pending_datagrams()
+
+    def _deliver_pending_datagrams(self):
+        # Datagrams received by one call are kept while reading is paused.
+        pending = self._pending_datagrams
+        while pending and self.is_reading():
+            data, addr = pending.popleft()
+            try:
+                self._protocol.datagram_received(data, addr)
+            except BaseException:
+                if pending:
+                    self._loop.call_soon(self._deliver_pending_datagrams)
+                raise
+
+    def resume_reading(self):
+        super().resume_reading()
+        if self._pending_datagrams and self.is_reading():
+            self._loop.call_soon(self._deliver_pending_datagrams)
+
     def sendto(self, data, addr=None):
         if not isinstance(data, (bytes, bytearray, memoryview)):
             raise TypeError(f'data argument must be a bytes-like object, '
@@ -1316,3 +1384,37 @@ def _sendto_ready(self):
             self._loop._remove_writer(self._sock_fd)
             if self._closing:
                 self._call_connection_lost(None)
+
+    def _sendto_ready__sendmmsg(self):
+        buffer = self._buffer
+        while buffer:
+            messages = itertools.islice(buffer, _DATAGRAM_SEND_BATCH)
+            if self._extra['peername']:
+                messages = [(data, None) for data, addr in messages]
+            else:
+                messages = list(messages)
+            try:
+                nsent = self._sock.sendmmsg(messages)
+            except (BlockingIOError, InterruptedError):
+                break  # Try again later.
+            except OSError as exc:
+                # The first datagram could not be sent: drop it.
+                data, addr = buffer.popleft()
+                self._buffer_size -= len(data)
+                self._protocol.error_received(exc)
+                return
+            except (SystemExit, KeyboardInterrupt):
+                raise
+            except BaseException as exc:
+                self._fatal_error(
+                    exc, 'Fatal write error on datagram transport')
+                return
+            for _ in range(nsent):
+                data, addr = buffer.popleft()
+                self._buffer_size -= len(data)
+
+        self._maybe_resume_protocol()  # May append to buffer.
+        if not self._buffer:
+            self._loop._remove_writer(self._sock_fd)
+            if self._closing:
+                self._call_connection_lost(None)
@@ -22,6 +22,14 @@
 
 _DEFAULT_LIMIT = 2 ** 16  # 64 KiB
 
+# StreamReaderProtocol receives into buffers taken from this pool.  A
+# protocol holds its buffer only between get_buffer() and buffer_updated(),
+# which transports call one right after the other, so a few buffers are
+# enough for all the streams.
+_RECV_BUFFER_SIZE = 256 * 1024
+_RECV_BUFFER_POOL_SIZE = 8
+_recv_buffer_pool = []
+
 
 async def open_connection(host=None, port=None, *,
                           limit=_DEFAULT_LIMIT, **kwds):
@@ -177,16 +185,22 @@ def _get_close_waiter(self, stream):
         raise NotImplementedError
 
 
-class StreamReaderProtocol(FlowControlMixin, protocols.Protocol):
+class StreamReaderProtocol(FlowControlMixin, protocols.Protocol,
+                           protocols.BufferedProtocol):
     """Helper class to adapt between Protocol and StreamReader.
 
     (This is a helper class instead of making StreamReader itself a
     Protocol subclass, because the StreamReader has other potential
     uses, and to prevent the user of the StreamReader to accidentally
     call inappropriate methods of the protocol.)
+
+    Transports which support BufferedProtocol receive into a buffer of
+    the protocol, which is copied into the buffer of the StreamReader;
+    the others call data_received().
     """
 
     _source_traceback = None
+    _recv_buffer = None
 
     def __init__(self, stream_reader, client_connected_cb=None, loop=None):
         super().__init__(loop=loop)
@@ -274,12 +288,45 @@ def connection_lost(self, exc):
         self._stream_writer = None
         self._task = None
         self._transport = None
+        # The transport may still use the buffer: do not return it to the
+        # pool.
+        self._recv_buffer = None
 
     def data_received(self, data):
         reader = self._stream_reader
         if reader is not None:
             reader.feed_data(data)
 
+    def get_buffer(self, sizehint):
+        buf = self._recv_buffer
+        if buf is None:
+            try:
+                buf = _recv_buffer_pool.pop()
+            except IndexError:
+                buf = memoryview(bytearray(_RECV_BUFFER_SIZE))
+            self._recv_buffer = buf
+        return buf
+
+    def buffer_updated(self, nbytes):
+        buf = self._recv_buffer
+        self._recv_buffer = None
+        try:
+            data = buf[:nbytes]
+            if (type(self).data_received is not
+                    StreamReaderProtocol.data_received):
+                # Subclasses overriding data_received() get the data from it.
+                self.data_received(bytes(data))
+                return
+            reader = self._stream_reader
+            if reader is not None:
+                if type(reader).feed_data is not StreamReader.feed_data:
+                    # The buffer is reused: subclasses may keep the data.
+                    data = bytes(data)
+                reader.feed_data(data)
+        finally:
+            if len(_recv_buffer_pool) < _RECV_BUFFER_POOL_SIZE:
+                _recv_buffer_pool.append(buf)
+
     def eof_received(self):
         reader = self._stream_reader
         if reader is not None:
@@ -1,6 +1,8 @@
 """Selector event loop for Unix with signal handling."""
 
 import errno
+import fcntl
+import functools
 import io
 import itertools
 import os
@@ -362,9 +364,12 @@ async def _sock_sendfile_native(self, sock, file, offset, count):
         except (AttributeError, io.UnsupportedOperation) as err:
             raise exceptions.SendfileNotAvailableError("not a regular file")
         try:
-            fsize = os.fstat(fileno).st_size
+            st = os.fstat(fileno)
         except OSError:
             raise exceptions.SendfileNotAvailableError("not a regular file")
+        if stat.S_ISFIFO(st.st_mode):
+            return await self._sock_sendfile_splice(sock, file, offset, count)
+        fsize = st.st_size
         blocksize = count if count else fsize
         if not blocksize:
             return 0  # empty file
@@ -459,6 +464,118 @@ def cb(fut):
                     self.remove_writer(fd)
         fut.add_done_callback(cb)
 
+    async def _sock_sendfile_splice(self, sock, file, offset, count):
+        try:
+            os.splice
+        except AttributeError:
+            raise exceptions.SendfileNotAvailableError(
+                "os.splice() is not available")
+        if offset:
+            raise exceptions.SendfileNotAvailableError("pipes are not seekable")
+        # The file object may have read ahead from the pipe: send what
+        # it has buffered first.
+        total_sent = 0
+        if hasattr(file, 'peek'):
+            data = await self.run_in_executor(None, file.peek, 1)
+            if count:
+                data = data[:count]
+            if not data:
+                return 0  # EOF
+            await self.sock_sendall(sock, data)
+            file.read(len(data))
+            total_sent = len(data)
+            if count:
+                count -= total_sent
+                if not count:
+                    return total_sent
+        return total_sent + await self._sock_splice(file.fileno(), sock, count)
+
+    async def _sock_relay_native(self, src, dst, count):
+        try:
+            os.splice
+        except AttributeError:
+            raise exceptions.SendfileNotAvailableError(
+                "os.splice() is not available")
+        # splice() needs a pipe at one end: move the data from src into
+        # a pipe of our own, then from the pipe into dst.
+        src_fd = src.fileno()
+        flags = os.SPLICE_F_MOVE | os.SPLICE_F_NONBLOCK
+        rfd, wfd = os.pipe()
+        try:
+            try:
+                pipe_size = fcntl.fcntl(wfd, fcntl.F_SETPIPE_SZ,
+                                        constants.RELAY_PIPE_SIZE)
+            except OSError:
+                # Over the limit of pipe memory for unprivileged users.
+                pipe_size = fcntl.fcntl(wfd, fcntl.F_GETPIPE_SZ)
+            total_sent = 0
+            while True:
+                blocksize = pipe_size
+                if count:
+                    blocksize = min(count - total_sent, blocksize)
+                    if blocksize <= 0:
+                        break
+                try:
+                    read = os.splice(src_fd, wfd, blocksize, flags=flags)
+                except BlockingIOError:
+                    await self._sock_splice_wait(src_fd, write=False)
+                    continue
+                except OSError as exc:
+                    if total_sent == 0:
+                        # The socket does not support splice(), fall back
+                        # on copying the data.
+                        raise exceptions.SendfileNotAvailableError(
+                            "os.splice call failed") from exc
+                    raise
+                if not read:
+                    break  # EOF
+                # The pipe was empty, so it now holds exactly the data read.
+                await self._sock_splice(rfd, dst, read)
+                total_sent += read
+            return total_sent
+        finally:
+            os.close(rfd)
+            os.close(wfd)
+
+    async def _sock_splice(self, fd, sock, count):
+        # Move data from the pipe fd into sock until EOF, or until count
+        # bytes are sent.
+        sock_fd = sock.fileno()
+        flags = os.SPLICE_F_MOVE | os.SPLICE_F_NONBLOCK
+        # Truncate to 1GiB to avoid OverflowError on 32-bit architectures.
+        blocksize = 2 ** 30
+        total_sent = 0
+        while True:
+            if count:
+                blocksize = count - total_sent
+                if blocksize <= 0:
+                    break
+            try:
+                sent = os.splice(fd, sock_fd, blocksize, flags=flags)
+            except BlockingIOError:
+                # Either the pipe is empty or the socket buffer is full.
+                await self._sock_splice_wait(fd, write=False)
+                await self._sock_splice_wait(sock_fd, write=True)
+                continue
+            if not sent:
+                break  # EOF
+            total_sent += sent
+        return total_sent
+
+    async def _sock_splice_wait(self, fd, *, write):
+        fut = self.create_future()
+        if write:
+            handle = self._add_writer(
+                fd, futures._set_result_unless_cancelled, fut, None)
+            fut.add_done_callback(
+                functools.partial(self._sock_write_done, fd, handle=handle))
+        else:
+            handle = self._add_reader(
+                fd, futures._set_result_unless_cancelled, fut, None)
+            fut.add_done_callback(
+                functools.partial(self._sock_read_done, fd, handle=handle))
+        await fut
+
     def _stop_serving(self, sock):
         # Is this a unix socket that needs cleanup?
         if sock in self._unix_server_sockets:
@@ -0,0 +1,811 @@
+"""Proactor event loop using io_uring on Linux."""
+
+import sys
+
+if sys.platform != 'linux':  # pragma: no cover
+    raise ImportError('Linux only')
+
+import collections
+import errno
+import os
+import select
+import socket
+import time
+
+try:
+    import _uring
+except ImportError:  # pragma: no cover
+    _uring = None
+
+from . import events
+from . import futures
+from . import proactor_events
+from . import sslproto
+from .log import logger
+
+
+__all__ = ('UringEventLoop', 'UringProactor')
+
+
+_MSG_NOSIGNAL = int(socket.MSG_NOSIGNAL)
+
+# Result of the completion of an operation which has been submitted again
+# to finish it, e.g. after a partial send.
+_PENDING = object()
+
+
+def _error(res):
+    err = -res
+    return OSError(err, os.strerror(err))
+
+
+class _UringFuture(futures.Future):
+    """Subclass of Future which represents an io_uring operation.
+
+    Cancelling it will cancel the operation.  finish(res, data) is called
+    with the result of the operation and returns the result of the future.
+    """
+
+    def __init__(self, proactor, finish, *, loop=None):
+        super().__init__(loop=loop)
+        if self._source_traceback:
+            del self._source_traceback[-1]
+        self._proactor = proactor
+        self._finish = finish
+        self._slot = None
+
+    def _repr_info(self):
+        info = super()._repr_info()
+        if self._slot is not None:
+            info.insert(1, f'slot={self._slot}')
+        return info
+
+    def cancel(self, msg=None):
+        if self._slot is not None and not self.done():
+            self._proactor._cancel(self._slot)
+        return super().cancel(msg=msg)
+
+    def _complete(self, res, more, data):
+        self._proactor._unregister(self)
+        if self.done():
+            self._discard(res)
+            return
+        if res == -errno.ECANCELED:
+            super().cancel()
+            return
+        try:
+            value = self._finish(res, data)
+        except OSError as exc:
+            self.set_exception(exc)
+        else:
+            if value is not _PENDING:
+                self.set_result(value)
+
+    def _discard(self, res):
+        pass
+
+
+class _AcceptFuture(_UringFuture):
+
+    def _discard(self, res):
+        # The connection was accepted after the future was cancelled.
+        if res >= 0:
+            os.close(res)
+
+
+class _RecvStream:
+    """Multishot receive on a connected socket, for transports.
+
+    callback(data, None) is called soon with the data of every completion,
+    and with b'' at end of file.  callback(None, exc) is called once the
+    receive has failed, or with exc None once it is done after cancel():
+    the data received until then is still passed to the callback.
+
+    Like the readers of selector event loops, a stream schedules the same
+    handle again whenever data arrives, rather than a handle per chunk.
+    """
+
+    bufsize = 64 * 1024
+
+    def __init__(self, proactor, sock, callback):
+        self._proactor = proactor
+        self._loop = proactor._loop
+        self._fd = sock.fileno()
+        self._callback = callback
+        self._slot = None
+        self._cancelled = False
+        self._multishot = proactor._ring.multishot_recv
+        self._received = collections.deque()
+        self._handle = events.Handle(self._deliver, (), self._loop)
+        self._scheduled = False
+        self._submit()
+
+    def __repr__(self):
+        state = 'cancelled' if self._cancelled else f'slot={self._slot}'
+        return f'<{self.__class__.__name__} fd={self._fd} {state}>'
+
+    def _submit(self, multishot=True):
+        ring = self._proactor._ring
+        if multishot and self._multishot:
+            slot = ring.recv_multishot(self, self._fd)
+        else:
+            slot = ring.recv(self, self._fd, self.bufsize)
+        self._proactor._register(self, slot)
+
+    def _resubmit(self, multishot=True):
+        if self._cancelled:
+            self._schedule(None, None)
+            return
+        try:
+            self._submit(multishot)
+        except OSError as exc:
+            self._schedule(None, exc)
+
+    def _schedule(self, data, exc):
+        self._received.append((data, exc))
+        if not self._scheduled:
+            self._scheduled = True
+            self._loop._add_callback(self._handle)
+
+    def _deliver(self):
+        self._scheduled = False
+        received = self._received
+        while received:
+            data, exc = received.popleft()
+            self._callback(data, exc)
+
+    def cancel(self):
+        if self._cancelled:
+            return
+        self._cancelled = True
+        if self._slot is not None:
+            self._proactor._cancel(self._slot)
+
+    def _complete(self, res, more, data):
+        if not more:
+            self._proactor._unregister(self)
+        if res > 0:
+            self._schedule(data, None)
+            if not more:
+                self._resubmit()
+        elif res == 0:
+            self._schedule(b'', None)
+        elif self._cancelled:
+            self._schedule(None, None)
+        elif res == -errno.ENOBUFS and self._multishot:
+            # All provided buffers are in use: receive the data which
+            # stays in the socket into a buffer of its own.
+            self._resubmit(multishot=False)
+        elif res == -errno.EINVAL and self._multishot:
+            # The kernel does not support multishot receives.
+            self._multishot = False
+            self._resubmit()
+        else:
+            self._schedule(None, _error(res))
+
+
+class _Send:
+    """Send of a buffer on a connected socket, for transports.
+
+    The transport is told when the whole buffer has been sent by a call
+    to its _write_done() method, right from the proactor.
+    """
+
+    def __init__(self, proactor, sock, data, transport):
+        self._proactor = proactor
+        self._fd = sock.fileno()
+        self._view = memoryview(data)
+        self._sent = 0
+        self._transport = transport
+        self._slot = None
+        self._cancelled = False
+        self._submit(data)
+
+    def __repr__(self):
+        state = 'cancelled' if self._cancelled else f'slot={self._slot}'
+        return (f'<{self.__class__.__name__} fd={self._fd} '
+                f'sent={self._sent}/{len(self._view)} {state}>')
+
+    def _submit(self, data):
+        slot = self._proactor._ring.send(self, self._fd, data, _MSG_NOSIGNAL)
+        self._proactor._register(self, slot)
+
+    def cancel(self):
+        if self._cancelled:
+            return
+        self._cancelled = True
+        if self._slot is not None:
+            self._proactor._cancel(self._slot)
+
+    def _complete(self, res, more, data):
+        self._proactor._unregister(self)
+        if self._cancelled:
+            return
+        if res < 0:
+            loop = self._proactor._loop
+            loop.call_soon(self._transport._write_error, _error(res))
+            return
+        self._sent += res
+        if self._sent < len(self._view):
+            self._submit(self._view[self._sent:])
+        else:
+            self._view.release()
+            self._transport._write_done()
+
+
+class _Acceptor:
+    """Multishot accept on a listening socket served by the event loop."""
+
+    def __init__(self, proactor, sock):
+        self._proactor = proactor
+        self._loop = proactor._loop
+        self._sock = sock
+        self._slot = None
+        self._closed = False
+        self._conns = collections.deque()
+        self._exc = None
+        self._waiter = None
+        self._submit()
+
+    def _submit(self):
+        slot = self._proactor._ring.accept(self, self._sock.fileno(), True)
+        self._proactor._register(self, slot)
+
+    def accept(self):
+        waiter = self._loop.create_future()
+        if self._exc is not None:
+            waiter.set_exception(self._exc)
+            self._exc = None
+        elif self._conns:
+            waiter.set_result(self._conns.popleft())
+        else:
+            self._waiter = waiter
+        return waiter
+
+    def cancel(self):
+        if self._closed:
+            return
+        self._closed = True
+        if self._slot is not None:
+            self._proactor._cancel(self._slot)
+        while self._conns:
+            conn, addr = self._conns.popleft()
+            conn.close()
+
+    def _complete(self, res, more, data):
+        if not more:
+            self._proactor._unregister(self)
+        if self._closed:
+            if res >= 0:
+                os.close(res)
+            return
+        if res >= 0:
+            sock = self._sock
+            conn = socket.socket(sock.family, sock.type, sock.proto,
+                                 fileno=res)
+            conn.setblocking(False)
+            try:
+                addr = conn.getpeername()
+            except OSError:
+                addr = None
+            self._conns.append((conn, addr))
+        elif res == -errno.EINVAL and not more:
+            # The kernel does not support multishot accepts: accept the
+            # connections one at a time.
+            self._closed = True
+            del self._proactor._acceptors[self._sock]
+            waiter = self._waiter
+            self._waiter = None
+            if waiter is not None and not waiter.done():
+                fut = self._proactor.accept(self._sock)
+                futures._chain_future(fut, waiter)
+            return
+        elif res != -errno.ECONNABORTED:
+            self._exc = _error(res)
+        if not more and self._exc is None:
+            try:
+                self._submit()
+            except (OSError, ValueError) as exc:
+                self._exc = exc
+        waiter = self._waiter
+        if waiter is None or waiter.done():
+            self._waiter = None
+        elif self._exc is not None:
+            self._waiter = None
+            waiter.set_exception(self._exc)
+            self._exc = None
+        elif self._conns:
+            self._waiter = None
+            waiter.set_result(self._conns.popleft())
+
+
+class UringProactor:
+    """Proactor implementation using io_uring.
+
+    Operations are only queued when they are started, and submitted to
+    the kernel by select(), with the same system call which waits for
+    completions.
+    """
+
+    def __init__(self, entries=4096):
+        if _uring is None:
+            raise OSError(errno.ENOSYS, 'io_uring is not supported')
+        self._loop = None
+        self._ring = _uring.Ring(entries)
+        # Pending operations.  Their slot can be reused as soon as wait()
+        # returns their last completion, before it is handled here.
+        self._ops = set()
+        self._acceptors = {}    # listening socket => _Acceptor
+
+    def _check_closed(self):
+        if self._ring is None:
+            raise RuntimeError('UringProactor is closed')
+
+    def __repr__(self):
+        info = [f'pending#={len(self._ops)}']
+        if self._ring is None:
+            info.append('closed')
+        return '<%s %s>' % (self.__class__.__name__, " ".join(info))
+
+    def set_loop(self, loop):
+        self._loop = loop
+
+    def select(self, timeout=None):
+        self._poll(timeout)
+        return []
+
+    def _result(self, value):
+        fut = self._loop.create_future()
+        fut.set_result(value)
+        return fut
+
+    def _future(self, finish, cls=_UringFuture):
+        self._check_closed()
+        fut = cls(self, finish, loop=self._loop)
+        if fut._source_traceback:
+            del fut._source_traceback[-1]
+        return fut
+
+    def _register(self, op, slot):
+        op._slot = slot
+        self._ops.add(op)
+        return op
+
+    def _unregister(self, op):
+        self._ops.remove(op)
+        op._slot = None
+
+    def _cancel(self, slot):
+        if self._ring is not None:
+            self._ring.cancel(slot)
+
+    @staticmethod
+    def _finish_result(res, data):
+        if res < 0:
+            raise _error(res)
+        return res
+
+    @staticmethod
+    def _finish_data(res, data):
+        if res < 0:
+            raise _error(res)
+        return data
+
+    def _when_ready(self, conn, events, func):
+        # Call func() once conn is ready, for the operations which io_uring
+        # runs with a message header that cannot be kept alive here.
+        try:
+            return self._result(func())
+        except (BlockingIOError, InterruptedError):
+            pass
+
+        def finish(res, data):
+            if res < 0:
+                raise _error(res)
+            try:
+                return func()
+            except (BlockingIOError, InterruptedError):
+                self._register(fut, self._ring.poll(fut, conn.fileno(),
+                                                    events))
+                return _PENDING
+
+        fut = self._future(finish)
+        return self._register(fut, self._ring.poll(fut, conn.fileno(),
+                                                   events))
+
+    def poll(self, conn, events):
+        fut = self._future(self._finish_result)
+        return self._register(fut, self._ring.poll(fut, conn.fileno(),
+                                                   events))
+
+    def recv(self, conn, nbytes, flags=0):
+        fut = self._future(self._finish_data)
+        if isinstance(conn, socket.socket):
+            slot = self._ring.recv(fut, conn.fileno(), nbytes, flags)
+        else:
+            slot = self._ring.read(fut, conn.fileno(), nbytes)
+        return self._register(fut, slot)
+
+    def recv_into(self, conn, buf, flags=0):
+        fut = self._future(self._finish_result)
+        if isinstance(conn, socket.socket):
+            slot = self._ring.recv_into(fut, conn.fileno(), buf, flags)
+        else:
+            slot = self._ring.read_into(fut, conn.fileno(), buf)
+        return self._register(fut, slot)
+
+    def recv_stream(self, conn, callback):
+        self._check_closed()
+        return _RecvStream(self, conn, callback)
+
+    def send_for_transport(self, conn, data, transport):
+        self._check_closed()
+        return _Send(self, conn, data, transport)
+
+    def recvfrom(self, conn, nbytes, flags=0):
+        return self._when_ready(conn, select.POLLIN,
+                                lambda: conn.recvfrom(nbytes, flags))
+
+    def recvfrom_into(self, conn, buf, nbytes=0, flags=0):
+        return self._when_ready(conn, select.POLLIN,
+                                lambda: conn.recvfrom_into(buf, nbytes, flags))
+
+    def sendto(self, conn, buf, flags=0, addr=None):
+        return self._when_ready(conn, select.POLLOUT,
+                                lambda: conn.sendto(buf, flags, addr))
+
+    def send(self, conn, buf, flags=0):
+        view = memoryview(buf).cast('B')
+        sent = 0
+        is_socket = isinstance(conn, socket.socket)
+        flags |= _MSG_NOSIGNAL
+
+        def submit(data):
+            if is_socket:
+                slot = self._ring.send(fut, conn.fileno(), data, flags)
+            else:
+                slot = self._ring.write(fut, conn.fileno(), data)
+            self._register(fut, slot)
+
+        def finish(res, data):
+            nonlocal sent
+            if res < 0:
+                raise _error(res)
+            sent += res
+            if sent < len(view):
+                submit(view[sent:])
+                return _PENDING
+            return sent
+
+        fut = self._future(finish)
+        submit(view)
+        return fut
+
+    def accept(self, listener):
+        acceptor = self._acceptors.get(listener)
+        if acceptor is not None:
+            return acceptor.accept()
+
+        def finish(res, data):
+            if res < 0:
+                raise _error(res)
+            conn = socket.socket(listener.family, listener.type,
+                                 listener.proto, fileno=res)
+            conn.setblocking(False)
+            return conn, conn.getpeername()
+
+        fut = self._future(finish, _AcceptFuture)
+        return self._register(fut, self._ring.accept(fut, listener.fileno()))
+
+    def connect(self, conn, address):
+        try:
+            conn.connect(address)
+        except (BlockingIOError, InterruptedError):
+            pass
+        else:
+            return self._result(None)
+
+        def finish(res, data):
+            if res < 0:
+                raise _error(res)
+            err = conn.getsockopt(socket.SOL_SOCKET, socket.SO_ERROR)
+            if err != 0:
+                raise OSError(err, f'Connect call failed {address}')
+
+        fut = self._future(finish)
+        return self._register(fut, self._ring.poll(fut, conn.fileno(),
+                                                   select.POLLOUT))
+
+    def sendfile(self, sock, file, offset, count):
+        fileno = file.fileno()
+
+        def send():
+            nonlocal offset, count
+            while count > 0:
+                sent = os.sendfile(sock.fileno(), fileno, offset, count)
+                if sent == 0:
+                    break  # EOF
+                offset += sent
+                count -= sent
+
+        return self._when_ready(sock, select.POLLOUT, send)
+
+    def _serve(self, sock):
+        # Accept the connections of a listening socket with a multishot
+        # accept, which completes for every connection.
+        self._check_closed()
+        if sock not in self._acceptors:
+            try:
+                self._acceptors[sock] = _Acceptor(self, sock)
+            except NotImplementedError:
+                pass
+
+    def _poll(self, timeout=None):
+        if timeout is not None and timeout < 0:
+            raise ValueError("negative timeout")
+        for op, res, more, data in self._ring.wait(timeout):
+            op._complete(res, more, data)
+
+    def _stop_serving(self, sock):
+        # The ring holds a reference to the socket while an accept is
+        # pending, so submit the cancellation before the socket is closed.
+        acceptor = self._acceptors.pop(sock, None)
+        if acceptor is not None:
+            acceptor.cancel()
+            self._ring.submit()
+
+    def close(self):
+        if self._ring is None:
+            # already closed
+            return
+
+        # Cancel remaining operations.
+        for acceptor in self._acceptors.values():
+            acceptor.cancel()
+        self._acceptors.clear()
+        for op in list(self._ops):
+            op.cancel()
+
+        # Wait until all cancelled operations complete, since the kernel
+        # may use their buffers until then.  Display progress every second.
+        msg_update = 1.0
+        start_time = time.monotonic()
+        next_msg = start_time + msg_update
+        while self._ops:
+            if next_msg <= time.monotonic():
+                logger.debug('%r is running after closing for %.1f seconds',
+                             self, time.monotonic() - start_time)
+                next_msg = time.monotonic() + msg_update
+
+            # handle a few completions, or timeout
+            self._poll(msg_update)
+
+        self._ring.close()
+        self._ring = None
+
+    def __del__(self):
+        self.close()
+
+
+class _UringSocketTransport(proactor_events._ProactorSocketTransport):
+    """Transport for connected sockets.
+
+    It receives with a multishot receive, and sends without the futures
+    of the proactor, which calls it back when a send is done.  Data received while reading is paused is kept until reading is resumed;
+    the receive is cancelled once more than max_paused_size bytes are kept.
+    """
+
+    max_paused_size = 256 * 1024
+
+    def __init__(self, loop, sock, protocol, waiter=None,
+                 extra=None, server=None):
+        self._paused_data = collections.deque()
+        self._paused_size = 0
+        self._read_eof = False
+        self._after_write_scheduled = False
+        super().__init__(loop, sock, protocol, waiter, extra, server)
+        # Received data comes in bytes objects from the ring.
+        self._data = None
+
+    def resume_reading(self):
+        if self._closing or not self._paused:
+            return
+
+        self._paused = False
+        if self._paused_data:
+            self._loop.call_soon(self._feed_paused_data)
+        if self._read_fut is None:
+            self._loop.call_soon(self._loop_reading)
+
+        if self._loop.get_debug():
+            logger.debug("%r resumes reading", self)
+
+    def _feed_paused_data(self):
+        while self._paused_data and not self._paused and not self._closing:
+            data = self._paused_data.popleft()
+            self._paused_size -= len(data)
+            self._data_received(data, len(data))
+
+    def _loop_writing(self, f=None, data=None):
+        # Called by write() when no send is pending.
+        assert f is None and data
+        try:
+            self._write_fut = self._loop._proactor.send_for_transport(
+                self._sock, data, self)
+        except OSError as exc:
+            self._fatal_error(exc, 'Fatal write error on socket transport')
+            return
+        self._pending_write = len(data)
+        self._maybe_pause_protocol()
+
+    def _write_done(self):
+        # Called by the proactor when the pending send is done: protocol
+        # methods cannot be called here, they are called by _after_write().
+        self._write_fut = None
+        self._pending_write = 0
+        data = self._buffer
+        self._buffer = None
+        if data:
+            try:
+                self._write_fut = self._loop._proactor.send_for_transport(
+                    self._sock, data, self)
+            except OSError as exc:
+                self._loop.call_soon(self._write_error, exc)
+                return
+            self._pending_write = len(data)
+        if self._after_write_scheduled:
+            return
+        if self._protocol_paused or (
+                self._write_fut is None and
+                (self._closing or self._eof_written or
+                 self._empty_waiter is not None)):
+            self._after_write_scheduled = True
+            self._loop.call_soon(self._after_write)
+
+    def _after_write(self):
+        self._after_write_scheduled = False
+        if self._called_connection_lost:
+            return
+        if self._write_fut is None:
+            if self._closing:
+                self._loop.call_soon(self._call_connection_lost, None)
+            if self._eof_written:
+                self._sock.shutdown(socket.SHUT_WR)
+            if (self._empty_waiter is not None
+                    and not self._empty_waiter.done()):
+                self._empty_waiter.set_result(None)
+        # Note that we do this last since the callback is called immediately
+        # and it may add more data to the buffer.
+        self._maybe_resume_protocol()
+
+    def _write_error(self, exc):
+        self._write_fut = None
+        if isinstance(exc, ConnectionResetError):
+            self._force_close(exc)
+        else:
+            self._fatal_error(exc, 'Fatal write error on socket transport')
+
+    def _loop_reading(self, fut=None):
+        if (self._closing or self._paused or self._read_eof
+                or self._read_fut is not None):
+            return
+        try:
+            self._read_fut = self._loop._proactor.recv_stream(
+                self._sock, self._stream_received)
+        except OSError as exc:
+            self._fatal_error(exc, 'Fatal read error on socket transport')
+
+    def _stream_received(self, data, exc):
+        if data is None:
+            # The receive failed, or it is done after being cancelled.
+            self._read_fut = None
+            if self._closing:
+                return
+            if exc is None:
+                self._loop_reading()
+            elif isinstance(exc, ConnectionResetError):
+                self._force_close(exc)
+            else:
+                self._fatal_error(exc, 'Fatal read error on socket transport')
+            return
+        if self._closing:
+            # since close() has been called we ignore any read data
+            return
+        if not data:
+            # the receive is done at end of file
+            self._read_fut = None
+            self._read_eof = True
+        if self._paused or self._paused_data:
+            self._paused_data.append(data)
+            self._paused_size += len(data)
+            if (self._paused_size > self.max_paused_size
+                    and self._read_fut is not None):
+                # Stop receiving, it is restarted once the receive is done
+                # if reading has been resumed.
+                self._read_fut.cancel()
+            return
+        self._data_received(data, len(data))
+
+
+class _UringWritePipeTransport(
+        proactor_events._ProactorBaseWritePipeTransport):
+    """Transport for write pipes.
+
+    The write end of a pipe cannot be read to learn that the read end was
+    closed, unlike a Windows pipe: it is polled for an error instead.
+    """
+
+    def __init__(self, *args, **kw):
+        super().__init__(*args, **kw)
+        self._read_fut = self._loop._proactor.poll(self._sock, select.POLLERR)
+        self._read_fut.add_done_callback(self._pipe_closed)
+
+    def _pipe_closed(self, fut):
+        if fut.cancelled():
+            # the transport has been closed
+            return
+        if self._closing:
+            assert self._read_fut is None
+            return
+        assert fut is self._read_fut, (fut, self._read_fut)
+        self._read_fut = None
+        if self._write_fut is not None:
+            self._force_close(BrokenPipeError())
+        else:
+            self.close()
+
+
+class UringEventLoop(proactor_events.BaseProactorEventLoop):
+    """Proactor event loop using io_uring.
+
+    Raise OSError if io_uring is not supported.
+    """
+
+    def __init__(self, proactor=None):
+        if proactor is None:
+            proactor = UringProactor()
+        super().__init__(proactor)
+
+    def _make_socket_transport(self, sock, protocol, waiter=None,
+                               extra=None, server=None):
+        return _UringSocketTransport(self, sock, protocol, waiter,
+                                     extra, server)
+
+    def _make_write_pipe_transport(self, sock, protocol, waiter=None,
+                                   extra=None):
+        return _UringWritePipeTransport(self, sock, protocol, waiter, extra)
+
+    def _make_ssl_transport(
+            self, rawsock, protocol, sslcontext, waiter=None,
+            *, server_side=False, server_hostname=None,
+            extra=None, server=None,
+            ssl_handshake_timeout=None,
+            ssl_shutdown_timeout=None):
+        ssl_protocol = sslproto.SSLProtocol(
+                self, protocol, sslcontext, waiter,
+                server_side, server_hostname,
+                ssl_handshake_timeout=ssl_handshake_timeout,
+                ssl_shutdown_timeout=ssl_shutdown_timeout)
+        _UringSocketTransport(self, rawsock, ssl_protocol,
+                              extra=extra, server=server)
+        return ssl_protocol._app_transport
+
+    def _run_forever_setup(self):
+        assert self._self_reading_future is None
+        self.call_soon(self._loop_self_reading)
+        super()._run_forever_setup()
+
+    def _run_forever_cleanup(self):
+        super()._run_forever_cleanup()
+        if self._self_reading_future is not None:
+            self._self_reading_future.cancel()
+            self._self_reading_future = None
+
+    def _start_serving(self, protocol_factory, sock,
+                       sslcontext=None, server=None, backlog=100,
+                       ssl_handshake_timeout=None,
+                       ssl_shutdown_timeout=None):
+        self._proactor._serve(sock)
+        super()._start_serving(protocol_factory, sock, sslcontext, server,
+                               backlog, ssl_handshake_timeout,
+                               ssl_shutdown_timeout)
@@ -8,6 +8,8 @@
 * Counter      dict subclass for counting hashable objects
 * OrderedDict  dict subclass that remembers the order entries were added
 * defaultdict  dict subclass that calls a factory function to supply missing values
+* ConcurrentDict  dict-like class for sharing items between many threads
+* ScalarDict   dict-like class storing int64 or float values compactly
 * UserDict     wrapper around dictionary objects for easier dict subclassing
 * UserList     wrapper around list objects for easier list subclassing
 * UserString   wrapper around string objects for easier string subclassing
@@ -16,8 +18,10 @@
 
 __all__ = [
     'ChainMap',
+    'ConcurrentDict',
     'Counter',
     'OrderedDict',
+    'ScalarDict',
     'UserDict',
     'UserList',
     'UserString',
@@ -59,6 +63,20 @@
 except ImportError:
     pass
 
+try:
+    from _collections import ConcurrentDict
+except ImportError:
+    pass
+else:
+    _collections_abc.MutableMapping.register(ConcurrentDict)
+
+try:
+    from _collections import ScalarDict
+except ImportError:
+    pass
+else:
+    _collections_abc.MutableMapping.register(ScalarDict)
+
 heapq = None  # Lazily imported
 
 
@@ -1,5 +1,6 @@
 """Implementation of JSONDecoder
 """
+import codecs
 import re
 
 from json import scanner
@@ -8,7 +9,7 @@
 except ImportError:
     c_scanstring = None
 
-__all__ = ['JSONDecoder', 'JSONDecodeError']
+__all__ = ['JSONDecoder', 'JSONDecodeError', 'JSONStreamDecoder']
 
 FLAGS = re.VERBOSE | re.MULTILINE | re.DOTALL
 
@@ -131,6 +132,7 @@ def py_scanstring(s, end, strict=True,
 scanstring = c_scanstring or py_scanstring
 
 WHITESPACE = re.compile(r'[ \t\n\r]*', FLAGS)
+WHITESPACE_BYTES = re.compile(rb'[ \t\n\r]*', FLAGS)
 WHITESPACE_STR = ' \t\n\r'
 
 
@@ -348,6 +350,31 @@ def decode(self, s, _w=WHITESPACE.match):
             raise JSONDecodeError("Extra data", s, end)
         return obj
 
+    def _decode_utf8(self, b, _w=WHITESPACE_BYTES.match):
+        """Return the Python representation of ``b`` (a bytes-like object
+        containing a UTF-8 encoded JSON document).
+
+        The C scanner parses ``b`` in place and only decodes the strings it
+        returns.  Errors are reported against the decoded document, like
+        decode() does.
+        """
+        c_make_scanner = scanner.c_make_scanner
+        if c_make_scanner is None or not isinstance(self.scan_once,
+                                                    c_make_scanner):
+            return self.decode(str(b, 'utf-8', 'surrogatepass'))
+        try:
+            obj, end = self.scan_once(b, _w(b, 0).end())
+        except StopIteration as err:
+            s = str(b, 'utf-8', 'surrogatepass')
+            pos = len(str(b[:err.value], 'utf-8', 'surrogatepass'))
+            raise JSONDecodeError("Expecting value", s, pos) from None
+        end = _w(b, end).end()
+        if end != len(b):
+            s = str(b, 'utf-8', 'surrogatepass')
+            pos = len(str(b[:end], 'utf-8', 'surrogatepass'))
+            raise JSONDecodeError("Extra data", s, pos)
+        return obj
+
     def raw_decode(self, s, idx=0):
         """Decode a JSON document from ``s`` (a ``str`` beginning with
         a JSON document) and return a 2-tuple of the Python
@@ -362,3 +389,112 @@ def raw_decode(self, s, idx=0):
         except StopIteration as err:
             raise JSONDecodeError("Expecting value", s, err.value) from None
         return obj, end
+
+
+class JSONStreamDecoder(object):
+    """Incremental decoder for a stream of JSON values.
+
+    Data is passed in chunks to feed(), which returns the list of the values
+    completed by that chunk.  By default the stream is a sequence of JSON
+    values separated by optional whitespace, such as newline-delimited JSON.
+    If ``array`` is true, the stream must contain a single JSON array and
+    the values returned are its elements.
+
+    Only the text of the value being read is kept between calls, so
+    arbitrarily long streams can be decoded with bounded memory.
+
+    ``decoder`` is the JSONDecoder instance used to decode each value.
+    Positions in JSONDecodeError are relative to the value (or to the
+    chunk for misplaced delimiters), not to the whole stream.
+    """
+
+    def __init__(self, decoder=None, *, array=False):
+        self.decoder = JSONDecoder() if decoder is None else decoder
+        self.array = array
+        self._split = scanner.make_splitter()
+        self._pending = []
+        self._bytes_decoder = None
+        # 'value' for a stream of values; for an array, one of 'start',
+        # 'first' (after '['), 'next' (after ','), 'sep' (after an
+        # element) and 'end' (after ']').
+        self._state = 'start' if array else 'value'
+
+    def feed(self, data, _w=WHITESPACE.match):
+        """Decode the next chunk of the stream.
+
+        ``data`` is a ``str``, or a ``bytes``-like object holding UTF-8
+        encoded text.  Return the list of values completed by this chunk.
+        """
+        if isinstance(data, str):
+            s = data
+        else:
+            if self._bytes_decoder is None:
+                self._bytes_decoder = codecs.getincrementaldecoder('utf-8')(
+                    'surrogatepass')
+            s = self._bytes_decoder.decode(data)
+        values = []
+        idx = 0
+        end = len(s)
+        while idx < end:
+            if not self._pending:
+                idx = _w(s, idx).end()
+                if idx == end:
+                    break
+                state = self._state
+                nextchar = s[idx]
+                if state == 'start':
+                    if nextchar != '[':
+                        raise JSONDecodeError("Expecting '['", s, idx)
+                    self._state = 'first'
+                    idx += 1
+                    continue
+                elif state == 'sep' or state == 'first' and nextchar == ']':
+                    if nextchar == ']':
+                        self._state = 'end'
+                    elif nextchar == ',' and state == 'sep':
+                        self._state = 'next'
+                    else:
+                        raise JSONDecodeError("Expecting ',' delimiter", s, idx)
+                    idx += 1
+                    continue
+                elif state == 'next' and nextchar == ']':
+                    raise JSONDecodeError(
+                        "Illegal trailing comma before end of array", s, idx)
+                elif state == 'end':
+                    raise JSONDecodeError("Extra data", s, idx)
+            value_end = self._split(s, idx)
+            if value_end < 0:
+                self._pending.append(s[idx:])
+                break
+            self._pending.append(s[idx:value_end])
+            values.append(self._decode_pending())
+            idx = value_end
+        return values
+
+    def close(self):
+        """Finish decoding the stream.
+
+        Return the list of values completed by the end of the stream, and
+        raise JSONDecodeError if the stream is truncated.
+        """
+        values = []
+        if self._bytes_decoder is not None:
+            values = self.feed(self._bytes_decoder.decode(b'', True))
+        if self._pending:
+            values.append(self._decode_pending())
+        if self._state in ('start', 'first', 'next'):
+            raise JSONDecodeError("Expecting value", '', 0)
+        if self._state == 'sep':
+            raise JSONDecodeError("Expecting ',' delimiter", '', 0)
+        return values
+
+    def _decode_pending(self, _w=WHITESPACE.match):
+        s = ''.join(self._pending)
+        self._pending.clear()
+        obj, end = self.decoder.raw_decode(s)
+        end = _w(s, end).end()
+        if end != len(s):
+            raise JSONDecodeError("Extra data", s, end)
+        if self.array:
+            self._state = 'sep'
+        return obj
@@ -1,6 +1,9 @@
 """Implementation of JSONEncoder
 """
+import os
 import re
+import sys
+from _thread import allocate_lock
 
 try:
     from _json import encode_basestring_ascii as c_encode_basestring_ascii
@@ -34,6 +37,31 @@
 
 INFINITY = float('inf')
 
+# With workers, containers are encoded in chunks of at least that many
+# items, and only if they have at least two chunks: handing a smaller chunk
+# over to another thread costs more than encoding it.
+_PARALLEL_CHUNK = 1024
+# The thread pool shared by all encoders, created on first use.
+_executor = None
+_executor_lock = allocate_lock()
+
+def _get_executor():
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            from concurrent.futures import ThreadPoolExecutor
+            _executor = ThreadPoolExecutor(thread_name_prefix='json.encoder')
+        return _executor
+
+def _after_fork():
+    # The threads of the pool do not exist in the child process.
+    global _executor
+    _executor = None
+    _executor_lock._at_fork_reinit()
+
+if hasattr(os, 'register_at_fork'):
+    os.register_at_fork(after_in_child=_after_fork)
+
 def py_encode_basestring(s):
     """Return a JSON representation of a Python string
 
@@ -104,7 +132,7 @@ class JSONEncoder(object):
     key_separator = ': '
     def __init__(self, *, skipkeys=False, ensure_ascii=True,
             check_circular=True, allow_nan=True, sort_keys=False,
-            indent=None, separators=None, default=None):
+            indent=None, separators=None, default=None, workers=None):
         """Constructor for JSONEncoder, with sensible defaults.
 
         If skipkeys is false, then it is a TypeError to attempt
@@ -143,6 +171,11 @@ def __init__(self, *, skipkeys=False, ensure_ascii=True,
         that can't otherwise be serialized.  It should return a JSON encodable
         version of the object or raise a ``TypeError``.
 
+        If workers is an integer greater than 1, encode() splits a large
+        list, tuple or dict into chunks which are encoded by up to that many
+        threads.  The result is the same as with serial encoding.  This is
+        only done on the free-threaded build, with the C accelerator.
+
         """
 
         self.skipkeys = skipkeys
@@ -157,6 +190,7 @@ def __init__(self, *, skipkeys=False, ensure_ascii=True,
             self.item_separator = ','
         if default is not None:
             self.default = default
+        self.workers = workers
 
     def default(self, o):
         """Implement this method in a subclass such that it returns
@@ -194,6 +228,15 @@ def encode(self, o):
                 return encode_basestring_ascii(o)
             else:
                 return encode_basestring(o)
+        if (self.workers is not None and self.workers > 1 and
+            type(o) in (list, tuple, dict) and
+            len(o) >= 2 * _PARALLEL_CHUNK and
+            c_make_encoder is not None and not sys._is_gil_enabled() and
+            type(self).iterencode is JSONEncoder.iterencode):
+            return self._encode_parallel(o)
+        return self._encode(o)
+
+    def _encode(self, o):
         # This doesn't pass the iterator directly to ''.join() because the
         # exceptions aren't as detailed.  The list call should be roughly
         # equivalent to the PySequence_Fast that ''.join() would do.
@@ -202,6 +245,82 @@ def encode(self, o):
             chunks = list(chunks)
         return ''.join(chunks)
 
+    def _encode_parallel(self, o):
+        if isinstance(o, dict):
+            items = list(o.items())
+            if self.sort_keys:
+                try:
+                    items.sort()
+                except TypeError:
+                    # Let serial encoding raise the same error.
+                    return self._encode(o)
+            start, end = '{', '}'
+        else:
+            items = o
+            start, end = '[', ']'
+        # Use several chunks per worker to balance the load.
+        n = len(items)
+        size = max(_PARALLEL_CHUNK, -(-n // (4 * self.workers)))
+        nchunks = -(-n // size)
+        indent = self.indent
+        if indent is not None and not isinstance(indent, str):
+            indent = ' ' * indent
+
+        results = [None] * nchunks
+        # Chunks are taken in order.  Serial encoding stops at the first
+        # error, so no chunk is taken after a failed one, and only the
+        # error of the first failed chunk is raised.
+        lock = allocate_lock()
+        state = [0, nchunks, None]  # next chunk, failed chunk, its error
+        def work():
+            while True:
+                with lock:
+                    i = state[0]
+                    if i >= state[1]:
+                        return
+                    state[0] = i + 1
+                # Each chunk has its own encoder, whose markers already
+                # contain o, as when serial encoding reaches its items.
+                encoder = c_make_encoder(
+                    {id(o): o} if self.check_circular else None,
+                    self.default,
+                    encode_basestring_ascii if self.ensure_ascii
+                    else encode_basestring,
+                    indent, self.key_separator, self.item_separator,
+                    self.sort_keys, self.skipkeys, self.allow_nan)
+                try:
+                    results[i] = encoder._encode_chunk(
+                        o, items, i * size, min(i * size + size, n), 0)
+                except Exception as exc:
+                    with lock:
+                        if i < state[1]:
+                            state[1:] = [i, exc]
+                    return
+        executor = _get_executor()
+        futures = [executor.submit(work)
+                   for _ in range(min(self.workers, nchunks) - 1)]
+        work()
+        # The calling thread only returns when all chunks are taken, so
+        # the tasks which have not started yet have nothing left to do.
+        for f in futures:
+            if not f.cancel():
+                f.result()
+        exc = state[2]
+        if exc is not None:
+            try:
+                raise exc
+            finally:
+                exc = state = None
+
+        # Each chunk starts with the newline and indentation of its first
+        # item, so the item separator joins them.
+        bodies = [r for r in results if r]
+        if not bodies:
+            return start + end
+        if self.indent is not None:
+            end = '\n' + end
+        return start + self.item_separator.join(bodies) + end
+
     def iterencode(self, o, _one_shot=False):
         """Encode the given object and yield each string
         representation as available.
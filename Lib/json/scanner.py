@@ -5,8 +5,12 @@
     from _json import make_scanner as c_make_scanner
 except ImportError:
     c_make_scanner = None
+try:
+    from _json import make_splitter as c_make_splitter
+except ImportError:
+    c_make_splitter = None
 
-__all__ = ['make_scanner']
+__all__ = ['make_scanner', 'make_splitter']
 
 NUMBER_RE = re.compile(
     r'(-?(?:0|[1-9][0-9]*))(\.[0-9]+)?([eE][-+]?[0-9]+)?',
@@ -71,3 +75,84 @@ def scan_once(string, idx):
     return scan_once
 
 make_scanner = c_make_scanner or py_make_scanner
+
+SPLIT_STRING = re.compile(r'["\\]')
+SPLIT_CONTAINER = re.compile(r'["\[\]{}]')
+SPLIT_SCALAR = re.compile(r'[ \t\n\r"\[\]{},:]')
+WHITESPACE = re.compile(r'[ \t\n\r]*')
+
+def py_make_splitter():
+    """Return a callable split(string, idx) that finds where the JSON value
+    starting at or after string[idx] ends.  It returns the index just after
+    the value, or -1 if the value continues in the next string passed to it.
+    The value is not parsed or validated.
+    """
+    depth = 0
+    started = scalar = in_string = escape = False
+
+    def split(string, idx):
+        nonlocal depth, started, scalar, in_string, escape
+        if not 0 <= idx <= len(string):
+            raise ValueError("idx is out of bounds")
+        end = len(string)
+        while idx < end:
+            if in_string:
+                if escape:
+                    escape = False
+                    idx += 1
+                    continue
+                m = SPLIT_STRING.search(string, idx)
+                if m is None:
+                    return -1
+                idx = m.end()
+                if m.group() == '\\':
+                    escape = True
+                    continue
+                in_string = False
+                if not depth:
+                    started = False
+                    return idx
+                continue
+            if not started:
+                idx = WHITESPACE.match(string, idx).end()
+                if idx == end:
+                    return -1
+                started = True
+                nextchar = string[idx]
+                idx += 1
+                if nextchar == '"':
+                    in_string = True
+                elif nextchar in '[{':
+                    depth = 1
+                elif nextchar in ']},:':
+                    # Not a value, let the scanner report the error
+                    started = False
+                    return idx
+                else:
+                    scalar = True
+                continue
+            if scalar:
+                m = SPLIT_SCALAR.search(string, idx)
+                if m is None:
+                    return -1
+                scalar = started = False
+                return m.start()
+            m = SPLIT_CONTAINER.search(string, idx)
+            if m is None:
+                return -1
+            idx = m.end()
+            nextchar = m.group()
+            if nextchar == '"':
+                in_string = True
+            elif nextchar in '[{':
+                depth += 1
+            else:
+                depth -= 1
+                if not depth:
+                    started = False
+                    return idx
+        return -1
+
+    return split
+
+make_splitter = c_make_splitter or py_make_splitter
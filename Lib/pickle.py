@@ -45,6 +45,11 @@
 except ImportError:
     _HAVE_PICKLE_BUFFER = False
 
+try:
+    from array import array as _array
+except ImportError:
+    _array = None
+
 
 # Shortcut for use in isinstance testing
 bytes_types = (bytes, bytearray)
@@ -578,6 +583,10 @@ def save(self, obj, save_persistent_id=True):
             if reduce is not _NoValue:
                 rv = reduce(obj)
             else:
+                if (t is _array and self._buffer_callback is not None and
+                    self._save_buffer_out_of_band(obj)):
+                    return
+
                 # Check for a class with a custom metaclass; treat as regular
                 # class
                 if issubclass(t, type):
@@ -878,6 +887,9 @@ def _save_bytearray_no_memo(self, obj):
             self.write(BYTEARRAY8 + pack("<Q", n) + obj)
 
     def save_bytearray(self, obj):
+        if (self._buffer_callback is not None and
+            self._save_buffer_out_of_band(obj)):
+            return
         if self.proto < 5:
             if not obj:  # bytearray is empty
                 self.save_reduce(bytearray, (), obj=obj)
@@ -889,6 +901,27 @@ def save_bytearray(self, obj):
     dispatch[bytearray] = save_bytearray
 
     if _HAVE_PICKLE_BUFFER:
+        def _save_buffer_out_of_band(self, obj):
+            # Save a bytearray or an array.array as an out-of-band buffer,
+            # unless buffer_callback asks for its data in-band.  Return
+            # true if obj was saved.  It is rebuilt by bytearray(buffer)
+            # or array(typecode, bytes(buffer)), which any version
+            # supporting protocol 5 can load, and which copy the buffer.
+            if self._buffer_callback(PickleBuffer(obj)):
+                return False
+
+            write = self.write
+            if type(obj) is bytearray:
+                self.save(bytearray)
+                write(NEXT_BUFFER + TUPLE1 + REDUCE)
+            else:
+                self.save(_array)
+                self.save(obj.typecode)
+                self.save(bytes)
+                write(NEXT_BUFFER + TUPLE1 + REDUCE + TUPLE2 + REDUCE)
+            self.memoize(obj)
+            return True
+
         def save_picklebuffer(self, obj):
             if self.proto < 5:
                 raise PicklingError("PickleBuffer can only be pickled with "
@@ -922,6 +955,9 @@ def save_picklebuffer(self, obj):
                         self.write(READONLY_BUFFER)
 
         dispatch[PickleBuffer] = save_picklebuffer
+    else:
+        def _save_buffer_out_of_band(self, obj):
+            return False
 
     def save_str(self, obj):
         if self.bin:
@@ -1882,9 +1918,12 @@ def _load(file, *, fix_imports=True, encoding="ASCII", errors="strict",
                      encoding=encoding, errors=errors).load()
 
 def _loads(s, /, *, fix_imports=True, encoding="ASCII", errors="strict",
-           buffers=None):
+           buffers=None, workers=None):
     if isinstance(s, str):
         raise TypeError("Can't load pickle from unicode string")
+    # Only the C implementation decodes ahead on helper threads.
+    if workers is not None and workers < 1:
+        raise ValueError("workers must be at least 1")
     file = io.BytesIO(s)
     return _Unpickler(file, fix_imports=fix_imports, buffers=buffers,
                       encoding=encoding, errors=errors).load()
@@ -522,10 +522,54 @@ def _get_charset_prefix(pattern, flags):
         return charset
     return None
 
+def _iter_sequence(pattern, flags):
+    # yield the items of a pattern with the flags applying to them,
+    # looking through groups
+    for op, av in pattern.data:
+        if op is SUBPATTERN:
+            group, add_flags, del_flags, p = av
+            yield from _iter_sequence(
+                p, _combine_flags(flags, add_flags, del_flags))
+        elif op is ATOMIC_GROUP:
+            yield from _iter_sequence(av, flags)
+        else:
+            yield op, av, flags
+
+def _get_required_literal(pattern, flags):
+    # look for a literal string that every match must contain, and the
+    # range of its offsets from the start of the match
+    candidates = []
+    literal = []
+    lo = hi = 0
+    for op, av, flags1 in _iter_sequence(pattern, flags):
+        if op is SUCCESS:
+            break
+        if op is LITERAL and not (flags1 & SRE_FLAG_IGNORECASE and
+                                  (flags1 & SRE_FLAG_LOCALE or
+                                   _get_iscased(flags1)(av))):
+            if not literal:
+                candidates.append((literal, lo, hi))
+            literal.append(av)
+            lo += 1
+            hi += 1
+            continue
+        literal = []
+        i, j = _parser.SubPattern(pattern.state, [(op, av)]).getwidth()
+        lo += i
+        hi += j
+    if not candidates:
+        return None
+    # prefer the longest literal, but one at a bounded offset lets the
+    # search skip ahead to the match start
+    return max(candidates,
+               key=lambda c: (len(c[0]) > 1 and c[2] < _parser.MAXWIDTH,
+                              len(c[0])))
+
 def _compile_info(code, pattern, flags):
     # internal: compile an info block.  in the current version,
-    # this contains min/max pattern width, and an optional literal
-    # prefix or a character map
+    # this contains min/max pattern width, an optional literal that
+    # every match contains, and an optional literal prefix or a
+    # character map
     lo, hi = pattern.getwidth()
     if hi > MAXCODE:
         hi = MAXCODE
@@ -536,11 +580,13 @@ def _compile_info(code, pattern, flags):
     prefix = []
     prefix_skip = 0
     charset = None # not used
+    required = None
     if not (flags & SRE_FLAG_IGNORECASE and flags & SRE_FLAG_LOCALE):
         # look for literal prefix
         prefix, prefix_skip, got_all = _get_literal_prefix(pattern, flags)
-        # if no prefix, look for charset prefix
+        # if no prefix, look for a required literal and charset prefix
         if not prefix:
+            required = _get_required_literal(pattern, flags)
             charset = _get_charset_prefix(pattern, flags)
             if charset:
                 charset, hascased = _optimize_charset(charset)
@@ -563,6 +609,8 @@ def _compile_info(code, pattern, flags):
             mask = mask | SRE_INFO_LITERAL
     elif charset:
         mask = mask | SRE_INFO_CHARSET
+    if required:
+        mask = mask | SRE_INFO_REQUIRED
     emit(mask)
     # pattern length
     if lo < MAXCODE:
@@ -571,6 +619,13 @@ def _compile_info(code, pattern, flags):
         emit(MAXCODE)
         prefix = prefix[:MAXCODE]
     emit(hi)
+    # add required literal
+    if required:
+        literal, required_lo, required_hi = required
+        emit(len(literal))
+        emit(min(required_lo, MAXCODE))
+        emit(min(required_hi, MAXREPEAT))
+        code.extend(literal)
     # add literal prefix
     if prefix:
         emit(len(prefix)) # length
@@ -729,10 +784,21 @@ def print_2(*args):
                     max = 'MAXREPEAT'
                 print_(op, skip, bin(flags), min, max, to=i+skip)
                 start = i+4
+                if flags & SRE_INFO_REQUIRED:
+                    required_len, required_lo, required_hi = code[start: start+3]
+                    if required_hi == MAXREPEAT:
+                        required_hi = 'MAXREPEAT'
+                    start += 3
+                    required = code[start: start+required_len]
+                    print_2('  required',
+                            '[%s]' % ', '.join('%#02x' % x for x in required),
+                            '(%r)' % ''.join(map(chr, required)),
+                            required_lo, required_hi)
+                    start += required_len
                 if flags & SRE_INFO_PREFIX:
-                    prefix_len, prefix_skip = code[i+4: i+6]
+                    prefix_len, prefix_skip = code[start: start+2]
                     print_2('  prefix_skip', prefix_skip)
-                    start = i + 6
+                    start += 2
                     prefix = code[start: start+prefix_len]
                     print_2('  prefix',
                             '[%s]' % ', '.join('%#02x' % x for x in prefix),
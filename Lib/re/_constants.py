@@ -13,7 +13,7 @@
 
 # update when constants are added or removed
 
-MAGIC = 20230612
+MAGIC = 20261016
 
 from _sre import MAXREPEAT, MAXGROUPS  # noqa: F401
 
@@ -222,3 +222,4 @@ def _makecodes(*names):
 SRE_INFO_PREFIX = 1 # has prefix
 SRE_INFO_LITERAL = 2 # entire pattern is literal (given by prefix)
 SRE_INFO_CHARSET = 4 # pattern starts with character from given set
+SRE_INFO_REQUIRED = 8 # pattern contains a given literal
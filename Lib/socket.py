@@ -57,6 +57,7 @@
 import sys
 from enum import IntEnum, IntFlag
 from functools import partial
+from stat import S_ISFIFO
 
 try:
     import errno
@@ -215,6 +216,9 @@ def _intenum_converter(value, enum_klass):
 
 class _GiveupOnSendfile(Exception): pass
 
+# Below this size, MSG_ZEROCOPY costs more than copying the data.
+_ZEROCOPY_MIN_SIZE = 16 * 1024
+
 
 class socket(_socket.socket):
 
@@ -363,9 +367,12 @@ def _sendfile_zerocopy(self, zerocopy_func, giveup_exc_type, file,
         except (AttributeError, io.UnsupportedOperation) as err:
             raise giveup_exc_type(err)  # not a regular file
         try:
-            fsize = os.fstat(fileno).st_size
+            st = os.fstat(fileno)
         except OSError as err:
             raise giveup_exc_type(err)  # not a regular file
+        if S_ISFIFO(st.st_mode):
+            raise giveup_exc_type("pipe")  # sent with splice()
+        fsize = st.st_size
         if not fsize:
             return 0  # empty file
         # Truncate to 1GiB to avoid OverflowError, see bpo-38319.
@@ -431,6 +438,85 @@ def _sendfile_use_sendfile(self, file, offset=0, count=None):
             raise _GiveupOnSendfile(
                 "os.sendfile() not available on this platform")
 
+    if hasattr(os, 'splice'):
+        def _sendfile_use_splice(self, file, offset=0, count=None):
+            """
+            Send the data read from a pipe using os.splice(), which moves
+            it from the pipe to the socket without copying it.
+            """
+            import selectors
+
+            self._check_sendfile_params(file, offset, count)
+            try:
+                fileno = file.fileno()
+                st = os.fstat(fileno)
+            except (AttributeError, io.UnsupportedOperation, OSError) as err:
+                raise _GiveupOnSendfile(err)  # not a pipe
+            if not S_ISFIFO(st.st_mode) or offset:
+                raise _GiveupOnSendfile("not a pipe")
+            timeout = self.gettimeout()
+            if timeout == 0:
+                raise ValueError("non-blocking sockets are not supported")
+
+            sockno = self.fileno()
+            if hasattr(selectors, 'PollSelector'):
+                read_selector = selectors.PollSelector()
+                write_selector = selectors.PollSelector()
+            else:
+                read_selector = selectors.SelectSelector()
+                write_selector = selectors.SelectSelector()
+            read_selector.register(fileno, selectors.EVENT_READ)
+            write_selector.register(sockno, selectors.EVENT_WRITE)
+            # The pipe is made non-blocking, so that waiting for data is
+            # subject to the timeout of the socket.
+            blocking = os.get_blocking(fileno)
+            os.set_blocking(fileno, False)
+            try:
+                total_sent = 0
+                # The file object may have read ahead from the pipe: send
+                # what it has buffered first.
+                if hasattr(file, 'peek'):
+                    data = file.peek(1)
+                    if count:
+                        data = data[:count]
+                    if data:
+                        self.sendall(data)
+                        file.read(len(data))
+                        total_sent = len(data)
+
+                # localize variable access to minimize overhead
+                splice = os.splice
+                blocksize = 2 ** 30
+                while True:
+                    if count:
+                        blocksize = count - total_sent
+                        if blocksize <= 0:
+                            break
+                    try:
+                        sent = splice(fileno, sockno, blocksize)
+                    except BlockingIOError:
+                        # Either the pipe is empty or the socket buffer
+                        # is full.
+                        if read_selector.select(0):
+                            selector = write_selector
+                        else:
+                            selector = read_selector
+                        if not selector.select(timeout):
+                            raise TimeoutError('timed out')
+                        continue
+                    if sent == 0:
+                        break  # EOF
+                    total_sent += sent
+                return total_sent
+            finally:
+                os.set_blocking(fileno, blocking)
+                read_selector.close()
+                write_selector.close()
+    else:
+        def _sendfile_use_splice(self, file, offset=0, count=None):
+            raise _GiveupOnSendfile(
+                "os.splice() not available on this platform")
+
     def _sendfile_use_send(self, file, offset=0, count=None):
         self._check_sendfile_params(file, offset, count)
         if self.gettimeout() == 0:
@@ -487,8 +573,9 @@ def sendfile(self, file, offset=0, count=None):
         os.sendfile() and return the total number of bytes which
         were sent.
         *file* must be a regular file object opened in binary mode.
-        If os.sendfile() is not available (e.g. Windows) or file is
-        not a regular file socket.send() will be used instead.
+        If *file* is a pipe, os.splice() is used where available.
+        Otherwise, if os.sendfile() is not available (e.g. Windows) or
+        file is not a regular file socket.send() will be used instead.
         *offset* tells from where to start reading the file.
         If specified, *count* is the total number of bytes to transmit
         as opposed to sending the file until EOF is reached.
@@ -500,9 +587,61 @@ def sendfile(self, file, offset=0, count=None):
         """
         try:
             return self._sendfile_use_sendfile(file, offset, count)
+        except _GiveupOnSendfile:
+            pass
+        try:
+            return self._sendfile_use_splice(file, offset, count)
         except _GiveupOnSendfile:
             return self._sendfile_use_send(file, offset, count)
 
+    if hasattr(_socket.socket, "recv_zerocopy_completions"):
+        def sendall_zerocopy(self, data):
+            """sendall_zerocopy(data)
+
+            Send all of data like sendall(), with the MSG_ZEROCOPY flag:
+            the kernel transmits the data straight from the buffer instead
+            of copying it.  Return once the kernel has released the buffer.
+            Small data, and sockets which do not support SO_ZEROCOPY, are
+            sent with sendall().  Non-blocking sockets are not supported.
+            """
+            timeout = self.gettimeout()
+            if timeout == 0:
+                raise ValueError("non-blocking sockets are not supported")
+            with memoryview(data) as view, view.cast("B") as view:
+                if len(view) < _ZEROCOPY_MIN_SIZE:
+                    return self.sendall(view)
+                try:
+                    self.setsockopt(SOL_SOCKET, SO_ZEROCOPY, 1)
+                except OSError:
+                    return self.sendall(view)
+                import select
+
+                pending = 0
+                pos = 0
+                while pos < len(view):
+                    try:
+                        pos += self.send(view[pos:], MSG_ZEROCOPY)
+                    except OSError as err:
+                        if err.errno != getattr(errno, 'ENOBUFS', None):
+                            raise
+                        # Too much memory is locked by zero-copy sends:
+                        # copy this part.
+                        pos += self.send(view[pos:])
+                    else:
+                        pending += 1
+
+                # Completions are reported with POLLERR.
+                poller = select.poll()
+                poller.register(self, 0)
+                while True:
+                    for first, last, copied in self.recv_zerocopy_completions():
+                        pending -= ((last - first) & 0xFFFFFFFF) + 1
+                    if pending <= 0:
+                        break
+                    if not poller.poll(None if timeout is None
+                                       else timeout * 1000):
+                        raise TimeoutError('timed out')
+
     def _decref_socketios(self):
         if self._io_refs > 0:
             self._io_refs -= 1
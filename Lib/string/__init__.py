@@ -16,9 +16,13 @@
 
 __all__ = ["ascii_letters", "ascii_lowercase", "ascii_uppercase", "capwords",
            "digits", "hexdigits", "octdigits", "printable", "punctuation",
-           "whitespace", "Formatter", "Template"]
+           "whitespace", "Formatter", "Matcher", "Template"]
 
 import _string
+try:
+    from _multisearch import Matcher
+except ImportError:
+    __all__.remove("Matcher")
 
 # Some strings for ctype-style character classification
 whitespace = ' \t\n\r\v\f'
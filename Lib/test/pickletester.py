@@ -1,3 +1,4 @@
+import array
 import builtins
 import collections
 import copyreg
@@ -3484,6 +3485,22 @@ def test_many_puts_and_gets(self):
                 loaded = self.loads(dumped)
                 self.assert_is_copy(obj, loaded)
 
+    def test_many_shared_references(self):
+        # Test that the memo finds every object again after many resizes
+        # of its internal table.
+        objs = [(i,) for i in range(20000)]
+        shuffled = objs[::7] + objs[1::7] + objs[2::7] + objs[3::7]
+        obj = [objs, shuffled, {'a': objs[5000], 'b': objs[-1]}]
+        for proto in protocols:
+            with self.subTest(proto=proto):
+                loaded = self.loads(self.dumps(obj, proto))
+                self.assertEqual(loaded, obj)
+                ids = {id(x): i for i, x in enumerate(loaded[0])}
+                self.assertEqual([ids[id(x)] for x in loaded[1]],
+                                 [x[0] for x in shuffled])
+                self.assertIs(loaded[2]['a'], loaded[0][5000])
+                self.assertIs(loaded[2]['b'], loaded[0][-1])
+
     def test_attribute_name_interning(self):
         # Test that attribute names of pickled objects are interned when
         # unpickling.
@@ -4016,6 +4033,83 @@ def test_oob_buffers(self):
                     self.assertIs(type(new), type(obj))
                     self.assertEqual(new, obj)
 
+    def test_oob_builtin_buffers(self):
+        # bytearray and array.array objects are saved as out-of-band
+        # buffers when a buffer_callback is given.
+        for obj in [bytearray(b"abcdefgh"), bytearray(),
+                    array.array('i', range(4)), array.array('d')]:
+            for proto in range(5, pickle.HIGHEST_PROTOCOL + 1):
+                with self.subTest(obj=obj, proto=proto):
+                    buffers = []
+                    data = self.dumps(obj, proto,
+                                      buffer_callback=buffers.append)
+                    self.assertEqual(len(buffers), 1)
+                    self.assertEqual(count_opcode(pickle.NEXT_BUFFER, data), 1)
+                    self.assertEqual(count_opcode(pickle.READONLY_BUFFER, data),
+                                     0)
+                    self.assertEqual(count_opcode(pickle.BYTEARRAY8, data), 0)
+                    with self.assertRaises(pickle.UnpicklingError):
+                        self.loads(data)
+
+                    for bufs in buffers, [bytes(pb.raw()) for pb in buffers]:
+                        new = self.loads(data, buffers=bufs)
+                        self.assertIs(type(new), type(obj))
+                        self.assertEqual(new, obj)
+                        # The data is copied.
+                        self.assertIsNot(new, obj)
+                        if obj:
+                            new[0] = new[1]
+                            self.assertNotEqual(new, obj)
+
+        # Subclasses and memoryview objects are pickled as before.
+        for proto in range(5, pickle.HIGHEST_PROTOCOL + 1):
+            buffers = []
+            obj = MyBytearray(b"abc")
+            data = self.dumps(obj, proto, buffer_callback=buffers.append)
+            self.assertEqual(buffers, [])
+            self.assertEqual(data, self.dumps(obj, proto))
+            with self.assertRaises(TypeError):
+                self.dumps(memoryview(b"abc"), proto,
+                           buffer_callback=buffers.append)
+
+        # Shared references are kept.
+        ba = bytearray(b"abc")
+        arr = array.array('i', range(4))
+        for proto in range(5, pickle.HIGHEST_PROTOCOL + 1):
+            buffers = []
+            data = self.dumps([ba, arr, ba, arr], proto,
+                              buffer_callback=buffers.append)
+            self.assertEqual(len(buffers), 2)
+            new = self.loads(data, buffers=buffers)
+            self.assertIs(new[0], new[2])
+            self.assertIs(new[1], new[3])
+            self.assertEqual(new, [ba, arr, ba, arr])
+
+    def test_oob_bytearray_in_band(self):
+        # A bytearray used to be always written in-band.  It is now passed
+        # to buffer_callback, and is only written in-band as before if
+        # the callback returns a true value.
+        obj = bytearray(b"abcdefgh")
+        for proto in range(5, pickle.HIGHEST_PROTOCOL + 1):
+            with self.subTest(proto=proto):
+                buffers = []
+                data = self.dumps(obj, proto,
+                                  buffer_callback=buffers.append)
+                self.assertEqual(len(buffers), 1)
+                self.assertEqual(bytes(buffers[0].raw()), obj)
+                self.assertEqual(count_opcode(pickle.BYTEARRAY8, data), 0)
+                self.assertEqual(count_opcode(pickle.NEXT_BUFFER, data), 1)
+
+                buffers = []
+                def in_band(pb):
+                    buffers.append(pb)
+                    return True
+                data = self.dumps([obj, obj], proto, buffer_callback=in_band)
+                self.assertEqual(len(buffers), 1)
+                self.assertEqual(data, self.dumps([obj, obj], proto))
+                self.assertEqual(count_opcode(pickle.BYTEARRAY8, data), 1)
+                self.assertEqual(self.loads(data), [obj, obj])
+
     def test_oob_buffers_writable_to_readonly(self):
         # Test reconstructing readonly object from writable buffer
         obj = ZeroCopyBytes(b"foobar")
@@ -4398,6 +4492,9 @@ class MySet(set):
 class MyFrozenSet(frozenset):
     sample = frozenset({"a", "b"})
 
+class MyBytearray(bytearray):
+    sample = bytearray(b"abc")
+
 myclasses = [MyInt, MyFloat,
              MyComplex,
              MyStr, MyUnicode,
@@ -4495,6 +4592,32 @@ def test_incomplete_input(self):
         s = io.BytesIO(b"X''.")
         self.assertRaises((EOFError, struct.error, pickle.UnpicklingError), self.load, s)
 
+    def test_loads_workers(self):
+        data = [('a' * i + '\xe9€\U0001f600' * (i % 5), b'b' * i, i)
+                for i in range(600)]
+        data.append(data[:10])
+        for proto in protocols:
+            s = self.dumps(data, proto)
+            for workers in (None, 1, 2, 5):
+                with self.subTest(proto=proto, workers=workers):
+                    self.assertEqual(self.loads(s, workers=workers), data)
+                    # Truncated data fails as without workers.
+                    with self.assertRaises(Exception) as cm:
+                        self.loads(s[:len(s)//2])
+                    with self.assertRaises(type(cm.exception)):
+                        self.loads(s[:len(s)//2], workers=workers)
+        # Lone surrogates are accepted, invalid UTF-8 is reported as usual.
+        s = self.dumps(['x' * 100_000, '\ud800' + 'y' * 100_000], 4)
+        self.assertEqual(self.loads(s, workers=3)[1][0], '\ud800')
+        s = s.replace(b'y' * 10, b'\xff' * 10)
+        with self.assertRaises(UnicodeDecodeError) as cm:
+            self.loads(s)
+        with self.assertRaises(UnicodeDecodeError) as cm2:
+            self.loads(s, workers=3)
+        self.assertEqual(str(cm2.exception), str(cm.exception))
+        for workers in (0, -1):
+            self.assertRaises(ValueError, self.loads, s, workers=workers)
+
     def test_bad_init(self):
         # Test issue3664 (pickle can segfault from a badly initialized Pickler).
         # Override initialization without calling __init__() of the superclass.
@@ -4761,6 +4884,16 @@ def test_priming_pickler_memo(self):
 
         self.assertNotEqual(first_pickled, primed_pickled)
 
+        # A memo of many objects can be copied and assigned.
+        data = [[i] for i in range(1000)]
+        pickler = self.pickler_class(io.BytesIO())
+        pickler.dump(data)
+        f = io.BytesIO()
+        primed = self.pickler_class(f)
+        primed.memo = pickler.memo.copy()
+        primed.dump(data)
+        self.assertLess(len(f.getvalue()), 10)
+
     def test_priming_unpickler_memo(self):
         # Verify that we can set the Unpickler's memo attribute.
         data = ["abcdefg", "abcdefg", 44]
@@ -403,6 +403,37 @@ def test_find_shift_table_overflow(self):
         self.checkequal(len(text2) - N*len("de") - len(pattern2),
                         text2, 'find', pattern2)
 
+    def test_find_short_needle(self):
+        # Cover the first+last character filter used for short needles
+        # in long haystacks, at every offset from the block boundaries.
+        for m in range(2, 18):
+            needle = 'x' + 'ab' * ((m - 2) // 2) + 'c' * (m % 2) + 'y'
+            decoy = needle[:-2] + 'zy'
+            for pos in (0, 1, 31, 32, 33, 63, 64, 65, 100):
+                for tail in range(0, 40, 7):
+                    text = ('x-y' * 50)[:pos] + needle + '-' * tail
+                    with self.subTest(m=m, pos=pos, tail=tail):
+                        self.checkequal(pos, text, 'find', needle)
+                        self.checkequal(pos, text + needle, 'find', needle)
+                        self.checkequal(1, text, 'count', needle)
+                        self.checkequal(-1, text, 'find', decoy)
+            text = (needle + '.') * 20 + needle * 30
+            self.checkequal(50, text, 'count', needle)
+            self.checkequal(8, text, 'count', needle, 0, 8 * (m + 1))
+            self.checkequal(text.replace(needle, '', 3), text,
+                            'replace', needle, '', 3)
+            self.checkequal(['', '.'] + ['.'] * 19 + [''] * 30,
+                            text, 'split', needle)
+        # Overlapping candidates are counted without overlap.
+        self.checkequal(33, 'x' * 100, 'count', 'xxx')
+        self.checkequal(1, 'xyx' * 40 + 'xyxy', 'count', 'xyxy')
+        # Many false candidates switch to the adaptive algorithm.
+        text = 'a' * 5000 + 'aaaaaaabaaaaaaaa' + 'a' * 5000
+        self.checkequal(5000, text, 'find', 'aaaaaaabaaaaaaaa')
+        self.checkequal(1, text, 'count', 'aaaaaaabaaaaaaaa')
+        self.checkequal(0, text, 'count', 'aaaaaaacaaaaaaaa')
+        self.checkequal(3338, text, 'count', 'aaa')
+
     def test_lower(self):
         self.checkequal('hello', 'HeLLo', 'lower')
         self.checkequal('hello', 'hello', 'lower')
@@ -176,9 +176,11 @@ def test_interleave_addrinfos(self):
 
 class BaseEventLoopTests(test_utils.TestCase):
 
+    BaseEventLoop = base_events.BaseEventLoop
+
     def setUp(self):
         super().setUp()
-        self.loop = base_events.BaseEventLoop()
+        self.loop = self.BaseEventLoop()
         self.loop._selector = mock.Mock()
         self.loop._selector.select.return_value = ()
         self.set_event_loop(self.loop)
@@ -1142,6 +1144,20 @@ async def sock_connect(sock, address):
             loop.close()
 
 
+class PyCoreBaseEventLoop(base_events._PyEventLoopCore,
+                          base_events.BaseEventLoop):
+    pass
+
+
+@unittest.skipUnless(hasattr(base_events, '_CEventLoopCore'),
+                     'requires the C _asyncio module')
+class PyCoreBaseEventLoopTests(BaseEventLoopTests):
+    # BaseEventLoopTests runs the C implementation of _EventLoopCore
+    # when it is available, run the tests again with the Python one.
+
+    BaseEventLoop = PyCoreBaseEventLoop
+
+
 class MyProto(asyncio.Protocol):
     done = None
 
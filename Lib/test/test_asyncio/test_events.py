@@ -3,6 +3,7 @@
 import concurrent.futures
 import contextlib
 import functools
+import gc
 import io
 import multiprocessing
 import os
@@ -33,6 +34,7 @@
 from multiprocessing.util import _cleanup_tests as multiprocessing_cleanup_tests
 from test.test_asyncio import utils as test_utils
 from test import support
+from test.support import import_helper
 from test.support import socket_helper
 from test.support import threading_helper
 from test.support import ALWAYS_EQ, LARGEST, SMALLEST
@@ -2374,12 +2376,129 @@ class SelectEventLoopTests(EventLoopTestsMixin,
         def create_event_loop(self):
             return asyncio.SelectorEventLoop(selectors.SelectSelector())
 
+    def uring_available():
+        try:
+            asyncio.UringProactor().close()
+        except (AttributeError, OSError):
+            return False
+        return True
+
+    class UringImportTests(unittest.TestCase):
+
+        @support.cpython_only
+        def test_lazy_import(self):
+            import_helper.ensure_lazy_imports(
+                "asyncio",
+                {"asyncio.uring_events", "asyncio.proactor_events", "_uring"})
+
+        @unittest.skipUnless(sys.platform == 'linux', 'Linux only')
+        def test_not_in_all(self):
+            self.assertNotIn('UringEventLoop', asyncio.__all__)
+            self.assertIsNotNone(asyncio.UringEventLoop)
+
+    @unittest.skipUnless(uring_available(), 'io_uring is not available')
+    class UringEventLoopTests(EventLoopTestsMixin,
+                              test_utils.TestCase):
+
+        def create_event_loop(self):
+            return asyncio.UringEventLoop()
+
+        def test_ring_traverse(self):
+            # The GC sees the objects held by operations in flight.
+            import _uring
+            a, b = socket.socketpair()
+            self.addCleanup(a.close)
+            self.addCleanup(b.close)
+            ring = _uring.Ring(8)
+            self.addCleanup(ring.close)
+            token1 = object()
+            token2 = object()
+            buf = memoryview(bytearray(10))
+            ring.recv(token1, a.fileno(), 10)
+            ring.recv_into(token2, b.fileno(), buf)
+            ring.submit()
+            referents = gc.get_referents(ring)
+            for obj in token1, token2, buf:
+                self.assertTrue(any(r is obj for r in referents))
+            self.assertTrue(any(type(r) is bytes for r in referents))
+
+        def test_reader_callback(self):
+            raise unittest.SkipTest("UringEventLoop does not have add_reader()")
+
+        def test_reader_callback_cancel(self):
+            raise unittest.SkipTest("UringEventLoop does not have add_reader()")
+
+        def test_writer_callback(self):
+            raise unittest.SkipTest("UringEventLoop does not have add_writer()")
+
+        def test_writer_callback_cancel(self):
+            raise unittest.SkipTest("UringEventLoop does not have add_writer()")
+
+        def test_remove_fds_after_closing(self):
+            raise unittest.SkipTest("UringEventLoop does not have add_reader()")
+
+        def test_add_signal_handler(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not have add_signal_handler()")
+
+        def test_signal_handling_while_selecting(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not have add_signal_handler()")
+
+        def test_signal_handling_args(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not have add_signal_handler()")
+
+        def test_create_unix_connection(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_ssl_unix_connection(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_unix_server(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_unix_server_path_socket_error(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_unix_server_ssl(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_unix_server_ssl_verify_failed(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_create_unix_server_ssl_verified(self):
+            raise unittest.SkipTest(
+                "UringEventLoop does not support Unix sockets")
+
+        def test_write_pipe(self):
+            raise unittest.SkipTest(
+                "UringEventLoop only writes to pipes while running")
+
+        def test_write_pty(self):
+            raise unittest.SkipTest(
+                "UringEventLoop only writes to pipes while running")
+
+        def test_bidirectional_pty(self):
+            raise unittest.SkipTest(
+                "UringEventLoop only writes to pipes while running")
+
+        def test_unclosed_pipe_transport(self):
+            raise unittest.SkipTest(
+                "proactor pipe transports do not show their state")
+
 
 def noop(*args, **kwargs):
     pass
 
 
-class HandleTests(test_utils.TestCase):
+class BaseHandleTests:
 
     def setUp(self):
         super().setUp()
@@ -2391,7 +2510,7 @@ def callback(*args):
             return args
 
         args = ()
-        h = asyncio.Handle(callback, args, self.loop)
+        h = self.Handle(callback, args, self.loop)
         self.assertIs(h._callback, callback)
         self.assertIs(h._args, args)
         self.assertFalse(h.cancelled())
@@ -2406,7 +2525,7 @@ def callback():
         self.loop = mock.Mock()
         self.loop.call_exception_handler = mock.Mock()
 
-        h = asyncio.Handle(callback, (), self.loop)
+        h = self.Handle(callback, (), self.loop)
         h._run()
 
         self.loop.call_exception_handler.assert_called_with({
@@ -2418,14 +2537,14 @@ def callback():
 
     def test_handle_weakref(self):
         wd = weakref.WeakValueDictionary()
-        h = asyncio.Handle(lambda: None, (), self.loop)
+        h = self.Handle(lambda: None, (), self.loop)
         wd['h'] = h  # Would fail without __weakref__ slot.
 
     def test_handle_repr(self):
         self.loop.get_debug.return_value = False
 
         # simple function
-        h = asyncio.Handle(noop, (1, 2), self.loop)
+        h = self.Handle(noop, (1, 2), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<Handle noop() at %s:%s>'
@@ -2438,32 +2557,32 @@ def test_handle_repr(self):
 
         # decorated function
         cb = types.coroutine(noop)
-        h = asyncio.Handle(cb, (), self.loop)
+        h = self.Handle(cb, (), self.loop)
         self.assertEqual(repr(h),
                         '<Handle noop() at %s:%s>'
                         % (filename, lineno))
 
         # partial function
         cb = functools.partial(noop, 1, 2)
-        h = asyncio.Handle(cb, (3,), self.loop)
+        h = self.Handle(cb, (3,), self.loop)
         regex = (r'^<Handle noop\(\)\(\) at %s:%s>$'
                  % (re.escape(filename), lineno))
         self.assertRegex(repr(h), regex)
 
         # partial function with keyword args
         cb = functools.partial(noop, x=1)
-        h = asyncio.Handle(cb, (2, 3), self.loop)
+        h = self.Handle(cb, (2, 3), self.loop)
         regex = (r'^<Handle noop\(\)\(\) at %s:%s>$'
                  % (re.escape(filename), lineno))
         self.assertRegex(repr(h), regex)
 
         # partial method
-        method = HandleTests.test_handle_repr
+        method = BaseHandleTests.test_handle_repr
         cb = functools.partialmethod(method)
         filename, lineno = test_utils.get_function_source(method)
-        h = asyncio.Handle(cb, (), self.loop)
+        h = self.Handle(cb, (), self.loop)
 
-        cb_regex = r'<function HandleTests.test_handle_repr .*>'
+        cb_regex = r'<function BaseHandleTests.test_handle_repr .*>'
         cb_regex = fr'functools.partialmethod\({cb_regex}\)\(\)'
         regex = fr'^<Handle {cb_regex} at {re.escape(filename)}:{lineno}>$'
         self.assertRegex(repr(h), regex)
@@ -2474,7 +2593,7 @@ def test_handle_repr_debug(self):
         # simple function
         create_filename = __file__
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.Handle(noop, (1, 2), self.loop)
+        h = self.Handle(noop, (1, 2), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<Handle noop(1, 2) at %s:%s created at %s:%s>'
@@ -2497,7 +2616,7 @@ def test_handle_repr_debug(self):
         # partial function
         cb = functools.partial(noop, 1, 2)
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.Handle(cb, (3,), self.loop)
+        h = self.Handle(cb, (3,), self.loop)
         regex = (r'^<Handle noop\(1, 2\)\(3\) at %s:%s created at %s:%s>$'
                  % (re.escape(filename), lineno,
                     re.escape(create_filename), create_lineno))
@@ -2506,7 +2625,7 @@ def test_handle_repr_debug(self):
         # partial function with keyword args
         cb = functools.partial(noop, x=1)
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.Handle(cb, (2, 3), self.loop)
+        h = self.Handle(cb, (2, 3), self.loop)
         regex = (r'^<Handle noop\(x=1\)\(2, 3\) at %s:%s created at %s:%s>$'
                  % (re.escape(filename), lineno,
                     re.escape(create_filename), create_lineno))
@@ -2573,7 +2692,19 @@ def test_coroutine_like_object_debug_formatting(self):
         self.assertEqual(coroutines._format_coroutine(coro), 'AAA()')
 
 
-class TimerTests(unittest.TestCase):
+class PyHandleTests(BaseHandleTests, test_utils.TestCase):
+
+    Handle = events._PyHandle
+
+
+@unittest.skipUnless(hasattr(events, '_CHandle'),
+                     'requires the C _asyncio module')
+class CHandleTests(BaseHandleTests, test_utils.TestCase):
+
+    Handle = getattr(events, '_CHandle', None)
+
+
+class BaseTimerTests:
 
     def setUp(self):
         super().setUp()
@@ -2581,14 +2712,14 @@ def setUp(self):
 
     def test_hash(self):
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, lambda: False, (),
-                                mock.Mock())
+        h = self.TimerHandle(when, lambda: False, (),
+                             mock.Mock())
         self.assertEqual(hash(h), hash(when))
 
     def test_when(self):
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, lambda: False, (),
-                                mock.Mock())
+        h = self.TimerHandle(when, lambda: False, (),
+                             mock.Mock())
         self.assertEqual(when, h.when())
 
     def test_timer(self):
@@ -2597,7 +2728,7 @@ def callback(*args):
 
         args = (1, 2, 3)
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, callback, args, mock.Mock())
+        h = self.TimerHandle(when, callback, args, mock.Mock())
         self.assertIs(h._callback, callback)
         self.assertIs(h._args, args)
         self.assertFalse(h.cancelled())
@@ -2613,7 +2744,7 @@ def test_timer_repr(self):
         self.loop.get_debug.return_value = False
 
         # simple function
-        h = asyncio.TimerHandle(123, noop, (), self.loop)
+        h = self.TimerHandle(123, noop, (), self.loop)
         src = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<TimerHandle when=123 noop() at %s:%s>' % src)
@@ -2629,7 +2760,7 @@ def test_timer_repr_debug(self):
         # simple function
         create_filename = __file__
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.TimerHandle(123, noop, (), self.loop)
+        h = self.TimerHandle(123, noop, (), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<TimerHandle when=123 noop() '
@@ -2650,8 +2781,8 @@ def callback(*args):
 
         when = time.monotonic()
 
-        h1 = asyncio.TimerHandle(when, callback, (), self.loop)
-        h2 = asyncio.TimerHandle(when, callback, (), self.loop)
+        h1 = self.TimerHandle(when, callback, (), self.loop)
+        h2 = self.TimerHandle(when, callback, (), self.loop)
         with self.assertRaises(AssertionError):
             self.assertLess(h1, h2)
         with self.assertRaises(AssertionError):
@@ -2674,8 +2805,8 @@ def callback(*args):
             self.assertEqual(h1, h2)
         self.assertNotEqual(h1, h2)
 
-        h1 = asyncio.TimerHandle(when, callback, (), self.loop)
-        h2 = asyncio.TimerHandle(when + 10.0, callback, (), self.loop)
+        h1 = self.TimerHandle(when, callback, (), self.loop)
+        h2 = self.TimerHandle(when + 10.0, callback, (), self.loop)
         with self.assertRaises(AssertionError):
             self.assertLess(h2, h1)
         with self.assertRaises(AssertionError):
@@ -2693,7 +2824,7 @@ def callback(*args):
         self.assertGreaterEqual(h2, h1)
         self.assertNotEqual(h1, h2)
 
-        h3 = asyncio.Handle(callback, (), self.loop)
+        h3 = self.Handle(callback, (), self.loop)
         self.assertIs(NotImplemented, h1.__eq__(h3))
         self.assertIs(NotImplemented, h1.__ne__(h3))
 
@@ -2726,6 +2857,20 @@ def callback(*args):
         self.assertGreater(h1, SMALLEST)
 
 
+class PyTimerTests(BaseTimerTests, unittest.TestCase):
+
+    Handle = events._PyHandle
+    TimerHandle = events._PyTimerHandle
+
+
+@unittest.skipUnless(hasattr(events, '_CTimerHandle'),
+                     'requires the C _asyncio module')
+class CTimerTests(BaseTimerTests, unittest.TestCase):
+
+    Handle = getattr(events, '_CHandle', None)
+    TimerHandle = getattr(events, '_CTimerHandle', None)
+
+
 class AbstractEventLoopTests(unittest.TestCase):
 
     def test_not_implemented(self):
@@ -2812,6 +2957,8 @@ async def inner():
                 await loop.sock_accept(f)
             with self.assertRaises(NotImplementedError):
                 await loop.sock_sendfile(f, f)
+            with self.assertRaises(NotImplementedError):
+                await loop.sock_relay(f, f)
             with self.assertRaises(NotImplementedError):
                 await loop.sendfile(f, f)
             with self.assertRaises(NotImplementedError):
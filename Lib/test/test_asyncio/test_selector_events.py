@@ -1599,5 +1599,153 @@ class MyException(Exception):
             exc_info=(MyException, MOCK_ANY, MOCK_ANY))
 
 
+@unittest.skipUnless(selector_events._HAS_MMSG,
+                     'requires recvmmsg_into() and sendmmsg()')
+class SelectorDatagramTransportMmsgTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_test_loop()
+        self.buffers = [memoryview(bytearray(16)) for _ in range(3)]
+        self.loop._get_datagram_buffers = lambda: self.buffers
+        self.protocol = test_utils.make_test_protocol(asyncio.DatagramProtocol)
+        self.sock = mock.Mock(spec_set=socket.socket)
+        self.sock.fileno.return_value = 7
+        self.sock.family = socket.AF_INET
+
+    def datagram_transport(self, address=None):
+        self.sock.getpeername.side_effect = None if address else OSError
+        transport = _SelectorDatagramTransport(self.loop, self.sock,
+                                               self.protocol,
+                                               address=address)
+        self.addCleanup(close_transport, transport)
+        return transport
+
+    def receive(self, *datagrams):
+        def recvmmsg_into(buffers):
+            self.assertIs(buffers, self.buffers)
+            result = []
+            for buf, (data, addr) in zip(buffers, datagrams):
+                buf[:len(data)] = data
+                result.append((len(data), addr))
+            return result
+        self.sock.recvmmsg_into.side_effect = recvmmsg_into
+
+    def test_read_ready(self):
+        transport = self.datagram_transport()
+        self.receive((b'data1', ('0.0.0.0', 1)), (b'data2', ('0.0.0.0', 2)))
+        transport._read_ready()
+
+        self.assertFalse(self.sock.recvfrom.called)
+        self.assertEqual(self.protocol.datagram_received.call_args_list, [
+            mock.call(b'data1', ('0.0.0.0', 1)),
+            mock.call(b'data2', ('0.0.0.0', 2)),
+        ])
+
+    def test_read_ready_tryagain(self):
+        transport = self.datagram_transport()
+        self.sock.recvmmsg_into.side_effect = BlockingIOError
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.assertFalse(self.protocol.datagram_received.called)
+
+    def test_read_ready_oserr(self):
+        transport = self.datagram_transport()
+        err = self.sock.recvmmsg_into.side_effect = ConnectionRefusedError()
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.protocol.error_received.assert_called_with(err)
+
+    def test_read_ready_paused(self):
+        transport = self.datagram_transport()
+        self.receive((b'data1', ('0.0.0.0', 1)), (b'data2', ('0.0.0.0', 2)),
+                     (b'data3', ('0.0.0.0', 3)))
+        self.protocol.datagram_received.side_effect = (
+            lambda data, addr: transport.pause_reading())
+        transport._read_ready()
+        self.protocol.datagram_received.assert_called_once_with(
+            b'data1', ('0.0.0.0', 1))
+
+        # The other datagrams are received once reading is resumed.
+        self.protocol.datagram_received.side_effect = None
+        transport.resume_reading()
+        test_utils.run_briefly(self.loop)
+        self.assertEqual(self.protocol.datagram_received.call_args_list, [
+            mock.call(b'data1', ('0.0.0.0', 1)),
+            mock.call(b'data2', ('0.0.0.0', 2)),
+            mock.call(b'data3', ('0.0.0.0', 3)),
+        ])
+        self.assertEqual(self.sock.recvmmsg_into.call_count, 1)
+
+    def test_read_ready_closed(self):
+        transport = self.datagram_transport()
+        self.receive((b'data1', ('0.0.0.0', 1)), (b'data2', ('0.0.0.0', 2)))
+        self.protocol.datagram_received.side_effect = (
+            lambda data, addr: transport.close())
+        transport._read_ready()
+        self.protocol.datagram_received.assert_called_once_with(
+            b'data1', ('0.0.0.0', 1))
+
+    def test_read_ready_protocol_error(self):
+        transport = self.datagram_transport()
+        self.receive((b'data1', ('0.0.0.0', 1)), (b'data2', ('0.0.0.0', 2)))
+        self.protocol.datagram_received.side_effect = [ZeroDivisionError,
+                                                       None]
+        with self.assertRaises(ZeroDivisionError):
+            transport._read_ready()
+
+        # The next datagram is still delivered.
+        test_utils.run_briefly(self.loop)
+        self.assertEqual(self.protocol.datagram_received.call_args_list, [
+            mock.call(b'data1', ('0.0.0.0', 1)),
+            mock.call(b'data2', ('0.0.0.0', 2)),
+        ])
+
+    def test_sendto_ready(self):
+        transport = self.datagram_transport()
+        messages = [(b'data1', ('0.0.0.0', 1)), (b'data2', ('0.0.0.0', 2)),
+                    (b'data3', ('0.0.0.0', 3))]
+        transport._buffer.extend(messages)
+        self.sock.sendmmsg.side_effect = [2, BlockingIOError]
+        self.loop._add_writer(7, transport._sendto_ready)
+        transport._sendto_ready()
+
+        self.assertFalse(self.sock.sendto.called)
+        self.assertEqual(self.sock.sendmmsg.call_args_list, [
+            mock.call(messages), mock.call(messages[2:])])
+        self.assertEqual(list(transport._buffer), messages[2:])
+        self.assertTrue(self.loop.writers)
+
+        self.sock.sendmmsg.side_effect = [1]
+        transport._sendto_ready()
+        self.assertFalse(transport._buffer)
+        self.assertFalse(self.loop.writers)
+
+    def test_sendto_ready_connected(self):
+        transport = self.datagram_transport(address=('0.0.0.0', 1))
+        transport._buffer.append((b'data', ('0.0.0.0', 1)))
+        self.sock.sendmmsg.return_value = 1
+        transport._sendto_ready()
+
+        self.sock.sendmmsg.assert_called_once_with([(b'data', None)])
+        self.assertFalse(transport._buffer)
+
+    def test_sendto_ready_error_received(self):
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'data1', ()), (b'data2', ())])
+        err = self.sock.sendmmsg.side_effect = ConnectionRefusedError()
+        transport._fatal_error = mock.Mock()
+        transport._sendto_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.protocol.error_received.assert_called_with(err)
+        # The datagram which failed is dropped.
+        self.assertEqual(list(transport._buffer), [(b'data2', ())])
+
+
 if __name__ == '__main__':
     unittest.main()
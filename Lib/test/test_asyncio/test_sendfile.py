@@ -6,6 +6,7 @@
 import socket
 import sys
 import tempfile
+import threading
 import unittest
 from asyncio import base_events
 from asyncio import constants
@@ -133,6 +134,24 @@ def tearDown(self):
     def run_loop(self, coro):
         return self.loop.run_until_complete(coro)
 
+    def open_pipe(self):
+        # Return the read end of a pipe, fed with DATA by a thread.
+        r, w = os.pipe()
+
+        def writer():
+            with open(w, 'wb') as f:
+                try:
+                    f.write(self.DATA)
+                except BrokenPipeError:
+                    pass
+
+        thread = threading.Thread(target=writer)
+        thread.start()
+        self.addCleanup(thread.join)
+        pipe = open(r, 'rb')
+        self.addCleanup(pipe.close)
+        return pipe
+
 
 class SockSendfileMixin(SendfileBase):
 
@@ -242,6 +261,111 @@ def test_sock_sendfile_mix_with_regular_send(self):
         self.assertEqual(proto.data, expected)
         self.assertEqual(self.file.tell(), len(self.DATA))
 
+    def test_sock_sendfile_pipe(self):
+        sock, proto = self.prepare_socksendfile()
+        pipe = self.open_pipe()
+        ret = self.run_loop(self.loop.sock_sendfile(sock, pipe))
+        sock.close()
+        self.run_loop(proto.wait_closed())
+
+        self.assertEqual(ret, len(self.DATA))
+        self.assertEqual(proto.data, self.DATA)
+
+    def test_sock_sendfile_pipe_with_count(self):
+        sock, proto = self.prepare_socksendfile()
+        pipe = self.open_pipe()
+        # The file object reads ahead from the pipe.
+        self.assertEqual(pipe.read(10), self.DATA[:10])
+        ret = self.run_loop(self.loop.sock_sendfile(sock, pipe, 0, 100_000))
+        sock.close()
+        self.run_loop(proto.wait_closed())
+
+        self.assertEqual(ret, 100_000)
+        self.assertEqual(proto.data, self.DATA[10:100_010])
+
+    def prepare_sockrelay(self):
+        sock, proto = self.prepare_socksendfile()
+        feeder, src = socket.socketpair()
+        for s in feeder, src:
+            s.setblocking(False)
+            self.addCleanup(s.close)
+        return feeder, src, sock, proto
+
+    def run_sockrelay(self, feeder, src, sock, **kwargs):
+        async def feed():
+            await self.loop.sock_sendall(feeder, self.DATA)
+            feeder.shutdown(socket.SHUT_WR)
+
+        async def main():
+            task = asyncio.create_task(feed())
+            ret = await self.loop.sock_relay(src, sock, **kwargs)
+            await task
+            return ret
+
+        return self.run_loop(main())
+
+    def test_sock_relay(self):
+        feeder, src, sock, proto = self.prepare_sockrelay()
+        ret = self.run_sockrelay(feeder, src, sock)
+        sock.close()
+        self.run_loop(proto.wait_closed())
+
+        self.assertEqual(ret, len(self.DATA))
+        self.assertEqual(proto.data, self.DATA)
+
+    def test_sock_relay_with_count(self):
+        feeder, src, sock, proto = self.prepare_sockrelay()
+        feeder.send(self.DATA[:10_000])
+        ret = self.run_loop(self.loop.sock_relay(src, sock, 2000))
+        sock.close()
+        self.run_loop(proto.wait_closed())
+
+        self.assertEqual(ret, 2000)
+        self.assertEqual(proto.data, self.DATA[:2000])
+        self.assertEqual(src.recv(10_000), self.DATA[2000:10_000])
+
+    def test_sock_relay_force_fallback(self):
+        feeder, src, sock, proto = self.prepare_sockrelay()
+
+        def sock_relay_native(src, dst, count):
+            # to raise SendfileNotAvailableError
+            return base_events.BaseEventLoop._sock_relay_native(
+                self.loop, src, dst, count)
+
+        self.loop._sock_relay_native = sock_relay_native
+
+        ret = self.run_sockrelay(feeder, src, sock)
+        sock.close()
+        self.run_loop(proto.wait_closed())
+
+        self.assertEqual(ret, len(self.DATA))
+        self.assertEqual(proto.data, self.DATA)
+
+    def test_sock_relay_force_unsupported_native(self):
+        feeder, src, sock, proto = self.prepare_sockrelay()
+
+        def sock_relay_native(src, dst, count):
+            # to raise SendfileNotAvailableError
+            return base_events.BaseEventLoop._sock_relay_native(
+                self.loop, src, dst, count)
+
+        self.loop._sock_relay_native = sock_relay_native
+
+        with self.assertRaisesRegex(asyncio.SendfileNotAvailableError,
+                                    "not available"):
+            self.run_loop(self.loop.sock_relay(src, sock, fallback=False))
+
+    def test_sock_relay_bad_args(self):
+        feeder, src, sock, proto = self.prepare_sockrelay()
+        with self.assertRaises(TypeError):
+            self.run_loop(self.loop.sock_relay(src, sock, 1.5))
+        with self.assertRaises(ValueError):
+            self.run_loop(self.loop.sock_relay(src, sock, 0))
+        with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as dgram:
+            dgram.setblocking(False)
+            with self.assertRaisesRegex(ValueError, "SOCK_STREAM"):
+                self.run_loop(self.loop.sock_relay(src, dgram))
+
 
 class SendfileMixin(SendfileBase):
 
@@ -316,6 +440,17 @@ def test_sendfile(self):
         self.assertEqual(srv_proto.data, self.DATA)
         self.assertEqual(self.file.tell(), len(self.DATA))
 
+    def test_sendfile_pipe(self):
+        srv_proto, cli_proto = self.prepare_sendfile()
+        pipe = self.open_pipe()
+        ret = self.run_loop(
+            self.loop.sendfile(cli_proto.transport, pipe))
+        cli_proto.transport.close()
+        self.run_loop(srv_proto.done)
+        self.assertEqual(ret, len(self.DATA))
+        self.assertEqual(srv_proto.nbytes, len(self.DATA))
+        self.assertEqual(srv_proto.data, self.DATA)
+
     def test_sendfile_force_fallback(self):
         srv_proto, cli_proto = self.prepare_sendfile()
 
@@ -866,6 +866,51 @@ def test_streamreaderprotocol_constructor_use_global_loop(self):
         protocol = asyncio.StreamReaderProtocol(reader)
         self.assertIs(protocol._loop, self.loop)
 
+    def test_streamreaderprotocol_buffer_updated(self):
+        stream = asyncio.StreamReader(loop=self.loop)
+        protocol = asyncio.StreamReaderProtocol(stream, loop=self.loop)
+        self.assertIsInstance(protocol, asyncio.BufferedProtocol)
+
+        buf = protocol.get_buffer(-1)
+        self.assertGreaterEqual(len(buf), len(self.DATA))
+        # The buffer is kept until buffer_updated() is called.
+        self.assertIs(protocol.get_buffer(-1), buf)
+        buf[:len(self.DATA)] = self.DATA
+        protocol.buffer_updated(len(self.DATA))
+        self.assertEqual(stream._buffer, self.DATA)
+
+        # The buffer is reused once the data has been copied.
+        buf2 = protocol.get_buffer(-1)
+        self.assertIs(buf2, buf)
+        buf2[:4] = b'more'
+        protocol.buffer_updated(4)
+        self.assertEqual(stream._buffer, self.DATA + b'more')
+
+    def test_streamreaderprotocol_buffer_updated_subclasses(self):
+        received = []
+
+        class Protocol(asyncio.StreamReaderProtocol):
+            def data_received(self, data):
+                received.append(data)
+
+        class Reader(asyncio.StreamReader):
+            def feed_data(self, data):
+                received.append(data)
+
+        stream = asyncio.StreamReader(loop=self.loop)
+        reader = Reader(loop=self.loop)
+        for protocol in [
+            Protocol(stream, loop=self.loop),
+            asyncio.StreamReaderProtocol(reader, loop=self.loop),
+        ]:
+            received.clear()
+            buf = protocol.get_buffer(-1)
+            buf[:len(self.DATA)] = self.DATA
+            protocol.buffer_updated(len(self.DATA))
+            # The data is passed in a bytes object, which can be kept.
+            self.assertEqual(received, [self.DATA])
+            self.assertIs(type(received[0]), bytes)
+
     def test_multiple_drain(self):
         # See https://github.com/python/cpython/issues/74116
         drained = 0
@@ -568,6 +568,64 @@ def test_sock_sendfile_not_regular_file(self):
                                                           0, None))
         self.assertEqual(self.file.tell(), 0)
 
+    @unittest.skipUnless(os.path.exists('/dev/zero'), 'requires /dev/zero')
+    def test_sock_sendfile_char_device(self):
+        # Like an empty file, since it has no size.
+        sock, proto = self.prepare()
+        with open('/dev/zero', 'rb') as f:
+            ret = self.run_loop(self.loop._sock_sendfile_native(sock, f,
+                                                                0, None))
+        self.assertEqual(ret, 0)
+
+    def test_sock_sendfile_pipe_with_offset(self):
+        sock, proto = self.prepare()
+        r, w = os.pipe()
+        with open(r, 'rb') as f, open(w, 'wb'):
+            with self.assertRaisesRegex(asyncio.SendfileNotAvailableError,
+                                        "not seekable"):
+                self.run_loop(self.loop._sock_sendfile_native(sock, f,
+                                                              10, None))
+
+    def make_relay_source(self):
+        feeder, src = socket.socketpair()
+        for s in feeder, src:
+            s.setblocking(False)
+            self.addCleanup(s.close)
+        return feeder, src
+
+    def test_sock_relay_not_available(self):
+        sock, proto = self.prepare()
+        feeder, src = self.make_relay_source()
+        with mock.patch('asyncio.unix_events.os', spec=[]):
+            with self.assertRaisesRegex(asyncio.SendfileNotAvailableError,
+                                        "os[.]splice[(][)] is not available"):
+                self.run_loop(self.loop._sock_relay_native(src, sock, None))
+
+    @unittest.skipUnless(hasattr(os, 'splice'), 'splice is not supported')
+    def test_sock_relay_os_error_first_call(self):
+        sock, proto = self.prepare()
+        feeder, src = self.make_relay_source()
+        with mock.patch('os.splice', side_effect=OSError(errno.EINVAL, '')):
+            with self.assertRaisesRegex(asyncio.SendfileNotAvailableError,
+                                        "os[.]splice call failed"):
+                self.run_loop(self.loop._sock_relay_native(src, sock, None))
+
+    @unittest.skipUnless(hasattr(os, 'splice'), 'splice is not supported')
+    def test_sock_relay_cancel(self):
+        sock, proto = self.prepare()
+        feeder, src = self.make_relay_source()
+        feeder.send(b'data')
+        task = self.loop.create_task(
+            self.loop.sock_relay(src, sock, fallback=False))
+        test_utils.run_briefly(self.loop)
+        # The relay waits for more data from src.
+        self.assertIsNotNone(self.loop._selector.get_key(src))
+        task.cancel()
+        with contextlib.suppress(asyncio.CancelledError):
+            self.run_loop(task)
+        with self.assertRaises(KeyError):
+            self.loop._selector.get_key(src)
+
     def test_sock_sendfile_cancel1(self):
         sock, proto = self.prepare()
 
@@ -17,7 +17,7 @@
 
 from collections import namedtuple, Counter, OrderedDict, _count_elements
 from collections import UserDict, UserString, UserList
-from collections import ChainMap
+from collections import ChainMap, ConcurrentDict, ScalarDict
 from collections import deque
 from collections.abc import Awaitable, Coroutine
 from collections.abc import AsyncIterator, AsyncIterable, AsyncGenerator
@@ -309,6 +309,379 @@ def __ror__(self, other):
         self.assertIs(type(tmp.maps[0]), dict)
 
 
+################################################################################
+### ConcurrentDict
+################################################################################
+
+class TestConcurrentDict(unittest.TestCase):
+
+    def test_basics(self):
+        d = ConcurrentDict()
+        self.assertEqual(len(d), 0)
+        self.assertIsInstance(d, MutableMapping)
+        d['a'] = 1
+        d[2] = 'b'
+        d[(3, 4)] = None
+        self.assertEqual(len(d), 3)
+        self.assertEqual(d['a'], 1)
+        self.assertEqual(d[2], 'b')
+        self.assertIsNone(d[(3, 4)])
+        self.assertIn('a', d)
+        self.assertNotIn('b', d)
+        with self.assertRaises(KeyError) as cm:
+            d['b']
+        self.assertEqual(cm.exception.args, ('b',))
+        del d['a']
+        self.assertNotIn('a', d)
+        self.assertRaises(KeyError, d.__delitem__, 'a')
+        self.assertRaises(TypeError, d.__setitem__, [], 1)
+        self.assertRaises(TypeError, d.__getitem__, [])
+        self.assertRaises(TypeError, hash, d)
+
+    def test_constructor(self):
+        items = {i: str(i) for i in range(1000)}
+        self.assertEqual(ConcurrentDict(), {})
+        self.assertEqual(ConcurrentDict(items), items)
+        self.assertEqual(ConcurrentDict(items.items()), items)
+        self.assertEqual(ConcurrentDict(UserDict(items)), items)
+        self.assertEqual(ConcurrentDict(ConcurrentDict(items)), items)
+        self.assertEqual(ConcurrentDict(a=1, b=2), {'a': 1, 'b': 2})
+        self.assertEqual(ConcurrentDict([('a', 1)], a=2), {'a': 2})
+        self.assertRaises(TypeError, ConcurrentDict, 1)
+        self.assertRaises(TypeError, ConcurrentDict, [1])
+        self.assertRaises(ValueError, ConcurrentDict, [(1, 2, 3)])
+        self.assertRaises(TypeError, ConcurrentDict, {}, {})
+
+    def test_methods(self):
+        d = ConcurrentDict(a=1)
+        self.assertEqual(d.get('a'), 1)
+        self.assertIsNone(d.get('b'))
+        self.assertEqual(d.get('b', 2), 2)
+        self.assertEqual(d.setdefault('a', 5), 1)
+        self.assertEqual(d.setdefault('b', 2), 2)
+        self.assertIsNone(d.setdefault('c'))
+        self.assertEqual(d, {'a': 1, 'b': 2, 'c': None})
+        self.assertEqual(d.pop('c'), None)
+        self.assertEqual(d.pop('c', 3), 3)
+        self.assertRaises(KeyError, d.pop, 'c')
+        d.update({'c': 3}, d=4)
+        d.update([('e', 5)])
+        self.assertEqual(sorted(d.keys()), ['a', 'b', 'c', 'd', 'e'])
+        self.assertEqual(sorted(d.values()), [1, 2, 3, 4, 5])
+        self.assertEqual(sorted(d.items()), list(zip('abcde', range(1, 6))))
+        self.assertEqual(sorted(d), ['a', 'b', 'c', 'd', 'e'])
+        d.clear()
+        self.assertEqual(len(d), 0)
+        self.assertEqual(list(d), [])
+
+    def test_many_items(self):
+        d = ConcurrentDict()
+        n = 10000
+        for i in range(n):
+            d[i] = i
+            d[str(i)] = i
+        self.assertEqual(len(d), 2 * n)
+        for i in range(0, n, 2):
+            del d[i]
+        self.assertEqual(len(d), n + n // 2)
+        for i in range(n):
+            self.assertEqual(i in d, i % 2 == 1)
+            self.assertEqual(d[str(i)], i)
+        self.assertEqual(sorted(k for k in d if isinstance(k, int)),
+                         list(range(1, n, 2)))
+
+    def test_equality(self):
+        d = ConcurrentDict({1: 2, 3: 4})
+        self.assertEqual(d, {1: 2, 3: 4})
+        self.assertEqual({1: 2, 3: 4}, d)
+        self.assertEqual(d, ConcurrentDict({3: 4, 1: 2}))
+        self.assertNotEqual(d, {1: 2})
+        self.assertNotEqual(d, ConcurrentDict())
+        self.assertNotEqual(d, [(1, 2), (3, 4)])
+        self.assertRaises(TypeError, operator.lt, d, d)
+
+    def test_copy(self):
+        d = ConcurrentDict({1: [2], 3: [4]})
+        for c in d.copy(), copy.copy(d), copy.deepcopy(d):
+            self.assertIsNot(c, d)
+            self.assertIs(type(c), ConcurrentDict)
+            self.assertEqual(c, d)
+        c = d.copy()
+        c[5] = 6
+        self.assertNotIn(5, d)
+        self.assertIs(c[1], d[1])
+        self.assertIsNot(copy.deepcopy(d)[1], d[1])
+
+    def test_pickle(self):
+        d = ConcurrentDict({1: 2, 'a': (3, 4)})
+        for proto in range(pickle.HIGHEST_PROTOCOL + 1):
+            with self.subTest(proto=proto):
+                e = pickle.loads(pickle.dumps(d, proto))
+                self.assertIs(type(e), ConcurrentDict)
+                self.assertEqual(e, d)
+
+    def test_repr(self):
+        self.assertEqual(repr(ConcurrentDict()), 'ConcurrentDict({})')
+        self.assertEqual(repr(ConcurrentDict(a=1)), "ConcurrentDict({'a': 1})")
+        d = ConcurrentDict()
+        d[1] = d
+        self.assertEqual(repr(d), 'ConcurrentDict({1: ConcurrentDict(...)})')
+
+    def test_subclass(self):
+        class C(ConcurrentDict):
+            pass
+        d = C(a=1)
+        self.assertEqual(d, {'a': 1})
+        self.assertIs(type(d.copy()), C)
+        self.assertEqual(repr(d), "C({'a': 1})")
+
+    @support.cpython_only
+    def test_gc(self):
+        import gc
+        import weakref
+        class A:
+            pass
+        d = ConcurrentDict()
+        a = A()
+        d['a'] = a
+        a.d = d
+        ref = weakref.ref(a)
+        del a, d
+        gc.collect()
+        self.assertIsNone(ref())
+
+
+class TestScalarDict(unittest.TestCase):
+
+    def test_basics(self):
+        d = ScalarDict('q')
+        self.assertEqual(d.typecode, 'q')
+        self.assertEqual(len(d), 0)
+        self.assertIsInstance(d, MutableMapping)
+        d['a'] = 1
+        d[2] = -2**63
+        d[(3, 4)] = 2**63 - 1
+        self.assertEqual(len(d), 3)
+        self.assertEqual(d['a'], 1)
+        self.assertEqual(d[2], -2**63)
+        self.assertEqual(d[(3, 4)], 2**63 - 1)
+        self.assertIn('a', d)
+        self.assertNotIn('b', d)
+        with self.assertRaises(KeyError) as cm:
+            d['b']
+        self.assertEqual(cm.exception.args, ('b',))
+        del d['a']
+        self.assertNotIn('a', d)
+        self.assertRaises(KeyError, d.__delitem__, 'a')
+        self.assertRaises(TypeError, d.__setitem__, [], 1)
+        self.assertRaises(TypeError, d.__getitem__, [])
+        self.assertRaises(TypeError, hash, d)
+
+    def test_values(self):
+        d = ScalarDict('q')
+        self.assertRaises(OverflowError, d.__setitem__, 'a', 2**63)
+        self.assertRaises(TypeError, d.__setitem__, 'a', 1.0)
+        self.assertRaises(TypeError, d.__setitem__, 'a', '1')
+        d['a'] = True
+        self.assertIs(type(d['a']), int)
+        self.assertNotIn('b', ScalarDict('q', {'a': 1}))
+        d = ScalarDict('d')
+        self.assertEqual(d.typecode, 'd')
+        d['a'] = 1
+        d['b'] = 0.5
+        d['c'] = float('inf')
+        self.assertRaises(TypeError, d.__setitem__, 'd', '1')
+        self.assertRaises(OverflowError, d.__setitem__, 'd', 10**400)
+        self.assertIs(type(d['a']), float)
+        self.assertEqual(d, {'a': 1.0, 'b': 0.5, 'c': float('inf')})
+
+    def test_constructor(self):
+        items = {str(i): i for i in range(1000)}
+        self.assertEqual(ScalarDict('q'), {})
+        self.assertEqual(ScalarDict('q', items), items)
+        self.assertEqual(ScalarDict('q', items.items()), items)
+        self.assertEqual(ScalarDict('q', UserDict(items)), items)
+        self.assertEqual(ScalarDict('d', ScalarDict('q', items)), items)
+        self.assertRaises(TypeError, ScalarDict)
+        self.assertRaises(TypeError, ScalarDict, 'q', 1)
+        self.assertRaises(TypeError, ScalarDict, 'q', [1])
+        self.assertRaises(ValueError, ScalarDict, 'q', [(1, 2, 3)])
+        self.assertRaises(TypeError, ScalarDict, 'q', {}, {})
+        self.assertRaises(TypeError, ScalarDict, 'q', a=1)
+        self.assertRaises(ValueError, ScalarDict, 'i')
+        self.assertRaises(TypeError, ScalarDict, 'qq')
+
+    def test_methods(self):
+        d = ScalarDict('q', {'a': 1})
+        self.assertEqual(d.get('a'), 1)
+        self.assertIsNone(d.get('b'))
+        self.assertEqual(d.get('b', 2), 2)
+        d.update({'b': 2, 'c': 3})
+        d.update([('d', 4)])
+        self.assertEqual(d.pop('d'), 4)
+        self.assertEqual(d.pop('d', 5), 5)
+        self.assertRaises(KeyError, d.pop, 'd')
+        self.assertEqual(d.keys(), ['a', 'b', 'c'])
+        self.assertEqual(d.values(), [1, 2, 3])
+        self.assertEqual(d.items(), [('a', 1), ('b', 2), ('c', 3)])
+        self.assertEqual(list(d), ['a', 'b', 'c'])
+        d.clear()
+        self.assertEqual(len(d), 0)
+        self.assertEqual(list(d), [])
+        d['a'] = 1
+        self.assertEqual(d, {'a': 1})
+
+    def test_add(self):
+        d = ScalarDict('q')
+        d.add('a', 2)
+        d.add('a', 3)
+        d.add('b', -1)
+        self.assertEqual(d, {'a': 5, 'b': -1})
+        d.add('a', 2**63 - 6)
+        with self.assertRaises(OverflowError):
+            d.add('a', 1)
+        self.assertEqual(d['a'], 2**63 - 1)
+        self.assertRaises(TypeError, d.add, 'a', 0.5)
+        d = ScalarDict('d')
+        d.add('a', 1)
+        d.add('a', 0.5)
+        self.assertEqual(d, {'a': 1.5})
+
+    def test_count(self):
+        words = 'the quick brown fox jumps over the lazy dog the end'.split()
+        for typecode in 'qd':
+            d = ScalarDict(typecode)
+            d.count(words)
+            self.assertEqual(d, Counter(words))
+            self.assertEqual(d.keys(), list(Counter(words)))
+            d.count(iter(['fox', 1]))
+            self.assertEqual(d['fox'], 2)
+            self.assertEqual(d[1], 1)
+            self.assertRaises(TypeError, d.count, 1)
+            self.assertRaises(TypeError, d.count, [[]])
+            d = ScalarDict(typecode)
+            _count_elements(d, 'abracadabra')
+            self.assertEqual(d, Counter('abracadabra'))
+
+    def test_many_items(self):
+        d = ScalarDict('q')
+        n = 10000
+        for i in range(n):
+            d[i] = i
+            d[str(i)] = i
+        self.assertEqual(len(d), 2 * n)
+        for i in range(0, n, 2):
+            del d[i]
+        self.assertEqual(len(d), n + n // 2)
+        for i in range(n):
+            self.assertEqual(i in d, i % 2 == 1)
+            self.assertEqual(d[str(i)], i)
+        self.assertEqual([k for k in d if isinstance(k, int)],
+                         list(range(1, n, 2)))
+        for i in range(n):
+            del d[str(i)]
+            d[str(i)] = -i
+        self.assertEqual(len(d), n + n // 2)
+        self.assertEqual(sum(d.values()), sum(range(1, n, 2)) - sum(range(n)))
+
+    def test_equal_keys(self):
+        d = ScalarDict('q')
+        d[1] = 1
+        d[1.0] = 2
+        d[True] = 3
+        self.assertEqual(d.items(), [(1, 3)])
+        d['1'] = 4
+        self.assertEqual(len(d), 2)
+
+    def test_mutating_lookup(self):
+        d = ScalarDict('q')
+        class Key:
+            def __hash__(self):
+                return 0
+            def __eq__(self, other):
+                d.clear()
+                return False
+        d[Key()] = 1
+        d[Key()] = 2
+        self.assertEqual(len(d), 1)
+
+    def test_iter_mutation(self):
+        d = ScalarDict('q', {'a': 1, 'b': 2})
+        it = iter(d)
+        self.assertEqual(next(it), 'a')
+        d['c'] = 3
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(RuntimeError, next, it)
+        it = iter(d)
+        d['a'] = 4
+        self.assertEqual(list(it), ['a', 'b', 'c'])
+
+    def test_equality(self):
+        d = ScalarDict('q', {1: 2, 3: 4})
+        self.assertEqual(d, {1: 2, 3: 4})
+        self.assertEqual({1: 2, 3: 4}, d)
+        self.assertEqual(d, ScalarDict('d', {3: 4, 1: 2}))
+        self.assertNotEqual(d, {1: 2})
+        self.assertNotEqual(d, ScalarDict('q'))
+        self.assertNotEqual(d, [(1, 2), (3, 4)])
+        self.assertRaises(TypeError, operator.lt, d, d)
+
+    def test_copy_and_pickle(self):
+        for typecode in 'qd':
+            d = ScalarDict(typecode, {1: 2, 'a': 3})
+            for c in copy.copy(d), copy.deepcopy(d):
+                self.assertIsNot(c, d)
+                self.assertIs(type(c), ScalarDict)
+                self.assertEqual(c.typecode, typecode)
+                self.assertEqual(c.items(), d.items())
+            for proto in range(pickle.HIGHEST_PROTOCOL + 1):
+                with self.subTest(typecode=typecode, proto=proto):
+                    e = pickle.loads(pickle.dumps(d, proto))
+                    self.assertIs(type(e), ScalarDict)
+                    self.assertEqual(e.typecode, typecode)
+                    self.assertEqual(e.items(), d.items())
+
+    def test_repr(self):
+        self.assertEqual(repr(ScalarDict('q')), "ScalarDict('q', {})")
+        self.assertEqual(repr(ScalarDict('d', {'a': 1})),
+                         "ScalarDict('d', {'a': 1.0})")
+
+    def test_subclass(self):
+        class C(ScalarDict):
+            pass
+        d = C('q', {'a': 1})
+        self.assertEqual(d, {'a': 1})
+        self.assertEqual(repr(d), "C('q', {'a': 1})")
+        self.assertIs(type(copy.copy(d)), C)
+
+    @support.cpython_only
+    def test_sizeof(self):
+        d = ScalarDict('q')
+        size = sys.getsizeof(d)
+        d['a'] = 1
+        self.assertGreater(sys.getsizeof(d), size)
+        for i in range(1000):
+            d[str(i)] = i
+        size = sys.getsizeof(d)
+        d[1] = 1
+        self.assertGreater(sys.getsizeof(d), size)
+
+    @support.cpython_only
+    def test_gc(self):
+        import gc
+        import weakref
+        class A:
+            pass
+        d = ScalarDict('q')
+        a = A()
+        d[a] = 1
+        a.d = d
+        ref = weakref.ref(a)
+        del a, d
+        gc.collect()
+        self.assertIsNone(ref())
+
+
 ################################################################################
 ### Named Tuples
 ################################################################################
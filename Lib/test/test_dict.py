@@ -933,6 +933,114 @@ def __eq__(self, other):
         resizing = True
         d[9] = 6
 
+    def test_large_dict_lookup(self):
+        # Large dicts keep a few bits of the hash next to the index of
+        # each entry.  Test keys whose hashes differ only in the high bits
+        # and keys with equal hashes.
+        class Key:
+            def __init__(self, value):
+                self.value = value
+            def __hash__(self):
+                return 1
+            def __eq__(self, other):
+                return isinstance(other, Key) and self.value == other.value
+
+        colliding = [i << 57 | 1 for i in range(1, 16)] + [Key(i) for i in range(8)]
+        keys = list(range(2, 60_000)) + colliding
+        d = dict.fromkeys(keys, 0)
+        for k in keys:
+            self.assertIn(k, d)
+        for k in [i << 57 | 3 for i in range(1, 16)] + [Key(8), 1, -1]:
+            self.assertNotIn(k, d)
+        for k in colliding[::2]:
+            del d[k]
+        for i, k in enumerate(colliding):
+            self.assertEqual(k in d, i % 2 == 1)
+        d.update(dict.fromkeys(range(60_000, 120_000), 1))
+        for i, k in enumerate(colliding):
+            self.assertEqual(k in d, i % 2 == 1)
+        self.assertEqual(sum(d.values()), 60_000)
+
+    def check_incremental_resize(self, n):
+        # Large dicts build their next table a few entries at a time
+        # while they fill up.  Test that values replaced and entries
+        # deleted in the meantime are seen in the resized table.
+        for make_key in (str, lambda i: i * 7919):
+            with self.subTest(key=make_key(1)):
+                d = {}
+                values = [None] * n
+                for i in range(n):
+                    d[make_key(i)] = values[i] = i
+                    if i % 7 == 3 and values[i // 2] is not None:
+                        d[make_key(i // 2)] = values[i // 2] = -i
+                    if i % 11 == 5 and values[i // 3] is not None:
+                        del d[make_key(i // 3)]
+                        values[i // 3] = None
+                    if i % 1009 == 0:
+                        self.assertEqual(d.popitem(), (make_key(i), i))
+                        values[i] = None
+                    if i == n * 7 // 20:
+                        c = d.copy()
+                        c_values = values[:i + 1]
+                self.assertEqual(len(d), n - values.count(None))
+                for i, v in enumerate(values):
+                    if v is None:
+                        self.assertNotIn(make_key(i), d)
+                    else:
+                        self.assertEqual(d[make_key(i)], v)
+                self.assertEqual(list(d.values()),
+                                 [v for v in values if v is not None])
+                self.assertEqual(list(c.values()),
+                                 [v for v in c_values if v is not None])
+                for k in c:
+                    self.assertIn(k, c)
+
+        # Switch from str keys to other keys while the next table is built.
+        m = n * 7 // 20
+        d = {str(i): i for i in range(m)}
+        d[m] = m
+        for i in range(m + 1, n // 2):
+            d[str(i)] = i
+        self.assertEqual(len(d), n // 2)
+        self.assertEqual(d[m], m)
+        for i in range(0, n // 2, 7):
+            self.assertEqual(d[str(i) if i != m else i], i)
+        d.clear()
+        self.assertEqual(d, {})
+
+    def test_large_dict_incremental_resize(self):
+        self.check_incremental_resize(200_000)
+
+    @support.cpython_only
+    def test_incremental_resize_threshold(self):
+        _testinternalcapi = import_helper.import_module('_testinternalcapi')
+        set_grow_log_size = _testinternalcapi.set_dict_grow_log_size
+        old = set_grow_log_size(12)
+        self.addCleanup(set_grow_log_size, old)
+        self.assertEqual(old, 17)
+        self.assertEqual(set_grow_log_size(12), 12)
+        self.assertRaises(ValueError, set_grow_log_size, 11)
+        self.assertRaises(ValueError, set_grow_log_size, 256)
+        # Tables of 2**12 slots and more now grow incrementally.
+        self.check_incremental_resize(20_000)
+
+        # Attributes set in place by the specialized STORE_ATTR.
+        class C:
+            pass
+        obj = C()
+        for i in range(10_000):
+            obj.a = i
+            setattr(obj, f'x{i}', i)
+            obj.b = -i
+        self.assertEqual(obj.a, 9_999)
+        self.assertEqual(obj.b, -9_999)
+        self.assertEqual(len(vars(obj)), 10_002)
+        self.assertEqual(list(vars(obj).values())[:3], [9_999, 0, -9_999])
+
+        # Tables smaller than the threshold are rebuilt in one go.
+        set_grow_log_size(20)
+        self.check_incremental_resize(20_000)
+
     def test_empty_presized_dict_in_freelist(self):
         # Bug #3537: if an empty but presized dict with a size larger
         # than 7 was in the freelist, it triggered an assertion failure
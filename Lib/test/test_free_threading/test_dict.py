@@ -4,6 +4,7 @@
 import weakref
 
 from ast import Or
+from collections import ConcurrentDict, ScalarDict
 from functools import partial
 from threading import Barrier, Thread
 from unittest import TestCase
@@ -245,5 +246,55 @@ def reader():
         with threading_helper.start_threads([t1, t2]):
             pass
 
+    def test_racing_concurrent_dict(self):
+        d = ConcurrentDict()
+        NUM_THREADS = 8
+        N = 5000
+        barrier = Barrier(NUM_THREADS)
+
+        def work(t):
+            barrier.wait()
+            for i in range(N):
+                d[(t, i)] = i
+                d[i] = t
+                d.setdefault(-i - 1, i)
+                self.assertEqual(d[(t, i)], i)
+            for i in range(0, N, 2):
+                del d[(t, i)]
+                self.assertEqual(d.pop((t, i + 1)), i + 1)
+
+        threads = [Thread(target=work, args=(t,)) for t in range(NUM_THREADS)]
+        with threading_helper.start_threads(threads):
+            pass
+
+        self.assertEqual(len(d), 2 * N)
+        for i in range(N):
+            self.assertIn(d[i], range(NUM_THREADS))
+            self.assertEqual(d[-i - 1], i)
+
+    def test_racing_scalar_dict(self):
+        d = ScalarDict('q')
+        NUM_THREADS = 8
+        N = 5000
+        barrier = Barrier(NUM_THREADS)
+
+        def work(t):
+            barrier.wait()
+            d.count(range(N))
+            for i in range(N):
+                d.add(str(i), 1)
+                d[(t, i)] = i
+            for i in range(N):
+                self.assertEqual(d.pop((t, i)), i)
+
+        threads = [Thread(target=work, args=(t,)) for t in range(NUM_THREADS)]
+        with threading_helper.start_threads(threads):
+            pass
+
+        self.assertEqual(len(d), 2 * N)
+        for i in range(N):
+            self.assertEqual(d[i], NUM_THREADS)
+            self.assertEqual(d[str(i)], NUM_THREADS)
+
 if __name__ == "__main__":
     unittest.main()
@@ -5815,11 +5815,14 @@ def test_collections_module_has_signatures(self):
         no_signature = {'OrderedDict', 'defaultdict'}
         unsupported_signature = {'deque'}
         methods_no_signature = {
+            'ConcurrentDict': {'update'},
             'OrderedDict': {'update'},
         }
         methods_unsupported_signature = {
+            'ConcurrentDict': {'pop'},
             'deque': {'index'},
             'OrderedDict': {'pop'},
+            'ScalarDict': {'pop'},
             'UserString': {'maketrans'},
         }
         self._test_module_has_signatures(collections,
@@ -1,6 +1,9 @@
+import contextlib
+import sys
 from io import StringIO
 from test.test_json import PyTest, CTest
 
+from test import support
 from test.support import bigmemtest, _1G
 
 class TestDump:
@@ -65,6 +68,126 @@ def __lt__(self, o):
         d[1337] = "true.dat"
         self.assertEqual(self.dumps(d, sort_keys=True), '{"1337": "true.dat"}')
 
+    @contextlib.contextmanager
+    def parallel(self):
+        # Encode even small containers in parallel, on all builds, with
+        # a thread pool which is shut down afterwards.
+        encoder = self.json.encoder
+        with (support.swap_attr(encoder, '_PARALLEL_CHUNK', 2),
+              support.swap_attr(sys, '_is_gil_enabled', lambda: False),
+              support.swap_attr(encoder, '_executor', None)):
+            try:
+                yield
+            finally:
+                if encoder._executor is not None:
+                    encoder._executor.shutdown()
+
+    def test_dumps_workers(self):
+        lst = [{'a': [i, str(i)], 'b': {'c': None}} for i in range(50)]
+        dct = {str(i): [i] for i in reversed(range(50))}
+        numkeys = {5: 'int', True: 'bool', 2.5: 'float', 7: 'int'}
+        with self.parallel():
+            for obj in (lst, tuple(lst), dct, numkeys, [1, 2, 3, 4], [[]],
+                        {}, [], 'a', 1):
+                for kwargs in ({}, {'indent': 2}, {'indent': '\t'},
+                               {'indent': 0}, {'separators': (',', ':')},
+                               {'ensure_ascii': False, 'sort_keys': True}):
+                    for workers in (2, 3, 7, 100):
+                        with self.subTest(obj=obj, workers=workers, **kwargs):
+                            self.assertEqual(
+                                self.dumps(obj, workers=workers, **kwargs),
+                                self.dumps(obj, **kwargs))
+            v = {b'invalid': 1, 'a': 2, b'x': 3, b'y': 4, 'b': 5}
+            for workers in (2, 5):
+                self.assertEqual(
+                    self.dumps(v, skipkeys=True, workers=workers, indent=1),
+                    self.dumps(v, skipkeys=True, indent=1))
+                self.assertEqual(
+                    self.dumps({b'x': 1, b'y': 2, b'z': 3, b't': 4},
+                               skipkeys=True, workers=workers),
+                    '{}')
+
+    def test_dumps_workers_errors(self):
+        # Errors are the same as with serial encoding.
+        def check(exc_type, obj, **kwargs):
+            with self.assertRaises(exc_type) as cm:
+                self.dumps(obj, **kwargs)
+            with self.parallel():
+                with self.assertRaises(exc_type) as cm2:
+                    self.dumps(obj, workers=4, **kwargs)
+            self.assertEqual(str(cm2.exception), str(cm.exception))
+            self.assertEqual(getattr(cm2.exception, '__notes__', None),
+                             getattr(cm.exception, '__notes__', None))
+            return cm.exception
+
+        for obj in ([1, 2, object(), 3], {'a': 1, 'b': [1, object()]},
+                    {1: 1, 'a': 2, None: 3},
+                    [[i] for i in range(20)] + [[object()], 1, {2}],
+                    tuple(range(30)) + ([b'x'],),
+                    {str(i): [i] for i in range(30)} | {'x': [1, {2}]}):
+            with self.subTest(obj=obj):
+                check(TypeError, obj, sort_keys=True)
+
+        # Circular references to the container from any chunk.
+        lst = [[i] for i in range(20)]
+        lst[15].append(lst)
+        exc = check(ValueError, lst)
+        self.assertEqual(exc.__notes__, ['when serializing list item 1',
+                                         'when serializing list item 15'])
+        dct = {str(i): i for i in range(20)}
+        dct['15'] = {'x': dct}
+        check(ValueError, dct)
+        check(ValueError, dct, sort_keys=True, indent=2)
+        tpl = tuple([i] for i in range(20)) + (lst,)
+        check(ValueError, tpl)
+        # An object reached twice is not a circular reference.
+        shared = [1]
+        with self.parallel():
+            self.assertEqual(self.dumps([shared] * 10, workers=3),
+                             self.dumps([shared] * 10))
+
+        # The failed item is not encoded again.
+        calls = []
+        def default(o):
+            calls.append(o)
+            raise TypeError('bad')
+        with self.parallel():
+            with self.assertRaisesRegex(TypeError, 'bad'):
+                self.dumps(list(range(20)) + [object()], default=default,
+                           workers=4)
+        self.assertEqual(len(calls), 1)
+
+    def test_dumps_workers_serial(self):
+        calls = []
+        def get_executor():
+            calls.append(None)
+            return get_executor.__wrapped__()
+        get_executor.__wrapped__ = self.json.encoder._get_executor
+        lst = list(range(100))
+        with support.swap_attr(self.json.encoder, '_get_executor',
+                               get_executor):
+            with self.parallel():
+                self.assertEqual(self.dumps(lst, workers=4), self.dumps(lst))
+            # With the C accelerator only.
+            self.assertEqual(len(calls),
+                             self.json.encoder.c_make_encoder is not None)
+            calls.clear()
+            # Not when the GIL is enabled.
+            with (self.parallel(),
+                  support.swap_attr(sys, '_is_gil_enabled', lambda: True)):
+                self.assertEqual(self.dumps(lst, workers=4), self.dumps(lst))
+            # Not for small containers.
+            with support.swap_attr(sys, '_is_gil_enabled', lambda: False):
+                self.assertEqual(self.dumps(lst, workers=4), self.dumps(lst))
+            # Not if iterencode() is overridden.
+            class Encoder(self.json.JSONEncoder):
+                def iterencode(self, o, _one_shot=False):
+                    return super().iterencode(o, _one_shot)
+            with self.parallel():
+                self.assertEqual(self.dumps(lst, workers=4, cls=Encoder),
+                                 self.dumps(lst))
+            self.assertEqual(calls, [])
+
 
 class TestPyDump(TestDump, PyTest): pass
 
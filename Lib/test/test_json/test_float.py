@@ -13,6 +13,23 @@ def test_ints(self):
             self.assertEqual(self.dumps(num), str(num))
             self.assertEqual(int(self.dumps(num)), num)
 
+    def test_long_digit_runs(self):
+        # The C scanner consumes digits a machine word at a time.
+        for n in range(1, 30):
+            digits = '1234567890' * 3
+            digits = digits[:n]
+            self.assertEqual(self.loads('7' + digits), int('7' + digits))
+            self.assertEqual(self.loads('[-7%s]' % digits), [-int('7' + digits)])
+            self.assertEqual(self.loads('0.' + digits), float('0.' + digits))
+            self.assertEqual(self.loads('1e-' + digits[:2]),
+                             float('1e-' + digits[:2]))
+            self.assertEqual(self.loads('[7%s.5e1]' % digits),
+                             [float('7%s.5e1' % digits)])
+            for c in '/:０':
+                with self.assertRaises(self.JSONDecodeError) as cm:
+                    self.loads('7' + digits + c + '1' * 8)
+                self.assertEqual(cm.exception.pos, n + 1)
+
     def test_out_of_range(self):
         self.assertEqual(self.loads('[23456789012E666]'), [float('inf')])
         self.assertEqual(self.loads('[-23456789012E666]'), [float('-inf')])
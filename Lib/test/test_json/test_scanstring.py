@@ -142,6 +142,29 @@ def test_bad_escapes(self):
             with self.assertRaises(self.JSONDecodeError, msg=s):
                 scanstring(s, 1, True)
 
+    def test_special_chars_at_all_offsets(self):
+        # The C scanner skips over runs of plain characters a machine word
+        # at a time; make sure special characters are found wherever they
+        # fall relative to the word boundaries.
+        scanstring = self.json.decoder.scanstring
+        for n in range(40):
+            prefix = 'x' * n
+            for tail in ('', 'y' * 17):
+                s = '"' + prefix + '"' + tail
+                self.assertEqual(scanstring(s, 1, True), (prefix, n + 2))
+                s = '"' + prefix + '\\n' + tail + '"'
+                self.assertEqual(scanstring(s, 1, True),
+                                 (prefix + '\n' + tail, len(s)))
+                for c in '\x00\x1f':
+                    s = '"' + prefix + c + tail + '"'
+                    with self.assertRaises(self.JSONDecodeError):
+                        scanstring(s, 1, True)
+                    self.assertEqual(scanstring(s, 1, False),
+                                     (prefix + c + tail, len(s)))
+                s = '"' + prefix + '\xe9\x7f' + tail + '"'
+                self.assertEqual(scanstring(s, 1, True),
+                                 (prefix + '\xe9\x7f' + tail, len(s)))
+
     def test_overflow(self):
         with self.assertRaises(OverflowError):
             self.json.decoder.scanstring(b"xxx", sys.maxsize+1)
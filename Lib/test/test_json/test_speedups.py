@@ -1,4 +1,4 @@
-from test.test_json import CTest
+from test.test_json import CTest, pyjson
 
 
 class BadBool:
@@ -28,6 +28,80 @@ def test(value):
         self.assertRaises(ZeroDivisionError, test, '""')
         self.assertRaises(ZeroDivisionError, test, '{}')
 
+    def test_scan_utf8_buffer(self):
+        import array, mmap
+        scan_once = self.json.decoder.JSONDecoder().scan_once
+        doc = '{"a\u00e9": ["\u20ac", 1.5, -2, null, true]}'
+        data = doc.encode()
+        expected = {'a\xe9': ['\u20ac', 1.5, -2, None, True]}
+        self.assertEqual(scan_once(doc, 0), (expected, len(doc)))
+        for b in (data, bytearray(data), memoryview(data),
+                  array.array('b', data)):
+            self.assertEqual(scan_once(b, 0), (expected, len(data)))
+        self.assertEqual(scan_once(b' "\xc3\xa9" ', 1), ('\xe9', 5))
+        with mmap.mmap(-1, len(data)) as mm:
+            mm.write(data)
+            self.assertEqual(scan_once(mm, 0), (expected, len(data)))
+        with self.assertRaises(TypeError):
+            scan_once(42, 0)
+
+    def test_bytes_errors_match_str(self):
+        # Errors for UTF-8 input are reported against the decoded document.
+        docs = ['[1, 2', '{"a": }', '[1,]', '["\u20ac", x]', '"\\x"',
+                '"\\u12"', '"\x01"', '[1] 2', '  ', '-', '{"\U0001f600" 1}',
+                '["\u20ac\\ud834\\uzzzz"]', '[\n"\u20ac",\n  truth]']
+        for doc in docs:
+            with self.subTest(doc=doc):
+                with self.assertRaises(self.JSONDecodeError) as cm:
+                    self.loads(doc)
+                with self.assertRaises(self.JSONDecodeError) as cm2:
+                    self.loads(doc.encode())
+                self.assertEqual(cm2.exception.msg, cm.exception.msg)
+                self.assertEqual(cm2.exception.pos, cm.exception.pos)
+                self.assertEqual(cm2.exception.lineno, cm.exception.lineno)
+                self.assertEqual(cm2.exception.colno, cm.exception.colno)
+                self.assertEqual(cm2.exception.doc, doc)
+        for data in (b'["\xff"]', b'["\xe2\x82"]', b'["a\xe2\x82\\n"]',
+                     b'[1, \xff]', b'[1] \xff'):
+            with self.subTest(data=data):
+                with self.assertRaises(UnicodeDecodeError) as cm:
+                    data.decode('utf-8', 'surrogatepass')
+                with self.assertRaises(UnicodeDecodeError) as cm2:
+                    self.loads(data)
+                self.assertEqual(str(cm2.exception), str(cm.exception))
+        # Lone surrogates are accepted, as for surrogatepass decoding.
+        self.assertEqual(self.loads(b'"\xed\xa0\x80\\n"'), '\ud800\n')
+
+    def test_shape_cache(self):
+        scan_once = self.json.decoder.JSONDecoder().scan_once
+        records = [{'id': i, 'name': 'x', 'sub': {'a': [], 'b': None}}
+                   for i in range(10)]
+        for doc in (self.dumps(records), self.dumps(records).encode()):
+            hits, misses = scan_once.shape_hits, scan_once.shape_misses
+            self.assertEqual(scan_once(doc, 0)[0], records)
+            self.assertEqual(scan_once.shape_hits - hits, 18)
+            self.assertEqual(scan_once.shape_misses - misses, 2)
+        # The keys of an object are only predicted from the object at the
+        # same nesting level; they can still differ in any way.
+        for doc in ['[{"a": 1, "b": 2}, {"a": 3}, {"a": 4, "b": 5, "c": 6},'
+                    ' {"b": 7, "a": 8}, {"a\\u0062": 9}, {"ab": 10},'
+                    ' {"€": 11}, {"€": 12}, {"\U0001f600": 13},'
+                    ' {"\U0001f600": 14}, {"a": 15, "a": 16}, {}, {"a": 17}]',
+                    '[' + '{"a": ' * 20 + '1' + '}' * 20 + ', '
+                    + '{"a": ' * 20 + '2' + '}' * 20 + ']']:
+            with self.subTest(doc=doc):
+                expected = pyjson.loads(doc)
+                self.assertEqual(self.loads(doc), expected)
+                self.assertEqual(self.loads(doc.encode()), expected)
+                self.assertEqual(self.loads(doc, object_pairs_hook=list),
+                                 pyjson.loads(doc, object_pairs_hook=list))
+        # Keys predicted by the cache are still checked for control
+        # characters in strict mode.
+        self.assertEqual(self.loads('[{"a\x01": 1}, {"a\x01": 2}]', strict=False),
+                         [{'a\x01': 1}, {'a\x01': 2}])
+        with self.assertRaises(self.JSONDecodeError):
+            self.loads('[{"a": 1}, {"a\x01": 2}]')
+
 
 class TestEncode(CTest):
     def test_make_encoder(self):
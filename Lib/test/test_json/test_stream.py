@@ -0,0 +1,135 @@
+import io
+from test.test_json import PyTest, CTest
+
+
+VALUES = [
+    {"a": [1, 2.5, 'x"y\\', {"b": None}], "c": "}]"},
+    'str\\"', 12345, -1.5e10, True, False, None, [], {},
+    "\xe9€\U0001f600", [[["deep"]]], "",
+]
+
+
+def chunked(s, size):
+    return [s[i:i + size] for i in range(0, len(s), size)]
+
+
+class TestStreamDecoder:
+    def decode(self, chunks, **kwargs):
+        decoder = self.json.JSONStreamDecoder(**kwargs)
+        values = []
+        for chunk in chunks:
+            values += decoder.feed(chunk)
+        values += decoder.close()
+        return values
+
+    def test_values(self):
+        for sep in ['\n', ' ', '\r\n\t ']:
+            s = sep.join(self.dumps(v, ensure_ascii=False) for v in VALUES)
+            for size in [1, 2, 3, 7, len(s)]:
+                with self.subTest(sep=sep, size=size):
+                    self.assertEqual(self.decode(chunked(s, size)), VALUES)
+        # Strings, arrays and objects need no separator.
+        values = [v for v in VALUES if not isinstance(v, (int, float))]
+        s = ''.join(self.dumps(v) for v in values)
+        self.assertEqual(self.decode(chunked(s, 3)), values)
+
+    def test_array(self):
+        s = self.dumps(VALUES, ensure_ascii=False, indent=2)
+        for size in [1, 2, 3, 7, len(s)]:
+            with self.subTest(size=size):
+                self.assertEqual(self.decode(chunked(s, size), array=True),
+                                 VALUES)
+        self.assertEqual(self.decode([' [ ] '], array=True), [])
+        self.assertEqual(self.decode(['[', '1', '2', ']'], array=True), [12])
+
+    def test_feed_returns_completed_values(self):
+        decoder = self.json.JSONStreamDecoder(array=True)
+        self.assertEqual(decoder.feed('[{"a": 1}, [2'), [{'a': 1}])
+        self.assertEqual(decoder.feed(', 3], 4'), [[2, 3]])
+        self.assertEqual(decoder.feed('5, 6]'), [45, 6])
+        self.assertEqual(decoder.close(), [])
+
+    def test_number_needs_delimiter(self):
+        decoder = self.json.JSONStreamDecoder()
+        self.assertEqual(decoder.feed('1 2'), [1])
+        self.assertEqual(decoder.feed('3'), [])
+        self.assertEqual(decoder.close(), [23])
+
+    def test_bytes(self):
+        s = '\n'.join(self.dumps(v, ensure_ascii=False) for v in VALUES)
+        data = s.encode()
+        self.assertEqual(self.decode(chunked(data, 1)), VALUES)
+        self.assertEqual(self.decode([bytearray(data)]), VALUES)
+        with self.assertRaises(UnicodeDecodeError):
+            self.decode([b'"\xe2\x82'])
+        with self.assertRaises(UnicodeDecodeError):
+            self.decode([b'"\xff"'])
+
+    def test_file(self):
+        s = '\n'.join(self.dumps(v) for v in VALUES)
+        f = io.StringIO(s)
+        decoder = self.json.JSONStreamDecoder()
+        values = []
+        while chunk := f.read(5):
+            values += decoder.feed(chunk)
+        values += decoder.close()
+        self.assertEqual(values, VALUES)
+
+    def test_decoder_options(self):
+        decoder = self.json.JSONDecoder(parse_int=str, object_pairs_hook=list)
+        stream = self.json.JSONStreamDecoder(decoder)
+        self.assertIs(stream.decoder, decoder)
+        self.assertEqual(stream.feed('{"a": 1}\n2\n'), [[('a', '1')], '2'])
+        self.assertEqual(stream.close(), [])
+
+    def test_errors(self):
+        for chunks, array, msg in [
+            (['{"a": }'], False, 'Expecting value'),
+            (['{"a": 1'], False, "Expecting ',' delimiter"),
+            (['"abc'], False, 'Unterminated string starting at'),
+            (['1x'], False, 'Extra data'),
+            ([']'], False, 'Expecting value'),
+            (['[1 2]'], False, "Expecting ',' delimiter"),
+            (['{}'], True, "Expecting '['"),
+            (['[1', ' 2]'], True, "Expecting ',' delimiter"),
+            (['[1,', ']'], True, 'Illegal trailing comma before end of array'),
+            (['[,1]'], True, 'Expecting value'),
+            (['[1] 2'], True, 'Extra data'),
+            (['[1, 2'], True, "Expecting ',' delimiter"),
+            (['[1,'], True, 'Expecting value'),
+            ([' '], True, 'Expecting value'),
+        ]:
+            with self.subTest(chunks=chunks, array=array):
+                with self.assertRaises(self.JSONDecodeError) as cm:
+                    self.decode(chunks, array=array)
+                self.assertEqual(cm.exception.msg, msg)
+
+    def test_strict(self):
+        with self.assertRaises(self.JSONDecodeError):
+            self.decode(['"a\x01b"'])
+        decoder = self.json.JSONDecoder(strict=False)
+        self.assertEqual(self.decode(['"a\x01', 'b"'], decoder=decoder),
+                         ['a\x01b'])
+
+    def test_splitter(self):
+        make_splitter = self.json.scanner.make_splitter
+        split = make_splitter()
+        self.assertEqual(split(' {"a": "}"} [', 0), 11)
+        self.assertEqual(split(' {"a": "}"} [', 11), -1)
+        split = make_splitter()
+        self.assertEqual(split('{"a": "\\', 0), -1)
+        self.assertEqual(split('"}"}, ', 0), 4)
+        self.assertEqual(make_splitter()('[1], ', 0), 3)
+        self.assertEqual(make_splitter()('"]"', 0), 3)
+        self.assertEqual(make_splitter()('  12 ', 0), 4)
+        self.assertEqual(make_splitter()('12', 0), -1)
+        self.assertEqual(make_splitter()(', 1', 0), 1)
+        self.assertRaises(ValueError, make_splitter(), 'abc', 4)
+        self.assertRaises(ValueError, make_splitter(), 'abc', -1)
+
+
+class TestPyStreamDecoder(TestStreamDecoder, PyTest): pass
+class TestCStreamDecoder(TestStreamDecoder, CTest):
+    def test_c_splitter(self):
+        self.assertIs(self.json.scanner.make_splitter,
+                      self.json.scanner.c_make_splitter)
@@ -1,13 +1,17 @@
 from _compat_pickle import (IMPORT_MAPPING, REVERSE_IMPORT_MAPPING,
                             NAME_MAPPING, REVERSE_NAME_MAPPING)
+import array
 import builtins
 import collections
 import contextlib
 import io
 import pickle
+import shutil
 import struct
+import subprocess
 import sys
 import tempfile
+import threading
 import warnings
 import weakref
 from textwrap import dedent
@@ -371,6 +375,30 @@ class CustomPyPicklerClass(pickle._Pickler,
     class CPickleTests(AbstractPickleModuleTests, unittest.TestCase):
         from _pickle import dump, dumps, load, loads, Pickler, Unpickler
 
+        def test_loads_workers_thread_errors(self):
+            data = ['x' * 1000 + str(i) for i in range(200)]
+            s = self.dumps(data, 4)
+            start = threading.Thread.start
+            started = []
+            def start_one(thread):
+                if started:
+                    raise exc
+                started.append(thread)
+                start(thread)
+            # Running out of threads is not an error.
+            exc = RuntimeError("can't start new thread")
+            with support.swap_attr(threading.Thread, 'start', start_one):
+                self.assertEqual(self.loads(s, workers=4), data)
+            self.assertEqual(len(started), 1)
+            # Other errors are raised once the started threads are joined.
+            started.clear()
+            exc = ZeroDivisionError
+            with support.swap_attr(threading.Thread, 'start', start_one):
+                self.assertRaises(ZeroDivisionError,
+                                  self.loads, s, workers=4)
+            self.assertEqual(len(started), 1)
+            self.assertFalse(started[0].is_alive())
+
     class CUnpicklerTests(PyUnpicklerTests):
         unpickler = _pickle.Unpickler
         bad_stack_errors = (pickle.UnpicklingError,)
@@ -464,7 +492,7 @@ def test_pickler(self):
             basesize = support.calcobjsize('7P2n3i2n3i2P')
             p = _pickle.Pickler(io.BytesIO())
             self.assertEqual(object.__sizeof__(p), basesize)
-            MT_size = struct.calcsize('3nP0n')
+            MT_size = struct.calcsize('3ni2P0n')
             ME_size = struct.calcsize('Pn0P')
             check = self.check_sizeof
             check(p, basesize +
@@ -478,7 +506,7 @@ def test_pickler(self):
                 0)  # Write buffer is cleared after every dump().
 
         def test_unpickler(self):
-            basesize = support.calcobjsize('2P2n2P 2P2n2i5P 2P3n8P2n2i')
+            basesize = support.calcobjsize('2P2n2P 2P2n2i5P 2P3n8P2n2iP')
             unpickler = _pickle.Unpickler
             P = struct.calcsize('P')  # Size of memo table entry.
             n = struct.calcsize('n')  # Size of mark table entry.
@@ -709,6 +737,61 @@ def test_multiprocessing_exceptions(self):
                                  ('multiprocessing.context', name))
 
 
+class OutOfBandCompatTests(unittest.TestCase):
+    # Out-of-band bytearray and array.array objects can be loaded by all
+    # versions that support protocol 5.
+
+    objects = [bytearray(b'abc'), array.array('d', [1.5, 2.0]),
+               array.array('q', [])]
+
+    def pickles(self):
+        modules = [pickle._dumps]
+        if has_c_implementation:
+            modules.append(pickle.dumps)
+        for dumps in modules:
+            buffers = []
+            data = dumps(self.objects, 5, buffer_callback=buffers.append)
+            self.assertEqual(len(buffers), len(self.objects))
+            yield data, [bytes(pb.raw()) for pb in buffers]
+
+    def test_names(self):
+        # Only names that exist since Python 3.8 are used.
+        allowed = {('builtins', 'bytearray'), ('builtins', 'bytes'),
+                   ('array', 'array')}
+        class RestrictedUnpickler(pickle._Unpickler):
+            def find_class(self, module, name):
+                if (module, name) not in allowed:
+                    raise pickle.UnpicklingError(f'{module}.{name}')
+                return super().find_class(module, name)
+        for data, buffers in self.pickles():
+            unpickler = RestrictedUnpickler(io.BytesIO(data), buffers=buffers)
+            self.assertEqual(unpickler.load(), self.objects)
+
+    @support.requires_subprocess()
+    def test_older_versions(self):
+        # Load the pickles with the older Python 3 versions found in PATH.
+        tested = False
+        for minor in range(8, sys.version_info.minor):
+            executable = shutil.which(f'python3.{minor}')
+            if (executable is None or
+                subprocess.run([executable, '-c', 'pass'],
+                               capture_output=True).returncode):
+                continue
+            code = ('import ast, pickle, sys\n'
+                    'data, buffers = ast.literal_eval(sys.stdin.read())\n'
+                    'print(repr(pickle.loads(data, buffers=buffers)))\n')
+            for data, buffers in self.pickles():
+                proc = subprocess.run([executable, '-I', '-c', code],
+                                      input=repr((data, buffers)),
+                                      capture_output=True, text=True)
+                with self.subTest(version=minor):
+                    self.assertEqual(proc.returncode, 0, proc.stderr)
+                    self.assertEqual(proc.stdout.strip(), repr(self.objects))
+                tested = True
+        if not tested:
+            self.skipTest('no older Python 3 version found')
+
+
 class CommandLineTest(unittest.TestCase):
     def setUp(self):
         self.filename = tempfile.mktemp()
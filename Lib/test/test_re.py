@@ -5,6 +5,7 @@
 import locale
 import re
 import string
+import sys
 import unittest
 import warnings
 from re import Scanner
@@ -1353,6 +1354,81 @@ def test_search_coverage(self):
         self.assertEqual(re.search(r"\s(b)", " b").group(1), "b")
         self.assertEqual(re.search(r"a\s", "a ").group(0), "a ")
 
+    def test_search_required_literal(self):
+        # The search skips to the literals that every match contains.
+        for s in ('x@example.com', 'a b@example.co bc@example.com',
+                  '\xe9 bc@example.com', '\u20ac bc@example.com',
+                  '\U0001f600 bc@example.com'):
+            with self.subTest(s=s):
+                m = re.search(r'\w+@example\.com', s)
+                self.assertEqual(m.group(), s.rsplit(' ', 1)[-1])
+        self.assertIsNone(re.search(r'\w+@example\.com', 'x@example.co'))
+        self.assertIsNone(re.search(r'\w+@example\.com', '@example.com'))
+        self.assertIsNone(re.search(r'\w+\u20ac', 'abc\xe9' * 10))
+        self.assertEqual(re.search(r'\w+\u20ac', 'abc\u20ac').span(), (0, 4))
+        p = re.compile(r'\d\d:\d\d ERROR \w+')
+        s = '10:00 INFO ok 10:01 ERROR disk 10:02 ERROR net'
+        self.assertEqual(p.findall(s), ['10:01 ERROR disk', '10:02 ERROR net'])
+        self.assertEqual(p.search(s, 15).group(), '10:02 ERROR net')
+        self.assertIsNone(p.search(s, 0, 25))
+        self.assertEqual(p.search(s, 0, 30).group(), '10:01 ERROR disk')
+        self.assertEqual(p.sub('-', s), '10:00 INFO ok - -')
+        self.assertIsNone(p.search(' ERROR x'))
+        self.assertEqual(re.findall(rb'\w+=\w+', b'a=1, bc=2, =3'),
+                         [b'a=1', b'bc=2'])
+        self.assertEqual(re.findall(r'.*ERROR.*timeout',
+                                    'ERROR\nERROR: timeout\nx timeout'),
+                         ['ERROR: timeout'])
+        self.assertEqual(re.findall(r'(?<=\d)x\b', 'ax 1x 2xx 3x'),
+                         ['x', 'x'])
+        self.assertEqual(re.findall(r'\bab', 'cab ab abab'), ['ab', 'ab'])
+        self.assertEqual(re.findall(r'(?i)\w+@x', 'A@X b@x'), ['A@X', 'b@x'])
+        self.assertEqual(re.findall(r'(?i:a)b', 'Ab aB ab'), ['Ab', 'ab'])
+
+    def test_search_linear_time(self):
+        # Patterns without backreferences, lookarounds or anchors are
+        # searched with a DFA, which takes linear time.
+        self.assertIsNone(re.search(r'(x+x+)+y', 'x' * 100 + ' y'))
+        self.assertIsNone(re.match(r'(x+x+)+y', 'x' * 100 + ' y'))
+        self.assertIsNone(re.fullmatch(r'(\w+\s?)*', 'foo bar ' * 50 + '!'))
+        self.assertEqual(re.findall(rb'(?:a|aa)+b', b'a' * 100 + b'ab'),
+                         [b'a' * 101 + b'b'])
+        s = 'ab' * 2000
+        self.assertIsNone(re.search(r'(?:a|b)*a(?:a|b){12}c', s))
+        self.assertEqual(re.search(r'(?:a|b)*a(?:a|b){12}c', s + 'ac').span(),
+                         (0, len(s) + 2))
+        # The groups and the end of the match come from the matcher.
+        self.assertEqual(re.search(r'(a+)(b*)c', 'xaac aabbc').groups(),
+                         ('aa', ''))
+        self.assertEqual(re.search(r'a+?(b+?)', 'xaabbb').span(), (1, 4))
+        self.assertEqual(re.search(r'(?:ab|a)(b*)', 'xabb').group(1), 'b')
+        self.assertEqual(re.fullmatch(r'(?:ab|a)(?:bc|c)', 'abc').span(),
+                         (0, 3))
+        self.assertIsNone(re.fullmatch(r'(?:ab|a)(?:bc|c)', 'abcc'))
+        self.assertEqual(re.search(r'(?i)(?:ſ|k)+x',
+                                   'aKſkx Kx').group(), 'Kſkx')
+        self.assertEqual(re.findall(r'[€\U0001f600]+\d', '€\U0001f6001'),
+                         ['€\U0001f6001'])
+        # Empty matches.
+        self.assertEqual([m.span() for m in re.finditer(r'b*', 'abbc')],
+                         [(0, 0), (1, 3), (3, 3), (4, 4)])
+        self.assertEqual(re.sub(r'x*', '-', 'abxd'), '-a-b--d-')
+        self.assertEqual(re.split(r'(?:a|)(?:b|)', 'cab'), ['', 'c', '', ''])
+        p = re.compile(r'\d*')
+        self.assertEqual(p.search('ab12', 1).span(), (1, 1))
+        self.assertEqual(p.match('ab12', 2, 3).span(), (2, 3))
+
+    @cpython_only
+    def test_search_dfa_sizeof(self):
+        # The states cached by the DFA count in the size of the pattern,
+        # and are limited per pattern.
+        p = re.compile(r'(?:a|b)*a(?:a|b){12}c')
+        size = sys.getsizeof(p)
+        self.assertGreater(size, sys.getsizeof(re.compile('x')))
+        self.assertIsNone(p.search('ab' * 2000))
+        self.assertGreater(sys.getsizeof(p), size)
+        self.assertLessEqual(sys.getsizeof(p), size + 2 * 64 * 1024)
+
     def assertMatch(self, pattern, text, match=None, span=None,
                     matcher=re.fullmatch):
         if match is None and span is None:
@@ -1704,6 +1780,37 @@ def test_finditer(self):
         self.assertEqual([item.group(0) for item in iter],
                          ["::", "::"])
 
+    def test_scan_spans(self):
+        def spans(p, s, *args):
+            return [x for m in p.finditer(s, *args)
+                    for i in range(p.groups + 1) for x in m.span(i)]
+
+        for p, s in [(r":+", "a:b::c:::d"),
+                     (r"(\w+)=(\d+)?", "a=1 bb= ccc=33"),
+                     (r"(?:(a)|(b))*c?", "abcbad€"),
+                     (r"x*", "axxb"),
+                     (rb"(\w+)=(\d+)?", b"a=1 bb= ccc=33"),
+                     (r"z", "abc")]:
+            with self.subTest(pattern=p, string=s):
+                p = re.compile(p)
+                v = p.scan_spans(s)
+                self.assertIsInstance(v, memoryview)
+                self.assertEqual(v.format, 'n')
+                self.assertTrue(v.readonly)
+                self.assertEqual(v.tolist(), spans(p, s))
+                self.assertEqual(p.scan_spans(s, 2).tolist(), spans(p, s, 2))
+                self.assertEqual(p.scan_spans(s, pos=1, endpos=5).tolist(),
+                                 spans(p, s, 1, 5))
+
+        p = re.compile(rb":+")
+        self.assertEqual(p.scan_spans(bytearray(b"a:b::c")).tolist(),
+                         [1, 2, 3, 5])
+        self.assertEqual(p.scan_spans(memoryview(b"xa:b::c")[1:]).tolist(),
+                         [1, 2, 3, 5])
+        self.assertEqual(len(p.scan_spans(b":a" * 1000)), 2000)
+        self.assertRaises(TypeError, p.scan_spans, "a:b")
+        self.assertRaises(TypeError, re.compile(":").scan_spans, b"a:b")
+
     def test_bug_926075(self):
         self.assertIsNot(re.compile('bug_926075'),
                          re.compile(b'bug_926075'))
@@ -2771,14 +2878,35 @@ def test_atomic_group(self):
   MAX_REPEAT 0 1
     LITERAL 98
 
- 0. INFO 4 0b0 1 2 (to 5)
- 5: ATOMIC_GROUP 11 (to 17)
- 7.   LITERAL 0x61 ('a')
- 9.   REPEAT_ONE 6 0 1 (to 16)
-13.     LITERAL 0x62 ('b')
-15.     SUCCESS
-16:   SUCCESS
-17: SUCCESS
+ 0. INFO 8 0b1000 1 2 (to 9)
+      required [0x61] ('a') 0 0
+ 9: ATOMIC_GROUP 11 (to 21)
+11.   LITERAL 0x61 ('a')
+13.   REPEAT_ONE 6 0 1 (to 20)
+17.     LITERAL 0x62 ('b')
+19.     SUCCESS
+20:   SUCCESS
+21: SUCCESS
+''')
+
+    def test_required_literal(self):
+        self.assertEqual(get_debug_out(r'\d+ab'), '''\
+MAX_REPEAT 1 MAXREPEAT
+  IN
+    CATEGORY CATEGORY_DIGIT
+LITERAL 97
+LITERAL 98
+
+ 0. INFO 9 0b1000 3 MAXREPEAT (to 10)
+      required [0x61, 0x62] ('ab') 1 MAXREPEAT
+10: REPEAT_ONE 9 1 MAXREPEAT (to 20)
+14.   IN 4 (to 19)
+16.     CATEGORY UNI_DIGIT
+18.     FAILURE
+19:   SUCCESS
+20: LITERAL 0x61 ('a')
+22. LITERAL 0x62 ('b')
+24. SUCCESS
 ''')
 
     def test_possesive_repeat_one(self):
@@ -1865,6 +1865,27 @@ def __eq__(self, o):
         s = {0}
         s.update(other)
 
+    def test_update_list_and_mutate(self):
+        # Items of lists are looked at ahead of adding them.
+        class X:
+            def __hash__(self):
+                return hash(0)
+            def __eq__(self, o):
+                other.clear()
+                return False
+
+        other = [0, *range(1, 100), *map(str, range(100))]
+        s = {X()}
+        s.update(other)
+        self.assertEqual(s - {0}, {x for x in s if isinstance(x, X)})
+
+        keys = [*range(10_000), *map(str, range(10_000)), (1, 2), 1.5]
+        s = set(keys * 2)
+        self.assertEqual(len(s), len(keys))
+        for k in keys:
+            self.assertIn(k, s)
+        self.assertEqual(frozenset(tuple(keys)), s)
+
 
 class TestOperationsMutating:
     """Regression test for bpo-46615"""
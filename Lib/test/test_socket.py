@@ -3105,6 +3105,159 @@ def _testRecvFromNegative(self):
         self.cli.sendto(MSG, 0, (HOST, self.port))
 
 
+@requireAttrs(socket.socket, "recvmmsg_into", "sendmmsg")
+class MultiMessageUDPTest(SocketUDPTest):
+
+    def setUp(self):
+        super().setUp()
+        self.cli = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addCleanup(self.cli.close)
+        self.cli.bind((HOST, 0))
+        self.serv.settimeout(support.LOOPBACK_TIMEOUT)
+
+    def testSendmmsgAndRecvmmsgInto(self):
+        addr = (HOST, self.port)
+        self.assertEqual(self.cli.sendmmsg([(b'a', addr),
+                                            (bytearray(b'bb'), addr),
+                                            (memoryview(b'ccc'), addr)]), 3)
+        buffers = [bytearray(4) for _ in range(4)]
+        result = self.serv.recvmmsg_into(buffers)
+        sender = self.cli.getsockname()
+        self.assertEqual(result, [(1, sender), (2, sender), (3, sender)])
+        self.assertEqual(buffers, [b'a\0\0\0', b'bb\0\0', b'ccc\0', bytes(4)])
+
+    def testRecvmmsgIntoTruncated(self):
+        self.cli.sendto(MSG, (HOST, self.port))
+        buf = bytearray(4)
+        result = self.serv.recvmmsg_into([memoryview(buf)])
+        self.assertEqual(result, [(4, self.cli.getsockname())])
+        self.assertEqual(buf, MSG[:4])
+
+    def testRecvmmsgIntoTimeout(self):
+        self.serv.settimeout(0.01)
+        self.assertRaises(TimeoutError, self.serv.recvmmsg_into,
+                          [bytearray(4)])
+        self.serv.setblocking(False)
+        self.assertRaises(BlockingIOError, self.serv.recvmmsg_into,
+                          [bytearray(4)])
+
+    def testRecvmmsgIntoNoBuffers(self):
+        self.assertEqual(self.serv.recvmmsg_into([]), [])
+
+    def testRecvmmsgIntoBadArgs(self):
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, None)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, [b'abc'])
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, [bytearray(4)],
+                          'flags')
+
+    def testSendmmsgConnected(self):
+        self.cli.connect((HOST, self.port))
+        self.assertEqual(self.cli.sendmmsg([(MSG, None), (MSG, None)]), 2)
+        self.assertEqual(self.serv.recv(1024), MSG)
+        self.assertEqual(self.serv.recv(1024), MSG)
+
+    def testSendmmsgNoMessages(self):
+        self.assertEqual(self.cli.sendmmsg([]), 0)
+
+    def testSendmmsgBadArgs(self):
+        addr = (HOST, self.port)
+        self.assertRaises(TypeError, self.cli.sendmmsg, None)
+        self.assertRaises(TypeError, self.cli.sendmmsg, [MSG])
+        self.assertRaises(TypeError, self.cli.sendmmsg, [(MSG,)])
+        self.assertRaises(TypeError, self.cli.sendmmsg, [('abc', addr)])
+        self.assertRaises(TypeError, self.cli.sendmmsg, [(MSG, addr)],
+                          'flags')
+        # Nothing is sent if a message is invalid.
+        self.assertRaises(TypeError, self.cli.sendmmsg,
+                          [(MSG, addr), (MSG, 'address')])
+        self.serv.setblocking(False)
+        self.assertRaises(BlockingIOError, self.serv.recv, 1024)
+
+
+@requireAttrs(socket.socket, "recv_zerocopy_completions")
+@requireAttrs(socket, "SO_ZEROCOPY", "MSG_ZEROCOPY")
+class ZerocopyTCPTest(SocketTCPTest):
+
+    def setUp(self):
+        super().setUp()
+        self.cli = socket.create_connection((HOST, self.port))
+        self.addCleanup(self.cli.close)
+        self.conn, _ = self.serv.accept()
+        self.addCleanup(self.conn.close)
+        try:
+            self.cli.setsockopt(socket.SOL_SOCKET, socket.SO_ZEROCOPY, 1)
+        except OSError as exc:
+            self.skipTest(f"SO_ZEROCOPY not supported: {exc}")
+
+    def testSendZerocopy(self):
+        self.assertEqual(self.cli.recv_zerocopy_completions(), [])
+        for _ in range(3):
+            self.cli.sendall(MSG, socket.MSG_ZEROCOPY)
+        received = b''
+        while len(received) < 3 * len(MSG):
+            received += self.conn.recv(1024)
+        self.assertEqual(received, MSG * 3)
+
+        completed = []
+        for _ in support.sleeping_retry(support.SHORT_TIMEOUT):
+            for first, last, copied in self.cli.recv_zerocopy_completions():
+                self.assertIsInstance(copied, bool)
+                completed.extend(range(first, last + 1))
+            if len(completed) == 3:
+                break
+        self.assertEqual(sorted(completed), [0, 1, 2])
+        self.assertEqual(self.cli.recv_zerocopy_completions(), [])
+
+    def testSendallZerocopy(self):
+        data = bytes(range(256)) * 1024
+        expected = data + data[:100] + data
+        received = bytearray()
+        def reader():
+            self.conn.settimeout(support.SHORT_TIMEOUT)
+            while len(received) < len(expected):
+                received.extend(self.conn.recv(65536))
+        thread = threading.Thread(target=reader)
+        thread.start()
+        self.addCleanup(thread.join)
+        self.assertIsNone(self.cli.sendall_zerocopy(data))
+        # Small data is sent with sendall().
+        self.cli.sendall_zerocopy(memoryview(data)[:100])
+        self.cli.sendall_zerocopy(bytearray(data))
+        thread.join()
+        self.assertEqual(received, expected)
+        # All completions were consumed.
+        self.assertEqual(self.cli.recv_zerocopy_completions(), [])
+
+    def testSendallZerocopyUnsupported(self):
+        # Sent with sendall() if SO_ZEROCOPY is not supported.
+        a, b = socket.socketpair()
+        self.addCleanup(a.close)
+        self.addCleanup(b.close)
+        data = b'x' * 100_000
+        received = bytearray()
+        def reader():
+            b.settimeout(support.SHORT_TIMEOUT)
+            while len(received) < len(data):
+                received.extend(b.recv(65536))
+        thread = threading.Thread(target=reader)
+        thread.start()
+        self.addCleanup(thread.join)
+        a.sendall_zerocopy(data)
+        thread.join()
+        self.assertEqual(received, data)
+
+    def testSendallZerocopyNonBlocking(self):
+        self.cli.setblocking(False)
+        self.assertRaises(ValueError, self.cli.sendall_zerocopy, b'x')
+
+    def testNoCompletions(self):
+        # Not enabled with SO_ZEROCOPY.
+        self.assertEqual(self.conn.recv_zerocopy_completions(), [])
+        self.conn.sendall(MSG)
+        self.assertEqual(self.conn.recv_zerocopy_completions(), [])
+        self.assertEqual(self.cli.recv(1024), MSG)
+
+
 @unittest.skipUnless(HAVE_SOCKET_UDPLITE,
           'UDPLITE sockets required for this test.')
 class BasicUDPLITETest(ThreadedUDPLITESocketTest):
@@ -6769,6 +6922,63 @@ def testNonRegularFile(self):
         self.assertEqual(len(data), self.FILESIZE)
         self.assertEqual(data, self.FILEDATA)
 
+    # pipe
+
+    def _testPipe(self):
+        address = self.serv.getsockname()
+        r, w = os.pipe()
+        file = open(r, 'rb')
+        def writer():
+            with open(w, 'wb') as f:
+                f.write(self.FILEDATA)
+        thread = threading.Thread(target=writer)
+        thread.start()
+        self.addCleanup(thread.join)
+        with socket.create_connection(address) as sock, file as file:
+            self.assertRaises(socket._GiveupOnSendfile,
+                              sock._sendfile_use_sendfile, file)
+            # The file object has read ahead from the pipe.
+            self.assertEqual(file.read(10), self.FILEDATA[:10])
+            sent = sock.sendfile(file, count=self.FILESIZE - 20)
+            self.assertEqual(sent, self.FILESIZE - 20)
+            sent = sock.sendfile(file)
+            self.assertEqual(sent, 10)
+
+    def testPipe(self):
+        conn = self.accept_conn()
+        data = self.recv_data(conn)
+        self.assertEqual(len(data), self.FILESIZE - 10)
+        self.assertEqual(data, self.FILEDATA[10:])
+
+    def _testPipeTimeout(self):
+        address = self.serv.getsockname()
+        r, w = os.pipe()
+        self.addCleanup(os.close, w)
+        with socket.create_connection(address, timeout=0.1) as sock, \
+             open(r, 'rb') as file:
+            self.assertRaises(TimeoutError, sock.sendfile, file)
+            self.assertTrue(os.get_blocking(r))
+
+    def testPipeTimeout(self):
+        conn = self.accept_conn()
+        self.assertEqual(self.recv_data(conn), b'')
+
+    # character device
+
+    def _testCharDevice(self):
+        address = self.serv.getsockname()
+        with socket.create_connection(address) as sock, \
+             open('/dev/zero', 'rb') as file:
+            # Like an empty file, since it has no size.
+            self.assertEqual(sock.sendfile(file), 0)
+
+    @unittest.skipUnless(hasattr(os, 'sendfile') and
+                         os.path.exists('/dev/zero'),
+                         'requires os.sendfile() and /dev/zero')
+    def testCharDevice(self):
+        conn = self.accept_conn()
+        self.assertEqual(self.recv_data(conn), b'')
+
     # empty file
 
     def _testEmptyFileSend(self):
@@ -277,6 +277,14 @@ def test_find(self):
         self.checkequal(100, 'a' * 100 + '\U00100304', 'find', '\U00100304')
         self.checkequal(-1, 'a' * 100 + '\U00100304', 'find', '\U00100204')
         self.checkequal(-1, 'a' * 100 + '\U00100304', 'find', '\U00102004')
+        # test implementation details of the short needle filter
+        for text in ('Ă' * 100 + 'Ăă',
+                     '\U00100304' * 100 + '\U00100304\U00100305'):
+            needle = text[-2:]
+            self.checkequal(100, text, 'find', needle)
+            self.checkequal(1, text, 'count', needle)
+            self.checkequal(-1, text, 'find', needle[0] + chr(ord(needle[1]) ^ 0x100))
+            self.checkequal(-1, text, 'find', needle[0] + chr(ord(needle[1]) & 0xff))
         # check mixed argument types
         self.checkequalnofix(0,  'abcdefghiabc', 'find', 'abc')
         self.checkequalnofix(9,  'abcdefghiabc', 'find', 'abc', 1)
@@ -1870,6 +1878,43 @@ def test_utf8_decode_valid_sequences(self):
         for seq, res in sequences:
             self.assertEqual(seq.decode('utf-8'), res)
 
+    def test_utf8_decode_long_runs(self):
+        # Runs of 2-byte sequences are decoded several at a time, and the
+        # kind of the result is chosen before decoding.
+        for text in ('\u0436' * 40, '\x80\u07ff' * 20, 'a' + '\xe9' * 39,
+                     '\u0436' * 20 + '\U0001f600', 'x' * 30 + '\uffff',
+                     '\xe9' * 30 + '\u0100' + '\xe9' * 9):
+            for i in range(len(text) + 1):
+                head, tail = text[:i].encode(), text[i:].encode()
+                self.assertEqual(tail.decode('utf-8'), text[i:])
+                for bad, res in ((b'\xc0\x80', '\ufffd\ufffd'),
+                                 (b'\xc2', '\ufffd'), (b'\xc2A', '\ufffdA'),
+                                 (b'\x80', '\ufffd')):
+                    with self.subTest(text=text, i=i, bad=bad):
+                        seq = head + bad + tail
+                        with self.assertRaises(UnicodeDecodeError) as cm:
+                            seq.decode('utf-8')
+                        self.assertEqual(cm.exception.start, len(head))
+                        self.assertEqual(seq.decode('utf-8', 'replace'),
+                                         text[:i] + res + text[i:])
+
+    def test_utf8_encode_long_runs(self):
+        # The size of the result of long strings is computed before
+        # encoding.
+        for text in ('a' * 150 + '\xe9', '\xe9' * 150, 'x' * 9 + '\u0436' * 140,
+                     '\u20ac' * 140 + 'y' * 9, '\U0001f600' * 140 + 'z'):
+            for i in range(len(text) + 1):
+                with self.subTest(text=text, i=i):
+                    self.assertEqual(text[i:].encode(),
+                                     text[i:].encode('utf-8', 'surrogatepass'))
+                    self.assertEqual(text[i:].encode().decode(), text[i:])
+                    seq = text[:i] + '\udc80' + text[i:]
+                    with self.assertRaises(UnicodeEncodeError) as cm:
+                        seq.encode()
+                    self.assertEqual(cm.exception.start, i)
+                    self.assertEqual(seq.encode('utf-8', 'surrogateescape'),
+                                     text[:i].encode() + b'\x80'
+                                     + text[i:].encode())
 
     def test_utf8_decode_invalid_sequences(self):
         # continuation bytes in a sequence of 2, 3, or 4 bytes
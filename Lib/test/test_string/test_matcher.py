@@ -0,0 +1,206 @@
+import mmap
+import pickle
+import random
+import unittest
+from test.support import import_helper, os_helper
+
+import_helper.import_module('_multisearch')
+from string import Matcher
+
+
+def reference_findall(patterns, s, pos=0, endpos=None):
+    # Leftmost-longest, non-overlapping matches found the slow way.
+    endpos = len(s) if endpos is None else endpos
+    result = []
+    i = pos
+    while i < endpos:
+        best = None
+        for k, p in enumerate(patterns):
+            if (s.startswith(p, i) and i + len(p) <= endpos
+                    and (best is None or len(p) > len(patterns[best]))):
+                best = k
+        if best is None:
+            i += 1
+        else:
+            result.append((i, best))
+            i += len(patterns[best])
+    return result
+
+
+class MatcherTest(unittest.TestCase):
+
+    def test_search(self):
+        m = Matcher(['he', 'she', 'his', 'hers'])
+        self.assertEqual(m.search('ushers'), (1, 1))
+        self.assertEqual(m.search('ushers', 2), (2, 3))
+        self.assertEqual(m.search('ushers', 2, 4), (2, 0))
+        self.assertEqual(m.search('ushers', 3), None)
+        self.assertEqual(m.search(''), None)
+        self.assertEqual(m.search('his', -10, 100), (0, 2))
+        self.assertEqual(m.search('his', 2, 1), None)
+
+    def test_leftmost_longest(self):
+        m = Matcher(['bc', 'abcd', 'a', 'abc'])
+        self.assertEqual(m.search('xabcde'), (1, 1))
+        self.assertEqual(m.findall('abcabcd'), [(0, 3), (3, 1)])
+        self.assertEqual(m.findall('abcabcd', 1), [(1, 0), (3, 1)])
+        self.assertEqual(m.findall('abcabcd', 0, 6), [(0, 3), (3, 3)])
+        # Duplicate patterns report the first one.
+        m = Matcher(['ab', 'x', 'ab'])
+        self.assertEqual(m.findall('abab'), [(0, 0), (2, 0)])
+
+    def test_findall_no_overlap(self):
+        m = Matcher(['aa', 'aaa'])
+        self.assertEqual(m.findall('aaaaaaa'), [(0, 1), (3, 1)])
+        self.assertEqual(m.findall('aaaaaaaa'), [(0, 1), (3, 1), (6, 0)])
+        m = Matcher(['aba'])
+        self.assertEqual(m.findall('ababababa'), [(0, 0), (4, 0)])
+
+    def test_replace(self):
+        m = Matcher(['cat', 'dog', 'bird'])
+        text = 'cat and dog and bird and cat'
+        self.assertEqual(m.replace(text, '*'), '* and * and * and *')
+        self.assertEqual(m.replace(text, ['c', 'd', 'b']),
+                         'c and d and b and c')
+        self.assertEqual(m.replace(text, ('c', 'd', 'b'), 2),
+                         'c and d and bird and cat')
+        self.assertEqual(m.replace(text, '*', 0), text)
+        self.assertEqual(m.replace('no match', '*'), 'no match')
+        self.assertEqual(m.replace('', '*'), '')
+        self.assertEqual(m.replace('dog', '\U0001f436'), '\U0001f436')
+        with self.assertRaises(ValueError):
+            m.replace(text, ['c', 'd'])
+        with self.assertRaises(TypeError):
+            m.replace(text, b'x')
+        with self.assertRaises(TypeError):
+            m.replace(text, ['c', 'd', 1])
+
+    def test_bytes(self):
+        m = Matcher([b'GET', bytearray(b'POST'), memoryview(b'\xff\x00')])
+        self.assertEqual(m.patterns, (b'GET', b'POST', b'\xff\x00'))
+        data = b'GET / POST /x \xff\x00'
+        expected = [(0, 0), (6, 1), (14, 2)]
+        self.assertEqual(m.findall(data), expected)
+        self.assertEqual(m.findall(bytearray(data)), expected)
+        self.assertEqual(m.findall(memoryview(data)), expected)
+        self.assertEqual(m.search(data, 1), (6, 1))
+        self.assertEqual(m.replace(data, [b'g', bytearray(b'p'), b'!']),
+                         b'g / p /x !')
+        self.assertEqual(m.replace(bytearray(data), b''), b' /  /x ')
+        with self.assertRaises(TypeError):
+            m.findall('GET')
+        with self.assertRaises(TypeError):
+            m.replace(data, 'x')
+        with self.assertRaises(TypeError):
+            Matcher(['GET']).findall(data)
+
+    def test_mmap(self):
+        m = Matcher([b'needle', b'pin'])
+        with open(os_helper.TESTFN, 'wb') as f:
+            f.write(b'hay' * 1000 + b'needle' + b'hay' * 1000 + b'pin')
+        self.addCleanup(os_helper.unlink, os_helper.TESTFN)
+        with open(os_helper.TESTFN, 'rb') as f:
+            with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+                self.assertEqual(m.findall(mm), [(3000, 0), (6006, 1)])
+
+    def test_string_kinds(self):
+        patterns = ['\xe9t\xe9', '€', '\U0001f600!', 'ab']
+        m = Matcher(patterns)
+        for text in ('ab \xe9t\xe9 ab', 'ab € \xe9t\xe9',
+                     '\U0001f600! ab €', 'x' * 100 + 'ab'):
+            with self.subTest(text=text):
+                self.assertEqual(m.findall(text),
+                                 reference_findall(patterns, text))
+        # Characters differing only in their high bits.
+        m = Matcher(['š', '\U00010061'])
+        self.assertEqual(m.search('a' * 50 + 'aš'), (51, 0))
+        self.assertIsNone(m.search('ɡ\U00020061' * 20))
+
+    def test_many_patterns(self):
+        # More distinct first characters than the prefilter handles.
+        patterns = [f'{c}{i}' for i, c in enumerate('abcdefghijklmnop')]
+        m = Matcher(patterns)
+        text = ' '.join(patterns) + ' z9 a1 p15'
+        self.assertEqual(m.findall(text), reference_findall(patterns, text))
+        # Including single character patterns.
+        patterns += list('0123456789') + ['\u0100', '\U00010000x']
+        m = Matcher(patterns)
+        text = (text + ' \u0100\U00010000x\U00010000') * 10
+        self.assertEqual(m.findall(text), reference_findall(patterns, text))
+
+    def test_random(self):
+        rnd = random.Random(42)
+        for alphabet in ('ab', 'abcd', 'a\xe9€', 'ab\U0001f600'):
+            for _ in range(200):
+                patterns = [''.join(rnd.choices(alphabet, k=rnd.randint(1, 5)))
+                            for _ in range(rnd.randint(1, 10))]
+                text = ''.join(rnd.choices(alphabet + 'xyz',
+                                           k=rnd.randint(0, 300)))
+                pos = rnd.randint(0, len(text))
+                with self.subTest(patterns=patterns, text=text, pos=pos):
+                    m = Matcher(patterns)
+                    self.assertEqual(m.findall(text),
+                                     reference_findall(patterns, text))
+                    self.assertEqual(m.findall(text, pos),
+                                     reference_findall(patterns, text, pos))
+
+    def test_small_sets(self):
+        # Small sets are searched one pattern at a time; patterns that
+        # never occur make the same set use the automaton.
+        rnd = random.Random(7)
+        fillers = ['#1', '#2', '#3', '#4', '#5']
+        for alphabet in ('ab', 'a\xe9€'):
+            for _ in range(100):
+                patterns = [''.join(rnd.choices(alphabet, k=rnd.randint(1, 4)))
+                            for _ in range(rnd.randint(1, 4))]
+                text = ''.join(rnd.choices(alphabet + 'x',
+                                           k=rnd.randint(0, 100)))
+                pos = rnd.randint(0, len(text))
+                endpos = rnd.randint(0, len(text))
+                small = Matcher(patterns)
+                large = Matcher(patterns + fillers)
+                with self.subTest(patterns=patterns, text=text):
+                    self.assertEqual(small.findall(text, pos, endpos),
+                                     large.findall(text, pos, endpos))
+                    self.assertEqual(small.search(text, pos, endpos),
+                                     large.search(text, pos, endpos))
+                    repls = [str(i) for i in range(len(patterns))]
+                    self.assertEqual(small.replace(text, repls, 3),
+                                     large.replace(text, repls + fillers, 3))
+                    data = text.encode()
+                    self.assertEqual(
+                        Matcher([p.encode() for p in patterns]).findall(data),
+                        reference_findall([p.encode() for p in patterns], data))
+
+    def test_constructor_errors(self):
+        self.assertRaises(ValueError, Matcher, [])
+        self.assertRaises(ValueError, Matcher, ['a', ''])
+        self.assertRaises(ValueError, Matcher, [b''])
+        self.assertRaises(TypeError, Matcher, ['a', b'b'])
+        self.assertRaises(TypeError, Matcher, [b'a', 'b'])
+        self.assertRaises(TypeError, Matcher, [b'a', 1])
+        self.assertRaises(TypeError, Matcher, 1)
+        self.assertRaises(TypeError, Matcher)
+
+    def test_attributes(self):
+        m = Matcher(p for p in ('x', 'y'))
+        self.assertEqual(m.patterns, ('x', 'y'))
+        self.assertEqual(repr(m), "Matcher(('x', 'y'))")
+        with self.assertRaises(AttributeError):
+            m.patterns = ()
+        with self.assertRaises(TypeError):
+            class M(Matcher):
+                pass
+
+    def test_pickle(self):
+        for patterns in (['a', 'bc'], [b'a', b'bc']):
+            m = Matcher(patterns)
+            for proto in range(pickle.HIGHEST_PROTOCOL + 1):
+                with self.subTest(patterns=patterns, proto=proto):
+                    m2 = pickle.loads(pickle.dumps(m, proto))
+                    self.assertIs(type(m2), Matcher)
+                    self.assertEqual(m2.patterns, m.patterns)
+
+
+if __name__ == '__main__':
+    unittest.main()
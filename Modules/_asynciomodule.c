@@ -10,6 +10,7 @@
 #include "pycore_modsupport.h"    // _PyArg_CheckPositional()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_object.h"        // _PyObject_SetMaybeWeakref
+#include "pycore_pyatomic_ft_wrappers.h"
 #include "pycore_pylifecycle.h"   // _Py_IsInterpreterFinalizing()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_runtime_init.h"  // _Py_ID()
@@ -78,8 +79,43 @@ typedef struct {
     PyObject *sw_arg;
 } TaskStepMethWrapper;
 
+#define HandleObj_HEAD(prefix)                                              \
+    PyObject_HEAD                                                           \
+    PyObject *prefix##_callback;                                            \
+    PyObject *prefix##_args;                                                \
+    PyObject *prefix##_loop;                                                \
+    PyObject *prefix##_context;                                             \
+    PyObject *prefix##_source_tb;                                           \
+    PyObject *prefix##_repr;                                                \
+    char prefix##_cancelled;                                                \
+
+typedef struct {
+    HandleObj_HEAD(h)
+} HandleObj;
+
+typedef struct {
+    HandleObj_HEAD(th)
+    char th_scheduled;
+    PyObject *th_when;
+} TimerHandleObj;
+
+/* The attributes of BaseEventLoop used by _run_once() and call_soon(). */
+typedef struct {
+    PyObject_HEAD
+    PyObject *lc_ready;
+    PyObject *lc_scheduled;
+    PyObject *lc_debug;
+    PyObject *lc_closed;
+    PyObject *lc_stopping;
+    PyObject *lc_clock_resolution;
+    Py_ssize_t lc_timer_cancelled_count;
+} EventLoopCoreObj;
+
 #define Future_CheckExact(state, obj) Py_IS_TYPE(obj, state->FutureType)
 #define Task_CheckExact(state, obj) Py_IS_TYPE(obj, state->TaskType)
+#define Handle_CheckExact(state, obj) Py_IS_TYPE(obj, state->HandleType)
+#define TimerHandle_CheckExact(state, obj) \
+    Py_IS_TYPE(obj, state->TimerHandleType)
 
 #define Future_Check(state, obj)                        \
     (Future_CheckExact(state, obj)                      \
@@ -146,9 +182,13 @@ typedef struct {
     PyTypeObject *TaskStepMethWrapper_Type;
     PyTypeObject *FutureType;
     PyTypeObject *TaskType;
+    PyTypeObject *HandleType;
+    PyTypeObject *TimerHandleType;
+    PyTypeObject *EventLoopCoreType;
 
     PyObject *asyncio_mod;
     PyObject *context_kwname;
+    PyObject *debug_kwname;
 
     /* WeakSet containing scheduled 3rd party tasks which don't
        inherit from native asyncio.Task */
@@ -179,6 +219,15 @@ typedef struct {
     /* Imports from asyncio.coroutines. */
     PyObject *asyncio_iscoroutine_func;
 
+    /* Imports from asyncio.format_helpers. */
+    PyObject *asyncio_extract_stack;
+    PyObject *asyncio_format_callback_source;
+
+    /* Imports from heapq. */
+    PyObject *heapq_heappush;
+    PyObject *heapq_heappop;
+    PyObject *heapq_heapify;
+
     /* Imports from traceback. */
     PyObject *traceback_extract_stack;
 
@@ -3604,224 +3653,2073 @@ task_wakeup(PyObject *op, PyObject *arg)
 }
 
 
-/*********************** Functions **************************/
+/*********************** Handle **************************/
 
 
 /*[clinic input]
-_asyncio._get_running_loop
-
-Return the running event loop or None.
-
-This is a low-level function intended to be used by event loops.
-This function is thread-specific.
-
+class _asyncio.Handle "HandleObj *" "&Handle_Type"
+class _asyncio.TimerHandle "TimerHandleObj *" "&TimerHandle_Type"
 [clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=2f75c1edc95be7b0]*/
 
-static PyObject *
-_asyncio__get_running_loop_impl(PyObject *module)
-/*[clinic end generated code: output=b4390af721411a0a input=0a21627e25a4bd43]*/
-{
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    PyObject *loop = Py_XNewRef(ts->asyncio_running_loop);
-    if (loop == NULL) {
-        /* There's no currently running event loop */
-        Py_RETURN_NONE;
-    }
-    return loop;
-}
-
-/*[clinic input]
-_asyncio._set_running_loop
-    loop: 'O'
-    /
-
-Set the running event loop.
-
-This is a low-level function intended to be used by event loops.
-This function is thread-specific.
-[clinic start generated code]*/
 
+/* Return a new reference to *field, or to None if it is NULL, that is
+   if the attribute has been deleted. */
 static PyObject *
-_asyncio__set_running_loop(PyObject *module, PyObject *loop)
-/*[clinic end generated code: output=ae56bf7a28ca189a input=4c9720233d606604]*/
+get_field_or_none(PyObject *obj, PyObject **field)
 {
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    if (loop == Py_None) {
-        loop = NULL;
-    }
-    Py_XSETREF(ts->asyncio_running_loop, Py_XNewRef(loop));
-    Py_RETURN_NONE;
+    PyObject *res;
+    Py_BEGIN_CRITICAL_SECTION(obj);
+    res = Py_XNewRef(*field);
+    Py_END_CRITICAL_SECTION();
+    return res != NULL ? res : Py_None;
 }
 
-/*[clinic input]
-_asyncio.get_event_loop
-
-Return an asyncio event loop.
-
-When called from a coroutine or a callback (e.g. scheduled with
-call_soon or similar API), this function will always return the
-running event loop.
-
-If there is no running event loop set, the function will return
-the result of `get_event_loop_policy().get_event_loop()` call.
-[clinic start generated code]*/
-
-static PyObject *
-_asyncio_get_event_loop_impl(PyObject *module)
-/*[clinic end generated code: output=2a2d8b2f824c648b input=9364bf2916c8655d]*/
+/* Store a new reference to value in *field. */
+static void
+set_field(PyObject *obj, PyObject **field, PyObject *value)
 {
-    asyncio_state *state = get_asyncio_state(module);
-    return get_event_loop(state);
+    PyObject *old;
+    Py_BEGIN_CRITICAL_SECTION(obj);
+    old = *field;
+    FT_ATOMIC_STORE_PTR_RELEASE(*field, Py_NewRef(value));
+    Py_END_CRITICAL_SECTION();
+    Py_XDECREF(old);
 }
 
-/*[clinic input]
-_asyncio.get_running_loop
+static int
+handle_init(asyncio_state *state, HandleObj *h, PyObject *callback,
+            PyObject *args, PyObject *loop, PyObject *context)
+{
+    PyObject *self = (PyObject *)h;
 
-Return the running event loop.  Raise a RuntimeError if there is none.
+    if (context == Py_None) {
+        context = PyContext_CopyCurrent();
+        if (context == NULL) {
+            return -1;
+        }
+        set_field(self, &h->h_context, context);
+        Py_DECREF(context);
+    }
+    else {
+        set_field(self, &h->h_context, context);
+    }
+    set_field(self, &h->h_loop, loop);
+    set_field(self, &h->h_callback, callback);
+    set_field(self, &h->h_args, args);
+    FT_ATOMIC_STORE_CHAR_RELAXED(h->h_cancelled, 0);
+    set_field(self, &h->h_repr, Py_None);
+    set_field(self, &h->h_source_tb, Py_None);
 
-This function is thread-specific.
-[clinic start generated code]*/
+    PyObject *res = PyObject_CallMethodNoArgs(loop, &_Py_ID(get_debug));
+    if (res == NULL) {
+        return -1;
+    }
+    int is_true = PyObject_IsTrue(res);
+    Py_DECREF(res);
+    if (is_true < 0) {
+        return -1;
+    }
+    if (is_true) {
+        /* The innermost Python frame is the caller of the constructor,
+           or of the loop method which created the handle. */
+        PyObject *tb = PyObject_CallNoArgs(state->asyncio_extract_stack);
+        if (tb == NULL) {
+            return -1;
+        }
+        set_field(self, &h->h_source_tb, tb);
+        Py_DECREF(tb);
+    }
+    return 0;
+}
 
 static PyObject *
-_asyncio_get_running_loop_impl(PyObject *module)
-/*[clinic end generated code: output=c247b5f9e529530e input=2a3bf02ba39f173d]*/
+new_handle(asyncio_state *state, PyObject *callback, PyObject *args,
+           PyObject *loop, PyObject *context)
 {
-    PyObject *loop;
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    loop = Py_XNewRef(ts->asyncio_running_loop);
-    if (loop == NULL) {
-        /* There's no currently running event loop */
-        PyErr_SetString(
-            PyExc_RuntimeError, "no running event loop");
+    PyTypeObject *tp = state->HandleType;
+    HandleObj *h = (HandleObj *)tp->tp_alloc(tp, 0);
+    if (h == NULL) {
         return NULL;
     }
-    return loop;
+    if (handle_init(state, h, callback, args, loop, context) < 0) {
+        Py_DECREF(h);
+        return NULL;
+    }
+    return (PyObject *)h;
 }
 
-/*[clinic input]
-_asyncio._register_task
-
-    task: object
-
-Register a new task in asyncio as executed by loop.
-
-Returns None.
-[clinic start generated code]*/
-
 static PyObject *
-_asyncio__register_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=8672dadd69a7d4e2 input=21075aaea14dfbad]*/
+new_timer_handle(asyncio_state *state, PyObject *when, PyObject *callback,
+                 PyObject *args, PyObject *loop, PyObject *context)
 {
-    asyncio_state *state = get_asyncio_state(module);
-    if (Task_Check(state, task)) {
-        // task is an asyncio.Task instance or subclass, use efficient
-        // linked-list implementation.
-        register_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    PyTypeObject *tp = state->TimerHandleType;
+    TimerHandleObj *th = (TimerHandleObj *)tp->tp_alloc(tp, 0);
+    if (th == NULL) {
+        return NULL;
     }
-    // As task does not inherit from asyncio.Task, fallback to less efficient
-    // weakset implementation.
-    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
-                                              &_Py_ID(add), task);
-    if (res == NULL) {
+    if (handle_init(state, (HandleObj *)th, callback, args, loop,
+                    context) < 0) {
+        Py_DECREF(th);
         return NULL;
     }
-    Py_DECREF(res);
-    Py_RETURN_NONE;
+    set_field((PyObject *)th, &th->th_when, when);
+    return (PyObject *)th;
 }
 
-/*[clinic input]
-_asyncio._register_eager_task
-
-    task: object
-
-Register a new task in asyncio as executed by loop.
+/* Return handle._cancelled as 0 or 1, or -1 on error. */
+static int
+handle_is_cancelled(asyncio_state *state, PyObject *handle)
+{
+    if (Handle_CheckExact(state, handle) ||
+        TimerHandle_CheckExact(state, handle))
+    {
+        return FT_ATOMIC_LOAD_CHAR_RELAXED(((HandleObj *)handle)->h_cancelled);
+    }
+    PyObject *cancelled = PyObject_GetAttr(handle, &_Py_ID(_cancelled));
+    if (cancelled == NULL) {
+        return -1;
+    }
+    int res = PyObject_IsTrue(cancelled);
+    Py_DECREF(cancelled);
+    return res;
+}
 
-Returns None.
-[clinic start generated code]*/
+/* Set timer._scheduled = value. */
+static int
+timer_handle_set_scheduled(asyncio_state *state, PyObject *timer, int value)
+{
+    if (TimerHandle_CheckExact(state, timer)) {
+        FT_ATOMIC_STORE_CHAR_RELAXED(((TimerHandleObj *)timer)->th_scheduled,
+                                     value);
+        return 0;
+    }
+    return PyObject_SetAttr(timer, &_Py_ID(_scheduled),
+                            value ? Py_True : Py_False);
+}
 
+/* Return a new reference to timer._when. */
 static PyObject *
-_asyncio__register_eager_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=dfe1d45367c73f1a input=237f684683398c51]*/
+timer_handle_get_when(asyncio_state *state, PyObject *timer)
 {
-    asyncio_state *state = get_asyncio_state(module);
-
-    if (Task_Check(state, task)) {
-        // task is an asyncio.Task instance or subclass, use efficient
-        // linked-list implementation.
-        register_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    if (TimerHandle_CheckExact(state, timer)) {
+        return get_field_or_none(timer, &((TimerHandleObj *)timer)->th_when);
     }
+    return PyObject_GetAttr(timer, &_Py_ID(_when));
+}
 
-    if (PySet_Add(state->non_asyncio_eager_tasks, task) < 0) {
+/* Return format_helpers._format_callback_source(callback, args,
+   debug=loop.get_debug()). */
+static PyObject *
+format_callback_source(asyncio_state *state, PyObject *loop,
+                       PyObject *callback, PyObject *args)
+{
+    PyObject *debug = PyObject_CallMethodNoArgs(loop, &_Py_ID(get_debug));
+    if (debug == NULL) {
         return NULL;
     }
-
-    Py_RETURN_NONE;
+    PyObject *stack[] = {callback, args, debug};
+    PyObject *res = PyObject_Vectorcall(state->asyncio_format_callback_source,
+                                        stack, 2, state->debug_kwname);
+    Py_DECREF(debug);
+    return res;
 }
 
+/* Pass an exception raised by the callback to the exception handler of
+   the loop. */
+static int
+handle_call_exception_handler(asyncio_state *state, HandleObj *h,
+                              PyObject *exc)
+{
+    PyObject *self = (PyObject *)h;
+    PyObject *callback = get_field_or_none(self, &h->h_callback);
+    PyObject *args = get_field_or_none(self, &h->h_args);
+    PyObject *loop = get_field_or_none(self, &h->h_loop);
+    PyObject *source_tb = get_field_or_none(self, &h->h_source_tb);
+    PyObject *cb = NULL, *message = NULL, *context = NULL, *res = NULL;
+    int is_true;
 
-/*[clinic input]
-_asyncio._unregister_task
-
-    task: object
-
-Unregister a task.
-
-Returns None.
-[clinic start generated code]*/
-
-static PyObject *
-_asyncio__unregister_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=6e5585706d568a46 input=28fb98c3975f7bdc]*/
-{
-    asyncio_state *state = get_asyncio_state(module);
-    if (Task_Check(state, task)) {
-        unregister_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    cb = format_callback_source(state, loop, callback, args);
+    if (cb == NULL) {
+        goto finally;
     }
-    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
-                                              &_Py_ID(discard), task);
+    message = PyUnicode_FromFormat("Exception in callback %S", cb);
+    if (message == NULL) {
+        goto finally;
+    }
+    context = PyDict_New();
+    if (context == NULL) {
+        goto finally;
+    }
+    if (PyDict_SetItem(context, &_Py_ID(message), message) < 0 ||
+        PyDict_SetItem(context, &_Py_ID(exception), exc) < 0 ||
+        PyDict_SetItem(context, &_Py_ID(handle), self) < 0) {
+        goto finally;
+    }
+    is_true = PyObject_IsTrue(source_tb);
+    if (is_true < 0) {
+        goto finally;
+    }
+    if (is_true && PyDict_SetItem(context, &_Py_ID(source_traceback),
+                                  source_tb) < 0) {
+        goto finally;
+    }
+    res = PyObject_CallMethodOneArg(loop, &_Py_ID(call_exception_handler),
+                                    context);
+
+finally:
+    Py_DECREF(callback);
+    Py_DECREF(args);
+    Py_DECREF(loop);
+    Py_DECREF(source_tb);
+    Py_XDECREF(cb);
+    Py_XDECREF(message);
+    Py_XDECREF(context);
     if (res == NULL) {
-        return NULL;
+        return -1;
     }
     Py_DECREF(res);
-    Py_RETURN_NONE;
+    return 0;
 }
 
-/*[clinic input]
-_asyncio._unregister_eager_task
-
-    task: object
-
-Unregister a task.
-
-Returns None.
-[clinic start generated code]*/
-
 static PyObject *
-_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=a426922bd07f23d1 input=9d07401ef14ee048]*/
+call_with_args(PyObject *callback, PyObject *args)
 {
-    asyncio_state *state = get_asyncio_state(module);
-    if (Task_Check(state, task)) {
-        // task is an asyncio.Task instance or subclass, use efficient
-        // linked-list implementation.
-        unregister_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    if (PyTuple_CheckExact(args)) {
+        return PyObject_Vectorcall(callback, _PyTuple_ITEMS(args),
+                                   PyTuple_GET_SIZE(args), NULL);
     }
-
-    if (PySet_Discard(state->non_asyncio_eager_tasks, task) < 0) {
+    PyObject *tuple = PySequence_Tuple(args);
+    if (tuple == NULL) {
         return NULL;
     }
-
-    Py_RETURN_NONE;
+    PyObject *res = PyObject_Call(callback, tuple, NULL);
+    Py_DECREF(tuple);
+    return res;
 }
 
+/* Implementation of Handle._run(): call the callback in the context of
+   the handle and pass its exceptions to the exception handler of the
+   loop. */
+static PyObject *
+handle_run(asyncio_state *state, HandleObj *h)
+{
+    PyObject *self = (PyObject *)h;
+    PyObject *callback = get_field_or_none(self, &h->h_callback);
+    PyObject *args = get_field_or_none(self, &h->h_args);
+    PyObject *context = get_field_or_none(self, &h->h_context);
+    PyObject *res;
+
+    if (PyContext_CheckExact(context)) {
+        /* Same as context.run(callback, *args) */
+        if (PyContext_Enter(context) < 0) {
+            res = NULL;
+        }
+        else {
+            res = call_with_args(callback, args);
+            if (PyContext_Exit(context) < 0) {
+                Py_CLEAR(res);
+            }
+        }
+    }
+    else {
+        PyObject *tuple = PySequence_Tuple(args);
+        if (tuple == NULL) {
+            res = NULL;
+        }
+        else {
+            Py_ssize_t n = PyTuple_GET_SIZE(tuple);
+            PyObject *run_args = PyTuple_New(n + 1);
+            if (run_args == NULL) {
+                res = NULL;
+            }
+            else {
+                PyTuple_SET_ITEM(run_args, 0, Py_NewRef(callback));
+                for (Py_ssize_t i = 0; i < n; i++) {
+                    PyTuple_SET_ITEM(run_args, i + 1,
+                                     Py_NewRef(PyTuple_GET_ITEM(tuple, i)));
+                }
+                PyObject *run = PyObject_GetAttr(context, &_Py_ID(run));
+                res = run ? PyObject_Call(run, run_args, NULL) : NULL;
+                Py_XDECREF(run);
+                Py_DECREF(run_args);
+            }
+            Py_DECREF(tuple);
+        }
+    }
+    Py_DECREF(callback);
+    Py_DECREF(args);
+    Py_DECREF(context);
+
+    if (res != NULL) {
+        Py_DECREF(res);
+        Py_RETURN_NONE;
+    }
+    if (PyErr_ExceptionMatches(PyExc_SystemExit) ||
+        PyErr_ExceptionMatches(PyExc_KeyboardInterrupt)) {
+        return NULL;
+    }
+    PyObject *exc = PyErr_GetRaisedException();
+    int err = handle_call_exception_handler(state, h, exc);
+    Py_DECREF(exc);
+    if (err < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+handle_repr_info(asyncio_state *state, HandleObj *h)
+{
+    PyObject *self = (PyObject *)h;
+    PyObject *callback = get_field_or_none(self, &h->h_callback);
+    PyObject *args = get_field_or_none(self, &h->h_args);
+    PyObject *loop = get_field_or_none(self, &h->h_loop);
+    PyObject *source_tb = get_field_or_none(self, &h->h_source_tb);
+    PyObject *info = NULL, *item = NULL;
+    int is_true;
+
+    info = PyList_New(0);
+    if (info == NULL) {
+        goto error;
+    }
+    item = PyType_GetName(Py_TYPE(self));
+    if (item == NULL || _PyList_AppendTakeRef((PyListObject *)info,
+                                              item) < 0) {
+        goto error;
+    }
+    if (FT_ATOMIC_LOAD_CHAR_RELAXED(h->h_cancelled) &&
+        PyList_Append(info, &_Py_ID(cancelled)) < 0) {
+        goto error;
+    }
+    if (callback != Py_None) {
+        item = format_callback_source(state, loop, callback, args);
+        if (item == NULL || _PyList_AppendTakeRef((PyListObject *)info,
+                                                  item) < 0) {
+            goto error;
+        }
+    }
+    is_true = PyObject_IsTrue(source_tb);
+    if (is_true < 0) {
+        goto error;
+    }
+    if (is_true) {
+        PyObject *frame = PySequence_GetItem(source_tb, -1);
+        if (frame == NULL) {
+            goto error;
+        }
+        PyObject *filename = PySequence_GetItem(frame, 0);
+        PyObject *lineno = filename ? PySequence_GetItem(frame, 1) : NULL;
+        Py_DECREF(frame);
+        if (lineno == NULL) {
+            Py_XDECREF(filename);
+            goto error;
+        }
+        item = PyUnicode_FromFormat("created at %S:%S", filename, lineno);
+        Py_DECREF(filename);
+        Py_DECREF(lineno);
+        if (item == NULL || _PyList_AppendTakeRef((PyListObject *)info,
+                                                  item) < 0) {
+            goto error;
+        }
+    }
+    Py_DECREF(callback);
+    Py_DECREF(args);
+    Py_DECREF(loop);
+    Py_DECREF(source_tb);
+    return info;
+
+error:
+    Py_DECREF(callback);
+    Py_DECREF(args);
+    Py_DECREF(loop);
+    Py_DECREF(source_tb);
+    Py_XDECREF(info);
+    return NULL;
+}
+
+static int
+handle_cancel(HandleObj *h)
+{
+    PyObject *self = (PyObject *)h;
+    int cancelled;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    cancelled = h->h_cancelled;
+    FT_ATOMIC_STORE_CHAR_RELAXED(h->h_cancelled, 1);
+    Py_END_CRITICAL_SECTION();
+    if (cancelled) {
+        return 0;
+    }
+
+    PyObject *loop = get_field_or_none(self, &h->h_loop);
+    PyObject *res = PyObject_CallMethodNoArgs(loop, &_Py_ID(get_debug));
+    Py_DECREF(loop);
+    if (res == NULL) {
+        return -1;
+    }
+    int is_true = PyObject_IsTrue(res);
+    Py_DECREF(res);
+    if (is_true < 0) {
+        return -1;
+    }
+    if (is_true) {
+        /* Keep a representation in debug mode to keep callback and
+           parameters. For example, to log the warning
+           "Executing <Handle...> took 2.5 second" */
+        PyObject *repr = PyObject_Repr(self);
+        if (repr == NULL) {
+            return -1;
+        }
+        set_field(self, &h->h_repr, repr);
+        Py_DECREF(repr);
+    }
+    set_field(self, &h->h_callback, Py_None);
+    set_field(self, &h->h_args, Py_None);
+    return 0;
+}
+
+/* ----- Handle */
+
+/*[clinic input]
+_asyncio.Handle.__init__
+
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context)
+/*[clinic end generated code: output=40a28e55725495e2 input=c0d847a7bc9e878f]*/
+{
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    return handle_init(state, self, callback, args, loop, context);
+}
+
+/*[clinic input]
+_asyncio.Handle._repr_info
+
+    cls: defining_class
+    /
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self, PyTypeObject *cls)
+/*[clinic end generated code: output=f14bddd49ef2fd4f input=3c16268d8be9861f]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    return handle_repr_info(state, self);
+}
+
+static PyObject *
+HandleObj_repr(PyObject *op)
+{
+    HandleObj *h = (HandleObj *)op;
+    PyObject *repr = get_field_or_none(op, &h->h_repr);
+    if (repr != Py_None) {
+        return repr;
+    }
+    Py_DECREF(repr);
+
+    PyObject *info = PyObject_CallMethodNoArgs(op, &_Py_ID(_repr_info));
+    if (info == NULL) {
+        return NULL;
+    }
+    PyObject *joined = PyUnicode_Join(_Py_LATIN1_CHR(' '), info);
+    Py_DECREF(info);
+    if (joined == NULL) {
+        return NULL;
+    }
+    repr = PyUnicode_FromFormat("<%U>", joined);
+    Py_DECREF(joined);
+    return repr;
+}
+
+/*[clinic input]
+_asyncio.Handle.get_context
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_get_context_impl(HandleObj *self)
+/*[clinic end generated code: output=533e37d94822a513 input=4f74b0143c38809e]*/
+{
+    return get_field_or_none((PyObject *)self, &self->h_context);
+}
+
+/*[clinic input]
+_asyncio.Handle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self)
+/*[clinic end generated code: output=ddb39234782aab82 input=eaa3eb93236f622f]*/
+{
+    if (handle_cancel(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.Handle.cancelled
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self)
+/*[clinic end generated code: output=0f4ad57f569e9f24 input=14a55098bea1b40a]*/
+{
+    return PyBool_FromLong(FT_ATOMIC_LOAD_CHAR_RELAXED(self->h_cancelled));
+}
+
+/*[clinic input]
+_asyncio.Handle._run
+
+    cls: defining_class
+    /
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self, PyTypeObject *cls)
+/*[clinic end generated code: output=bca0bd6b15113f86 input=9f87b20cd5454d89]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    return handle_run(state, self);
+}
+
+static int
+HandleObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    HandleObj *h = (HandleObj *)op;
+    Py_VISIT(Py_TYPE(h));
+    Py_VISIT(h->h_callback);
+    Py_VISIT(h->h_args);
+    Py_VISIT(h->h_loop);
+    Py_VISIT(h->h_context);
+    Py_VISIT(h->h_source_tb);
+    Py_VISIT(h->h_repr);
+    return 0;
+}
+
+static int
+HandleObj_clear(PyObject *op)
+{
+    HandleObj *h = (HandleObj *)op;
+    Py_CLEAR(h->h_callback);
+    Py_CLEAR(h->h_args);
+    Py_CLEAR(h->h_loop);
+    Py_CLEAR(h->h_context);
+    Py_CLEAR(h->h_source_tb);
+    Py_CLEAR(h->h_repr);
+    return 0;
+}
+
+static void
+HandleObj_dealloc(PyObject *op)
+{
+    PyTypeObject *tp = Py_TYPE(op);
+    PyObject_GC_UnTrack(op);
+    PyObject_ClearWeakRefs(op);
+    (void)HandleObj_clear(op);
+    tp->tp_free(op);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef Handle_methods[] = {
+    _ASYNCIO_HANDLE__REPR_INFO_METHODDEF
+    _ASYNCIO_HANDLE_GET_CONTEXT_METHODDEF
+    _ASYNCIO_HANDLE_CANCEL_METHODDEF
+    _ASYNCIO_HANDLE_CANCELLED_METHODDEF
+    _ASYNCIO_HANDLE__RUN_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyMemberDef Handle_members[] = {
+    {"_callback", Py_T_OBJECT_EX, offsetof(HandleObj, h_callback), 0, NULL},
+    {"_args", Py_T_OBJECT_EX, offsetof(HandleObj, h_args), 0, NULL},
+    {"_cancelled", Py_T_BOOL, offsetof(HandleObj, h_cancelled), 0, NULL},
+    {"_loop", Py_T_OBJECT_EX, offsetof(HandleObj, h_loop), 0, NULL},
+    {"_source_traceback", Py_T_OBJECT_EX,
+     offsetof(HandleObj, h_source_tb), 0, NULL},
+    {"_repr", Py_T_OBJECT_EX, offsetof(HandleObj, h_repr), 0, NULL},
+    {"_context", Py_T_OBJECT_EX, offsetof(HandleObj, h_context), 0, NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyType_Slot Handle_slots[] = {
+    {Py_tp_dealloc, HandleObj_dealloc},
+    {Py_tp_repr, HandleObj_repr},
+    {Py_tp_doc, (void *)_asyncio_Handle___init____doc__},
+    {Py_tp_traverse, HandleObj_traverse},
+    {Py_tp_clear, HandleObj_clear},
+    {Py_tp_methods, Handle_methods},
+    {Py_tp_members, Handle_members},
+    {Py_tp_init, _asyncio_Handle___init__},
+    {Py_tp_new, PyType_GenericNew},
+    {0, NULL},
+};
+
+static PyType_Spec Handle_spec = {
+    .name = "_asyncio.Handle",
+    .basicsize = sizeof(HandleObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE |
+              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_MANAGED_WEAKREF),
+    .slots = Handle_slots,
+};
+
+/* ----- TimerHandle */
+
+/*[clinic input]
+_asyncio.TimerHandle.__init__
+
+    when: object
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by timed callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context)
+/*[clinic end generated code: output=0d98475472bfab93 input=ec6d223ba9888cec]*/
+{
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    if (handle_init(state, (HandleObj *)self, callback, args, loop,
+                    context) < 0) {
+        return -1;
+    }
+    set_field((PyObject *)self, &self->th_when, when);
+    FT_ATOMIC_STORE_CHAR_RELAXED(self->th_scheduled, 0);
+    return 0;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle._repr_info
+
+    cls: defining_class
+    /
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self, PyTypeObject *cls)
+/*[clinic end generated code: output=45372c5f5c3c5d57 input=aa51cacdebdf8a51]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    PyObject *info = handle_repr_info(state, (HandleObj *)self);
+    if (info == NULL) {
+        return NULL;
+    }
+    Py_ssize_t pos = FT_ATOMIC_LOAD_CHAR_RELAXED(self->th_cancelled) ? 2 : 1;
+    PyObject *when = get_field_or_none((PyObject *)self, &self->th_when);
+    PyObject *item = PyUnicode_FromFormat("when=%S", when);
+    Py_DECREF(when);
+    if (item == NULL || PyList_Insert(info, pos, item) < 0) {
+        Py_XDECREF(item);
+        Py_DECREF(info);
+        return NULL;
+    }
+    Py_DECREF(item);
+    return info;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=315df6426e6662ff input=529996fd507bb125]*/
+{
+    if (!FT_ATOMIC_LOAD_CHAR_RELAXED(self->th_cancelled)) {
+        PyObject *loop = get_field_or_none((PyObject *)self, &self->th_loop);
+        PyObject *res = PyObject_CallMethodOneArg(
+            loop, &_Py_ID(_timer_handle_cancelled), (PyObject *)self);
+        Py_DECREF(loop);
+        if (res == NULL) {
+            return NULL;
+        }
+        Py_DECREF(res);
+    }
+    if (handle_cancel((HandleObj *)self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle.when
+
+Return a scheduled callback time.
+
+The time is an absolute timestamp, using the same time
+reference as loop.time().
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=cab0e5577e51b3af input=de801fd191075931]*/
+{
+    return get_field_or_none((PyObject *)self, &self->th_when);
+}
+
+static Py_hash_t
+TimerHandleObj_hash(PyObject *op)
+{
+    TimerHandleObj *th = (TimerHandleObj *)op;
+    PyObject *when = get_field_or_none(op, &th->th_when);
+    Py_hash_t res = PyObject_Hash(when);
+    Py_DECREF(when);
+    return res;
+}
+
+/* Compare the times of two timer handles with Py_LT or Py_GT. */
+static PyObject *
+timer_handle_compare_when(TimerHandleObj *a, TimerHandleObj *b, int op)
+{
+    PyObject *res;
+    PyObject *wa = get_field_or_none((PyObject *)a, &a->th_when);
+    PyObject *wb = get_field_or_none((PyObject *)b, &b->th_when);
+    if (PyFloat_CheckExact(wa) && PyFloat_CheckExact(wb)) {
+        /* Fast path for loop.time() values, used by the heap of
+           scheduled callbacks. */
+        double x = PyFloat_AS_DOUBLE(wa);
+        double y = PyFloat_AS_DOUBLE(wb);
+        res = PyBool_FromLong(op == Py_LT ? x < y : x > y);
+    }
+    else {
+        res = PyObject_RichCompare(wa, wb, op);
+    }
+    Py_DECREF(wa);
+    Py_DECREF(wb);
+    return res;
+}
+
+/* The result of self.__eq__(other) for a timer handle other. */
+static PyObject *
+timer_handle_eq(asyncio_state *state, TimerHandleObj *a, TimerHandleObj *b)
+{
+    PyObject *self = (PyObject *)a;
+    PyObject *other = (PyObject *)b;
+    if (!TimerHandle_CheckExact(state, self)) {
+        return PyObject_CallMethodOneArg(self, &_Py_ID(__eq__), other);
+    }
+
+    /* self._when == other._when and self._callback == other._callback
+       and self._args == other._args
+       and self._cancelled == other._cancelled */
+    PyObject **fields[][2] = {
+        {&a->th_when, &b->th_when},
+        {&a->th_callback, &b->th_callback},
+        {&a->th_args, &b->th_args},
+    };
+    for (size_t i = 0; i < Py_ARRAY_LENGTH(fields); i++) {
+        PyObject *x = get_field_or_none(self, fields[i][0]);
+        PyObject *y = get_field_or_none(other, fields[i][1]);
+        PyObject *res = PyObject_RichCompare(x, y, Py_EQ);
+        Py_DECREF(x);
+        Py_DECREF(y);
+        if (res == NULL) {
+            return NULL;
+        }
+        int is_true = PyObject_IsTrue(res);
+        if (is_true <= 0) {
+            /* The false operand is the result of "and". */
+            if (is_true < 0) {
+                Py_CLEAR(res);
+            }
+            return res;
+        }
+        Py_DECREF(res);
+    }
+    return PyBool_FromLong(FT_ATOMIC_LOAD_CHAR_RELAXED(a->th_cancelled) ==
+                           FT_ATOMIC_LOAD_CHAR_RELAXED(b->th_cancelled));
+}
+
+static PyObject *
+TimerHandleObj_richcompare(PyObject *self, PyObject *other, int op)
+{
+    asyncio_state *state = get_asyncio_state_by_def(self);
+    if (!Py_IS_TYPE(other, Py_TYPE(self)) &&
+        !PyObject_TypeCheck(other, state->TimerHandleType)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    TimerHandleObj *a = (TimerHandleObj *)self;
+    TimerHandleObj *b = (TimerHandleObj *)other;
+    PyObject *res;
+    int is_true;
+
+    switch (op) {
+    case Py_LT:
+    case Py_GT:
+        return timer_handle_compare_when(a, b, op);
+    case Py_LE:
+    case Py_GE:
+        /* self._when < other._when or self.__eq__(other) */
+        res = timer_handle_compare_when(a, b, op == Py_LE ? Py_LT : Py_GT);
+        if (res == NULL) {
+            return NULL;
+        }
+        is_true = PyObject_IsTrue(res);
+        if (is_true != 0) {
+            if (is_true < 0) {
+                Py_CLEAR(res);
+            }
+            return res;
+        }
+        Py_DECREF(res);
+        return timer_handle_eq(state, a, b);
+    case Py_EQ:
+        return timer_handle_eq(state, a, b);
+    case Py_NE:
+        /* Like object.__ne__(), invert the result of __eq__(). */
+        res = timer_handle_eq(state, a, b);
+        if (res == NULL || res == Py_NotImplemented) {
+            return res;
+        }
+        is_true = PyObject_IsTrue(res);
+        Py_DECREF(res);
+        if (is_true < 0) {
+            return NULL;
+        }
+        return PyBool_FromLong(!is_true);
+    default:
+        Py_UNREACHABLE();
+    }
+}
+
+static int
+TimerHandleObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    TimerHandleObj *th = (TimerHandleObj *)op;
+    Py_VISIT(th->th_when);
+    return HandleObj_traverse(op, visit, arg);
+}
+
+static int
+TimerHandleObj_clear(PyObject *op)
+{
+    TimerHandleObj *th = (TimerHandleObj *)op;
+    Py_CLEAR(th->th_when);
+    return HandleObj_clear(op);
+}
+
+static void
+TimerHandleObj_dealloc(PyObject *op)
+{
+    PyTypeObject *tp = Py_TYPE(op);
+    PyObject_GC_UnTrack(op);
+    PyObject_ClearWeakRefs(op);
+    (void)TimerHandleObj_clear(op);
+    tp->tp_free(op);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef TimerHandle_methods[] = {
+    _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF
+    _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF
+    _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyMemberDef TimerHandle_members[] = {
+    {"_scheduled", Py_T_BOOL, offsetof(TimerHandleObj, th_scheduled), 0, NULL},
+    {"_when", Py_T_OBJECT_EX, offsetof(TimerHandleObj, th_when), 0, NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyType_Slot TimerHandle_slots[] = {
+    {Py_tp_dealloc, TimerHandleObj_dealloc},
+    {Py_tp_doc, (void *)_asyncio_TimerHandle___init____doc__},
+    {Py_tp_hash, TimerHandleObj_hash},
+    {Py_tp_richcompare, TimerHandleObj_richcompare},
+    {Py_tp_traverse, TimerHandleObj_traverse},
+    {Py_tp_clear, TimerHandleObj_clear},
+    {Py_tp_methods, TimerHandle_methods},
+    {Py_tp_members, TimerHandle_members},
+    {Py_tp_init, _asyncio_TimerHandle___init__},
+    {0, NULL},
+};
+
+static PyType_Spec TimerHandle_spec = {
+    .name = "_asyncio.TimerHandle",
+    .basicsize = sizeof(TimerHandleObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = TimerHandle_slots,
+};
+
+
+/*********************** Event loop core **************************/
+
+
+/*[clinic input]
+class _asyncio._EventLoopCore "EventLoopCoreObj *" "&EventLoopCore_Type"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=40797fec8e74b941]*/
+
+/* Same as _MIN_SCHEDULED_TIMER_HANDLES,
+   _MIN_CANCELLED_TIMER_HANDLES_FRACTION and MAXIMUM_SELECT_TIMEOUT
+   in asyncio.base_events. */
+#define MIN_SCHEDULED_TIMER_HANDLES 100
+#define MIN_CANCELLED_TIMER_HANDLES_FRACTION 0.5
+#define MAXIMUM_SELECT_TIMEOUT (24 * 3600)
+
+/* Return a new reference to an attribute of the loop stored in its C
+   struct, or raise AttributeError if it has not been set. */
+static PyObject *
+loop_core_get(EventLoopCoreObj *self, PyObject **field, const char *name)
+{
+    PyObject *res;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    res = Py_XNewRef(*field);
+    Py_END_CRITICAL_SECTION();
+    if (res == NULL) {
+        PyErr_Format(PyExc_AttributeError,
+                     "'%T' object has no attribute '%s'", self, name);
+    }
+    return res;
+}
+
+#define LOOP_CORE_GET(self, NAME) \
+    loop_core_get(self, &(self)->lc_##NAME, "_" #NAME)
+
+/* Return the truth value of an attribute stored in the C struct. */
+static int
+loop_core_is_true(EventLoopCoreObj *self, PyObject **field, const char *name)
+{
+    PyObject *value = loop_core_get(self, field, name);
+    if (value == NULL) {
+        return -1;
+    }
+    int res = PyObject_IsTrue(value);
+    Py_DECREF(value);
+    return res;
+}
+
+#define LOOP_CORE_IS_TRUE(self, NAME) \
+    loop_core_is_true(self, &(self)->lc_##NAME, "_" #NAME)
+
+/* The checks done by call_soon() and call_at() before scheduling
+   a callback: see BaseEventLoop._check_closed(), _check_thread() and
+   _check_callback(). */
+static int
+loop_core_check_callback(EventLoopCoreObj *self, PyObject *callback,
+                         PyObject *method)
+{
+    int is_true = LOOP_CORE_IS_TRUE(self, closed);
+    if (is_true < 0) {
+        return -1;
+    }
+    if (is_true) {
+        PyErr_SetString(PyExc_RuntimeError, "Event loop is closed");
+        return -1;
+    }
+    is_true = LOOP_CORE_IS_TRUE(self, debug);
+    if (is_true <= 0) {
+        return is_true;
+    }
+    PyObject *res = PyObject_CallMethodNoArgs((PyObject *)self,
+                                              &_Py_ID(_check_thread));
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    res = PyObject_CallMethodObjArgs((PyObject *)self,
+                                     &_Py_ID(_check_callback),
+                                     callback, method, NULL);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+/* self._ready.append(handle) */
+static int
+loop_core_append_ready(EventLoopCoreObj *self, PyObject *handle)
+{
+    PyObject *ready = LOOP_CORE_GET(self, ready);
+    if (ready == NULL) {
+        return -1;
+    }
+    PyObject *res = PyObject_CallMethodOneArg(ready, &_Py_ID(append), handle);
+    Py_DECREF(ready);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+static PyObject *
+loop_core_call_soon(asyncio_state *state, EventLoopCoreObj *self,
+                    PyObject *callback, PyObject *args, PyObject *context)
+{
+    PyObject *handle = new_handle(state, callback, args, (PyObject *)self,
+                                  context);
+    if (handle == NULL) {
+        return NULL;
+    }
+    if (loop_core_append_ready(self, handle) < 0) {
+        Py_DECREF(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore.get_debug
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore_get_debug_impl(EventLoopCoreObj *self)
+/*[clinic end generated code: output=e4c977d4efcd38cf input=4f4cffc17d9f7f87]*/
+{
+    return LOOP_CORE_GET(self, debug);
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore.call_later
+
+    cls: defining_class
+    delay: object
+    callback: object
+    *args: tuple
+    context: object = None
+
+Arrange for a callback to be called at a given time.
+
+Return a Handle: an opaque object with a cancel() method that
+can be used to cancel the call.
+
+The delay can be an int or float, expressed in seconds.  It is
+always relative to the current time.
+
+Each callback will be called exactly once.  If two callbacks
+are scheduled for exactly the same time, it is undefined which
+will be called first.
+
+Any positional arguments after the callback will be passed to
+the callback when it is called.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore_call_later_impl(EventLoopCoreObj *self,
+                                        PyTypeObject *cls, PyObject *delay,
+                                        PyObject *callback, PyObject *args,
+                                        PyObject *context)
+/*[clinic end generated code: output=223b0bea3a142a2a input=92d1bd2146c6d9d7]*/
+{
+    if (delay == Py_None) {
+        PyErr_SetString(PyExc_TypeError, "delay must not be None");
+        return NULL;
+    }
+    PyObject *now = PyObject_CallMethodNoArgs((PyObject *)self,
+                                              &_Py_ID(time));
+    if (now == NULL) {
+        return NULL;
+    }
+    PyObject *when = PyNumber_Add(now, delay);
+    Py_DECREF(now);
+    if (when == NULL) {
+        return NULL;
+    }
+
+    /* self.call_at(when, callback, *args, context=context) */
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    PyObject *small_stack[8];
+    PyObject **stack = small_stack;
+    if (nargs + 4 > (Py_ssize_t)Py_ARRAY_LENGTH(small_stack)) {
+        stack = PyMem_New(PyObject *, nargs + 4);
+        if (stack == NULL) {
+            Py_DECREF(when);
+            return PyErr_NoMemory();
+        }
+    }
+    stack[0] = (PyObject *)self;
+    stack[1] = when;
+    stack[2] = callback;
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+        stack[i + 3] = PyTuple_GET_ITEM(args, i);
+    }
+    stack[nargs + 3] = context;
+    PyObject *timer = PyObject_VectorcallMethod(
+        &_Py_ID(call_at), stack, nargs + 3, state->context_kwname);
+    if (stack != small_stack) {
+        PyMem_Free(stack);
+    }
+    Py_DECREF(when);
+    return timer;
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore.call_at
+
+    cls: defining_class
+    when: object
+    callback: object
+    *args: tuple
+    context: object = None
+
+Like call_later(), but uses an absolute time.
+
+Absolute time corresponds to the event loop's time() method.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore_call_at_impl(EventLoopCoreObj *self,
+                                     PyTypeObject *cls, PyObject *when,
+                                     PyObject *callback, PyObject *args,
+                                     PyObject *context)
+/*[clinic end generated code: output=f3ee4ef78407ec81 input=abd361521e1dd85c]*/
+{
+    if (when == Py_None) {
+        PyErr_SetString(PyExc_TypeError, "when cannot be None");
+        return NULL;
+    }
+    if (loop_core_check_callback(self, callback, &_Py_ID(call_at)) < 0) {
+        return NULL;
+    }
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    PyObject *timer = new_timer_handle(state, when, callback, args,
+                                       (PyObject *)self, context);
+    if (timer == NULL) {
+        return NULL;
+    }
+    PyObject *scheduled = LOOP_CORE_GET(self, scheduled);
+    if (scheduled == NULL) {
+        Py_DECREF(timer);
+        return NULL;
+    }
+    PyObject *res = PyObject_CallFunctionObjArgs(state->heapq_heappush,
+                                                 scheduled, timer, NULL);
+    Py_DECREF(scheduled);
+    if (res == NULL) {
+        Py_DECREF(timer);
+        return NULL;
+    }
+    Py_DECREF(res);
+    FT_ATOMIC_STORE_CHAR_RELAXED(((TimerHandleObj *)timer)->th_scheduled, 1);
+    return timer;
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore.call_soon
+
+    cls: defining_class
+    callback: object
+    *args: tuple
+    context: object = None
+
+Arrange for a callback to be called as soon as possible.
+
+This operates as a FIFO queue: callbacks are called in the
+order in which they are registered.  Each callback will be
+called exactly once.
+
+Any positional arguments after the callback will be passed to
+the callback when it is called.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore_call_soon_impl(EventLoopCoreObj *self,
+                                       PyTypeObject *cls, PyObject *callback,
+                                       PyObject *args, PyObject *context)
+/*[clinic end generated code: output=5dc1b6996d730ae1 input=53accd7e4a0027d0]*/
+{
+    if (loop_core_check_callback(self, callback, &_Py_ID(call_soon)) < 0) {
+        return NULL;
+    }
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    return loop_core_call_soon(state, self, callback, args, context);
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore._call_soon
+
+    cls: defining_class
+    callback: object
+    args: object
+    context: object
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore__call_soon_impl(EventLoopCoreObj *self,
+                                        PyTypeObject *cls,
+                                        PyObject *callback, PyObject *args,
+                                        PyObject *context)
+/*[clinic end generated code: output=2aa660d5ba863b4e input=45bf8aafe6d2cc58]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    return loop_core_call_soon(state, self, callback, args, context);
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore._add_callback
+
+    cls: defining_class
+    handle: object
+    /
+
+Add a Handle to _ready.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore__add_callback_impl(EventLoopCoreObj *self,
+                                           PyTypeObject *cls,
+                                           PyObject *handle)
+/*[clinic end generated code: output=aaa04221da9dd1b4 input=068230fa18d3d511]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    int cancelled = handle_is_cancelled(state, handle);
+    if (cancelled < 0) {
+        return NULL;
+    }
+    if (!cancelled && loop_core_append_ready(self, handle) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore._timer_handle_cancelled
+
+    cls: defining_class
+    handle: object
+    /
+
+Notification that a TimerHandle has been cancelled.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore__timer_handle_cancelled_impl(EventLoopCoreObj *self,
+                                                     PyTypeObject *cls,
+                                                     PyObject *handle)
+/*[clinic end generated code: output=de6d23e051bb6802 input=b85a35aa560be481]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    int scheduled;
+    if (TimerHandle_CheckExact(state, handle)) {
+        scheduled = FT_ATOMIC_LOAD_CHAR_RELAXED(
+            ((TimerHandleObj *)handle)->th_scheduled);
+    }
+    else {
+        PyObject *value = PyObject_GetAttr(handle, &_Py_ID(_scheduled));
+        if (value == NULL) {
+            return NULL;
+        }
+        scheduled = PyObject_IsTrue(value);
+        Py_DECREF(value);
+        if (scheduled < 0) {
+            return NULL;
+        }
+    }
+    if (scheduled) {
+        Py_BEGIN_CRITICAL_SECTION(self);
+        self->lc_timer_cancelled_count++;
+        Py_END_CRITICAL_SECTION();
+    }
+    Py_RETURN_NONE;
+}
+
+/* Remove the cancelled timers from self._scheduled. */
+static int
+loop_core_remove_cancelled(asyncio_state *state, EventLoopCoreObj *self)
+{
+    PyObject *scheduled = LOOP_CORE_GET(self, scheduled);
+    if (scheduled == NULL) {
+        return -1;
+    }
+    Py_ssize_t sched_count = PyObject_Length(scheduled);
+    if (sched_count < 0) {
+        goto error;
+    }
+    Py_ssize_t cancelled_count;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    cancelled_count = self->lc_timer_cancelled_count;
+    Py_END_CRITICAL_SECTION();
+
+    if (sched_count > MIN_SCHEDULED_TIMER_HANDLES &&
+        (double)cancelled_count / sched_count >
+            MIN_CANCELLED_TIMER_HANDLES_FRACTION)
+    {
+        /* Remove delayed calls that were cancelled if their number
+           is too high */
+        PyObject *new_scheduled = PyList_New(0);
+        if (new_scheduled == NULL) {
+            goto error;
+        }
+        PyObject *it = PyObject_GetIter(scheduled);
+        if (it == NULL) {
+            Py_DECREF(new_scheduled);
+            goto error;
+        }
+        PyObject *handle;
+        while ((handle = PyIter_Next(it)) != NULL) {
+            int cancelled = handle_is_cancelled(state, handle);
+            if (cancelled < 0 ||
+                (cancelled ?
+                 timer_handle_set_scheduled(state, handle, 0) :
+                 PyList_Append(new_scheduled, handle)) < 0)
+            {
+                Py_DECREF(handle);
+                break;
+            }
+            Py_DECREF(handle);
+        }
+        Py_DECREF(it);
+        if (PyErr_Occurred()) {
+            Py_DECREF(new_scheduled);
+            goto error;
+        }
+        PyObject *res = PyObject_CallOneArg(state->heapq_heapify,
+                                            new_scheduled);
+        if (res == NULL) {
+            Py_DECREF(new_scheduled);
+            goto error;
+        }
+        Py_DECREF(res);
+        set_field((PyObject *)self, &self->lc_scheduled, new_scheduled);
+        Py_DECREF(new_scheduled);
+        Py_BEGIN_CRITICAL_SECTION(self);
+        self->lc_timer_cancelled_count = 0;
+        Py_END_CRITICAL_SECTION();
+    }
+    else {
+        /* Remove delayed calls that were cancelled from head of queue. */
+        while (1) {
+            Py_ssize_t size = PyObject_Length(scheduled);
+            if (size < 0) {
+                goto error;
+            }
+            if (size == 0) {
+                break;
+            }
+            PyObject *head = PySequence_GetItem(scheduled, 0);
+            if (head == NULL) {
+                goto error;
+            }
+            int cancelled = handle_is_cancelled(state, head);
+            Py_DECREF(head);
+            if (cancelled < 0) {
+                goto error;
+            }
+            if (!cancelled) {
+                break;
+            }
+            Py_BEGIN_CRITICAL_SECTION(self);
+            self->lc_timer_cancelled_count--;
+            Py_END_CRITICAL_SECTION();
+            head = PyObject_CallOneArg(state->heapq_heappop, scheduled);
+            if (head == NULL) {
+                goto error;
+            }
+            int err = timer_handle_set_scheduled(state, head, 0);
+            Py_DECREF(head);
+            if (err < 0) {
+                goto error;
+            }
+        }
+    }
+    Py_DECREF(scheduled);
+    return 0;
+
+error:
+    Py_DECREF(scheduled);
+    return -1;
+}
+
+/* Return the timeout to poll for I/O events with. */
+static PyObject *
+loop_core_select_timeout(asyncio_state *state, EventLoopCoreObj *self)
+{
+    int is_true = LOOP_CORE_IS_TRUE(self, ready);
+    if (is_true == 0) {
+        is_true = LOOP_CORE_IS_TRUE(self, stopping);
+    }
+    if (is_true < 0) {
+        return NULL;
+    }
+    if (is_true) {
+        return PyLong_FromLong(0);
+    }
+
+    PyObject *scheduled = LOOP_CORE_GET(self, scheduled);
+    if (scheduled == NULL) {
+        return NULL;
+    }
+    is_true = PyObject_IsTrue(scheduled);
+    if (is_true <= 0) {
+        Py_DECREF(scheduled);
+        return is_true < 0 ? NULL : Py_NewRef(Py_None);
+    }
+
+    /* Compute the desired timeout. */
+    PyObject *head = PySequence_GetItem(scheduled, 0);
+    Py_DECREF(scheduled);
+    if (head == NULL) {
+        return NULL;
+    }
+    PyObject *when = timer_handle_get_when(state, head);
+    Py_DECREF(head);
+    if (when == NULL) {
+        return NULL;
+    }
+    PyObject *now = PyObject_CallMethodNoArgs((PyObject *)self,
+                                              &_Py_ID(time));
+    if (now == NULL) {
+        Py_DECREF(when);
+        return NULL;
+    }
+    PyObject *timeout = PyNumber_Subtract(when, now);
+    Py_DECREF(when);
+    Py_DECREF(now);
+    if (timeout == NULL) {
+        return NULL;
+    }
+
+    PyObject *limit = PyLong_FromLong(MAXIMUM_SELECT_TIMEOUT);
+    if (limit == NULL) {
+        Py_DECREF(timeout);
+        return NULL;
+    }
+    is_true = PyObject_RichCompareBool(timeout, limit, Py_GT);
+    if (is_true > 0) {
+        Py_SETREF(timeout, limit);
+        return timeout;
+    }
+    Py_DECREF(limit);
+    if (is_true == 0) {
+        PyObject *zero = PyLong_FromLong(0);
+        is_true = PyObject_RichCompareBool(timeout, zero, Py_LT);
+        if (is_true > 0) {
+            Py_SETREF(timeout, zero);
+            return timeout;
+        }
+        Py_DECREF(zero);
+    }
+    if (is_true < 0) {
+        Py_CLEAR(timeout);
+    }
+    return timeout;
+}
+
+/* Move the timers which are due from self._scheduled to self._ready. */
+static int
+loop_core_schedule_due_timers(asyncio_state *state, EventLoopCoreObj *self)
+{
+    PyObject *scheduled = NULL, *end_time = NULL;
+    PyObject *now = PyObject_CallMethodNoArgs((PyObject *)self,
+                                              &_Py_ID(time));
+    if (now == NULL) {
+        return -1;
+    }
+    PyObject *resolution = LOOP_CORE_GET(self, clock_resolution);
+    if (resolution == NULL) {
+        Py_DECREF(now);
+        return -1;
+    }
+    end_time = PyNumber_Add(now, resolution);
+    Py_DECREF(now);
+    Py_DECREF(resolution);
+    if (end_time == NULL) {
+        return -1;
+    }
+    scheduled = LOOP_CORE_GET(self, scheduled);
+    if (scheduled == NULL) {
+        goto error;
+    }
+
+    while (1) {
+        Py_ssize_t size = PyObject_Length(scheduled);
+        if (size < 0) {
+            goto error;
+        }
+        if (size == 0) {
+            break;
+        }
+        PyObject *handle = PySequence_GetItem(scheduled, 0);
+        if (handle == NULL) {
+            goto error;
+        }
+        PyObject *when = timer_handle_get_when(state, handle);
+        Py_DECREF(handle);
+        if (when == NULL) {
+            goto error;
+        }
+        int is_due;
+        if (PyFloat_CheckExact(when) && PyFloat_CheckExact(end_time)) {
+            is_due = PyFloat_AS_DOUBLE(when) < PyFloat_AS_DOUBLE(end_time);
+        }
+        else {
+            is_due = PyObject_RichCompareBool(when, end_time, Py_GE);
+            if (is_due >= 0) {
+                is_due = !is_due;
+            }
+        }
+        Py_DECREF(when);
+        if (is_due <= 0) {
+            if (is_due < 0) {
+                goto error;
+            }
+            break;
+        }
+        handle = PyObject_CallOneArg(state->heapq_heappop, scheduled);
+        if (handle == NULL) {
+            goto error;
+        }
+        if (timer_handle_set_scheduled(state, handle, 0) < 0 ||
+            loop_core_append_ready(self, handle) < 0)
+        {
+            Py_DECREF(handle);
+            goto error;
+        }
+        Py_DECREF(handle);
+    }
+    Py_DECREF(scheduled);
+    Py_DECREF(end_time);
+    return 0;
+
+error:
+    Py_XDECREF(scheduled);
+    Py_DECREF(end_time);
+    return -1;
+}
+
+/* Run a handle in debug mode and log it if it is slow. */
+static int
+loop_core_run_handle_debug(asyncio_state *state, EventLoopCoreObj *self,
+                           PyObject *handle)
+{
+    PyObject *loop = (PyObject *)self;
+    PyObject *t0 = NULL, *t1 = NULL, *dt = NULL, *res = NULL;
+    int err = -1;
+
+    if (PyObject_SetAttr(loop, &_Py_ID(_current_handle), handle) < 0) {
+        return -1;
+    }
+    t0 = PyObject_CallMethodNoArgs(loop, &_Py_ID(time));
+    if (t0 == NULL) {
+        goto finally;
+    }
+    if (Handle_CheckExact(state, handle) ||
+        TimerHandle_CheckExact(state, handle))
+    {
+        res = handle_run(state, (HandleObj *)handle);
+    }
+    else {
+        res = PyObject_CallMethodNoArgs(handle, &_Py_ID(_run));
+    }
+    if (res == NULL) {
+        goto finally;
+    }
+    t1 = PyObject_CallMethodNoArgs(loop, &_Py_ID(time));
+    if (t1 == NULL) {
+        goto finally;
+    }
+    dt = PyNumber_Subtract(t1, t0);
+    if (dt == NULL) {
+        goto finally;
+    }
+    PyObject *slow = PyObject_GetAttr(loop, &_Py_ID(slow_callback_duration));
+    if (slow == NULL) {
+        goto finally;
+    }
+    int is_slow = PyObject_RichCompareBool(dt, slow, Py_GE);
+    Py_DECREF(slow);
+    if (is_slow < 0) {
+        goto finally;
+    }
+    if (is_slow) {
+        /* logger.warning('Executing %s took %.3f seconds',
+                          _format_handle(handle), dt) */
+        PyObject *logger = PyImport_ImportModuleAttrString(
+            "asyncio.base_events", "logger");
+        if (logger == NULL) {
+            goto finally;
+        }
+        PyObject *format_handle = PyImport_ImportModuleAttrString(
+            "asyncio.base_events", "_format_handle");
+        if (format_handle == NULL) {
+            Py_DECREF(logger);
+            goto finally;
+        }
+        PyObject *formatted = PyObject_CallOneArg(format_handle, handle);
+        Py_DECREF(format_handle);
+        if (formatted == NULL) {
+            Py_DECREF(logger);
+            goto finally;
+        }
+        PyObject *msg = PyUnicode_FromString("Executing %s took %.3f seconds");
+        PyObject *r = NULL;
+        if (msg != NULL) {
+            r = PyObject_CallMethodObjArgs(logger, &_Py_ID(warning),
+                                           msg, formatted, dt, NULL);
+            Py_DECREF(msg);
+        }
+        Py_DECREF(formatted);
+        Py_DECREF(logger);
+        if (r == NULL) {
+            goto finally;
+        }
+        Py_DECREF(r);
+    }
+    err = 0;
+
+finally:
+    {
+        PyObject *exc = PyErr_GetRaisedException();
+        if (PyObject_SetAttr(loop, &_Py_ID(_current_handle), Py_None) < 0) {
+            if (exc != NULL) {
+                _PyErr_ChainExceptions1(exc);
+            }
+            err = -1;
+        }
+        else {
+            PyErr_SetRaisedException(exc);
+        }
+    }
+    Py_XDECREF(t0);
+    Py_XDECREF(t1);
+    Py_XDECREF(dt);
+    Py_XDECREF(res);
+    return err;
+}
+
+/*[clinic input]
+_asyncio._EventLoopCore._run_once
+
+    cls: defining_class
+    /
+
+Run one full iteration of the event loop.
+
+This calls all currently ready callbacks, polls for I/O,
+schedules the resulting callbacks, and finally schedules
+'call_later' callbacks.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__EventLoopCore__run_once_impl(EventLoopCoreObj *self,
+                                       PyTypeObject *cls)
+/*[clinic end generated code: output=d765ac6d49b7b0ad input=2a62ec97d258ef4c]*/
+{
+    asyncio_state *state = get_asyncio_state_by_cls(cls);
+    PyObject *loop = (PyObject *)self;
+
+    if (loop_core_remove_cancelled(state, self) < 0) {
+        return NULL;
+    }
+
+    PyObject *timeout = loop_core_select_timeout(state, self);
+    if (timeout == NULL) {
+        return NULL;
+    }
+    PyObject *selector = PyObject_GetAttr(loop, &_Py_ID(_selector));
+    if (selector == NULL) {
+        Py_DECREF(timeout);
+        return NULL;
+    }
+    PyObject *event_list = PyObject_CallMethodOneArg(selector, &_Py_ID(select),
+                                                     timeout);
+    Py_DECREF(selector);
+    Py_DECREF(timeout);
+    if (event_list == NULL) {
+        return NULL;
+    }
+    PyObject *res = PyObject_CallMethodOneArg(loop, &_Py_ID(_process_events),
+                                              event_list);
+    Py_DECREF(event_list);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+
+    /* Handle 'later' callbacks that are ready. */
+    if (loop_core_schedule_due_timers(state, self) < 0) {
+        return NULL;
+    }
+
+    /* This is the only place where callbacks are actually *called*.
+       All other places just add them to ready.
+       Note: We run all currently scheduled callbacks, but not any
+       callbacks scheduled by callbacks run this time around --
+       they will be run the next time (after another I/O poll). */
+    PyObject *ready = LOOP_CORE_GET(self, ready);
+    if (ready == NULL) {
+        return NULL;
+    }
+    Py_ssize_t ntodo = PyObject_Length(ready);
+    PyObject *popleft = ntodo > 0 ?
+        PyObject_GetAttr(ready, &_Py_ID(popleft)) : NULL;
+    Py_DECREF(ready);
+    if (ntodo < 0 || (ntodo > 0 && popleft == NULL)) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < ntodo; i++) {
+        PyObject *handle = PyObject_CallNoArgs(popleft);
+        if (handle == NULL) {
+            goto error;
+        }
+        int cancelled = handle_is_cancelled(state, handle);
+        if (cancelled != 0) {
+            Py_DECREF(handle);
+            if (cancelled < 0) {
+                goto error;
+            }
+            continue;
+        }
+        int debug = LOOP_CORE_IS_TRUE(self, debug);
+        if (debug < 0) {
+            Py_DECREF(handle);
+            goto error;
+        }
+        if (debug) {
+            int err = loop_core_run_handle_debug(state, self, handle);
+            Py_DECREF(handle);
+            if (err < 0) {
+                goto error;
+            }
+            continue;
+        }
+        if (Handle_CheckExact(state, handle) ||
+            TimerHandle_CheckExact(state, handle))
+        {
+            res = handle_run(state, (HandleObj *)handle);
+        }
+        else {
+            res = PyObject_CallMethodNoArgs(handle, &_Py_ID(_run));
+        }
+        Py_DECREF(handle);
+        if (res == NULL) {
+            goto error;
+        }
+        Py_DECREF(res);
+    }
+    Py_XDECREF(popleft);
+    Py_RETURN_NONE;
+
+error:
+    Py_DECREF(popleft);
+    return NULL;
+}
+
+static int
+EventLoopCoreObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    EventLoopCoreObj *self = (EventLoopCoreObj *)op;
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->lc_ready);
+    Py_VISIT(self->lc_scheduled);
+    Py_VISIT(self->lc_debug);
+    Py_VISIT(self->lc_closed);
+    Py_VISIT(self->lc_stopping);
+    Py_VISIT(self->lc_clock_resolution);
+    return 0;
+}
+
+static int
+EventLoopCoreObj_clear(PyObject *op)
+{
+    EventLoopCoreObj *self = (EventLoopCoreObj *)op;
+    Py_CLEAR(self->lc_ready);
+    Py_CLEAR(self->lc_scheduled);
+    Py_CLEAR(self->lc_debug);
+    Py_CLEAR(self->lc_closed);
+    Py_CLEAR(self->lc_stopping);
+    Py_CLEAR(self->lc_clock_resolution);
+    return 0;
+}
+
+static void
+EventLoopCoreObj_dealloc(PyObject *op)
+{
+    PyTypeObject *tp = Py_TYPE(op);
+    PyObject_GC_UnTrack(op);
+    (void)EventLoopCoreObj_clear(op);
+    tp->tp_free(op);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef EventLoopCore_methods[] = {
+    _ASYNCIO__EVENTLOOPCORE_GET_DEBUG_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE_CALL_LATER_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE_CALL_AT_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE_CALL_SOON_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE__CALL_SOON_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE__ADD_CALLBACK_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE__TIMER_HANDLE_CANCELLED_METHODDEF
+    _ASYNCIO__EVENTLOOPCORE__RUN_ONCE_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyMemberDef EventLoopCore_members[] = {
+    {"_ready", Py_T_OBJECT_EX, offsetof(EventLoopCoreObj, lc_ready), 0, NULL},
+    {"_scheduled", Py_T_OBJECT_EX,
+     offsetof(EventLoopCoreObj, lc_scheduled), 0, NULL},
+    {"_timer_cancelled_count", Py_T_PYSSIZET,
+     offsetof(EventLoopCoreObj, lc_timer_cancelled_count), 0, NULL},
+    {"_debug", Py_T_OBJECT_EX, offsetof(EventLoopCoreObj, lc_debug), 0, NULL},
+    {"_closed", Py_T_OBJECT_EX,
+     offsetof(EventLoopCoreObj, lc_closed), 0, NULL},
+    {"_stopping", Py_T_OBJECT_EX,
+     offsetof(EventLoopCoreObj, lc_stopping), 0, NULL},
+    {"_clock_resolution", Py_T_OBJECT_EX,
+     offsetof(EventLoopCoreObj, lc_clock_resolution), 0, NULL},
+    {NULL} /* Sentinel */
+};
+
+PyDoc_STRVAR(EventLoopCore_doc,
+"Scheduling and running of callbacks for BaseEventLoop.");
+
+static PyType_Slot EventLoopCore_slots[] = {
+    {Py_tp_dealloc, EventLoopCoreObj_dealloc},
+    {Py_tp_doc, (void *)EventLoopCore_doc},
+    {Py_tp_traverse, EventLoopCoreObj_traverse},
+    {Py_tp_clear, EventLoopCoreObj_clear},
+    {Py_tp_methods, EventLoopCore_methods},
+    {Py_tp_members, EventLoopCore_members},
+    {Py_tp_new, PyType_GenericNew},
+    {0, NULL},
+};
+
+static PyType_Spec EventLoopCore_spec = {
+    .name = "_asyncio._EventLoopCore",
+    .basicsize = sizeof(EventLoopCoreObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = EventLoopCore_slots,
+};
+
+
+/*********************** Functions **************************/
+
+
+/*[clinic input]
+_asyncio._get_running_loop
+
+Return the running event loop or None.
+
+This is a low-level function intended to be used by event loops.
+This function is thread-specific.
+
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__get_running_loop_impl(PyObject *module)
+/*[clinic end generated code: output=b4390af721411a0a input=0a21627e25a4bd43]*/
+{
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    PyObject *loop = Py_XNewRef(ts->asyncio_running_loop);
+    if (loop == NULL) {
+        /* There's no currently running event loop */
+        Py_RETURN_NONE;
+    }
+    return loop;
+}
+
+/*[clinic input]
+_asyncio._set_running_loop
+    loop: 'O'
+    /
+
+Set the running event loop.
+
+This is a low-level function intended to be used by event loops.
+This function is thread-specific.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__set_running_loop(PyObject *module, PyObject *loop)
+/*[clinic end generated code: output=ae56bf7a28ca189a input=4c9720233d606604]*/
+{
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    if (loop == Py_None) {
+        loop = NULL;
+    }
+    Py_XSETREF(ts->asyncio_running_loop, Py_XNewRef(loop));
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.get_event_loop
+
+Return an asyncio event loop.
+
+When called from a coroutine or a callback (e.g. scheduled with
+call_soon or similar API), this function will always return the
+running event loop.
+
+If there is no running event loop set, the function will return
+the result of `get_event_loop_policy().get_event_loop()` call.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_get_event_loop_impl(PyObject *module)
+/*[clinic end generated code: output=2a2d8b2f824c648b input=9364bf2916c8655d]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    return get_event_loop(state);
+}
+
+/*[clinic input]
+_asyncio.get_running_loop
+
+Return the running event loop.  Raise a RuntimeError if there is none.
+
+This function is thread-specific.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_get_running_loop_impl(PyObject *module)
+/*[clinic end generated code: output=c247b5f9e529530e input=2a3bf02ba39f173d]*/
+{
+    PyObject *loop;
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    loop = Py_XNewRef(ts->asyncio_running_loop);
+    if (loop == NULL) {
+        /* There's no currently running event loop */
+        PyErr_SetString(
+            PyExc_RuntimeError, "no running event loop");
+        return NULL;
+    }
+    return loop;
+}
+
+/*[clinic input]
+_asyncio._register_task
+
+    task: object
+
+Register a new task in asyncio as executed by loop.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__register_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=8672dadd69a7d4e2 input=21075aaea14dfbad]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (Task_Check(state, task)) {
+        // task is an asyncio.Task instance or subclass, use efficient
+        // linked-list implementation.
+        register_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+    // As task does not inherit from asyncio.Task, fallback to less efficient
+    // weakset implementation.
+    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
+                                              &_Py_ID(add), task);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._register_eager_task
+
+    task: object
+
+Register a new task in asyncio as executed by loop.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__register_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=dfe1d45367c73f1a input=237f684683398c51]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+
+    if (Task_Check(state, task)) {
+        // task is an asyncio.Task instance or subclass, use efficient
+        // linked-list implementation.
+        register_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+
+    if (PySet_Add(state->non_asyncio_eager_tasks, task) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+_asyncio._unregister_task
+
+    task: object
+
+Unregister a task.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__unregister_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=6e5585706d568a46 input=28fb98c3975f7bdc]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (Task_Check(state, task)) {
+        unregister_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
+                                              &_Py_ID(discard), task);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._unregister_eager_task
+
+    task: object
+
+Unregister a task.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=a426922bd07f23d1 input=9d07401ef14ee048]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (Task_Check(state, task)) {
+        // task is an asyncio.Task instance or subclass, use efficient
+        // linked-list implementation.
+        unregister_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+
+    if (PySet_Discard(state->non_asyncio_eager_tasks, task) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+_asyncio._enter_task
 
-/*[clinic input]
-_asyncio._enter_task
-
     loop: object
     task: object
 
@@ -4193,12 +6091,20 @@ module_traverse(PyObject *mod, visitproc visit, void *arg)
     Py_VISIT(state->TaskStepMethWrapper_Type);
     Py_VISIT(state->FutureType);
     Py_VISIT(state->TaskType);
+    Py_VISIT(state->HandleType);
+    Py_VISIT(state->TimerHandleType);
+    Py_VISIT(state->EventLoopCoreType);
 
     Py_VISIT(state->asyncio_mod);
     Py_VISIT(state->traceback_extract_stack);
     Py_VISIT(state->asyncio_future_repr_func);
     Py_VISIT(state->asyncio_get_event_loop_policy);
     Py_VISIT(state->asyncio_iscoroutine_func);
+    Py_VISIT(state->asyncio_extract_stack);
+    Py_VISIT(state->asyncio_format_callback_source);
+    Py_VISIT(state->heapq_heappush);
+    Py_VISIT(state->heapq_heappop);
+    Py_VISIT(state->heapq_heapify);
     Py_VISIT(state->asyncio_task_get_stack_func);
     Py_VISIT(state->asyncio_task_print_stack_func);
     Py_VISIT(state->asyncio_task_repr_func);
@@ -4210,6 +6116,7 @@ module_traverse(PyObject *mod, visitproc visit, void *arg)
     Py_VISIT(state->iscoroutine_typecache);
 
     Py_VISIT(state->context_kwname);
+    Py_VISIT(state->debug_kwname);
 
     return 0;
 }
@@ -4223,12 +6130,20 @@ module_clear(PyObject *mod)
     Py_CLEAR(state->TaskStepMethWrapper_Type);
     Py_CLEAR(state->FutureType);
     Py_CLEAR(state->TaskType);
+    Py_CLEAR(state->HandleType);
+    Py_CLEAR(state->TimerHandleType);
+    Py_CLEAR(state->EventLoopCoreType);
 
     Py_CLEAR(state->asyncio_mod);
     Py_CLEAR(state->traceback_extract_stack);
     Py_CLEAR(state->asyncio_future_repr_func);
     Py_CLEAR(state->asyncio_get_event_loop_policy);
     Py_CLEAR(state->asyncio_iscoroutine_func);
+    Py_CLEAR(state->asyncio_extract_stack);
+    Py_CLEAR(state->asyncio_format_callback_source);
+    Py_CLEAR(state->heapq_heappush);
+    Py_CLEAR(state->heapq_heappop);
+    Py_CLEAR(state->heapq_heapify);
     Py_CLEAR(state->asyncio_task_get_stack_func);
     Py_CLEAR(state->asyncio_task_print_stack_func);
     Py_CLEAR(state->asyncio_task_repr_func);
@@ -4240,6 +6155,7 @@ module_clear(PyObject *mod)
     Py_CLEAR(state->iscoroutine_typecache);
 
     Py_CLEAR(state->context_kwname);
+    Py_CLEAR(state->debug_kwname);
     // Clear the ref to running loop so that finalizers can run early.
     // If there are other running loops in different threads,
     // those get cleared in PyThreadState_Clear.
@@ -4276,6 +6192,11 @@ module_init(asyncio_state *state)
         goto fail;
     }
 
+    state->debug_kwname = Py_BuildValue("(s)", "debug");
+    if (state->debug_kwname == NULL) {
+        goto fail;
+    }
+
 #define WITH_MOD(NAME) \
     Py_CLEAR(module); \
     module = PyImport_ImportModule(NAME); \
@@ -4307,6 +6228,16 @@ module_init(asyncio_state *state)
     WITH_MOD("asyncio.coroutines")
     GET_MOD_ATTR(state->asyncio_iscoroutine_func, "iscoroutine")
 
+    WITH_MOD("asyncio.format_helpers")
+    GET_MOD_ATTR(state->asyncio_extract_stack, "extract_stack")
+    GET_MOD_ATTR(state->asyncio_format_callback_source,
+                 "_format_callback_source")
+
+    WITH_MOD("heapq")
+    GET_MOD_ATTR(state->heapq_heappush, "heappush")
+    GET_MOD_ATTR(state->heapq_heappop, "heappop")
+    GET_MOD_ATTR(state->heapq_heapify, "heapify")
+
     WITH_MOD("traceback")
     GET_MOD_ATTR(state->traceback_extract_stack, "extract_stack")
 
@@ -4377,6 +6308,10 @@ module_exec(PyObject *mod)
     CREATE_TYPE(mod, state->FutureIterType, &FutureIter_spec, NULL);
     CREATE_TYPE(mod, state->FutureType, &Future_spec, NULL);
     CREATE_TYPE(mod, state->TaskType, &Task_spec, state->FutureType);
+    CREATE_TYPE(mod, state->HandleType, &Handle_spec, NULL);
+    CREATE_TYPE(mod, state->TimerHandleType, &TimerHandle_spec,
+                state->HandleType);
+    CREATE_TYPE(mod, state->EventLoopCoreType, &EventLoopCore_spec, NULL);
 
 #undef CREATE_TYPE
 
@@ -4387,6 +6322,18 @@ module_exec(PyObject *mod)
     if (PyModule_AddType(mod, state->TaskType) < 0) {
         return -1;
     }
+
+    if (PyModule_AddType(mod, state->HandleType) < 0) {
+        return -1;
+    }
+
+    if (PyModule_AddType(mod, state->TimerHandleType) < 0) {
+        return -1;
+    }
+
+    if (PyModule_AddType(mod, state->EventLoopCoreType) < 0) {
+        return -1;
+    }
     // Must be done after types are added to avoid a circular dependency
     if (module_init(state) < 0) {
         return -1;
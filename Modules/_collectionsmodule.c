@@ -3,8 +3,11 @@
 #include "pycore_dict.h"          // _PyDict_GetItem_KnownHash()
 #include "pycore_long.h"          // _PyLong_GetZero()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
+#include "pycore_object_deferred.h" // _PyObject_SetDeferredRefcount()
+#include "pycore_pyerrors.h"      // _PyErr_SetKeyError()
 #include "pycore_pyatomic_ft_wrappers.h"
 #include "pycore_typeobject.h"    // _PyType_GetModuleState()
+#include "pycore_unicodeobject.h" // _PyUnicode_Equal()
 #include "pycore_weakref.h"       // FT_CLEAR_WEAKREFS()
 
 #include <stddef.h>
@@ -15,6 +18,9 @@ typedef struct {
     PyTypeObject *dequeiter_type;
     PyTypeObject *dequereviter_type;
     PyTypeObject *tuplegetter_type;
+    PyTypeObject *cdict_type;
+    PyTypeObject *sdict_type;
+    PyTypeObject *sdictiter_type;
 } collections_state;
 
 static inline collections_state *
@@ -47,10 +53,12 @@ find_module_state_by_def(PyTypeObject *type)
 module _collections
 class _tuplegetter "_tuplegetterobject *" "clinic_state()->tuplegetter_type"
 class _collections.deque "dequeobject *" "clinic_state()->deque_type"
+class _collections.ScalarDict "sdictobject *" "find_module_state_by_def(type)->sdict_type"
 [clinic start generated code]*/
-/*[clinic end generated code: output=da39a3ee5e6b4b0d input=a033cc2a8476b3f1]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=091698c54321089a]*/
 
 typedef struct dequeobject dequeobject;
+typedef struct sdictobject sdictobject;
 
 /* We can safely assume type to be the defining class,
  * since tuplegetter is not a base type */
@@ -2505,6 +2513,1627 @@ static PyType_Spec defdict_spec = {
     .slots = defdict_slots,
 };
 
+/* concurrent dict object ***************************************************/
+
+/* A ConcurrentDict spreads its items over CDICT_SHARDS ordinary dicts,
+   chosen by the hash of the key.  Each shard has its own lock on the
+   free-threaded build, so writers to different shards do not contend, and
+   a shard grows on its own: a resize copies and blocks only the items of
+   one shard.  Lookups use the lock-free reads of the shard dicts. */
+
+#define CDICT_LOG_SHARDS 6
+#define CDICT_SHARDS (1 << CDICT_LOG_SHARDS)
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *shards[CDICT_SHARDS];
+} cdictobject;
+
+#define cdictobject_CAST(op)  ((cdictobject *)(op))
+
+static PyType_Spec cdict_spec;
+
+static inline PyObject *
+cdict_shard(cdictobject *cd, Py_hash_t hash)
+{
+    /* The shards index their tables with the low bits of the hash, so
+       pick the shard from the high bits of a multiplicative hash. */
+#if SIZEOF_SIZE_T > 4
+    size_t h = (size_t)hash * 0x9E3779B97F4A7C15u;
+#else
+    size_t h = (size_t)hash * 0x9E3779B9u;
+#endif
+    return cd->shards[h >> (8 * SIZEOF_SIZE_T - CDICT_LOG_SHARDS)];
+}
+
+static PyObject *
+cdict_alloc(PyTypeObject *type)
+{
+    cdictobject *cd = (cdictobject *)type->tp_alloc(type, 0);
+    if (cd == NULL) {
+        return NULL;
+    }
+    // Like thread-locals, concurrent dicts are meant to be shared by many
+    // threads: use deferred reference counting to avoid contention.
+    _PyObject_SetDeferredRefcount((PyObject *)cd);
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        cd->shards[i] = PyDict_New();
+        if (cd->shards[i] == NULL) {
+            Py_DECREF(cd);
+            return NULL;
+        }
+    }
+    return (PyObject *)cd;
+}
+
+static PyObject *
+cdict_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    return cdict_alloc(type);
+}
+
+static int
+cdict_setitem(cdictobject *cd, PyObject *key, PyObject *value)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return -1;
+    }
+    return _PyDict_SetItem_KnownHash(cdict_shard(cd, hash), key, value, hash);
+}
+
+static int
+cdict_update_arg(cdictobject *cd, PyObject *arg)
+{
+    PyObject *items;
+    if (PyDict_Check(arg)) {
+        items = PyDict_Items(arg);
+    }
+    else {
+        int has_keys = PyObject_HasAttrWithError(arg, &_Py_ID(keys));
+        if (has_keys < 0) {
+            return -1;
+        }
+        if (has_keys) {
+            items = PyMapping_Items(arg);
+        }
+        else {
+            items = PySequence_List(arg);
+        }
+    }
+    if (items == NULL) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(items); i++) {
+        PyObject *item = PySequence_Fast(PyList_GET_ITEM(items, i), "");
+        if (item == NULL) {
+            if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+                PyErr_Format(PyExc_TypeError,
+                    "cannot convert dictionary update "
+                    "sequence element #%zd to a sequence", i);
+            }
+            goto error;
+        }
+        if (PySequence_Fast_GET_SIZE(item) != 2) {
+            PyErr_Format(PyExc_ValueError,
+                         "dictionary update sequence element #%zd "
+                         "has length %zd; 2 is required",
+                         i, PySequence_Fast_GET_SIZE(item));
+            Py_DECREF(item);
+            goto error;
+        }
+        int rc = cdict_setitem(cd, PySequence_Fast_GET_ITEM(item, 0),
+                               PySequence_Fast_GET_ITEM(item, 1));
+        Py_DECREF(item);
+        if (rc < 0) {
+            goto error;
+        }
+    }
+    Py_DECREF(items);
+    return 0;
+
+error:
+    Py_DECREF(items);
+    return -1;
+}
+
+static int
+cdict_update_common(cdictobject *cd, PyObject *args, PyObject *kwds,
+                    const char *name)
+{
+    PyObject *arg = NULL;
+    if (!PyArg_UnpackTuple(args, name, 0, 1, &arg)) {
+        return -1;
+    }
+    if (arg != NULL && cdict_update_arg(cd, arg) < 0) {
+        return -1;
+    }
+    if (kwds != NULL && PyDict_GET_SIZE(kwds) && cdict_update_arg(cd, kwds) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int
+cdict_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    return cdict_update_common(cdictobject_CAST(self), args, kwds,
+                               "ConcurrentDict");
+}
+
+PyDoc_STRVAR(cdict_update_doc,
+"D.update([other, ]**kwds) -> None.  Update D from mapping/iterable other and kwds.");
+
+static PyObject *
+cdict_update(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    if (cdict_update_common(cdictobject_CAST(self), args, kwds, "update") < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+cdict_length(PyObject *self)
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    Py_ssize_t n = 0;
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        n += PyDict_GET_SIZE(cd->shards[i]);
+    }
+    return n;
+}
+
+static PyObject *
+cdict_subscript(PyObject *self, PyObject *key)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    PyObject *value;
+    PyObject *shard = cdict_shard(cdictobject_CAST(self), hash);
+    int rc = _PyDict_GetItemRef_KnownHash((PyDictObject *)shard, key, hash,
+                                          &value);
+    if (rc == 0) {
+        _PyErr_SetKeyError(key);
+    }
+    return value;
+}
+
+static int
+cdict_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    if (value != NULL) {
+        return cdict_setitem(cd, key, value);
+    }
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return -1;
+    }
+    return _PyDict_DelItem_KnownHash(cdict_shard(cd, hash), key, hash);
+}
+
+static int
+cdict_contains(PyObject *self, PyObject *key)
+{
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return -1;
+    }
+    PyObject *shard = cdict_shard(cdictobject_CAST(self), hash);
+    return _PyDict_Contains_KnownHash(shard, key, hash);
+}
+
+PyDoc_STRVAR(cdict_get_doc,
+"get($self, key, default=None, /)\n--\n\n\
+Return the value for key if key is in the dictionary, else default.");
+
+static PyObject *
+cdict_get(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (!_PyArg_CheckPositional("get", nargs, 1, 2)) {
+        return NULL;
+    }
+    PyObject *key = args[0];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    PyObject *value;
+    PyObject *shard = cdict_shard(cdictobject_CAST(self), hash);
+    int rc = _PyDict_GetItemRef_KnownHash((PyDictObject *)shard, key, hash,
+                                          &value);
+    if (rc == 0) {
+        value = Py_NewRef(nargs > 1 ? args[1] : Py_None);
+    }
+    return value;
+}
+
+PyDoc_STRVAR(cdict_setdefault_doc,
+"setdefault($self, key, default=None, /)\n--\n\n\
+Insert key with a value of default if key is not in the dictionary.\n\
+\n\
+Return the value for key if key is in the dictionary, else default.");
+
+static PyObject *
+cdict_setdefault(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (!_PyArg_CheckPositional("setdefault", nargs, 1, 2)) {
+        return NULL;
+    }
+    PyObject *key = args[0];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    PyObject *result;
+    PyObject *shard = cdict_shard(cdictobject_CAST(self), hash);
+    if (PyDict_SetDefaultRef(shard, key, nargs > 1 ? args[1] : Py_None,
+                             &result) < 0) {
+        return NULL;
+    }
+    return result;
+}
+
+PyDoc_STRVAR(cdict_pop_doc,
+"pop($self, key, default=<unrepresentable>, /)\n--\n\n\
+D.pop(k[,d]) -> v, remove specified key and return the corresponding value.\n\
+\n\
+If the key is not found, return the default if given; otherwise,\n\
+raise a KeyError.");
+
+static PyObject *
+cdict_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    if (!_PyArg_CheckPositional("pop", nargs, 1, 2)) {
+        return NULL;
+    }
+    PyObject *key = args[0];
+    Py_hash_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    PyObject *result;
+    PyObject *shard = cdict_shard(cdictobject_CAST(self), hash);
+    int rc = _PyDict_Pop_KnownHash((PyDictObject *)shard, key, hash, &result);
+    if (rc == 0) {
+        if (nargs > 1) {
+            return Py_NewRef(args[1]);
+        }
+        _PyErr_SetKeyError(key);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(cdict_clear_doc, "D.clear() -> None.  Remove all items from D.");
+
+static PyObject *
+cdict_clear_method(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        PyDict_Clear(cd->shards[i]);
+    }
+    Py_RETURN_NONE;
+}
+
+/* Concatenate the lists that func returns for each shard. */
+static PyObject *
+cdict_collect(cdictobject *cd, PyObject *(*func)(PyObject *))
+{
+    PyObject *result = PyList_New(0);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        PyObject *part = func(cd->shards[i]);
+        if (part == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        int rc = PyList_Extend(result, part);
+        Py_DECREF(part);
+        if (rc < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+PyDoc_STRVAR(cdict_keys_doc, "D.keys() -> a list of the keys of D.");
+
+static PyObject *
+cdict_keys(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    return cdict_collect(cdictobject_CAST(self), PyDict_Keys);
+}
+
+PyDoc_STRVAR(cdict_values_doc, "D.values() -> a list of the values of D.");
+
+static PyObject *
+cdict_values(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    return cdict_collect(cdictobject_CAST(self), PyDict_Values);
+}
+
+PyDoc_STRVAR(cdict_items_doc,
+"D.items() -> a list of the (key, value) pairs of D.");
+
+static PyObject *
+cdict_items(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    return cdict_collect(cdictobject_CAST(self), PyDict_Items);
+}
+
+static PyObject *
+cdict_iter(PyObject *self)
+{
+    PyObject *keys = cdict_keys(self, NULL);
+    if (keys == NULL) {
+        return NULL;
+    }
+    PyObject *it = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return it;
+}
+
+/* Return a dict with the items of cd. */
+static PyObject *
+cdict_as_dict(cdictobject *cd)
+{
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        if (PyDict_Update(dict, cd->shards[i]) < 0) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+    return dict;
+}
+
+PyDoc_STRVAR(cdict_copy_doc, "D.copy() -> a shallow copy of D.");
+
+static PyObject *
+cdict_copy(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    cdictobject *new = (cdictobject *)cdict_alloc(Py_TYPE(cd));
+    if (new == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        if (PyDict_Update(new->shards[i], cd->shards[i]) < 0) {
+            Py_DECREF(new);
+            return NULL;
+        }
+    }
+    return (PyObject *)new;
+}
+
+static PyObject *
+cdict_reduce(PyObject *self, PyObject *Py_UNUSED(dummy))
+{
+    PyObject *items = cdict_items(self, NULL);
+    if (items == NULL) {
+        return NULL;
+    }
+    PyObject *iter = PyObject_GetIter(items);
+    Py_DECREF(items);
+    if (iter == NULL) {
+        return NULL;
+    }
+    return Py_BuildValue("O()OON", Py_TYPE(self), Py_None, Py_None, iter);
+}
+
+static PyObject *
+cdict_repr(PyObject *self)
+{
+    int status = Py_ReprEnter(self);
+    if (status != 0) {
+        if (status < 0) {
+            return NULL;
+        }
+        return PyUnicode_FromFormat("%s(...)", _PyType_Name(Py_TYPE(self)));
+    }
+    PyObject *result = NULL;
+    PyObject *dict = cdict_as_dict(cdictobject_CAST(self));
+    if (dict != NULL) {
+        result = PyUnicode_FromFormat("%s(%R)", _PyType_Name(Py_TYPE(self)),
+                                      dict);
+        Py_DECREF(dict);
+    }
+    Py_ReprLeave(self);
+    return result;
+}
+
+static PyObject *
+cdict_richcompare(PyObject *self, PyObject *other, int op)
+{
+    if (op != Py_EQ && op != Py_NE) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    int other_is_cdict = PyType_GetBaseByToken(Py_TYPE(other), &cdict_spec,
+                                               NULL);
+    if (other_is_cdict < 0) {
+        return NULL;
+    }
+    if (!other_is_cdict && !PyDict_Check(other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject *a = cdict_as_dict(cdictobject_CAST(self));
+    if (a == NULL) {
+        return NULL;
+    }
+    PyObject *b;
+    if (other_is_cdict) {
+        b = cdict_as_dict(cdictobject_CAST(other));
+        if (b == NULL) {
+            Py_DECREF(a);
+            return NULL;
+        }
+    }
+    else {
+        b = Py_NewRef(other);
+    }
+    PyObject *result = PyObject_RichCompare(a, b, op);
+    Py_DECREF(a);
+    Py_DECREF(b);
+    return result;
+}
+
+static int
+cdict_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    Py_VISIT(Py_TYPE(cd));
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        Py_VISIT(cd->shards[i]);
+    }
+    return 0;
+}
+
+static int
+cdict_tp_clear(PyObject *self)
+{
+    cdictobject *cd = cdictobject_CAST(self);
+    for (int i = 0; i < CDICT_SHARDS; i++) {
+        Py_CLEAR(cd->shards[i]);
+    }
+    return 0;
+}
+
+static void
+cdict_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    (void)cdict_tp_clear(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef cdict_methods[] = {
+    {"get", _PyCFunction_CAST(cdict_get), METH_FASTCALL, cdict_get_doc},
+    {"setdefault", _PyCFunction_CAST(cdict_setdefault), METH_FASTCALL,
+     cdict_setdefault_doc},
+    {"pop", _PyCFunction_CAST(cdict_pop), METH_FASTCALL, cdict_pop_doc},
+    {"update", _PyCFunction_CAST(cdict_update), METH_VARARGS | METH_KEYWORDS,
+     cdict_update_doc},
+    {"clear", cdict_clear_method, METH_NOARGS, cdict_clear_doc},
+    {"keys", cdict_keys, METH_NOARGS, cdict_keys_doc},
+    {"values", cdict_values, METH_NOARGS, cdict_values_doc},
+    {"items", cdict_items, METH_NOARGS, cdict_items_doc},
+    {"copy", cdict_copy, METH_NOARGS, cdict_copy_doc},
+    {"__copy__", cdict_copy, METH_NOARGS, cdict_copy_doc},
+    {"__reduce__", cdict_reduce, METH_NOARGS, reduce_doc},
+    {"__class_getitem__", Py_GenericAlias, METH_O|METH_CLASS,
+     PyDoc_STR("See PEP 585")},
+    {NULL}
+};
+
+PyDoc_STRVAR(cdict_doc,
+"ConcurrentDict(mapping_or_iterable=(), /, **kwargs)\n\
+--\n\
+\n\
+Mapping for sharing items between many threads.\n\
+\n\
+The items are spread over several dicts by the hash of their key, so\n\
+that threads updating different keys rarely wait for each other on the\n\
+free-threaded build.  Iteration order is unspecified, and keys(),\n\
+values() and items() return lists.");
+
+static PyType_Slot cdict_slots[] = {
+    {Py_tp_token, Py_TP_USE_SPEC},
+    {Py_tp_dealloc, cdict_dealloc},
+    {Py_tp_repr, cdict_repr},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+    {Py_tp_doc, (void *)cdict_doc},
+    {Py_tp_traverse, cdict_traverse},
+    {Py_tp_clear, cdict_tp_clear},
+    {Py_tp_richcompare, cdict_richcompare},
+    {Py_tp_iter, cdict_iter},
+    {Py_tp_methods, cdict_methods},
+    {Py_tp_init, cdict_init},
+    {Py_tp_new, cdict_new},
+    {Py_mp_length, cdict_length},
+    {Py_mp_subscript, cdict_subscript},
+    {Py_mp_ass_subscript, cdict_ass_subscript},
+    {Py_sq_contains, cdict_contains},
+    {0, NULL},
+};
+
+static PyType_Spec cdict_spec = {
+    .name = "collections.ConcurrentDict",
+    .basicsize = sizeof(cdictobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_MAPPING),
+    .slots = cdict_slots,
+};
+
+/* scalar dict object *******************************************************/
+
+/* A ScalarDict maps keys to C int64_t or double values, which are stored
+   next to the keys instead of as int or float objects and are only boxed
+   when they are read.  The table is laid out like a compact dict: a table
+   of int32 indices into an ordered array of entries, probed in the same
+   order.  Like the keys of a dict whose keys are all str, the entries do
+   not store the hash of the key while all keys are exact str objects; the
+   array of hashes is only created for the first key of another type. */
+
+#define SD_EMPTY (-1)
+#define SD_DUMMY (-2)
+#define SD_ERROR (-3)
+#define SD_LOG_MINSIZE 3
+#define SD_MAX_LOG_SIZE 31
+#define SD_PERTURB_SHIFT 5
+#define SD_USABLE(size) (((size) << 1) / 3)
+
+typedef union {
+    int64_t q;
+    double d;
+} sdvalue;
+
+typedef struct {
+    PyObject *key;          /* NULL for a deleted entry */
+    sdvalue value;
+} sdentry;
+
+struct sdictobject {
+    PyObject_HEAD
+    char typecode;          /* 'q' or 'd' */
+    uint8_t log2size;       /* log2 of the size of indices, or 0 */
+    Py_ssize_t used;        /* number of items */
+    Py_ssize_t nentries;    /* number of used entries, deleted included */
+    int32_t *indices;
+    sdentry *entries;       /* SD_USABLE(1 << log2size) entries */
+    Py_hash_t *hashes;      /* NULL while all keys are exact str */
+};
+
+#define sdictobject_CAST(op)  ((sdictobject *)(op))
+
+static inline Py_hash_t
+sdict_entry_hash(sdictobject *sd, Py_ssize_t ix)
+{
+    if (sd->hashes != NULL) {
+        return sd->hashes[ix];
+    }
+    return PyUnstable_Unicode_GET_CACHED_HASH(sd->entries[ix].key);
+}
+
+static PyObject *
+sdict_box(sdictobject *sd, sdvalue value)
+{
+    if (sd->typecode == 'q') {
+        return PyLong_FromInt64(value.q);
+    }
+    return PyFloat_FromDouble(value.d);
+}
+
+static int
+sdict_unbox(sdictobject *sd, PyObject *obj, sdvalue *value)
+{
+    if (sd->typecode == 'q') {
+        return PyLong_AsInt64(obj, &value->q);
+    }
+    value->d = PyFloat_AsDouble(obj);
+    if (value->d == -1.0 && PyErr_Occurred()) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Return the index of the entry for key, SD_EMPTY if there is none, or
+   SD_ERROR.  If slot is not NULL, set it to the slot of the index. */
+static Py_ssize_t
+sdict_lookup(sdictobject *sd, PyObject *key, Py_hash_t hash, size_t *slot)
+{
+restart:
+    if (sd->indices == NULL) {
+        return SD_EMPTY;
+    }
+    size_t mask = ((size_t)1 << sd->log2size) - 1;
+    size_t i = (size_t)hash & mask;
+    size_t perturb = (size_t)hash;
+    for (;;) {
+        Py_ssize_t ix = sd->indices[i];
+        if (ix == SD_EMPTY) {
+            return SD_EMPTY;
+        }
+        if (ix >= 0) {
+            sdentry *entries = sd->entries;
+            PyObject *startkey = entries[ix].key;
+            if (startkey == key) {
+                goto found;
+            }
+            if (sdict_entry_hash(sd, ix) == hash) {
+                if (PyUnicode_CheckExact(startkey) && PyUnicode_CheckExact(key)) {
+                    if (_PyUnicode_Equal(startkey, key)) {
+                        goto found;
+                    }
+                }
+                else {
+                    Py_INCREF(startkey);
+                    int cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
+                    Py_DECREF(startkey);
+                    if (cmp < 0) {
+                        return SD_ERROR;
+                    }
+                    if (entries != sd->entries || ix >= sd->nentries ||
+                        entries[ix].key != startkey)
+                    {
+                        /* The table was mutated, restart */
+                        goto restart;
+                    }
+                    if (cmp) {
+                        goto found;
+                    }
+                }
+            }
+        }
+        perturb >>= SD_PERTURB_SHIFT;
+        i = mask & (i*5 + perturb + 1);
+        continue;
+found:
+        if (slot != NULL) {
+            *slot = i;
+        }
+        return ix;
+    }
+}
+
+/* Rebuild the table with room for at least minsize items, dropping
+   deleted entries. */
+static int
+sdict_resize(sdictobject *sd, Py_ssize_t minsize)
+{
+    uint8_t log2size = SD_LOG_MINSIZE;
+    while (SD_USABLE((Py_ssize_t)1 << log2size) < minsize) {
+        if (++log2size > SD_MAX_LOG_SIZE) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    size_t size = (size_t)1 << log2size;
+    Py_ssize_t usable = SD_USABLE((Py_ssize_t)size);
+    int32_t *indices = PyMem_New(int32_t, size);
+    sdentry *entries = PyMem_New(sdentry, usable);
+    Py_hash_t *hashes = NULL;
+    if (sd->hashes != NULL) {
+        hashes = PyMem_New(Py_hash_t, usable);
+    }
+    if (indices == NULL || entries == NULL ||
+        (sd->hashes != NULL && hashes == NULL))
+    {
+        PyMem_Free(indices);
+        PyMem_Free(entries);
+        PyMem_Free(hashes);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(indices, 0xff, size * sizeof(int32_t));
+
+    size_t mask = size - 1;
+    Py_ssize_t n = 0;
+    for (Py_ssize_t ix = 0; ix < sd->nentries; ix++) {
+        if (sd->entries[ix].key == NULL) {
+            continue;
+        }
+        Py_hash_t hash = sdict_entry_hash(sd, ix);
+        size_t i = (size_t)hash & mask;
+        for (size_t perturb = (size_t)hash; indices[i] != SD_EMPTY;) {
+            perturb >>= SD_PERTURB_SHIFT;
+            i = mask & (i*5 + perturb + 1);
+        }
+        indices[i] = (int32_t)n;
+        entries[n] = sd->entries[ix];
+        if (hashes != NULL) {
+            hashes[n] = hash;
+        }
+        n++;
+    }
+    assert(n == sd->used);
+
+    PyMem_Free(sd->indices);
+    PyMem_Free(sd->entries);
+    PyMem_Free(sd->hashes);
+    sd->log2size = log2size;
+    sd->indices = indices;
+    sd->entries = entries;
+    sd->hashes = hashes;
+    sd->nentries = n;
+    return 0;
+}
+
+/* Start storing hashes, for a key which is not an exact str. */
+static int
+sdict_store_hashes(sdictobject *sd)
+{
+    assert(sd->hashes == NULL && sd->indices != NULL);
+    Py_ssize_t usable = SD_USABLE((Py_ssize_t)1 << sd->log2size);
+    Py_hash_t *hashes = PyMem_New(Py_hash_t, usable);
+    if (hashes == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (Py_ssize_t ix = 0; ix < sd->nentries; ix++) {
+        PyObject *key = sd->entries[ix].key;
+        hashes[ix] = key ? PyUnstable_Unicode_GET_CACHED_HASH(key) : -1;
+    }
+    sd->hashes = hashes;
+    return 0;
+}
+
+/* Add an item for a key which is not in the table. */
+static int
+sdict_insert(sdictobject *sd, PyObject *key, Py_hash_t hash, sdvalue value)
+{
+    if (sd->indices == NULL ||
+        sd->nentries >= SD_USABLE((Py_ssize_t)1 << sd->log2size))
+    {
+        /* Like dicts, grow to 3 times the number of items. */
+        if (sdict_resize(sd, Py_MAX(sd->used * 3, 1)) < 0) {
+            return -1;
+        }
+    }
+    if (sd->hashes == NULL && !PyUnicode_CheckExact(key) &&
+        sdict_store_hashes(sd) < 0)
+    {
+        return -1;
+    }
+    size_t mask = ((size_t)1 << sd->log2size) - 1;
+    size_t i = (size_t)hash & mask;
+    for (size_t perturb = (size_t)hash; sd->indices[i] >= 0;) {
+        perturb >>= SD_PERTURB_SHIFT;
+        i = mask & (i*5 + perturb + 1);
+    }
+    Py_ssize_t ix = sd->nentries;
+    sd->indices[i] = (int32_t)ix;
+    sd->entries[ix].key = Py_NewRef(key);
+    sd->entries[ix].value = value;
+    if (sd->hashes != NULL) {
+        sd->hashes[ix] = hash;
+    }
+    sd->nentries++;
+    sd->used++;
+    return 0;
+}
+
+static int
+sdict_setitem_lock_held(sdictobject *sd, PyObject *key, PyObject *obj)
+{
+    sdvalue value;
+    if (sdict_unbox(sd, obj, &value) < 0) {
+        return -1;
+    }
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return -1;
+    }
+    Py_ssize_t ix = sdict_lookup(sd, key, hash, NULL);
+    if (ix == SD_ERROR) {
+        return -1;
+    }
+    if (ix >= 0) {
+        sd->entries[ix].value = value;
+        return 0;
+    }
+    return sdict_insert(sd, key, hash, value);
+}
+
+static int
+sdict_delitem_lock_held(sdictobject *sd, PyObject *key, sdvalue *value)
+{
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return -1;
+    }
+    size_t slot;
+    Py_ssize_t ix = sdict_lookup(sd, key, hash, &slot);
+    if (ix == SD_ERROR) {
+        return -1;
+    }
+    if (ix == SD_EMPTY) {
+        return 0;
+    }
+    PyObject *oldkey = sd->entries[ix].key;
+    if (value != NULL) {
+        *value = sd->entries[ix].value;
+    }
+    sd->indices[slot] = SD_DUMMY;
+    sd->entries[ix].key = NULL;
+    sd->used--;
+    Py_DECREF(oldkey);
+    return 1;
+}
+
+/* Add amount to the value for key, inserting it if needed. */
+static int
+sdict_add_lock_held(sdictobject *sd, PyObject *key, Py_hash_t hash,
+                    sdvalue amount)
+{
+    Py_ssize_t ix = sdict_lookup(sd, key, hash, NULL);
+    if (ix == SD_ERROR) {
+        return -1;
+    }
+    if (ix == SD_EMPTY) {
+        return sdict_insert(sd, key, hash, amount);
+    }
+    sdvalue *value = &sd->entries[ix].value;
+    if (sd->typecode == 'd') {
+        value->d += amount.d;
+    }
+    else {
+        if (amount.q > 0 ? value->q > INT64_MAX - amount.q
+                         : value->q < INT64_MIN - amount.q)
+        {
+            PyErr_SetString(PyExc_OverflowError,
+                            "value out of range of a 64-bit integer");
+            return -1;
+        }
+        value->q += amount.q;
+    }
+    return 0;
+}
+
+static int
+sdict_count_lock_held(sdictobject *sd, PyObject *it)
+{
+    sdvalue one;
+    if (sd->typecode == 'q') {
+        one.q = 1;
+    }
+    else {
+        one.d = 1.0;
+    }
+    PyObject *key;
+    while ((key = PyIter_Next(it)) != NULL) {
+        Py_hash_t hash = _PyObject_HashFast(key);
+        if (hash == -1 || sdict_add_lock_held(sd, key, hash, one) < 0) {
+            Py_DECREF(key);
+            return -1;
+        }
+        Py_DECREF(key);
+    }
+    return PyErr_Occurred() ? -1 : 0;
+}
+
+static void
+sdict_clear_lock_held(sdictobject *sd)
+{
+    sdentry *entries = sd->entries;
+    Py_ssize_t n = sd->nentries;
+    PyMem_Free(sd->indices);
+    PyMem_Free(sd->hashes);
+    sd->log2size = 0;
+    sd->used = 0;
+    sd->nentries = 0;
+    sd->indices = NULL;
+    sd->entries = NULL;
+    sd->hashes = NULL;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        Py_XDECREF(entries[i].key);
+    }
+    PyMem_Free(entries);
+}
+
+static int
+sdict_update_lock_held(sdictobject *sd, PyObject *arg)
+{
+    PyObject *items;
+    int has_keys = PyObject_HasAttrWithError(arg, &_Py_ID(keys));
+    if (has_keys < 0) {
+        return -1;
+    }
+    if (has_keys) {
+        items = PyMapping_Items(arg);
+    }
+    else {
+        items = PySequence_List(arg);
+    }
+    if (items == NULL) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(items); i++) {
+        PyObject *item = PySequence_Fast(PyList_GET_ITEM(items, i), "");
+        if (item == NULL) {
+            if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+                PyErr_Format(PyExc_TypeError,
+                    "cannot convert dictionary update "
+                    "sequence element #%zd to a sequence", i);
+            }
+            goto error;
+        }
+        if (PySequence_Fast_GET_SIZE(item) != 2) {
+            PyErr_Format(PyExc_ValueError,
+                         "dictionary update sequence element #%zd "
+                         "has length %zd; 2 is required",
+                         i, PySequence_Fast_GET_SIZE(item));
+            Py_DECREF(item);
+            goto error;
+        }
+        int rc = sdict_setitem_lock_held(sd, PySequence_Fast_GET_ITEM(item, 0),
+                                         PySequence_Fast_GET_ITEM(item, 1));
+        Py_DECREF(item);
+        if (rc < 0) {
+            goto error;
+        }
+    }
+    Py_DECREF(items);
+    return 0;
+
+error:
+    Py_DECREF(items);
+    return -1;
+}
+
+/*[clinic input]
+@classmethod
+_collections.ScalarDict.__new__ as sdict_new
+
+    typecode: int(accept={str})
+    mapping_or_iterable as arg: object(c_default="NULL") = ()
+    /
+
+Mapping from keys to numbers stored as C values.
+
+The typecode is 'q' for 64-bit signed integers or 'd' for floats.
+Values are converted to Python objects when they are read.
+[clinic start generated code]*/
+
+static PyObject *
+sdict_new_impl(PyTypeObject *type, int typecode, PyObject *arg)
+/*[clinic end generated code: output=461640318f6eb028 input=845765ecb58525fc]*/
+{
+    if (typecode != 'q' && typecode != 'd') {
+        PyErr_SetString(PyExc_ValueError,
+                        "typecode must be 'q' or 'd'");
+        return NULL;
+    }
+    sdictobject *sd = (sdictobject *)type->tp_alloc(type, 0);
+    if (sd == NULL) {
+        return NULL;
+    }
+    sd->typecode = (char)typecode;
+    if (arg != NULL && sdict_update_lock_held(sd, arg) < 0) {
+        Py_DECREF(sd);
+        return NULL;
+    }
+    return (PyObject *)sd;
+}
+
+static Py_ssize_t
+sdict_length(PyObject *self)
+{
+    return FT_ATOMIC_LOAD_SSIZE_RELAXED(sdictobject_CAST(self)->used);
+}
+
+static PyObject *
+sdict_subscript(PyObject *self, PyObject *key)
+{
+    sdictobject *sd = sdictobject_CAST(self);
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    PyObject *result = NULL;
+    Py_BEGIN_CRITICAL_SECTION(sd);
+    Py_ssize_t ix = sdict_lookup(sd, key, hash, NULL);
+    if (ix >= 0) {
+        result = sdict_box(sd, sd->entries[ix].value);
+    }
+    else if (ix == SD_EMPTY) {
+        _PyErr_SetKeyError(key);
+    }
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
+
+static int
+sdict_ass_subscript(PyObject *self, PyObject *key, PyObject *value)
+{
+    sdictobject *sd = sdictobject_CAST(self);
+    int rc;
+    Py_BEGIN_CRITICAL_SECTION(sd);
+    if (value != NULL) {
+        rc = sdict_setitem_lock_held(sd, key, value);
+    }
+    else {
+        rc = sdict_delitem_lock_held(sd, key, NULL);
+        if (rc == 0) {
+            _PyErr_SetKeyError(key);
+            rc = -1;
+        }
+        else if (rc > 0) {
+            rc = 0;
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    return rc;
+}
+
+static int
+sdict_contains(PyObject *self, PyObject *key)
+{
+    sdictobject *sd = sdictobject_CAST(self);
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return -1;
+    }
+    Py_ssize_t ix;
+    Py_BEGIN_CRITICAL_SECTION(sd);
+    ix = sdict_lookup(sd, key, hash, NULL);
+    Py_END_CRITICAL_SECTION();
+    if (ix == SD_ERROR) {
+        return -1;
+    }
+    return ix >= 0;
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.get
+
+    self: self(type="sdictobject *")
+    key: object
+    default: object = None
+    /
+
+Return the value for key if key is in the dictionary, else default.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_get_impl(sdictobject *self, PyObject *key,
+                                 PyObject *default_value)
+/*[clinic end generated code: output=ce7fae86ac6487f9 input=5d5ff7b96bf6ddf8]*/
+{
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    Py_ssize_t ix = sdict_lookup(self, key, hash, NULL);
+    if (ix == SD_ERROR) {
+        return NULL;
+    }
+    if (ix == SD_EMPTY) {
+        return Py_NewRef(default_value);
+    }
+    return sdict_box(self, self->entries[ix].value);
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.pop
+
+    self: self(type="sdictobject *")
+    key: object
+    default: object = NULL
+    /
+
+Remove the key and return its value.
+
+If the key is not found, return the default if given; otherwise,
+raise a KeyError.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_pop_impl(sdictobject *self, PyObject *key,
+                                 PyObject *default_value)
+/*[clinic end generated code: output=fe6a677e9b783f0b input=69abe37ddc1c08b8]*/
+{
+    sdvalue value;
+    int rc = sdict_delitem_lock_held(self, key, &value);
+    if (rc < 0) {
+        return NULL;
+    }
+    if (rc == 0) {
+        if (default_value != NULL) {
+            return Py_NewRef(default_value);
+        }
+        _PyErr_SetKeyError(key);
+        return NULL;
+    }
+    return sdict_box(self, value);
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.add
+
+    self: self(type="sdictobject *")
+    key: object
+    amount: object
+    /
+
+Add amount to the value for key.
+
+A missing key is inserted with a value of amount.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_add_impl(sdictobject *self, PyObject *key,
+                                 PyObject *amount)
+/*[clinic end generated code: output=a28848bd7671c0cc input=bfdbf4e069d0ecb8]*/
+{
+    sdvalue value;
+    if (sdict_unbox(self, amount, &value) < 0) {
+        return NULL;
+    }
+    Py_hash_t hash = _PyObject_HashFast(key);
+    if (hash == -1) {
+        return NULL;
+    }
+    if (sdict_add_lock_held(self, key, hash, value) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.count
+
+    self: self(type="sdictobject *")
+    iterable: object
+    /
+
+Add 1 to the value for each element of iterable.
+
+Elements that are not keys yet are inserted with a value of 1.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_count_impl(sdictobject *self, PyObject *iterable)
+/*[clinic end generated code: output=93cf05eb6172d51f input=eadd6629bfd06cc4]*/
+{
+    PyObject *it = PyObject_GetIter(iterable);
+    if (it == NULL) {
+        return NULL;
+    }
+    int rc = sdict_count_lock_held(self, it);
+    Py_DECREF(it);
+    if (rc < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.update
+
+    self: self(type="sdictobject *")
+    mapping_or_iterable as arg: object
+    /
+
+Set the values for the items of a mapping or an iterable of pairs.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_update_impl(sdictobject *self, PyObject *arg)
+/*[clinic end generated code: output=25ecceb6ccadf5d6 input=30d859a3f889b6e6]*/
+{
+    if (sdict_update_lock_held(self, arg) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.clear
+
+    self: self(type="sdictobject *")
+
+Remove all items.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_clear_impl(sdictobject *self)
+/*[clinic end generated code: output=6aa936e35b1bd8f5 input=485c71b74f7321f2]*/
+{
+    sdict_clear_lock_held(self);
+    Py_RETURN_NONE;
+}
+
+/* Return a list of the keys (kind 0), values (kind 1) or items (kind 2). */
+static PyObject *
+sdict_list_lock_held(sdictobject *sd, int kind)
+{
+    PyObject *result = PyList_New(sd->used);
+    if (result == NULL) {
+        return NULL;
+    }
+    Py_ssize_t n = 0;
+    for (Py_ssize_t ix = 0; ix < sd->nentries; ix++) {
+        sdentry *ep = &sd->entries[ix];
+        if (ep->key == NULL) {
+            continue;
+        }
+        PyObject *item;
+        if (kind == 0) {
+            item = Py_NewRef(ep->key);
+        }
+        else {
+            item = sdict_box(sd, ep->value);
+            if (item != NULL && kind == 2) {
+                PyObject *value = item;
+                item = PyTuple_Pack(2, ep->key, value);
+                Py_DECREF(value);
+            }
+        }
+        if (item == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, n, item);
+        n++;
+    }
+    assert(n == sd->used);
+    return result;
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.keys
+
+    self: self(type="sdictobject *")
+
+Return a list of the keys.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_keys_impl(sdictobject *self)
+/*[clinic end generated code: output=59a6fde0bfc312ff input=d975f46a2f2e0155]*/
+{
+    return sdict_list_lock_held(self, 0);
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.values
+
+    self: self(type="sdictobject *")
+
+Return a list of the values.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_values_impl(sdictobject *self)
+/*[clinic end generated code: output=e16c20bb665e6be9 input=b60de1d78d9120c6]*/
+{
+    return sdict_list_lock_held(self, 1);
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.items
+
+    self: self(type="sdictobject *")
+
+Return a list of the (key, value) pairs.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict_items_impl(sdictobject *self)
+/*[clinic end generated code: output=96047dba11951324 input=bbf30cd447e04c69]*/
+{
+    return sdict_list_lock_held(self, 2);
+}
+
+/*[clinic input]
+_collections.ScalarDict.__reduce__
+
+    self: self(type="sdictobject *")
+
+Return state information for pickling.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict___reduce___impl(sdictobject *self)
+/*[clinic end generated code: output=8e3bfcd24ce9aaf4 input=789eb71d44790cb3]*/
+{
+    PyObject *items = _collections_ScalarDict_items((PyObject *)self, NULL);
+    if (items == NULL) {
+        return NULL;
+    }
+    return Py_BuildValue("O(CN)", Py_TYPE(self), self->typecode, items);
+}
+
+/*[clinic input]
+@critical_section
+_collections.ScalarDict.__sizeof__
+
+    self: self(type="sdictobject *")
+
+Return the size in memory, in bytes.
+[clinic start generated code]*/
+
+static PyObject *
+_collections_ScalarDict___sizeof___impl(sdictobject *self)
+/*[clinic end generated code: output=49f83e0b90847fdb input=6f0d311304858067]*/
+{
+    size_t res = _PyObject_SIZE(Py_TYPE(self));
+    if (self->indices != NULL) {
+        size_t size = (size_t)1 << self->log2size;
+        size_t usable = SD_USABLE(size);
+        res += size * sizeof(int32_t) + usable * sizeof(sdentry);
+        if (self->hashes != NULL) {
+            res += usable * sizeof(Py_hash_t);
+        }
+    }
+    return PyLong_FromSize_t(res);
+}
+
+static PyObject *
+sdict_get_typecode(PyObject *self, void *Py_UNUSED(closure))
+{
+    return PyUnicode_FromOrdinal(sdictobject_CAST(self)->typecode);
+}
+
+/* Return a dict with the items of sd. */
+static PyObject *
+sdict_to_dict(PyObject *sd)
+{
+    PyObject *items = _collections_ScalarDict_items(sd, NULL);
+    if (items == NULL) {
+        return NULL;
+    }
+    PyObject *dict = PyDict_New();
+    if (dict != NULL && PyDict_MergeFromSeq2(dict, items, 1) < 0) {
+        Py_CLEAR(dict);
+    }
+    Py_DECREF(items);
+    return dict;
+}
+
+static PyObject *
+sdict_repr(PyObject *self)
+{
+    sdictobject *sd = sdictobject_CAST(self);
+    int status = Py_ReprEnter(self);
+    if (status != 0) {
+        if (status < 0) {
+            return NULL;
+        }
+        return PyUnicode_FromFormat("%s(...)", _PyType_Name(Py_TYPE(self)));
+    }
+    PyObject *result = NULL;
+    PyObject *dict = sdict_to_dict(self);
+    if (dict != NULL) {
+        result = PyUnicode_FromFormat("%s('%c', %R)",
+                                      _PyType_Name(Py_TYPE(self)),
+                                      sd->typecode, dict);
+        Py_DECREF(dict);
+    }
+    Py_ReprLeave(self);
+    return result;
+}
+
+static PyObject *
+sdict_richcompare(PyObject *self, PyObject *other, int op)
+{
+    collections_state *state = find_module_state_by_def(Py_TYPE(self));
+    int other_is_sdict = PyObject_TypeCheck(other, state->sdict_type);
+    if ((op != Py_EQ && op != Py_NE) ||
+        !(PyDict_Check(other) || other_is_sdict))
+    {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject *a = sdict_to_dict(self);
+    if (a == NULL) {
+        return NULL;
+    }
+    PyObject *b = other_is_sdict ? sdict_to_dict(other) : Py_NewRef(other);
+    if (b == NULL) {
+        Py_DECREF(a);
+        return NULL;
+    }
+    PyObject *result = PyObject_RichCompare(a, b, op);
+    Py_DECREF(a);
+    Py_DECREF(b);
+    return result;
+}
+
+static int
+sdict_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    sdictobject *sd = sdictobject_CAST(self);
+    Py_VISIT(Py_TYPE(sd));
+    for (Py_ssize_t i = 0; i < sd->nentries; i++) {
+        Py_VISIT(sd->entries[i].key);
+    }
+    return 0;
+}
+
+static int
+sdict_tp_clear(PyObject *self)
+{
+    sdict_clear_lock_held(sdictobject_CAST(self));
+    return 0;
+}
+
+static void
+sdict_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    (void)sdict_tp_clear(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+/* Iterator over the keys of a ScalarDict. */
+
+typedef struct {
+    PyObject_HEAD
+    sdictobject *sd;        /* NULL when exhausted */
+    Py_ssize_t pos;
+    Py_ssize_t used;
+} sdictiterobject;
+
+#define sdictiterobject_CAST(op)  ((sdictiterobject *)(op))
+
+static PyObject *
+sdict_iter(PyObject *self)
+{
+    collections_state *state = find_module_state_by_def(Py_TYPE(self));
+    sdictiterobject *it = PyObject_GC_New(sdictiterobject,
+                                          state->sdictiter_type);
+    if (it == NULL) {
+        return NULL;
+    }
+    it->sd = (sdictobject *)Py_NewRef(self);
+    it->pos = 0;
+    it->used = sdict_length(self);
+    PyObject_GC_Track(it);
+    return (PyObject *)it;
+}
+
+static PyObject *
+sdictiter_next(PyObject *op)
+{
+    sdictiterobject *it = sdictiterobject_CAST(op);
+    sdictobject *sd = it->sd;
+    PyObject *key = NULL;
+    if (sd == NULL) {
+        return NULL;
+    }
+    Py_BEGIN_CRITICAL_SECTION(sd);
+    if (sd->used != it->used) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "ScalarDict changed size during iteration");
+        it->used = -1;  /* Make this state sticky */
+    }
+    else {
+        while (it->pos < sd->nentries) {
+            key = sd->entries[it->pos++].key;
+            if (key != NULL) {
+                Py_INCREF(key);
+                break;
+            }
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    if (key == NULL && !PyErr_Occurred()) {
+        it->sd = NULL;
+        Py_DECREF(sd);
+    }
+    return key;
+}
+
+static int
+sdictiter_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    sdictiterobject *it = sdictiterobject_CAST(op);
+    Py_VISIT(Py_TYPE(it));
+    Py_VISIT(it->sd);
+    return 0;
+}
+
+static void
+sdictiter_dealloc(PyObject *op)
+{
+    sdictiterobject *it = sdictiterobject_CAST(op);
+    PyTypeObject *tp = Py_TYPE(it);
+    PyObject_GC_UnTrack(it);
+    Py_XDECREF(it->sd);
+    PyObject_GC_Del(it);
+    Py_DECREF(tp);
+}
+
+static PyType_Slot sdictiter_slots[] = {
+    {Py_tp_dealloc, sdictiter_dealloc},
+    {Py_tp_getattro, PyObject_GenericGetAttr},
+    {Py_tp_traverse, sdictiter_traverse},
+    {Py_tp_iter, PyObject_SelfIter},
+    {Py_tp_iternext, sdictiter_next},
+    {0, NULL},
+};
+
+static PyType_Spec sdictiter_spec = {
+    .name = "collections._scalar_dict_iterator",
+    .basicsize = sizeof(sdictiterobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION),
+    .slots = sdictiter_slots,
+};
+
+static PyMethodDef sdict_methods[] = {
+    _COLLECTIONS_SCALARDICT_GET_METHODDEF
+    _COLLECTIONS_SCALARDICT_POP_METHODDEF
+    _COLLECTIONS_SCALARDICT_ADD_METHODDEF
+    _COLLECTIONS_SCALARDICT_COUNT_METHODDEF
+    _COLLECTIONS_SCALARDICT_UPDATE_METHODDEF
+    _COLLECTIONS_SCALARDICT_CLEAR_METHODDEF
+    _COLLECTIONS_SCALARDICT_KEYS_METHODDEF
+    _COLLECTIONS_SCALARDICT_VALUES_METHODDEF
+    _COLLECTIONS_SCALARDICT_ITEMS_METHODDEF
+    _COLLECTIONS_SCALARDICT___REDUCE___METHODDEF
+    _COLLECTIONS_SCALARDICT___SIZEOF___METHODDEF
+    {"__class_getitem__", Py_GenericAlias, METH_O|METH_CLASS,
+     PyDoc_STR("See PEP 585")},
+    {NULL}
+};
+
+static PyGetSetDef sdict_getset[] = {
+    {"typecode", sdict_get_typecode, NULL,
+     PyDoc_STR("the typecode character used to create the ScalarDict")},
+    {NULL}
+};
+
+static PyType_Slot sdict_slots[] = {
+    {Py_tp_dealloc, sdict_dealloc},
+    {Py_tp_repr, sdict_repr},
+    {Py_tp_richcompare, sdict_richcompare},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+    {Py_tp_doc, (void *)sdict_new__doc__},
+    {Py_tp_traverse, sdict_traverse},
+    {Py_tp_clear, sdict_tp_clear},
+    {Py_tp_iter, sdict_iter},
+    {Py_tp_methods, sdict_methods},
+    {Py_tp_getset, sdict_getset},
+    {Py_tp_new, sdict_new},
+    {Py_mp_length, sdict_length},
+    {Py_mp_subscript, sdict_subscript},
+    {Py_mp_ass_subscript, sdict_ass_subscript},
+    {Py_sq_contains, sdict_contains},
+    {0, NULL},
+};
+
+static PyType_Spec sdict_spec = {
+    .name = "collections.ScalarDict",
+    .basicsize = sizeof(sdictobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_MAPPING),
+    .slots = sdict_slots,
+};
+
 /* helper function for Counter  *********************************************/
 
 /*[clinic input]
@@ -2536,6 +4165,15 @@ _collections__count_elements_impl(PyObject *module, PyObject *mapping,
     if (it == NULL)
         return NULL;
 
+    if (Py_IS_TYPE(mapping, get_module_state(module)->sdict_type)) {
+        /* Add to the unboxed counts without any lookup of methods. */
+        Py_BEGIN_CRITICAL_SECTION(mapping);
+        (void)sdict_count_lock_held((sdictobject *)mapping, it);
+        Py_END_CRITICAL_SECTION();
+        mapping_get = mapping_setitem = NULL;
+        goto done;
+    }
+
     /* Only take the fast path when get() and __setitem__()
      * have not been overridden.
      */
@@ -2789,6 +4427,9 @@ collections_traverse(PyObject *mod, visitproc visit, void *arg)
     Py_VISIT(state->dequeiter_type);
     Py_VISIT(state->dequereviter_type);
     Py_VISIT(state->tuplegetter_type);
+    Py_VISIT(state->cdict_type);
+    Py_VISIT(state->sdict_type);
+    Py_VISIT(state->sdictiter_type);
     return 0;
 }
 
@@ -2801,6 +4442,9 @@ collections_clear(PyObject *mod)
     Py_CLEAR(state->dequeiter_type);
     Py_CLEAR(state->dequereviter_type);
     Py_CLEAR(state->tuplegetter_type);
+    Py_CLEAR(state->cdict_type);
+    Py_CLEAR(state->sdict_type);
+    Py_CLEAR(state->sdictiter_type);
     return 0;
 }
 
@@ -2814,6 +4458,8 @@ PyDoc_STRVAR(collections_doc,
 "High performance data structures.\n\
 - deque:        ordered collection accessible from endpoints only\n\
 - defaultdict:  dict subclass with a default value factory\n\
+- ConcurrentDict: mapping for sharing items between threads\n\
+- ScalarDict:   mapping from keys to unboxed int64 or double values\n\
 ");
 
 static struct PyMethodDef collections_methods[] = {
@@ -2840,6 +4486,9 @@ collections_exec(PyObject *module) {
     ADD_TYPE(module, &dequeiter_spec, state->dequeiter_type, NULL);
     ADD_TYPE(module, &dequereviter_spec, state->dequereviter_type, NULL);
     ADD_TYPE(module, &tuplegetter_spec, state->tuplegetter_type, NULL);
+    ADD_TYPE(module, &cdict_spec, state->cdict_type, NULL);
+    ADD_TYPE(module, &sdict_spec, state->sdict_type, NULL);
+    ADD_TYPE(module, &sdictiter_spec, state->sdictiter_type, NULL);
 
     if (PyModule_AddType(module, &PyODict_Type) < 0) {
         return -1;
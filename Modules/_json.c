@@ -26,10 +26,30 @@ typedef struct _PyScannerObject {
     PyObject *parse_float;
     PyObject *parse_int;
     PyObject *parse_constant;
+    Py_ssize_t shape_hits;
+    Py_ssize_t shape_misses;
 } PyScannerObject;
 
 #define PyScannerObject_CAST(op)    ((PyScannerObject *)(op))
 
+/* Number of nesting levels for which the keys of the last object read are
+   remembered. */
+#define SHAPE_CACHE_SIZE 8
+
+/* State of a single call of the scanner */
+typedef struct {
+    PyObject *memo;         /* dict used to share equal key strings */
+    Py_ssize_t depth;       /* nesting level of the current value */
+    /* Tuple of the keys of the last object read at each nesting level.
+       Objects in JSON documents often share the same keys in the same
+       order; those keys can then be matched against the document without
+       decoding them again.  Keys that can't be matched that way (because
+       they contain escapes) are stored as None. */
+    PyObject *shapes[SHAPE_CACHE_SIZE];
+    Py_ssize_t shape_hits;
+    Py_ssize_t shape_misses;
+} ScannerState;
+
 static PyMemberDef scanner_members[] = {
     {"strict", Py_T_BOOL, offsetof(PyScannerObject, strict), Py_READONLY, "strict"},
     {"object_hook", _Py_T_OBJECT, offsetof(PyScannerObject, object_hook), Py_READONLY, "object_hook"},
@@ -37,6 +57,10 @@ static PyMemberDef scanner_members[] = {
     {"parse_float", _Py_T_OBJECT, offsetof(PyScannerObject, parse_float), Py_READONLY, "parse_float"},
     {"parse_int", _Py_T_OBJECT, offsetof(PyScannerObject, parse_int), Py_READONLY, "parse_int"},
     {"parse_constant", _Py_T_OBJECT, offsetof(PyScannerObject, parse_constant), Py_READONLY, "parse_constant"},
+    {"shape_hits", Py_T_PYSSIZET, offsetof(PyScannerObject, shape_hits), Py_READONLY,
+     "number of objects whose keys were all predicted by the shape cache"},
+    {"shape_misses", Py_T_PYSSIZET, offsetof(PyScannerObject, shape_misses), Py_READONLY,
+     "number of objects whose keys were not all predicted by the shape cache"},
     {NULL}
 };
 
@@ -76,7 +100,11 @@ static PyObject *
 py_encode_basestring_ascii(PyObject* Py_UNUSED(self), PyObject *pystr);
 
 static PyObject *
-scan_once_unicode(PyScannerObject *s, PyObject *memo, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
+scanstring_unicode(PyObject *pystr, Py_ssize_t end, int strict, Py_ssize_t *next_end_ptr);
+static PyObject *
+scan_once_unicode(PyScannerObject *s, ScannerState *st, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
+static PyObject *
+scan_once_utf8(PyScannerObject *s, ScannerState *st, const Py_buffer *view, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
 static PyObject *
 _build_rval_index_tuple(PyObject *rval, Py_ssize_t idx);
 static PyObject *
@@ -109,6 +137,79 @@ encoder_encode_float(PyEncoderObject *s, PyObject *obj);
 
 #define S_CHAR(c) (c >= ' ' && c <= '~' && c != '\\' && c != '"')
 #define IS_WHITESPACE(c) (((c) == ' ') || ((c) == '\t') || ((c) == '\n') || ((c) == '\r'))
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+
+/* Word-at-a-time helpers for scanning 1-byte kind strings.
+ *
+ * VECTOR_HAS_ZERO(v) is nonzero iff at least one byte of v is zero, and
+ * VECTOR_HAS_LESS(v, n) is nonzero iff at least one byte of v is less
+ * than n (for n <= 128).  Both are exact as a whole, but the individual
+ * flag bits may be set spuriously above the first matching byte, so
+ * callers only use them to decide whether a word can be skipped. */
+#if SIZEOF_SIZE_T == 8
+#  define VECTOR_0101 0x0101010101010101ULL
+#elif SIZEOF_SIZE_T == 4
+#  define VECTOR_0101 0x01010101U
+#else
+#  error C 'size_t' size should be either 4 or 8!
+#endif
+#define VECTOR_8080 (VECTOR_0101 * 0x80)
+#define VECTOR_HAS_LESS(v, n) (((v) - VECTOR_0101 * (n)) & ~(v) & VECTOR_8080)
+#define VECTOR_HAS_ZERO(v) VECTOR_HAS_LESS(v, 1)
+
+/* Return the index of the first word-sized block of s[start:len] that may
+ * contain a '"', a '\\' or (if strict) a control character.  The caller
+ * finishes the scan one character at a time from the returned index. */
+static inline Py_ssize_t
+skip_plain_chars_ucs1(const Py_UCS1 *s, Py_ssize_t start, Py_ssize_t len,
+                      int strict)
+{
+    const size_t quotes = VECTOR_0101 * '"';
+    const size_t backslashes = VECTOR_0101 * '\\';
+    Py_ssize_t i = start;
+
+    while (i + SIZEOF_SIZE_T <= len) {
+        size_t v;
+        memcpy(&v, s + i, SIZEOF_SIZE_T);
+        size_t special = VECTOR_HAS_ZERO(v ^ quotes) |
+                         VECTOR_HAS_ZERO(v ^ backslashes);
+        if (strict) {
+            special |= VECTOR_HAS_LESS(v, 0x20);
+        }
+        if (special) {
+            break;
+        }
+        i += SIZEOF_SIZE_T;
+    }
+    return i;
+}
+
+/* Return the index of the first non-digit character in str[idx:len]. */
+static inline Py_ssize_t
+skip_digits(int kind, const void *str, Py_ssize_t idx, Py_ssize_t len)
+{
+    if (kind == PyUnicode_1BYTE_KIND) {
+        const Py_UCS1 *s = (const Py_UCS1 *)str;
+        const size_t zeros = VECTOR_0101 * '0';
+        /* After XOR with '0' every digit is in the range 0..9 and every
+           other character is >= 10, so adding 0x76 sets the high bit of
+           each byte that was not a digit. */
+        const size_t bias = VECTOR_0101 * (0x80 - 10);
+        while (idx + SIZEOF_SIZE_T <= len) {
+            size_t v;
+            memcpy(&v, s + idx, SIZEOF_SIZE_T);
+            v ^= zeros;
+            if (((v + bias) | v) & VECTOR_8080) {
+                break;
+            }
+            idx += SIZEOF_SIZE_T;
+        }
+    }
+    while (idx < len && IS_DIGIT(PyUnicode_READ(kind, str, idx))) {
+        idx++;
+    }
+    return idx;
+}
 
 static Py_ssize_t
 ascii_escape_unichar(Py_UCS4 c, unsigned char *output, Py_ssize_t chars)
@@ -360,182 +461,6 @@ _build_rval_index_tuple(PyObject *rval, Py_ssize_t idx) {
     return tpl;
 }
 
-static PyObject *
-scanstring_unicode(PyObject *pystr, Py_ssize_t end, int strict, Py_ssize_t *next_end_ptr)
-{
-    /* Read the JSON string from PyUnicode pystr.
-    end is the index of the first character after the quote.
-    if strict is zero then literal control characters are allowed
-    *next_end_ptr is a return-by-reference index of the character
-        after the end quote
-
-    Return value is a new PyUnicode
-    */
-    PyObject *rval = NULL;
-    Py_ssize_t len;
-    Py_ssize_t begin = end - 1;
-    Py_ssize_t next /* = begin */;
-    const void *buf;
-    int kind;
-
-    PyUnicodeWriter *writer = NULL;
-
-    len = PyUnicode_GET_LENGTH(pystr);
-    buf = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
-
-    if (end < 0 || len < end) {
-        PyErr_SetString(PyExc_ValueError, "end is out of bounds");
-        goto bail;
-    }
-    while (1) {
-        /* Find the end of the string or the next escape */
-        Py_UCS4 c;
-        {
-            // Use tight scope variable to help register allocation.
-            Py_UCS4 d = 0;
-            for (next = end; next < len; next++) {
-                d = PyUnicode_READ(kind, buf, next);
-                if (d == '"' || d == '\\') {
-                    break;
-                }
-                if (d <= 0x1f && strict) {
-                    raise_errmsg("Invalid control character at", pystr, next);
-                    goto bail;
-                }
-            }
-            c = d;
-        }
-
-        if (c == '"') {
-            // Fast path for simple case.
-            if (writer == NULL) {
-                PyObject *ret = PyUnicode_Substring(pystr, end, next);
-                if (ret == NULL) {
-                    goto bail;
-                }
-                *next_end_ptr = next + 1;;
-                return ret;
-            }
-        }
-        else if (c != '\\') {
-            raise_errmsg("Unterminated string starting at", pystr, begin);
-            goto bail;
-        } else if (writer == NULL) {
-            writer = PyUnicodeWriter_Create(0);
-            if (writer == NULL) {
-                goto bail;
-            }
-        }
-
-        /* Pick up this chunk if it's not zero length */
-        if (next != end) {
-            if (PyUnicodeWriter_WriteSubstring(writer, pystr, end, next) < 0) {
-                goto bail;
-            }
-        }
-        next++;
-        if (c == '"') {
-            end = next;
-            break;
-        }
-        if (next == len) {
-            raise_errmsg("Unterminated string starting at", pystr, begin);
-            goto bail;
-        }
-        c = PyUnicode_READ(kind, buf, next);
-        if (c != 'u') {
-            /* Non-unicode backslash escapes */
-            end = next + 1;
-            switch (c) {
-                case '"': break;
-                case '\\': break;
-                case '/': break;
-                case 'b': c = '\b'; break;
-                case 'f': c = '\f'; break;
-                case 'n': c = '\n'; break;
-                case 'r': c = '\r'; break;
-                case 't': c = '\t'; break;
-                default: c = 0;
-            }
-            if (c == 0) {
-                raise_errmsg("Invalid \\escape", pystr, end - 2);
-                goto bail;
-            }
-        }
-        else {
-            c = 0;
-            next++;
-            end = next + 4;
-            if (end >= len) {
-                raise_errmsg("Invalid \\uXXXX escape", pystr, next - 1);
-                goto bail;
-            }
-            /* Decode 4 hex digits */
-            for (; next < end; next++) {
-                Py_UCS4 digit = PyUnicode_READ(kind, buf, next);
-                c <<= 4;
-                switch (digit) {
-                    case '0': case '1': case '2': case '3': case '4':
-                    case '5': case '6': case '7': case '8': case '9':
-                        c |= (digit - '0'); break;
-                    case 'a': case 'b': case 'c': case 'd': case 'e':
-                    case 'f':
-                        c |= (digit - 'a' + 10); break;
-                    case 'A': case 'B': case 'C': case 'D': case 'E':
-                    case 'F':
-                        c |= (digit - 'A' + 10); break;
-                    default:
-                        raise_errmsg("Invalid \\uXXXX escape", pystr, end - 5);
-                        goto bail;
-                }
-            }
-            /* Surrogate pair */
-            if (Py_UNICODE_IS_HIGH_SURROGATE(c) && end + 6 < len &&
-                PyUnicode_READ(kind, buf, next++) == '\\' &&
-                PyUnicode_READ(kind, buf, next++) == 'u') {
-                Py_UCS4 c2 = 0;
-                end += 6;
-                /* Decode 4 hex digits */
-                for (; next < end; next++) {
-                    Py_UCS4 digit = PyUnicode_READ(kind, buf, next);
-                    c2 <<= 4;
-                    switch (digit) {
-                        case '0': case '1': case '2': case '3': case '4':
-                        case '5': case '6': case '7': case '8': case '9':
-                            c2 |= (digit - '0'); break;
-                        case 'a': case 'b': case 'c': case 'd': case 'e':
-                        case 'f':
-                            c2 |= (digit - 'a' + 10); break;
-                        case 'A': case 'B': case 'C': case 'D': case 'E':
-                        case 'F':
-                            c2 |= (digit - 'A' + 10); break;
-                        default:
-                            raise_errmsg("Invalid \\uXXXX escape", pystr, end - 5);
-                            goto bail;
-                    }
-                }
-                if (Py_UNICODE_IS_LOW_SURROGATE(c2))
-                    c = Py_UNICODE_JOIN_SURROGATES(c, c2);
-                else
-                    end -= 6;
-            }
-        }
-        if (PyUnicodeWriter_WriteChar(writer, c) < 0) {
-            goto bail;
-        }
-    }
-
-    rval = PyUnicodeWriter_Finish(writer);
-    *next_end_ptr = end;
-    return rval;
-
-bail:
-    *next_end_ptr = -1;
-    PyUnicodeWriter_Discard(writer);
-    return NULL;
-}
-
 PyDoc_STRVAR(pydoc_scanstring,
     "scanstring(string, end, strict=True) -> (string, end)\n"
     "\n"
@@ -657,215 +582,115 @@ scanner_clear(PyObject *op)
     return 0;
 }
 
+/* Return a new reference to the keys of the last object read at the current
+   nesting level, or NULL if there is none. */
 static PyObject *
-_parse_object_unicode(PyScannerObject *s, PyObject *memo, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+shape_lookup(ScannerState *st)
 {
-    /* Read a JSON object from PyUnicode pystr.
-    idx is the index of the first character after the opening curly brace.
-    *next_idx_ptr is a return-by-reference index to the first character after
-        the closing curly brace.
-
-    Returns a new PyObject (usually a dict, but object_hook can change that)
-    */
-    const void *str;
-    int kind;
-    Py_ssize_t end_idx;
-    PyObject *val = NULL;
-    PyObject *rval = NULL;
-    PyObject *key = NULL;
-    int has_pairs_hook = (s->object_pairs_hook != Py_None);
-    Py_ssize_t next_idx;
-    Py_ssize_t comma_idx;
-
-    str = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
-    end_idx = PyUnicode_GET_LENGTH(pystr) - 1;
+    return Py_XNewRef(st->shapes[st->depth % SHAPE_CACHE_SIZE]);
+}
 
-    if (has_pairs_hook)
-        rval = PyList_New(0);
-    else
-        rval = PyDict_New();
-    if (rval == NULL)
+/* The nkeys-th key of an object did not match shape: return a new list
+   holding the nkeys keys read so far. */
+static PyObject *
+shape_mismatch(PyObject *shape, Py_ssize_t nkeys)
+{
+    PyObject *keys = PyList_New(nkeys);
+    if (keys == NULL) {
         return NULL;
+    }
+    for (Py_ssize_t i = 0; i < nkeys; i++) {
+        PyList_SET_ITEM(keys, i, Py_NewRef(PyTuple_GET_ITEM(shape, i)));
+    }
+    return keys;
+}
 
-    /* skip whitespace after { */
-    while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind,str, idx))) idx++;
-
-    /* only loop if the object is non-empty */
-    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != '}') {
-        while (1) {
-            PyObject *memokey;
-
-            /* read key */
-            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != '"') {
-                raise_errmsg("Expecting property name enclosed in double quotes", pystr, idx);
-                goto bail;
-            }
-            key = scanstring_unicode(pystr, idx + 1, s->strict, &next_idx);
-            if (key == NULL)
-                goto bail;
-            if (PyDict_SetDefaultRef(memo, key, key, &memokey) < 0) {
-                goto bail;
-            }
-            Py_SETREF(key, memokey);
-            idx = next_idx;
-
-            /* skip whitespace between key and : delimiter, read :, skip whitespace */
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ':') {
-                raise_errmsg("Expecting ':' delimiter", pystr, idx);
-                goto bail;
-            }
-            idx++;
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-
-            /* read any JSON term */
-            val = scan_once_unicode(s, memo, pystr, idx, &next_idx);
-            if (val == NULL)
-                goto bail;
-
-            if (has_pairs_hook) {
-                PyObject *item = PyTuple_Pack(2, key, val);
-                if (item == NULL)
-                    goto bail;
-                Py_CLEAR(key);
-                Py_CLEAR(val);
-                if (PyList_Append(rval, item) == -1) {
-                    Py_DECREF(item);
-                    goto bail;
-                }
-                Py_DECREF(item);
-            }
-            else {
-                if (PyDict_SetItem(rval, key, val) < 0)
-                    goto bail;
-                Py_CLEAR(key);
-                Py_CLEAR(val);
-            }
-            idx = next_idx;
-
-            /* skip whitespace before } or , */
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-
-            /* bail if the object is closed or we didn't get the , delimiter */
-            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == '}')
-                break;
-            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ',') {
-                raise_errmsg("Expecting ',' delimiter", pystr, idx);
-                goto bail;
-            }
-            comma_idx = idx;
-            idx++;
-
-            /* skip whitespace after , delimiter */
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-
-            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == '}') {
-                raise_errmsg("Illegal trailing comma before end of object", pystr, comma_idx);
-                goto bail;
-            }
+/* Update the shape cache once an object with nkeys keys has been read.
+   keys is NULL if all keys were predicted by shape. */
+static int
+shape_store(ScannerState *st, PyObject *shape, PyObject *keys, Py_ssize_t nkeys)
+{
+    PyObject *new_shape;
+    if (keys == NULL) {
+        if (nkeys == PyTuple_GET_SIZE(shape)) {
+            st->shape_hits++;
+            return 0;
         }
+        new_shape = PyTuple_GetSlice(shape, 0, nkeys);
     }
-
-    *next_idx_ptr = idx + 1;
-
-    if (has_pairs_hook) {
-        val = PyObject_CallOneArg(s->object_pairs_hook, rval);
-        Py_DECREF(rval);
-        return val;
+    else {
+        new_shape = PyList_AsTuple(keys);
     }
-
-    /* if object_hook is not None: rval = object_hook(rval) */
-    if (s->object_hook != Py_None) {
-        val = PyObject_CallOneArg(s->object_hook, rval);
-        Py_DECREF(rval);
-        return val;
+    if (new_shape == NULL) {
+        return -1;
     }
-    return rval;
-bail:
-    Py_XDECREF(key);
-    Py_XDECREF(val);
-    Py_XDECREF(rval);
-    return NULL;
+    st->shape_misses++;
+    Py_XSETREF(st->shapes[st->depth % SHAPE_CACHE_SIZE], new_shape);
+    return 0;
 }
 
-static PyObject *
-_parse_array_unicode(PyScannerObject *s, PyObject *memo, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr) {
-    /* Read a JSON array from PyUnicode pystr.
-    idx is the index of the first character after the opening brace.
-    *next_idx_ptr is a return-by-reference index to the first character after
-        the closing brace.
-
-    Returns a new PyList
-    */
-    const void *str;
-    int kind;
-    Py_ssize_t end_idx;
-    PyObject *val = NULL;
-    PyObject *rval;
-    Py_ssize_t next_idx;
-    Py_ssize_t comma_idx;
-
-    rval = PyList_New(0);
-    if (rval == NULL)
-        return NULL;
-
-    str = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
-    end_idx = PyUnicode_GET_LENGTH(pystr) - 1;
-
-    /* skip whitespace after [ */
-    while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-
-    /* only loop if the array is non-empty */
-    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ']') {
-        while (1) {
-
-            /* read any JSON term  */
-            val = scan_once_unicode(s, memo, pystr, idx, &next_idx);
-            if (val == NULL)
-                goto bail;
-
-            if (PyList_Append(rval, val) == -1)
-                goto bail;
-
-            Py_CLEAR(val);
-            idx = next_idx;
-
-            /* skip whitespace between term and , */
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
-
-            /* bail if the array is closed or we didn't get the , delimiter */
-            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == ']')
-                break;
-            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ',') {
-                raise_errmsg("Expecting ',' delimiter", pystr, idx);
-                goto bail;
-            }
-            comma_idx = idx;
-            idx++;
-
-            /* skip whitespace after , */
-            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+/* Record key, read from a string literal of raw_len characters, as the
+   nkeys-th key of an object whose keys did not match the cached shape.
+   Only keys without escapes can be matched against the document later,
+   others are recorded as None. */
+static int
+shape_append(PyObject *keys, PyObject *key, Py_ssize_t raw_len)
+{
+    if (raw_len != PyUnicode_GET_LENGTH(key)) {
+        key = Py_None;
+    }
+    return PyList_Append(keys, key);
+}
 
-            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == ']') {
-                raise_errmsg("Illegal trailing comma before end of array", pystr, comma_idx);
-                goto bail;
+/* Check whether the string literal starting after the opening quote at
+   pystr[idx] consists of exactly the characters of key.  Return the index
+   after its closing quote, or -1. */
+static Py_ssize_t
+match_key_unicode(PyObject *pystr, Py_ssize_t idx, PyObject *key)
+{
+    Py_ssize_t len = PyUnicode_GET_LENGTH(key);
+    int kind = PyUnicode_KIND(pystr);
+    const void *str = PyUnicode_DATA(pystr);
+    int key_kind = PyUnicode_KIND(key);
+    const void *key_str = PyUnicode_DATA(key);
+
+    if (idx + len >= PyUnicode_GET_LENGTH(pystr) ||
+        PyUnicode_READ(kind, str, idx + len) != '"')
+    {
+        return -1;
+    }
+    if (kind == key_kind) {
+        if (memcmp((const char *)str + idx * kind, key_str, len * kind) != 0) {
+            return -1;
+        }
+    }
+    else {
+        for (Py_ssize_t i = 0; i < len; i++) {
+            if (PyUnicode_READ(kind, str, idx + i) !=
+                PyUnicode_READ(key_kind, key_str, i))
+            {
+                return -1;
             }
         }
     }
+    return idx + len + 1;
+}
 
-    /* verify that idx < end_idx, PyUnicode_READ(kind, str, idx) should be ']' */
-    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ']') {
-        raise_errmsg("Expecting value", pystr, end_idx);
-        goto bail;
+/* Same as match_key_unicode() for the UTF-8 buffer view.  Only ASCII keys
+   are matched. */
+static Py_ssize_t
+match_key_utf8(const Py_buffer *view, Py_ssize_t idx, PyObject *key)
+{
+    const Py_UCS1 *str = (const Py_UCS1 *)view->buf;
+    Py_ssize_t len = PyUnicode_GET_LENGTH(key);
+
+    if (!PyUnicode_IS_ASCII(key) || idx + len >= view->len ||
+        str[idx + len] != '"' ||
+        memcmp(str + idx, PyUnicode_1BYTE_DATA(key), len) != 0)
+    {
+        return -1;
     }
-    *next_idx_ptr = idx + 1;
-    return rval;
-bail:
-    Py_XDECREF(val);
-    Py_DECREF(rval);
-    return NULL;
+    return idx + len + 1;
 }
 
 static PyObject *
@@ -894,233 +719,110 @@ _parse_constant(PyScannerObject *s, const char *constant, Py_ssize_t idx, Py_ssi
     return rval;
 }
 
-static PyObject *
-_match_number_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t start, Py_ssize_t *next_idx_ptr) {
-    /* Read a JSON number from PyUnicode pystr.
-    idx is the index of the first character of the number
-    *next_idx_ptr is a return-by-reference index to the first character after
-        the number.
-
-    Returns a new PyObject representation of that number:
-        PyLong, or PyFloat.
-        May return other types if parse_int or parse_float are set
-    */
-    const void *str;
-    int kind;
-    Py_ssize_t end_idx;
-    Py_ssize_t idx = start;
-    int is_float = 0;
-    PyObject *rval;
-    PyObject *numstr = NULL;
-    PyObject *custom_func;
-
-    str = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
-    end_idx = PyUnicode_GET_LENGTH(pystr) - 1;
-
-    /* read a sign if it's there, make sure it's not the end of the string */
-    if (PyUnicode_READ(kind, str, idx) == '-') {
-        idx++;
-        if (idx > end_idx) {
-            raise_stop_iteration(start);
-            return NULL;
-        }
-    }
+/* Scanner for UTF-8 encoded buffers (bytes, bytearray, memoryview, mmap...).
+ *
+ * Both scanners are instantiated from _json_scanner.h.  The UTF-8 one works
+ * on byte offsets into the buffer and only decodes the string tokens it
+ * returns.  String tokens are decoded strictly (with surrogatepass, like
+ * json.loads()), so a document that scans successfully is valid UTF-8.
+ *
+ * Errors are reported against the decoded document, so that the exception
+ * is the same as if the buffer had been decoded to str first. */
 
-    /* read as many integer digits as we find as long as it doesn't start with 0 */
-    if (PyUnicode_READ(kind, str, idx) >= '1' && PyUnicode_READ(kind, str, idx) <= '9') {
-        idx++;
-        while (idx <= end_idx && PyUnicode_READ(kind, str, idx) >= '0' && PyUnicode_READ(kind, str, idx) <= '9') idx++;
-    }
-    /* if it starts with 0 we only expect one integer digit */
-    else if (PyUnicode_READ(kind, str, idx) == '0') {
-        idx++;
-    }
-    /* no integer digits, error */
-    else {
-        raise_stop_iteration(start);
-        return NULL;
+static void
+raise_errmsg_utf8(const char *msg, const Py_buffer *view, Py_ssize_t end)
+{
+    /* Raise JSONDecodeError for the byte offset end of view */
+    const unsigned char *buf = (const unsigned char *)view->buf;
+    PyObject *pystr = PyUnicode_DecodeUTF8(view->buf, view->len,
+                                           "surrogatepass");
+    if (pystr == NULL) {
+        /* Invalid UTF-8: report the UnicodeDecodeError instead */
+        return;
     }
-
-    /* if the next char is '.' followed by a digit then read all float digits */
-    if (idx < end_idx && PyUnicode_READ(kind, str, idx) == '.' && PyUnicode_READ(kind, str, idx + 1) >= '0' && PyUnicode_READ(kind, str, idx + 1) <= '9') {
-        is_float = 1;
-        idx += 2;
-        while (idx <= end_idx && PyUnicode_READ(kind, str, idx) >= '0' && PyUnicode_READ(kind, str, idx) <= '9') idx++;
+    /* The buffer is valid UTF-8, so every byte that is not a continuation
+       byte starts a character. */
+    Py_ssize_t pos = 0;
+    for (Py_ssize_t i = 0; i < end; i++) {
+        pos += (buf[i] & 0xc0) != 0x80;
     }
+    raise_errmsg(msg, pystr, pos);
+    Py_DECREF(pystr);
+}
 
-    /* if the next char is 'e' or 'E' then maybe read the exponent (or backtrack) */
-    if (idx < end_idx && (PyUnicode_READ(kind, str, idx) == 'e' || PyUnicode_READ(kind, str, idx) == 'E')) {
-        Py_ssize_t e_start = idx;
-        idx++;
-
-        /* read an exponent sign if present */
-        if (idx < end_idx && (PyUnicode_READ(kind, str, idx) == '-' || PyUnicode_READ(kind, str, idx) == '+')) idx++;
-
-        /* read all digits */
-        while (idx <= end_idx && PyUnicode_READ(kind, str, idx) >= '0' && PyUnicode_READ(kind, str, idx) <= '9') idx++;
-
-        /* if we got a digit, then parse as float. if not, backtrack */
-        if (PyUnicode_READ(kind, str, idx - 1) >= '0' && PyUnicode_READ(kind, str, idx - 1) <= '9') {
-            is_float = 1;
-        }
-        else {
-            idx = e_start;
-        }
+static void
+reraise_decode_error_utf8(const Py_buffer *view)
+{
+    /* A string token failed to decode.  Replace the exception by the one
+       raised when decoding the whole document. */
+    if (!PyErr_ExceptionMatches(PyExc_UnicodeDecodeError)) {
+        return;
     }
-
-    if (is_float && s->parse_float != (PyObject *)&PyFloat_Type)
-        custom_func = s->parse_float;
-    else if (!is_float && s->parse_int != (PyObject *) &PyLong_Type)
-        custom_func = s->parse_int;
-    else
-        custom_func = NULL;
-
-    if (custom_func) {
-        /* copy the section we determined to be a number */
-        numstr = PyUnicode_FromKindAndData(kind,
-                                           (char*)str + kind * start,
-                                           idx - start);
-        if (numstr == NULL)
-            return NULL;
-        rval = PyObject_CallOneArg(custom_func, numstr);
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *pystr = PyUnicode_DecodeUTF8(view->buf, view->len,
+                                           "surrogatepass");
+    if (pystr == NULL) {
+        Py_DECREF(exc);
     }
     else {
-        Py_ssize_t i, n;
-        char *buf;
-        /* Straight conversion to ASCII, to avoid costly conversion of
-           decimal unicode digits (which cannot appear here) */
-        n = idx - start;
-        numstr = PyBytes_FromStringAndSize(NULL, n);
-        if (numstr == NULL)
-            return NULL;
-        buf = PyBytes_AS_STRING(numstr);
-        for (i = 0; i < n; i++) {
-            buf[i] = (char) PyUnicode_READ(kind, str, i + start);
-        }
-        if (is_float)
-            rval = PyFloat_FromString(numstr);
-        else
-            rval = PyLong_FromString(buf, NULL, 10);
+        Py_DECREF(pystr);
+        PyErr_SetRaisedException(exc);
     }
-    Py_DECREF(numstr);
-    *next_idx_ptr = idx;
-    return rval;
 }
 
+/* Return the str decoded from view[start:end]. */
 static PyObject *
-scan_once_unicode(PyScannerObject *s, PyObject *memo, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+substring_utf8(const Py_buffer *view, Py_ssize_t start, Py_ssize_t end)
 {
-    /* Read one JSON term (of any kind) from PyUnicode pystr.
-    idx is the index of the first character of the term
-    *next_idx_ptr is a return-by-reference index to the first character after
-        the number.
-
-    Returns a new PyObject representation of the term.
-    */
-    PyObject *res;
-    const void *str;
-    int kind;
-    Py_ssize_t length;
-
-    str = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
-    length = PyUnicode_GET_LENGTH(pystr);
-
-    if (idx < 0) {
-        PyErr_SetString(PyExc_ValueError, "idx cannot be negative");
-        return NULL;
-    }
-    if (idx >= length) {
-        raise_stop_iteration(idx);
-        return NULL;
+    PyObject *res = PyUnicode_DecodeUTF8((const char *)view->buf + start,
+                                         end - start, "surrogatepass");
+    if (res == NULL) {
+        reraise_decode_error_utf8(view);
     }
+    return res;
+}
 
-    switch (PyUnicode_READ(kind, str, idx)) {
-        case '"':
-            /* string */
-            return scanstring_unicode(pystr, idx + 1, s->strict, next_idx_ptr);
-        case '{':
-            /* object */
-            if (_Py_EnterRecursiveCall(" while decoding a JSON object "
-                                       "from a unicode string"))
-                return NULL;
-            res = _parse_object_unicode(s, memo, pystr, idx + 1, next_idx_ptr);
-            _Py_LeaveRecursiveCall();
-            return res;
-        case '[':
-            /* array */
-            if (_Py_EnterRecursiveCall(" while decoding a JSON array "
-                                       "from a unicode string"))
-                return NULL;
-            res = _parse_array_unicode(s, memo, pystr, idx + 1, next_idx_ptr);
-            _Py_LeaveRecursiveCall();
-            return res;
-        case 'n':
-            /* null */
-            if ((idx + 3 < length) && PyUnicode_READ(kind, str, idx + 1) == 'u' && PyUnicode_READ(kind, str, idx + 2) == 'l' && PyUnicode_READ(kind, str, idx + 3) == 'l') {
-                *next_idx_ptr = idx + 4;
-                Py_RETURN_NONE;
-            }
-            break;
-        case 't':
-            /* true */
-            if ((idx + 3 < length) && PyUnicode_READ(kind, str, idx + 1) == 'r' && PyUnicode_READ(kind, str, idx + 2) == 'u' && PyUnicode_READ(kind, str, idx + 3) == 'e') {
-                *next_idx_ptr = idx + 4;
-                Py_RETURN_TRUE;
-            }
-            break;
-        case 'f':
-            /* false */
-            if ((idx + 4 < length) && PyUnicode_READ(kind, str, idx + 1) == 'a' &&
-                PyUnicode_READ(kind, str, idx + 2) == 'l' &&
-                PyUnicode_READ(kind, str, idx + 3) == 's' &&
-                PyUnicode_READ(kind, str, idx + 4) == 'e') {
-                *next_idx_ptr = idx + 5;
-                Py_RETURN_FALSE;
-            }
-            break;
-        case 'N':
-            /* NaN */
-            if ((idx + 2 < length) && PyUnicode_READ(kind, str, idx + 1) == 'a' &&
-                PyUnicode_READ(kind, str, idx + 2) == 'N') {
-                return _parse_constant(s, "NaN", idx, next_idx_ptr);
-            }
-            break;
-        case 'I':
-            /* Infinity */
-            if ((idx + 7 < length) && PyUnicode_READ(kind, str, idx + 1) == 'n' &&
-                PyUnicode_READ(kind, str, idx + 2) == 'f' &&
-                PyUnicode_READ(kind, str, idx + 3) == 'i' &&
-                PyUnicode_READ(kind, str, idx + 4) == 'n' &&
-                PyUnicode_READ(kind, str, idx + 5) == 'i' &&
-                PyUnicode_READ(kind, str, idx + 6) == 't' &&
-                PyUnicode_READ(kind, str, idx + 7) == 'y') {
-                return _parse_constant(s, "Infinity", idx, next_idx_ptr);
-            }
-            break;
-        case '-':
-            /* -Infinity */
-            if ((idx + 8 < length) && PyUnicode_READ(kind, str, idx + 1) == 'I' &&
-                PyUnicode_READ(kind, str, idx + 2) == 'n' &&
-                PyUnicode_READ(kind, str, idx + 3) == 'f' &&
-                PyUnicode_READ(kind, str, idx + 4) == 'i' &&
-                PyUnicode_READ(kind, str, idx + 5) == 'n' &&
-                PyUnicode_READ(kind, str, idx + 6) == 'i' &&
-                PyUnicode_READ(kind, str, idx + 7) == 't' &&
-                PyUnicode_READ(kind, str, idx + 8) == 'y') {
-                return _parse_constant(s, "-Infinity", idx, next_idx_ptr);
-            }
-            break;
+/* Write the str decoded from view[start:end] to writer. */
+static int
+write_substring_utf8(PyUnicodeWriter *writer, const Py_buffer *view,
+                     Py_ssize_t start, Py_ssize_t end)
+{
+    if (PyUnicodeWriter_DecodeUTF8Stateful(writer,
+                                           (const char *)view->buf + start,
+                                           end - start, "surrogatepass",
+                                           NULL) < 0) {
+        reraise_decode_error_utf8(view);
+        return -1;
     }
-    /* Didn't find a string, object, array, or named constant. Look for a number. */
-    return _match_number_unicode(s, pystr, idx, next_idx_ptr);
+    return 0;
 }
 
+#define JSON(F) F##_unicode
+#define JSON_SOURCE PyObject *
+#define JSON_KIND(src) PyUnicode_KIND(src)
+#define JSON_DATA(src) PyUnicode_DATA(src)
+#define JSON_LENGTH(src) PyUnicode_GET_LENGTH(src)
+#define JSON_RAISE_ERRMSG raise_errmsg
+#define JSON_SUBSTRING PyUnicode_Substring
+#define JSON_WRITE_SUBSTRING PyUnicodeWriter_WriteSubstring
+#define JSON_SOURCE_NAME "a unicode string"
+#include "_json_scanner.h"
+
+#define JSON(F) F##_utf8
+#define JSON_SOURCE const Py_buffer *
+#define JSON_KIND(src) PyUnicode_1BYTE_KIND
+#define JSON_DATA(src) ((src)->buf)
+#define JSON_LENGTH(src) ((src)->len)
+#define JSON_RAISE_ERRMSG raise_errmsg_utf8
+#define JSON_SUBSTRING substring_utf8
+#define JSON_WRITE_SUBSTRING write_substring_utf8
+#define JSON_SOURCE_NAME "a byte string"
+#include "_json_scanner.h"
+
 static PyObject *
 scanner_call(PyObject *self, PyObject *args, PyObject *kwds)
 {
-    /* Python callable interface to scan_once_{str,unicode} */
+    /* Python callable interface to scan_once_{unicode,utf8} */
     PyObject *pystr;
     PyObject *rval;
     Py_ssize_t idx;
@@ -1129,20 +831,39 @@ scanner_call(PyObject *self, PyObject *args, PyObject *kwds)
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:scan_once", kwlist, &pystr, &idx))
         return NULL;
 
-    if (!PyUnicode_Check(pystr)) {
+    if (!PyUnicode_Check(pystr) && !PyObject_CheckBuffer(pystr)) {
         PyErr_Format(PyExc_TypeError,
-                     "first argument must be a string, not %.80s",
+                     "first argument must be a string or a bytes-like "
+                     "object, not %.80s",
                      Py_TYPE(pystr)->tp_name);
         return NULL;
     }
 
-    PyObject *memo = PyDict_New();
-    if (memo == NULL) {
+    PyScannerObject *scanner = PyScannerObject_CAST(self);
+    ScannerState st = {0};
+    st.memo = PyDict_New();
+    if (st.memo == NULL) {
         return NULL;
     }
-    rval = scan_once_unicode(PyScannerObject_CAST(self),
-                             memo, pystr, idx, &next_idx);
-    Py_DECREF(memo);
+    if (PyUnicode_Check(pystr)) {
+        rval = scan_once_unicode(scanner, &st, pystr, idx, &next_idx);
+    }
+    else {
+        /* A UTF-8 encoded document; idx and next_idx are byte offsets */
+        Py_buffer view;
+        if (PyObject_GetBuffer(pystr, &view, PyBUF_SIMPLE) < 0) {
+            Py_DECREF(st.memo);
+            return NULL;
+        }
+        rval = scan_once_utf8(scanner, &st, &view, idx, &next_idx);
+        PyBuffer_Release(&view);
+    }
+    Py_DECREF(st.memo);
+    for (int i = 0; i < SHAPE_CACHE_SIZE; i++) {
+        Py_XDECREF(st.shapes[i]);
+    }
+    _Py_atomic_add_ssize(&scanner->shape_hits, st.shape_hits);
+    _Py_atomic_add_ssize(&scanner->shape_misses, st.shape_misses);
     if (rval == NULL)
         return NULL;
     return _build_rval_index_tuple(rval, next_idx);
@@ -1216,6 +937,170 @@ static PyType_Spec PyScannerType_spec = {
     .slots = PyScannerType_slots,
 };
 
+/* Splitter: find the boundaries of consecutive JSON values in a stream of
+ * text chunks, without parsing them.  Used by json.JSONStreamDecoder. */
+
+typedef struct _PySplitterObject {
+    PyObject_HEAD
+    Py_ssize_t depth;       /* nesting level of arrays and objects */
+    char started;           /* inside a value */
+    char scalar;            /* inside a number or a named constant */
+    char in_string;         /* inside a string */
+    char escape;            /* after a backslash in a string */
+} PySplitterObject;
+
+#define PySplitterObject_CAST(op)   ((PySplitterObject *)(op))
+
+static Py_ssize_t
+splitter_scan(PySplitterObject *self, PyObject *pystr, Py_ssize_t idx)
+{
+    /* Continue reading the current value from pystr[idx:].
+    Return the index just after its end and reset the state, or -1 if the
+    value goes on past the end of pystr.
+    */
+    const void *str = PyUnicode_DATA(pystr);
+    int kind = PyUnicode_KIND(pystr);
+    Py_ssize_t len = PyUnicode_GET_LENGTH(pystr);
+
+    for (; idx < len; idx++) {
+        Py_UCS4 c;
+        if (self->in_string) {
+            if (self->escape) {
+                self->escape = 0;
+                continue;
+            }
+            if (kind == PyUnicode_1BYTE_KIND) {
+                idx = skip_plain_chars_ucs1((const Py_UCS1 *)str, idx, len, 0);
+                if (idx == len) {
+                    break;
+                }
+            }
+            c = PyUnicode_READ(kind, str, idx);
+            if (c == '\\') {
+                self->escape = 1;
+            }
+            else if (c == '"') {
+                self->in_string = 0;
+                if (self->depth == 0) {
+                    goto done;
+                }
+            }
+            continue;
+        }
+        c = PyUnicode_READ(kind, str, idx);
+        if (!self->started) {
+            if (IS_WHITESPACE(c)) {
+                continue;
+            }
+            self->started = 1;
+            switch (c) {
+                case '"':
+                    self->in_string = 1;
+                    break;
+                case '[': case '{':
+                    self->depth = 1;
+                    break;
+                case ']': case '}': case ',': case ':':
+                    /* Not a value, let the scanner report the error */
+                    goto done;
+                default:
+                    self->scalar = 1;
+            }
+            continue;
+        }
+        if (self->scalar) {
+            switch (c) {
+                case ' ': case '\t': case '\n': case '\r':
+                case '[': case ']': case '{': case '}':
+                case ',': case ':': case '"':
+                    self->scalar = 0;
+                    self->started = 0;
+                    return idx;
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                self->in_string = 1;
+                break;
+            case '[': case '{':
+                self->depth++;
+                break;
+            case ']': case '}':
+                if (--self->depth == 0) {
+                    goto done;
+                }
+                break;
+        }
+    }
+    return -1;
+
+done:
+    self->started = 0;
+    return idx + 1;
+}
+
+static PyObject *
+splitter_call(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *pystr;
+    Py_ssize_t idx;
+    Py_ssize_t end;
+    static char *kwlist[] = {"string", "idx", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Un:split", kwlist, &pystr, &idx))
+        return NULL;
+
+    if (idx < 0 || idx > PyUnicode_GET_LENGTH(pystr)) {
+        PyErr_SetString(PyExc_ValueError, "idx is out of bounds");
+        return NULL;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    end = splitter_scan(PySplitterObject_CAST(self), pystr, idx);
+    Py_END_CRITICAL_SECTION();
+    return PyLong_FromSsize_t(end);
+}
+
+static PyObject *
+splitter_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, ":make_splitter", kwlist))
+        return NULL;
+    return type->tp_alloc(type, 0);
+}
+
+static void
+splitter_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+PyDoc_STRVAR(splitter_doc,
+"make_splitter()\n"
+"--\n"
+"\n"
+"Return a callable splitter(string, idx) that finds where the JSON value\n"
+"starting at or after string[idx] ends.  It returns the index just after\n"
+"the value, or -1 if the value continues in the next string passed to it.");
+
+static PyType_Slot PySplitterType_slots[] = {
+    {Py_tp_doc, (void *)splitter_doc},
+    {Py_tp_dealloc, splitter_dealloc},
+    {Py_tp_call, splitter_call},
+    {Py_tp_new, splitter_new},
+    {0, 0}
+};
+
+static PyType_Spec PySplitterType_spec = {
+    .name = "_json.Splitter",
+    .basicsize = sizeof(PySplitterObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = PySplitterType_slots,
+};
+
 static PyObject *
 encoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
@@ -1636,6 +1521,32 @@ encoder_encode_key_value(PyEncoderObject *s, PyUnicodeWriter *writer, bool *firs
     return 0;
 }
 
+/* Encode the key-value pairs items[start:stop] of the dict dct. */
+static int
+encoder_encode_items(PyEncoderObject *s, PyUnicodeWriter *writer, bool *first,
+                     PyObject *dct, PyObject *items,
+                     Py_ssize_t start, Py_ssize_t stop,
+                     Py_ssize_t indent_level, PyObject *indent_cache,
+                     PyObject *item_separator)
+{
+    for (Py_ssize_t i = start; i < stop && i < PyList_GET_SIZE(items); i++) {
+        PyObject *item = PyList_GET_ITEM(items, i);
+
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            PyErr_SetString(PyExc_ValueError, "items must return 2-tuples");
+            return -1;
+        }
+
+        PyObject *key = PyTuple_GET_ITEM(item, 0);
+        PyObject *value = PyTuple_GET_ITEM(item, 1);
+        if (encoder_encode_key_value(s, writer, first, dct, key, value,
+                                     indent_level, indent_cache,
+                                     item_separator) < 0)
+            return -1;
+    }
+    return 0;
+}
+
 static int
 encoder_listencode_dict(PyEncoderObject *s, PyUnicodeWriter *writer,
                         PyObject *dct,
@@ -1685,21 +1596,10 @@ encoder_listencode_dict(PyEncoderObject *s, PyUnicodeWriter *writer,
         if (items == NULL || (s->sort_keys && PyList_Sort(items) < 0))
             goto bail;
 
-        for (Py_ssize_t  i = 0; i < PyList_GET_SIZE(items); i++) {
-            PyObject *item = PyList_GET_ITEM(items, i);
-
-            if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
-                PyErr_SetString(PyExc_ValueError, "items must return 2-tuples");
-                goto bail;
-            }
-
-            key = PyTuple_GET_ITEM(item, 0);
-            value = PyTuple_GET_ITEM(item, 1);
-            if (encoder_encode_key_value(s, writer, &first, dct, key, value,
-                                         indent_level, indent_cache,
-                                         separator) < 0)
-                goto bail;
-        }
+        if (encoder_encode_items(s, writer, &first, dct, items,
+                                 0, PyList_GET_SIZE(items),
+                                 indent_level, indent_cache, separator) < 0)
+            goto bail;
         Py_CLEAR(items);
 
     } else {
@@ -1735,6 +1635,31 @@ encoder_listencode_dict(PyEncoderObject *s, PyUnicodeWriter *writer,
     return -1;
 }
 
+/* Encode the items s_fast[start:stop] of the sequence seq.  The size is
+   checked at every step, since encoding an item can shrink the list. */
+static int
+encoder_encode_elements(PyEncoderObject *s, PyUnicodeWriter *writer,
+                        PyObject *seq, PyObject *s_fast,
+                        Py_ssize_t start, Py_ssize_t stop,
+                        Py_ssize_t indent_level, PyObject *indent_cache,
+                        PyObject *item_separator)
+{
+    for (Py_ssize_t i = start;
+         i < stop && i < PySequence_Fast_GET_SIZE(s_fast); i++)
+    {
+        PyObject *obj = PySequence_Fast_GET_ITEM(s_fast, i);
+        if (i > start) {
+            if (PyUnicodeWriter_WriteStr(writer, item_separator) < 0)
+                return -1;
+        }
+        if (encoder_listencode_obj(s, writer, obj, indent_level, indent_cache)) {
+            _PyErr_FormatNote("when serializing %T item %zd", seq, i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
 static int
 encoder_listencode_list(PyEncoderObject *s, PyUnicodeWriter *writer,
                         PyObject *seq,
@@ -1742,7 +1667,6 @@ encoder_listencode_list(PyEncoderObject *s, PyUnicodeWriter *writer,
 {
     PyObject *ident = NULL;
     PyObject *s_fast = NULL;
-    Py_ssize_t i;
 
     ident = NULL;
     s_fast = PySequence_Fast(seq, "_iterencode_list needs a sequence");
@@ -1783,17 +1707,9 @@ encoder_listencode_list(PyEncoderObject *s, PyUnicodeWriter *writer,
             goto bail;
         }
     }
-    for (i = 0; i < PySequence_Fast_GET_SIZE(s_fast); i++) {
-        PyObject *obj = PySequence_Fast_GET_ITEM(s_fast, i);
-        if (i) {
-            if (PyUnicodeWriter_WriteStr(writer, separator) < 0)
-                goto bail;
-        }
-        if (encoder_listencode_obj(s, writer, obj, indent_level, indent_cache)) {
-            _PyErr_FormatNote("when serializing %T item %zd", seq, i);
-            goto bail;
-        }
-    }
+    if (encoder_encode_elements(s, writer, seq, s_fast, 0, PY_SSIZE_T_MAX,
+                                indent_level, indent_cache, separator) < 0)
+        goto bail;
     if (ident != NULL) {
         if (PyDict_DelItem(s->markers, ident))
             goto bail;
@@ -1819,6 +1735,91 @@ encoder_listencode_list(PyEncoderObject *s, PyUnicodeWriter *writer,
     return -1;
 }
 
+static PyObject *
+encoder_encode_chunk(PyObject *op, PyObject *args)
+{
+    /* Encode items start to stop of a list, a tuple or a dict as they are
+       written between its brackets, the first one preceded by the newline
+       and indentation if any.  The items of a dict are given as a list of
+       (key, value) pairs.  Used by JSONEncoder to encode chunks of a big
+       container in parallel. */
+    PyObject *container, *items;
+    Py_ssize_t start, stop, indent_level;
+    PyEncoderObject *self = PyEncoderObject_CAST(op);
+
+    if (!PyArg_ParseTuple(args, "OOnnn:_encode_chunk", &container, &items,
+                          &start, &stop, &indent_level))
+        return NULL;
+
+    PyObject *s_fast = PySequence_Fast(items, "_encode_chunk needs a sequence");
+    if (s_fast == NULL) {
+        return NULL;
+    }
+    if (start < 0 || start > stop || stop > PySequence_Fast_GET_SIZE(s_fast)) {
+        PyErr_SetString(PyExc_ValueError, "chunk out of range");
+        Py_DECREF(s_fast);
+        return NULL;
+    }
+    if (PyDict_Check(container) && !PyList_Check(s_fast)) {
+        PyErr_SetString(PyExc_TypeError, "the items of a dict must be a list");
+        Py_DECREF(s_fast);
+        return NULL;
+    }
+
+    PyUnicodeWriter *writer = PyUnicodeWriter_Create(0);
+    if (writer == NULL) {
+        Py_DECREF(s_fast);
+        return NULL;
+    }
+
+    PyObject *indent_cache = NULL;
+    PyObject *separator = self->item_separator; // borrowed reference
+    if (self->indent != Py_None) {
+        indent_cache = create_indent_cache(self, indent_level);
+        if (indent_cache == NULL) {
+            goto bail;
+        }
+        indent_level++;
+        separator = get_item_separator(self, indent_level, indent_cache);
+        if (separator == NULL) {
+            goto bail;
+        }
+    }
+
+    if (PyDict_Check(container)) {
+        bool first = true;
+        if (encoder_encode_items(self, writer, &first, container, s_fast,
+                                 start, stop, indent_level, indent_cache,
+                                 separator) < 0)
+            goto bail;
+    }
+    else {
+        if (self->indent != Py_None && start < stop &&
+            write_newline_indent(writer, indent_level, indent_cache) < 0)
+        {
+            goto bail;
+        }
+        if (encoder_encode_elements(self, writer, container, s_fast,
+                                    start, stop, indent_level, indent_cache,
+                                    separator) < 0)
+            goto bail;
+    }
+    Py_XDECREF(indent_cache);
+    Py_DECREF(s_fast);
+    return PyUnicodeWriter_Finish(writer);
+
+bail:
+    PyUnicodeWriter_Discard(writer);
+    Py_XDECREF(indent_cache);
+    Py_DECREF(s_fast);
+    return NULL;
+}
+
+static PyMethodDef encoder_methods[] = {
+    {"_encode_chunk", encoder_encode_chunk, METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL}
+};
+
 static void
 encoder_dealloc(PyObject *self)
 {
@@ -1867,6 +1868,7 @@ static PyType_Slot PyEncoderType_slots[] = {
     {Py_tp_traverse, encoder_traverse},
     {Py_tp_clear, encoder_clear},
     {Py_tp_members, encoder_members},
+    {Py_tp_methods, encoder_methods},
     {Py_tp_new, encoder_new},
     {0, 0}
 };
@@ -1906,6 +1908,11 @@ _json_exec(PyObject *module)
         return -1;
     }
 
+    PyObject *PySplitterType = PyType_FromSpec(&PySplitterType_spec);
+    if (PyModule_Add(module, "make_splitter", PySplitterType) < 0) {
+        return -1;
+    }
+
     PyObject *PyEncoderType = PyType_FromSpec(&PyEncoderType_spec);
     if (PyModule_Add(module, "make_encoder", PyEncoderType) < 0) {
         return -1;
@@ -0,0 +1,695 @@
+/*
+ * JSON scanner template
+ *
+ * This file is included twice by _json.c: once for str documents, and once
+ * for UTF-8 encoded buffers (bytes, bytearray, memoryview, mmap...).  The
+ * including file defines:
+ *
+ *   JSON(F)            name mangling macro
+ *   JSON_SOURCE        type of the document argument src
+ *   JSON_KIND(src)     its PyUnicode kind (PyUnicode_1BYTE_KIND for UTF-8)
+ *   JSON_DATA(src)     pointer to its characters
+ *   JSON_LENGTH(src)   its length in characters
+ *   JSON_RAISE_ERRMSG(msg, src, idx)
+ *                      raise JSONDecodeError for index idx of src
+ *   JSON_SUBSTRING(src, start, end)
+ *                      return the decoded str of src[start:end]
+ *   JSON_WRITE_SUBSTRING(writer, src, start, end)
+ *                      write the decoded src[start:end] to writer
+ *   JSON_SOURCE_NAME   description of src for recursion errors
+ *
+ * For UTF-8 buffers all indices are byte offsets.  Any character outside of
+ * a string must be ASCII to be valid JSON, so reading the buffer byte by
+ * byte finds the same tokens as reading the decoded document.
+ */
+
+static PyObject *
+JSON(scanstring)(JSON_SOURCE src, Py_ssize_t end, int strict, Py_ssize_t *next_end_ptr)
+{
+    /* Read the JSON string from src.
+    end is the index of the first character after the quote.
+    if strict is zero then literal control characters are allowed
+    *next_end_ptr is a return-by-reference index of the character
+        after the end quote
+
+    Return value is a new PyUnicode
+    */
+    PyObject *rval = NULL;
+    Py_ssize_t len;
+    Py_ssize_t begin = end - 1;
+    Py_ssize_t next /* = begin */;
+    const void *buf;
+    int kind;
+
+    PyUnicodeWriter *writer = NULL;
+
+    len = JSON_LENGTH(src);
+    buf = JSON_DATA(src);
+    kind = JSON_KIND(src);
+
+    if (end < 0 || len < end) {
+        PyErr_SetString(PyExc_ValueError, "end is out of bounds");
+        goto bail;
+    }
+    while (1) {
+        /* Find the end of the string or the next escape.  Bytes of
+           multi-byte UTF-8 sequences are all >= 0x80, so they can't be
+           mistaken for a quote, a backslash or a control character. */
+        Py_UCS4 c;
+        {
+            // Use tight scope variable to help register allocation.
+            Py_UCS4 d = 0;
+            next = end;
+            if (kind == PyUnicode_1BYTE_KIND) {
+                next = skip_plain_chars_ucs1((const Py_UCS1 *)buf, end, len,
+                                             strict);
+            }
+            for (; next < len; next++) {
+                d = PyUnicode_READ(kind, buf, next);
+                if (d == '"' || d == '\\') {
+                    break;
+                }
+                if (d <= 0x1f && strict) {
+                    JSON_RAISE_ERRMSG("Invalid control character at", src, next);
+                    goto bail;
+                }
+            }
+            c = d;
+        }
+
+        if (c == '"') {
+            // Fast path for simple case.
+            if (writer == NULL) {
+                PyObject *ret = JSON_SUBSTRING(src, end, next);
+                if (ret == NULL) {
+                    goto bail;
+                }
+                *next_end_ptr = next + 1;
+                return ret;
+            }
+        }
+        else if (c != '\\') {
+            JSON_RAISE_ERRMSG("Unterminated string starting at", src, begin);
+            goto bail;
+        } else if (writer == NULL) {
+            writer = PyUnicodeWriter_Create(0);
+            if (writer == NULL) {
+                goto bail;
+            }
+        }
+
+        /* Pick up this chunk if it's not zero length */
+        if (next != end) {
+            if (JSON_WRITE_SUBSTRING(writer, src, end, next) < 0) {
+                goto bail;
+            }
+        }
+        next++;
+        if (c == '"') {
+            end = next;
+            break;
+        }
+        if (next == len) {
+            JSON_RAISE_ERRMSG("Unterminated string starting at", src, begin);
+            goto bail;
+        }
+        c = PyUnicode_READ(kind, buf, next);
+        if (c != 'u') {
+            /* Non-unicode backslash escapes */
+            end = next + 1;
+            switch (c) {
+                case '"': break;
+                case '\\': break;
+                case '/': break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                default: c = 0;
+            }
+            if (c == 0) {
+                JSON_RAISE_ERRMSG("Invalid \\escape", src, end - 2);
+                goto bail;
+            }
+        }
+        else {
+            c = 0;
+            next++;
+            end = next + 4;
+            if (end >= len) {
+                JSON_RAISE_ERRMSG("Invalid \\uXXXX escape", src, next - 1);
+                goto bail;
+            }
+            /* Decode 4 hex digits */
+            for (; next < end; next++) {
+                Py_UCS4 digit = PyUnicode_READ(kind, buf, next);
+                c <<= 4;
+                switch (digit) {
+                    case '0': case '1': case '2': case '3': case '4':
+                    case '5': case '6': case '7': case '8': case '9':
+                        c |= (digit - '0'); break;
+                    case 'a': case 'b': case 'c': case 'd': case 'e':
+                    case 'f':
+                        c |= (digit - 'a' + 10); break;
+                    case 'A': case 'B': case 'C': case 'D': case 'E':
+                    case 'F':
+                        c |= (digit - 'A' + 10); break;
+                    default:
+                        JSON_RAISE_ERRMSG("Invalid \\uXXXX escape", src, end - 5);
+                        goto bail;
+                }
+            }
+            /* Surrogate pair */
+            if (Py_UNICODE_IS_HIGH_SURROGATE(c) && end + 6 < len &&
+                PyUnicode_READ(kind, buf, next++) == '\\' &&
+                PyUnicode_READ(kind, buf, next++) == 'u') {
+                Py_UCS4 c2 = 0;
+                end += 6;
+                /* Decode 4 hex digits */
+                for (; next < end; next++) {
+                    Py_UCS4 digit = PyUnicode_READ(kind, buf, next);
+                    c2 <<= 4;
+                    switch (digit) {
+                        case '0': case '1': case '2': case '3': case '4':
+                        case '5': case '6': case '7': case '8': case '9':
+                            c2 |= (digit - '0'); break;
+                        case 'a': case 'b': case 'c': case 'd': case 'e':
+                        case 'f':
+                            c2 |= (digit - 'a' + 10); break;
+                        case 'A': case 'B': case 'C': case 'D': case 'E':
+                        case 'F':
+                            c2 |= (digit - 'A' + 10); break;
+                        default:
+                            JSON_RAISE_ERRMSG("Invalid \\uXXXX escape", src, end - 5);
+                            goto bail;
+                    }
+                }
+                if (Py_UNICODE_IS_LOW_SURROGATE(c2))
+                    c = Py_UNICODE_JOIN_SURROGATES(c, c2);
+                else
+                    end -= 6;
+            }
+        }
+        if (PyUnicodeWriter_WriteChar(writer, c) < 0) {
+            goto bail;
+        }
+    }
+
+    rval = PyUnicodeWriter_Finish(writer);
+    *next_end_ptr = end;
+    return rval;
+
+bail:
+    *next_end_ptr = -1;
+    PyUnicodeWriter_Discard(writer);
+    return NULL;
+}
+
+static PyObject *
+JSON(_parse_object)(PyScannerObject *s, ScannerState *st, JSON_SOURCE src, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read a JSON object from src.
+    idx is the index of the first character after the opening curly brace.
+    *next_idx_ptr is a return-by-reference index to the first character after
+        the closing curly brace.
+
+    Returns a new PyObject (usually a dict, but object_hook can change that)
+    */
+    const void *str;
+    int kind;
+    Py_ssize_t end_idx;
+    PyObject *val = NULL;
+    PyObject *rval = NULL;
+    PyObject *key = NULL;
+    PyObject *shape;
+    PyObject *keys = NULL;
+    Py_ssize_t nkeys = 0;
+    int has_pairs_hook = (s->object_pairs_hook != Py_None);
+    Py_ssize_t next_idx;
+    Py_ssize_t comma_idx;
+
+    str = JSON_DATA(src);
+    kind = JSON_KIND(src);
+    end_idx = JSON_LENGTH(src) - 1;
+
+    shape = shape_lookup(st);
+    if (shape == NULL) {
+        keys = PyList_New(0);
+        if (keys == NULL)
+            return NULL;
+    }
+
+    if (has_pairs_hook)
+        rval = PyList_New(0);
+    else
+        rval = _PyDict_NewPresized(shape ? PyTuple_GET_SIZE(shape) : 0);
+    if (rval == NULL)
+        goto bail;
+
+    /* skip whitespace after { */
+    while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind,str, idx))) idx++;
+
+    /* only loop if the object is non-empty */
+    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != '}') {
+        while (1) {
+            PyObject *memokey;
+
+            /* read key */
+            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != '"') {
+                JSON_RAISE_ERRMSG("Expecting property name enclosed in double quotes", src, idx);
+                goto bail;
+            }
+            if (keys == NULL) {
+                /* try the key at the same position in the last object */
+                next_idx = -1;
+                if (nkeys < PyTuple_GET_SIZE(shape)) {
+                    key = PyTuple_GET_ITEM(shape, nkeys);
+                    if (key != Py_None) {
+                        next_idx = JSON(match_key)(src, idx + 1, key);
+                    }
+                }
+                if (next_idx < 0) {
+                    key = NULL;
+                    keys = shape_mismatch(shape, nkeys);
+                    if (keys == NULL)
+                        goto bail;
+                }
+            }
+            if (keys == NULL) {
+                key = Py_NewRef(key);
+            }
+            else {
+                key = JSON(scanstring)(src, idx + 1, s->strict, &next_idx);
+                if (key == NULL)
+                    goto bail;
+                if (PyDict_SetDefaultRef(st->memo, key, key, &memokey) < 0) {
+                    goto bail;
+                }
+                Py_SETREF(key, memokey);
+                if (shape_append(keys, key, next_idx - idx - 2) < 0) {
+                    goto bail;
+                }
+            }
+            nkeys++;
+            idx = next_idx;
+
+            /* skip whitespace between key and : delimiter, read :, skip whitespace */
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ':') {
+                JSON_RAISE_ERRMSG("Expecting ':' delimiter", src, idx);
+                goto bail;
+            }
+            idx++;
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+            /* read any JSON term */
+            val = JSON(scan_once)(s, st, src, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (has_pairs_hook) {
+                PyObject *item = PyTuple_Pack(2, key, val);
+                if (item == NULL)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+                if (PyList_Append(rval, item) == -1) {
+                    Py_DECREF(item);
+                    goto bail;
+                }
+                Py_DECREF(item);
+            }
+            else {
+                if (PyDict_SetItem(rval, key, val) < 0)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+            }
+            idx = next_idx;
+
+            /* skip whitespace before } or , */
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+            /* bail if the object is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == '}')
+                break;
+            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ',') {
+                JSON_RAISE_ERRMSG("Expecting ',' delimiter", src, idx);
+                goto bail;
+            }
+            comma_idx = idx;
+            idx++;
+
+            /* skip whitespace after , delimiter */
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == '}') {
+                JSON_RAISE_ERRMSG("Illegal trailing comma before end of object", src, comma_idx);
+                goto bail;
+            }
+        }
+    }
+
+    *next_idx_ptr = idx + 1;
+
+    if (shape_store(st, shape, keys, nkeys) < 0)
+        goto bail;
+    Py_XDECREF(shape);
+    Py_XDECREF(keys);
+
+    if (has_pairs_hook) {
+        val = PyObject_CallOneArg(s->object_pairs_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+
+    /* if object_hook is not None: rval = object_hook(rval) */
+    if (s->object_hook != Py_None) {
+        val = PyObject_CallOneArg(s->object_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+    return rval;
+bail:
+    Py_XDECREF(shape);
+    Py_XDECREF(keys);
+    Py_XDECREF(key);
+    Py_XDECREF(val);
+    Py_XDECREF(rval);
+    return NULL;
+}
+
+static PyObject *
+JSON(_parse_array)(PyScannerObject *s, ScannerState *st, JSON_SOURCE src, Py_ssize_t idx, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON array from src.
+    idx is the index of the first character after the opening brace.
+    *next_idx_ptr is a return-by-reference index to the first character after
+        the closing brace.
+
+    Returns a new PyList
+    */
+    const void *str;
+    int kind;
+    Py_ssize_t end_idx;
+    PyObject *val = NULL;
+    PyObject *rval;
+    Py_ssize_t next_idx;
+    Py_ssize_t comma_idx;
+
+    rval = PyList_New(0);
+    if (rval == NULL)
+        return NULL;
+
+    str = JSON_DATA(src);
+    kind = JSON_KIND(src);
+    end_idx = JSON_LENGTH(src) - 1;
+
+    /* skip whitespace after [ */
+    while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+    /* only loop if the array is non-empty */
+    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ']') {
+        while (1) {
+
+            /* read any JSON term  */
+            val = JSON(scan_once)(s, st, src, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (PyList_Append(rval, val) == -1)
+                goto bail;
+
+            Py_CLEAR(val);
+            idx = next_idx;
+
+            /* skip whitespace between term and , */
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+            /* bail if the array is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == ']')
+                break;
+            if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ',') {
+                JSON_RAISE_ERRMSG("Expecting ',' delimiter", src, idx);
+                goto bail;
+            }
+            comma_idx = idx;
+            idx++;
+
+            /* skip whitespace after , */
+            while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind, str, idx))) idx++;
+
+            if (idx <= end_idx && PyUnicode_READ(kind, str, idx) == ']') {
+                JSON_RAISE_ERRMSG("Illegal trailing comma before end of array", src, comma_idx);
+                goto bail;
+            }
+        }
+    }
+
+    /* verify that idx < end_idx, PyUnicode_READ(kind, str, idx) should be ']' */
+    if (idx > end_idx || PyUnicode_READ(kind, str, idx) != ']') {
+        JSON_RAISE_ERRMSG("Expecting value", src, end_idx);
+        goto bail;
+    }
+    *next_idx_ptr = idx + 1;
+    return rval;
+bail:
+    Py_XDECREF(val);
+    Py_DECREF(rval);
+    return NULL;
+}
+
+static PyObject *
+JSON(_match_number)(PyScannerObject *s, JSON_SOURCE src, Py_ssize_t start, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON number from src.
+    idx is the index of the first character of the number
+    *next_idx_ptr is a return-by-reference index to the first character after
+        the number.
+
+    Returns a new PyObject representation of that number:
+        PyLong, or PyFloat.
+        May return other types if parse_int or parse_float are set
+    */
+    const void *str;
+    int kind;
+    Py_ssize_t end_idx;
+    Py_ssize_t idx = start;
+    int is_float = 0;
+    PyObject *rval;
+    PyObject *numstr = NULL;
+    PyObject *custom_func;
+
+    str = JSON_DATA(src);
+    kind = JSON_KIND(src);
+    end_idx = JSON_LENGTH(src) - 1;
+
+    /* read a sign if it's there, make sure it's not the end of the string */
+    if (PyUnicode_READ(kind, str, idx) == '-') {
+        idx++;
+        if (idx > end_idx) {
+            raise_stop_iteration(start);
+            return NULL;
+        }
+    }
+
+    /* read as many integer digits as we find as long as it doesn't start with 0 */
+    if (PyUnicode_READ(kind, str, idx) >= '1' && PyUnicode_READ(kind, str, idx) <= '9') {
+        idx = skip_digits(kind, str, idx + 1, end_idx + 1);
+    }
+    /* if it starts with 0 we only expect one integer digit */
+    else if (PyUnicode_READ(kind, str, idx) == '0') {
+        idx++;
+    }
+    /* no integer digits, error */
+    else {
+        raise_stop_iteration(start);
+        return NULL;
+    }
+
+    /* if the next char is '.' followed by a digit then read all float digits */
+    if (idx < end_idx && PyUnicode_READ(kind, str, idx) == '.' && PyUnicode_READ(kind, str, idx + 1) >= '0' && PyUnicode_READ(kind, str, idx + 1) <= '9') {
+        is_float = 1;
+        idx = skip_digits(kind, str, idx + 2, end_idx + 1);
+    }
+
+    /* if the next char is 'e' or 'E' then maybe read the exponent (or backtrack) */
+    if (idx < end_idx && (PyUnicode_READ(kind, str, idx) == 'e' || PyUnicode_READ(kind, str, idx) == 'E')) {
+        Py_ssize_t e_start = idx;
+        idx++;
+
+        /* read an exponent sign if present */
+        if (idx < end_idx && (PyUnicode_READ(kind, str, idx) == '-' || PyUnicode_READ(kind, str, idx) == '+')) idx++;
+
+        /* read all digits */
+        idx = skip_digits(kind, str, idx, end_idx + 1);
+
+        /* if we got a digit, then parse as float. if not, backtrack */
+        if (PyUnicode_READ(kind, str, idx - 1) >= '0' && PyUnicode_READ(kind, str, idx - 1) <= '9') {
+            is_float = 1;
+        }
+        else {
+            idx = e_start;
+        }
+    }
+
+    if (is_float && s->parse_float != (PyObject *)&PyFloat_Type)
+        custom_func = s->parse_float;
+    else if (!is_float && s->parse_int != (PyObject *) &PyLong_Type)
+        custom_func = s->parse_int;
+    else
+        custom_func = NULL;
+
+    if (custom_func) {
+        /* copy the section we determined to be a number */
+        numstr = PyUnicode_FromKindAndData(kind,
+                                           (char*)str + kind * start,
+                                           idx - start);
+        if (numstr == NULL)
+            return NULL;
+        rval = PyObject_CallOneArg(custom_func, numstr);
+    }
+    else {
+        Py_ssize_t i, n;
+        char *buf;
+        /* Straight conversion to ASCII, to avoid costly conversion of
+           decimal unicode digits (which cannot appear here) */
+        n = idx - start;
+        numstr = PyBytes_FromStringAndSize(NULL, n);
+        if (numstr == NULL)
+            return NULL;
+        buf = PyBytes_AS_STRING(numstr);
+        for (i = 0; i < n; i++) {
+            buf[i] = (char) PyUnicode_READ(kind, str, i + start);
+        }
+        if (is_float)
+            rval = PyFloat_FromString(numstr);
+        else
+            rval = PyLong_FromString(buf, NULL, 10);
+    }
+    Py_DECREF(numstr);
+    *next_idx_ptr = idx;
+    return rval;
+}
+
+static PyObject *
+JSON(scan_once)(PyScannerObject *s, ScannerState *st, JSON_SOURCE src, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read one JSON term (of any kind) from src.
+    idx is the index of the first character of the term
+    *next_idx_ptr is a return-by-reference index to the first character after
+        the number.
+
+    Returns a new PyObject representation of the term.
+    */
+    PyObject *res;
+    const void *str;
+    int kind;
+    Py_ssize_t length;
+
+    str = JSON_DATA(src);
+    kind = JSON_KIND(src);
+    length = JSON_LENGTH(src);
+
+    if (idx < 0) {
+        PyErr_SetString(PyExc_ValueError, "idx cannot be negative");
+        return NULL;
+    }
+    if (idx >= length) {
+        raise_stop_iteration(idx);
+        return NULL;
+    }
+
+    switch (PyUnicode_READ(kind, str, idx)) {
+        case '"':
+            /* string */
+            return JSON(scanstring)(src, idx + 1, s->strict, next_idx_ptr);
+        case '{':
+            /* object */
+            if (_Py_EnterRecursiveCall(" while decoding a JSON object "
+                                       "from " JSON_SOURCE_NAME))
+                return NULL;
+            st->depth++;
+            res = JSON(_parse_object)(s, st, src, idx + 1, next_idx_ptr);
+            st->depth--;
+            _Py_LeaveRecursiveCall();
+            return res;
+        case '[':
+            /* array */
+            if (_Py_EnterRecursiveCall(" while decoding a JSON array "
+                                       "from " JSON_SOURCE_NAME))
+                return NULL;
+            st->depth++;
+            res = JSON(_parse_array)(s, st, src, idx + 1, next_idx_ptr);
+            st->depth--;
+            _Py_LeaveRecursiveCall();
+            return res;
+        case 'n':
+            /* null */
+            if ((idx + 3 < length) && PyUnicode_READ(kind, str, idx + 1) == 'u' && PyUnicode_READ(kind, str, idx + 2) == 'l' && PyUnicode_READ(kind, str, idx + 3) == 'l') {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_NONE;
+            }
+            break;
+        case 't':
+            /* true */
+            if ((idx + 3 < length) && PyUnicode_READ(kind, str, idx + 1) == 'r' && PyUnicode_READ(kind, str, idx + 2) == 'u' && PyUnicode_READ(kind, str, idx + 3) == 'e') {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_TRUE;
+            }
+            break;
+        case 'f':
+            /* false */
+            if ((idx + 4 < length) && PyUnicode_READ(kind, str, idx + 1) == 'a' &&
+                PyUnicode_READ(kind, str, idx + 2) == 'l' &&
+                PyUnicode_READ(kind, str, idx + 3) == 's' &&
+                PyUnicode_READ(kind, str, idx + 4) == 'e') {
+                *next_idx_ptr = idx + 5;
+                Py_RETURN_FALSE;
+            }
+            break;
+        case 'N':
+            /* NaN */
+            if ((idx + 2 < length) && PyUnicode_READ(kind, str, idx + 1) == 'a' &&
+                PyUnicode_READ(kind, str, idx + 2) == 'N') {
+                return _parse_constant(s, "NaN", idx, next_idx_ptr);
+            }
+            break;
+        case 'I':
+            /* Infinity */
+            if ((idx + 7 < length) && PyUnicode_READ(kind, str, idx + 1) == 'n' &&
+                PyUnicode_READ(kind, str, idx + 2) == 'f' &&
+                PyUnicode_READ(kind, str, idx + 3) == 'i' &&
+                PyUnicode_READ(kind, str, idx + 4) == 'n' &&
+                PyUnicode_READ(kind, str, idx + 5) == 'i' &&
+                PyUnicode_READ(kind, str, idx + 6) == 't' &&
+                PyUnicode_READ(kind, str, idx + 7) == 'y') {
+                return _parse_constant(s, "Infinity", idx, next_idx_ptr);
+            }
+            break;
+        case '-':
+            /* -Infinity */
+            if ((idx + 8 < length) && PyUnicode_READ(kind, str, idx + 1) == 'I' &&
+                PyUnicode_READ(kind, str, idx + 2) == 'n' &&
+                PyUnicode_READ(kind, str, idx + 3) == 'f' &&
+                PyUnicode_READ(kind, str, idx + 4) == 'i' &&
+                PyUnicode_READ(kind, str, idx + 5) == 'n' &&
+                PyUnicode_READ(kind, str, idx + 6) == 'i' &&
+                PyUnicode_READ(kind, str, idx + 7) == 't' &&
+                PyUnicode_READ(kind, str, idx + 8) == 'y') {
+                return _parse_constant(s, "-Infinity", idx, next_idx_ptr);
+            }
+            break;
+    }
+    /* Didn't find a string, object, array, or named constant. Look for a number. */
+    return JSON(_match_number)(s, src, idx, next_idx_ptr);
+}
+
+#undef JSON
+#undef JSON_SOURCE
+#undef JSON_KIND
+#undef JSON_DATA
+#undef JSON_LENGTH
+#undef JSON_RAISE_ERRMSG
+#undef JSON_SUBSTRING
+#undef JSON_WRITE_SUBSTRING
+#undef JSON_SOURCE_NAME
@@ -0,0 +1,341 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
+#include "pycore_modsupport.h"    // _PyArg_CheckPositional()
+
+PyDoc_STRVAR(matcher_new__doc__,
+"Matcher(patterns, /)\n"
+"--\n"
+"\n"
+"Compile a set of literal strings for searching them all at once.\n"
+"\n"
+"The patterns are either all str or all bytes-like objects.  Matches\n"
+"are leftmost-longest and do not overlap.");
+
+static PyObject *
+matcher_new_impl(PyTypeObject *type, PyObject *patterns);
+
+static PyObject *
+matcher_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    PyTypeObject *base_tp = get_multisearch_state_by_type(type)->MatcherType;
+    PyObject *patterns;
+
+    if ((type == base_tp || type->tp_init == base_tp->tp_init) &&
+        !_PyArg_NoKeywords("Matcher", kwargs)) {
+        goto exit;
+    }
+    if (!_PyArg_CheckPositional("Matcher", PyTuple_GET_SIZE(args), 1, 1)) {
+        goto exit;
+    }
+    patterns = PyTuple_GET_ITEM(args, 0);
+    return_value = matcher_new_impl(type, patterns);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_multisearch_Matcher_search__doc__,
+"search($self, /, string, pos=0, endpos=sys.maxsize)\n"
+"--\n"
+"\n"
+"Find the first match in string[pos:endpos].\n"
+"\n"
+"Return a (start, index) tuple, where index is the index of the matched\n"
+"pattern, or None if no pattern occurs.");
+
+#define _MULTISEARCH_MATCHER_SEARCH_METHODDEF    \
+    {"search", _PyCFunction_CAST(_multisearch_Matcher_search), METH_FASTCALL|METH_KEYWORDS, _multisearch_Matcher_search__doc__},
+
+static PyObject *
+_multisearch_Matcher_search_impl(MatcherObject *self, PyObject *string,
+                                 Py_ssize_t pos, Py_ssize_t endpos);
+
+static PyObject *
+_multisearch_Matcher_search(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(string), &_Py_ID(pos), &_Py_ID(endpos), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"string", "pos", "endpos", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "search",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *string;
+    Py_ssize_t pos = 0;
+    Py_ssize_t endpos = PY_SSIZE_T_MAX;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 3, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    string = args[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        {
+            Py_ssize_t ival = -1;
+            PyObject *iobj = _PyNumber_Index(args[1]);
+            if (iobj != NULL) {
+                ival = PyLong_AsSsize_t(iobj);
+                Py_DECREF(iobj);
+            }
+            if (ival == -1 && PyErr_Occurred()) {
+                goto exit;
+            }
+            pos = ival;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        endpos = ival;
+    }
+skip_optional_pos:
+    return_value = _multisearch_Matcher_search_impl((MatcherObject *)self, string, pos, endpos);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_multisearch_Matcher_findall__doc__,
+"findall($self, /, string, pos=0, endpos=sys.maxsize)\n"
+"--\n"
+"\n"
+"Return a list of all non-overlapping matches in string[pos:endpos].\n"
+"\n"
+"Each match is a (start, index) tuple, where index is the index of the\n"
+"matched pattern.");
+
+#define _MULTISEARCH_MATCHER_FINDALL_METHODDEF    \
+    {"findall", _PyCFunction_CAST(_multisearch_Matcher_findall), METH_FASTCALL|METH_KEYWORDS, _multisearch_Matcher_findall__doc__},
+
+static PyObject *
+_multisearch_Matcher_findall_impl(MatcherObject *self, PyObject *string,
+                                  Py_ssize_t pos, Py_ssize_t endpos);
+
+static PyObject *
+_multisearch_Matcher_findall(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(string), &_Py_ID(pos), &_Py_ID(endpos), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"string", "pos", "endpos", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "findall",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *string;
+    Py_ssize_t pos = 0;
+    Py_ssize_t endpos = PY_SSIZE_T_MAX;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 3, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    string = args[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        {
+            Py_ssize_t ival = -1;
+            PyObject *iobj = _PyNumber_Index(args[1]);
+            if (iobj != NULL) {
+                ival = PyLong_AsSsize_t(iobj);
+                Py_DECREF(iobj);
+            }
+            if (ival == -1 && PyErr_Occurred()) {
+                goto exit;
+            }
+            pos = ival;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        endpos = ival;
+    }
+skip_optional_pos:
+    return_value = _multisearch_Matcher_findall_impl((MatcherObject *)self, string, pos, endpos);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_multisearch_Matcher_replace__doc__,
+"replace($self, /, string, repl, count=-1)\n"
+"--\n"
+"\n"
+"Return a copy of string with matches replaced by repl.\n"
+"\n"
+"repl is either a single replacement for all patterns or a sequence with\n"
+"a replacement for each pattern.  If count is given, only the first count\n"
+"matches are replaced.  A bytes-like string gives a bytes result.");
+
+#define _MULTISEARCH_MATCHER_REPLACE_METHODDEF    \
+    {"replace", _PyCFunction_CAST(_multisearch_Matcher_replace), METH_FASTCALL|METH_KEYWORDS, _multisearch_Matcher_replace__doc__},
+
+static PyObject *
+_multisearch_Matcher_replace_impl(MatcherObject *self, PyObject *string,
+                                  PyObject *repl, Py_ssize_t count);
+
+static PyObject *
+_multisearch_Matcher_replace(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(string), &_Py_ID(repl), &_Py_ID(count), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"string", "repl", "count", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "replace",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 2;
+    PyObject *string;
+    PyObject *repl;
+    Py_ssize_t count = -1;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 2, /*maxpos*/ 3, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    string = args[0];
+    repl = args[1];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        count = ival;
+    }
+skip_optional_pos:
+    return_value = _multisearch_Matcher_replace_impl((MatcherObject *)self, string, repl, count);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_multisearch_Matcher___reduce____doc__,
+"__reduce__($self, /)\n"
+"--\n"
+"\n"
+"Return state information for pickling.");
+
+#define _MULTISEARCH_MATCHER___REDUCE___METHODDEF    \
+    {"__reduce__", (PyCFunction)_multisearch_Matcher___reduce__, METH_NOARGS, _multisearch_Matcher___reduce____doc__},
+
+static PyObject *
+_multisearch_Matcher___reduce___impl(MatcherObject *self);
+
+static PyObject *
+_multisearch_Matcher___reduce__(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _multisearch_Matcher___reduce___impl((MatcherObject *)self);
+}
+/*[clinic end generated code: output=92c559fca1a231eb input=a9049054013a1b77]*/
@@ -0,0 +1,1009 @@
+/*
+ * Multi-pattern literal search
+ *
+ * A Matcher is built once from a set of literal strings and finds all
+ * of them in a single pass over a string, using an Aho-Corasick
+ * automaton compiled to a dense transition table over the characters
+ * that occur in the patterns.  The text between candidate starts is
+ * skipped by a prefilter on the first two characters of the patterns
+ * (or the first one): when there are only a few distinct prefixes, it
+ * compares them against a block of characters at a time, otherwise it
+ * looks them up in a bitmap.
+ *
+ * Matches are leftmost-longest and do not overlap: the match starting
+ * first wins, and of the patterns starting there, the longest one.
+ */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_bytesobject.h"   // _PyBytesWriter
+#include "pycore_moduleobject.h"  // _PyModule_GetState()
+
+#include <stddef.h>               // offsetof()
+
+/* Maximum number of distinct prefixes compared by the prefilter; larger
+   sets are looked up in a bitmap of MS_BITMAP_BITS hashes. */
+#define MS_MAX_FIRST 8
+#define MS_BITMAP_BITS 4096
+#define MS_PREFIX_HASH(c, d) \
+    ((((size_t)(c) * 33) ^ (size_t)(d)) & (MS_BITMAP_BITS - 1))
+/* Sets of at most MS_FIND_MAX patterns are searched one pattern at a
+   time with the substring search of str and bytes, which is faster than
+   the automaton for them (see Tools/searchbench). */
+#define MS_FIND_MAX 4
+/* Number of characters checked at a time by the prefilter. */
+#define MS_BLOCK 32
+/* The prefilter is turned off for the rest of a search if, over
+   MS_SKIP_PROBE calls, it skipped less than MS_SKIP_MIN characters
+   per call on average. */
+#define MS_SKIP_PROBE 32
+#define MS_SKIP_MIN 8
+
+/* Each state of the automaton is a row of the transition table, and is
+   represented by the offset of its row.  A row starts with information
+   about the state, followed by the next state for every class. */
+#define MS_ROW_OUTLEN 0     /* length of the longest pattern ending in
+                               the state, or 0 */
+#define MS_ROW_OUTINDEX 1   /* index of that pattern */
+#define MS_ROW_DEPTH 2      /* length of the prefix the state stands for */
+#define MS_ROW_NEXT 3
+
+typedef struct {
+    PyTypeObject *MatcherType;
+} multisearch_state;
+
+static multisearch_state *
+get_multisearch_state(PyObject *module)
+{
+    multisearch_state *state = _PyModule_GetState(module);
+    assert(state != NULL);
+    return state;
+}
+
+static struct PyModuleDef multisearchmodule;
+#define get_multisearch_state_by_type(type) \
+    (get_multisearch_state(PyType_GetModuleByDef(type, &multisearchmodule)))
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *patterns;         /* tuple of str or bytes */
+    int isbytes;
+    Py_ssize_t nclasses;        /* character classes, 0 is "no pattern" */
+    Py_ssize_t nstates;
+    int32_t *table;             /* nstates rows of MS_ROW_NEXT + nclasses */
+    int32_t lowclass[256];      /* classes of the characters below 256 */
+    Py_ssize_t nwide;
+    Py_UCS4 *widechars;         /* sorted pattern characters >= 256 */
+    int32_t *wideclass;
+    int nfirst;                 /* distinct prefixes, or 0 if there are
+                                   more than MS_MAX_FIRST */
+    int pairs;                  /* the prefixes are pairs of characters */
+    Py_UCS4 first[MS_MAX_FIRST];
+    Py_UCS4 second[MS_MAX_FIRST];
+    unsigned char bitmap[MS_BITMAP_BITS / 8];  /* hashes of all prefixes */
+} MatcherObject;
+
+#define MatcherObject_CAST(op)  ((MatcherObject *)(op))
+
+static int32_t
+matcher_wide_class(const MatcherObject *self, Py_UCS4 c)
+{
+    Py_ssize_t lo = 0, hi = self->nwide;
+    while (lo < hi) {
+        Py_ssize_t mid = (lo + hi) / 2;
+        if (self->widechars[mid] < c) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if (lo < self->nwide && self->widechars[lo] == c) {
+        return self->wideclass[lo];
+    }
+    return 0;
+}
+
+#define MS_CHAR Py_UCS1
+#define MS_CHARSIZE 1
+#define MS(F) ms_ucs1_##F
+#include "multisearch_lib.h"
+
+#define MS_CHAR Py_UCS2
+#define MS_CHARSIZE 2
+#define MS(F) ms_ucs2_##F
+#include "multisearch_lib.h"
+
+#define MS_CHAR Py_UCS4
+#define MS_CHARSIZE 4
+#define MS(F) ms_ucs4_##F
+#include "multisearch_lib.h"
+
+/*[clinic input]
+module _multisearch
+class _multisearch.Matcher "MatcherObject *" "get_multisearch_state_by_type(type)->MatcherType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=83bb09ba906eca80]*/
+
+
+/* --- Building the automaton ---------------------------------------------- */
+
+static inline Py_UCS4
+pattern_char(PyObject *pattern, int isbytes, Py_ssize_t i)
+{
+    if (isbytes) {
+        return (unsigned char)PyBytes_AS_STRING(pattern)[i];
+    }
+    return PyUnicode_READ_CHAR(pattern, i);
+}
+
+static inline Py_ssize_t
+pattern_length(PyObject *pattern, int isbytes)
+{
+    return isbytes ? PyBytes_GET_SIZE(pattern) : PyUnicode_GET_LENGTH(pattern);
+}
+
+static int
+compare_ucs4(const void *a, const void *b)
+{
+    Py_UCS4 x = *(const Py_UCS4 *)a, y = *(const Py_UCS4 *)b;
+    return (x > y) - (x < y);
+}
+
+static int32_t
+matcher_class(const MatcherObject *self, Py_UCS4 c)
+{
+    return c < 256 ? self->lowclass[c] : matcher_wide_class(self, c);
+}
+
+/* Fill the bitmap of prefixes and collect the distinct prefixes of the
+   patterns.  Return 0 and leave no prefix if there are more than
+   MS_MAX_FIRST. */
+static int
+matcher_collect_prefixes(MatcherObject *self)
+{
+    PyObject *patterns = self->patterns;
+    self->nfirst = 0;
+    memset(self->bitmap, 0, sizeof(self->bitmap));
+    for (Py_ssize_t k = 0; k < PyTuple_GET_SIZE(patterns); k++) {
+        PyObject *pattern = PyTuple_GET_ITEM(patterns, k);
+        Py_UCS4 c = pattern_char(pattern, self->isbytes, 0);
+        Py_UCS4 d = self->pairs ? pattern_char(pattern, self->isbytes, 1) : 0;
+        size_t h = MS_PREFIX_HASH(c, d);
+        self->bitmap[h >> 3] |= 1 << (h & 7);
+    }
+    for (Py_ssize_t k = 0; k < PyTuple_GET_SIZE(patterns); k++) {
+        PyObject *pattern = PyTuple_GET_ITEM(patterns, k);
+        Py_UCS4 c = pattern_char(pattern, self->isbytes, 0);
+        Py_UCS4 d = self->pairs ? pattern_char(pattern, self->isbytes, 1) : 0;
+        int j;
+        for (j = 0; j < self->nfirst; j++) {
+            if (self->first[j] == c && self->second[j] == d) {
+                break;
+            }
+        }
+        if (j == self->nfirst) {
+            if (self->nfirst == MS_MAX_FIRST) {
+                self->nfirst = 0;
+                return 0;
+            }
+            self->first[j] = c;
+            self->second[j] = d;
+            self->nfirst++;
+        }
+    }
+    return 1;
+}
+
+/* Assign a class to every distinct character of the patterns and record
+   the prefixes for the prefilter: the first two characters of the
+   patterns, or the first one if there is a single character pattern. */
+static int
+matcher_build_classes(MatcherObject *self, Py_ssize_t total)
+{
+    PyObject *patterns = self->patterns;
+    Py_ssize_t npatterns = PyTuple_GET_SIZE(patterns);
+    int32_t nclasses = 1;
+
+    memset(self->lowclass, 0, sizeof(self->lowclass));
+    /* Characters >= 256: sort them, then number the distinct ones. */
+    self->widechars = PyMem_New(Py_UCS4, total);
+    if (self->widechars == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    Py_ssize_t nwide = 0;
+    for (Py_ssize_t k = 0; k < npatterns; k++) {
+        PyObject *pattern = PyTuple_GET_ITEM(patterns, k);
+        Py_ssize_t len = pattern_length(pattern, self->isbytes);
+        for (Py_ssize_t i = 0; i < len; i++) {
+            Py_UCS4 c = pattern_char(pattern, self->isbytes, i);
+            if (c < 256) {
+                if (self->lowclass[c] == 0) {
+                    self->lowclass[c] = nclasses++;
+                }
+            }
+            else {
+                self->widechars[nwide++] = c;
+            }
+        }
+    }
+    if (nwide) {
+        qsort(self->widechars, nwide, sizeof(Py_UCS4), compare_ucs4);
+        Py_ssize_t n = 0;
+        for (Py_ssize_t i = 0; i < nwide; i++) {
+            if (n == 0 || self->widechars[n - 1] != self->widechars[i]) {
+                self->widechars[n++] = self->widechars[i];
+            }
+        }
+        nwide = n;
+        self->wideclass = PyMem_New(int32_t, nwide);
+        if (self->wideclass == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (Py_ssize_t i = 0; i < nwide; i++) {
+            self->wideclass[i] = nclasses++;
+        }
+    }
+    self->nwide = nwide;
+    self->nclasses = nclasses;
+
+    self->pairs = 1;
+    for (Py_ssize_t k = 0; k < npatterns; k++) {
+        if (pattern_length(PyTuple_GET_ITEM(patterns, k), self->isbytes) < 2) {
+            self->pairs = 0;
+        }
+    }
+    (void)matcher_collect_prefixes(self);
+    return 0;
+}
+
+/* Build the trie of the patterns, then turn it into a complete
+   automaton: missing transitions follow the failure links, computed in
+   breadth-first order so that the failure state of a state is always
+   complete before the state itself.  Finally lay the automaton out as
+   the table of rows used for searching. */
+static int
+matcher_build_automaton(MatcherObject *self, Py_ssize_t total)
+{
+    PyObject *patterns = self->patterns;
+    Py_ssize_t npatterns = PyTuple_GET_SIZE(patterns);
+    Py_ssize_t nclasses = self->nclasses;
+    Py_ssize_t stride = MS_ROW_NEXT + nclasses;
+    Py_ssize_t maxstates = total + 1;
+    int32_t *delta = NULL, *depth = NULL, *outlen = NULL, *outindex = NULL;
+    int32_t *fail = NULL, *queue = NULL;
+    int res = -1;
+
+    if ((size_t)maxstates > INT32_MAX / (size_t)stride) {
+        PyErr_SetString(PyExc_OverflowError, "too many patterns");
+        return -1;
+    }
+    delta = PyMem_Calloc(maxstates * nclasses, sizeof(int32_t));
+    depth = PyMem_New(int32_t, maxstates);
+    outlen = PyMem_Calloc(maxstates, sizeof(int32_t));
+    outindex = PyMem_Calloc(maxstates, sizeof(int32_t));
+    fail = PyMem_New(int32_t, maxstates);
+    queue = PyMem_New(int32_t, maxstates);
+    if (delta == NULL || depth == NULL || outlen == NULL
+        || outindex == NULL || fail == NULL || queue == NULL)
+    {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    /* The trie.  0 is the root and is never the target of an edge, so
+       a zero transition means "no edge" until the automaton is
+       completed. */
+    int32_t nstates = 1;
+    depth[0] = 0;
+    for (Py_ssize_t k = 0; k < npatterns; k++) {
+        PyObject *pattern = PyTuple_GET_ITEM(patterns, k);
+        Py_ssize_t len = pattern_length(pattern, self->isbytes);
+        int32_t state = 0;
+        for (Py_ssize_t i = 0; i < len; i++) {
+            int32_t c = matcher_class(
+                self, pattern_char(pattern, self->isbytes, i));
+            int32_t *next = &delta[state * nclasses + c];
+            if (*next == 0) {
+                depth[nstates] = depth[state] + 1;
+                *next = nstates++;
+            }
+            state = *next;
+        }
+        if (outlen[state] == 0) {
+            /* The first of duplicate patterns wins. */
+            outlen[state] = (int32_t)len;
+            outindex[state] = (int32_t)k;
+        }
+    }
+
+    /* Failure links and the complete automaton. */
+    Py_ssize_t head = 0, tail = 0;
+    fail[0] = 0;
+    for (Py_ssize_t c = 0; c < nclasses; c++) {
+        int32_t t = delta[c];
+        if (t) {
+            fail[t] = 0;
+            queue[tail++] = t;
+        }
+    }
+    while (head < tail) {
+        int32_t s = queue[head++];
+        int32_t f = fail[s];
+        if (outlen[s] == 0) {
+            outlen[s] = outlen[f];
+            outindex[s] = outindex[f];
+        }
+        int32_t *row = &delta[s * nclasses];
+        const int32_t *frow = &delta[f * nclasses];
+        for (Py_ssize_t c = 0; c < nclasses; c++) {
+            if (row[c]) {
+                fail[row[c]] = frow[c];
+                queue[tail++] = row[c];
+            }
+            else {
+                row[c] = frow[c];
+            }
+        }
+    }
+
+    self->table = PyMem_New(int32_t, nstates * stride);
+    if (self->table == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (int32_t s = 0; s < nstates; s++) {
+        int32_t *row = &self->table[s * stride];
+        row[MS_ROW_OUTLEN] = outlen[s];
+        row[MS_ROW_OUTINDEX] = outindex[s];
+        row[MS_ROW_DEPTH] = depth[s];
+        for (Py_ssize_t c = 0; c < nclasses; c++) {
+            row[MS_ROW_NEXT + c] = (int32_t)(delta[s * nclasses + c] * stride);
+        }
+    }
+    self->nstates = nstates;
+    res = 0;
+
+done:
+    PyMem_Free(delta);
+    PyMem_Free(depth);
+    PyMem_Free(outlen);
+    PyMem_Free(outindex);
+    PyMem_Free(fail);
+    PyMem_Free(queue);
+    return res;
+}
+
+static PyObject *
+matcher_patterns_tuple(PyObject *patterns, int *p_isbytes,
+                       Py_ssize_t *p_total)
+{
+    PyObject *tuple = PySequence_Tuple(patterns);
+    if (tuple == NULL) {
+        return NULL;
+    }
+    Py_ssize_t n = PyTuple_GET_SIZE(tuple);
+    if (n == 0) {
+        PyErr_SetString(PyExc_ValueError, "at least one pattern is required");
+        goto error;
+    }
+    int isbytes = !PyUnicode_Check(PyTuple_GET_ITEM(tuple, 0));
+    Py_ssize_t total = 0;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = PyTuple_GET_ITEM(tuple, i);
+        if (PyUnicode_Check(item) == isbytes) {
+            PyErr_SetString(PyExc_TypeError,
+                            "cannot mix str and bytes patterns");
+            goto error;
+        }
+        if (isbytes && !PyBytes_CheckExact(item)) {
+            /* Any bytes-like object is copied to bytes. */
+            if (!PyObject_CheckBuffer(item)) {
+                PyErr_Format(PyExc_TypeError,
+                             "expected str or bytes-like object, got '%.200s'",
+                             Py_TYPE(item)->tp_name);
+                goto error;
+            }
+            PyObject *b = PyBytes_FromObject(item);
+            if (b == NULL) {
+                goto error;
+            }
+            PyTuple_SET_ITEM(tuple, i, b);
+            Py_DECREF(item);
+            item = b;
+        }
+        Py_ssize_t len = pattern_length(item, isbytes);
+        if (len == 0) {
+            PyErr_SetString(PyExc_ValueError, "empty pattern");
+            goto error;
+        }
+        total += len;
+    }
+    *p_isbytes = isbytes;
+    *p_total = total;
+    return tuple;
+
+error:
+    Py_DECREF(tuple);
+    return NULL;
+}
+
+/*[clinic input]
+@classmethod
+_multisearch.Matcher.__new__ as matcher_new
+
+    patterns: object
+    /
+
+Compile a set of literal strings for searching them all at once.
+
+The patterns are either all str or all bytes-like objects.  Matches
+are leftmost-longest and do not overlap.
+[clinic start generated code]*/
+
+static PyObject *
+matcher_new_impl(PyTypeObject *type, PyObject *patterns)
+/*[clinic end generated code: output=a2c7cd404d9b5532 input=1db2aa06080bf518]*/
+{
+    int isbytes;
+    Py_ssize_t total;
+    PyObject *tuple = matcher_patterns_tuple(patterns, &isbytes, &total);
+    if (tuple == NULL) {
+        return NULL;
+    }
+    MatcherObject *self = (MatcherObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        Py_DECREF(tuple);
+        return NULL;
+    }
+    self->patterns = tuple;
+    self->isbytes = isbytes;
+    if (matcher_build_classes(self, total) < 0
+        || matcher_build_automaton(self, total) < 0)
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static void
+matcher_dealloc(PyObject *op)
+{
+    MatcherObject *self = MatcherObject_CAST(op);
+    PyTypeObject *tp = Py_TYPE(self);
+
+    Py_XDECREF(self->patterns);
+    PyMem_Free(self->table);
+    PyMem_Free(self->widechars);
+    PyMem_Free(self->wideclass);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+
+/* --- Searching ----------------------------------------------------------- */
+
+typedef struct {
+    PyObject *object;
+    const void *data;
+    Py_ssize_t length;
+    int charsize;
+    Py_buffer view;
+    /* For small sets of patterns: the start of the next occurrence of
+       every pattern at or after the last search position, -1 if not
+       searched yet, or the end position if there is none.  Successive
+       searches of findall() and replace() only search again for the
+       patterns whose occurrence they went past. */
+    Py_ssize_t next[MS_FIND_MAX];
+} ms_string;
+
+static int
+ms_string_init(MatcherObject *self, PyObject *string, ms_string *str)
+{
+    str->object = string;
+    str->view.buf = NULL;
+    for (int k = 0; k < MS_FIND_MAX; k++) {
+        str->next[k] = -1;
+    }
+    if (PyUnicode_Check(string)) {
+        if (self->isbytes) {
+            PyErr_SetString(PyExc_TypeError,
+                            "cannot use a bytes pattern on a string-like object");
+            return -1;
+        }
+        str->data = PyUnicode_DATA(string);
+        str->length = PyUnicode_GET_LENGTH(string);
+        str->charsize = PyUnicode_KIND(string);
+        return 0;
+    }
+    if (PyObject_GetBuffer(string, &str->view, PyBUF_SIMPLE) != 0) {
+        PyErr_Format(PyExc_TypeError, "expected string or bytes-like "
+                     "object, got '%.200s'", Py_TYPE(string)->tp_name);
+        return -1;
+    }
+    if (!self->isbytes) {
+        PyErr_SetString(PyExc_TypeError,
+                        "cannot use a string pattern on a bytes-like object");
+        PyBuffer_Release(&str->view);
+        str->view.buf = NULL;
+        return -1;
+    }
+    str->data = str->view.buf;
+    str->length = str->view.len;
+    str->charsize = 1;
+    return 0;
+}
+
+static void
+ms_string_fini(ms_string *str)
+{
+    if (str->view.buf != NULL) {
+        PyBuffer_Release(&str->view);
+    }
+}
+
+static void
+ms_adjust_bounds(const ms_string *str, Py_ssize_t *pos, Py_ssize_t *endpos)
+{
+    if (*pos < 0) {
+        *pos = 0;
+    }
+    else if (*pos > str->length) {
+        *pos = str->length;
+    }
+    if (*endpos < 0) {
+        *endpos = 0;
+    }
+    else if (*endpos > str->length) {
+        *endpos = str->length;
+    }
+}
+
+/* Find the leftmost-longest match of a small set of patterns with one
+   substring search per pattern. */
+static Py_ssize_t
+ms_find_search(const MatcherObject *self, ms_string *str,
+               Py_ssize_t pos, Py_ssize_t endpos,
+               Py_ssize_t *plen, Py_ssize_t *pindex)
+{
+    PyObject *patterns = self->patterns;
+    Py_ssize_t best = -1, bestlen = 0;
+
+    if (pos >= endpos) {
+        return -1;
+    }
+    for (Py_ssize_t k = 0; k < PyTuple_GET_SIZE(patterns); k++) {
+        PyObject *pattern = PyTuple_GET_ITEM(patterns, k);
+        Py_ssize_t len = pattern_length(pattern, self->isbytes);
+        Py_ssize_t start = str->next[k];
+        if (start < pos) {
+            if (self->isbytes) {
+                start = _PyBytes_Find((const char *)str->data + pos,
+                                      endpos - pos, PyBytes_AS_STRING(pattern),
+                                      len, pos);
+            }
+            else {
+                start = PyUnicode_Find(str->object, pattern, pos, endpos, 1);
+                assert(start != -2);
+            }
+            if (start < 0) {
+                start = endpos;
+            }
+            str->next[k] = start;
+        }
+        if (start < endpos
+            && (best < 0 || start < best || (start == best && len > bestlen)))
+        {
+            best = start;
+            bestlen = len;
+            *pindex = k;
+        }
+    }
+    if (best >= 0) {
+        *plen = bestlen;
+    }
+    return best;
+}
+
+static Py_ssize_t
+ms_search(const MatcherObject *self, ms_string *str,
+          Py_ssize_t pos, Py_ssize_t endpos,
+          Py_ssize_t *plen, Py_ssize_t *pindex)
+{
+    if (PyTuple_GET_SIZE(self->patterns) <= MS_FIND_MAX) {
+        return ms_find_search(self, str, pos, endpos, plen, pindex);
+    }
+    switch (str->charsize) {
+    case 1:
+        return ms_ucs1_search(self, str->data, pos, endpos, plen, pindex);
+    case 2:
+        return ms_ucs2_search(self, str->data, pos, endpos, plen, pindex);
+    default:
+        return ms_ucs4_search(self, str->data, pos, endpos, plen, pindex);
+    }
+}
+
+/*[clinic input]
+_multisearch.Matcher.search
+
+    string: object
+    pos: Py_ssize_t = 0
+    endpos: Py_ssize_t(c_default="PY_SSIZE_T_MAX") = sys.maxsize
+
+Find the first match in string[pos:endpos].
+
+Return a (start, index) tuple, where index is the index of the matched
+pattern, or None if no pattern occurs.
+[clinic start generated code]*/
+
+static PyObject *
+_multisearch_Matcher_search_impl(MatcherObject *self, PyObject *string,
+                                 Py_ssize_t pos, Py_ssize_t endpos)
+/*[clinic end generated code: output=7568cc2dbd6068ea input=282b513f585a5286]*/
+{
+    ms_string str;
+    Py_ssize_t len, index;
+
+    if (ms_string_init(self, string, &str) < 0) {
+        return NULL;
+    }
+    ms_adjust_bounds(&str, &pos, &endpos);
+    Py_ssize_t start = ms_search(self, &str, pos, endpos, &len, &index);
+    ms_string_fini(&str);
+    if (start < 0) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("nn", start, index);
+}
+
+/*[clinic input]
+_multisearch.Matcher.findall
+
+    string: object
+    pos: Py_ssize_t = 0
+    endpos: Py_ssize_t(c_default="PY_SSIZE_T_MAX") = sys.maxsize
+
+Return a list of all non-overlapping matches in string[pos:endpos].
+
+Each match is a (start, index) tuple, where index is the index of the
+matched pattern.
+[clinic start generated code]*/
+
+static PyObject *
+_multisearch_Matcher_findall_impl(MatcherObject *self, PyObject *string,
+                                  Py_ssize_t pos, Py_ssize_t endpos)
+/*[clinic end generated code: output=47e425c5c4044d4c input=8137428a512d0d4e]*/
+{
+    ms_string str;
+    Py_ssize_t len, index;
+
+    if (ms_string_init(self, string, &str) < 0) {
+        return NULL;
+    }
+    ms_adjust_bounds(&str, &pos, &endpos);
+    PyObject *list = PyList_New(0);
+    if (list == NULL) {
+        goto done;
+    }
+    while (pos < endpos) {
+        Py_ssize_t start = ms_search(self, &str, pos, endpos, &len, &index);
+        if (start < 0) {
+            break;
+        }
+        PyObject *item = Py_BuildValue("nn", start, index);
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_CLEAR(list);
+            goto done;
+        }
+        Py_DECREF(item);
+        pos = start + len;
+    }
+done:
+    ms_string_fini(&str);
+    return list;
+}
+
+/* Check the replacement argument of replace() and return a new
+   reference to a tuple with a replacement for every pattern. */
+static PyObject *
+ms_replacements(MatcherObject *self, PyObject *repl)
+{
+    Py_ssize_t npatterns = PyTuple_GET_SIZE(self->patterns);
+    PyObject *tuple;
+    if (PyUnicode_Check(repl) || PyBytes_Check(repl)
+        || PyByteArray_Check(repl))
+    {
+        tuple = PyTuple_New(npatterns);
+        if (tuple == NULL) {
+            return NULL;
+        }
+        for (Py_ssize_t i = 0; i < npatterns; i++) {
+            PyTuple_SET_ITEM(tuple, i, Py_NewRef(repl));
+        }
+    }
+    else {
+        tuple = PySequence_Tuple(repl);
+        if (tuple == NULL) {
+            return NULL;
+        }
+        if (PyTuple_GET_SIZE(tuple) != npatterns) {
+            PyErr_Format(PyExc_ValueError,
+                         "expected %zd replacements, got %zd",
+                         npatterns, PyTuple_GET_SIZE(tuple));
+            goto error;
+        }
+    }
+    for (Py_ssize_t i = 0; i < npatterns; i++) {
+        PyObject *item = PyTuple_GET_ITEM(tuple, i);
+        if (self->isbytes ? !PyObject_CheckBuffer(item)
+                          : !PyUnicode_Check(item))
+        {
+            PyErr_Format(PyExc_TypeError,
+                         "replacement must be %s, not %.200s",
+                         self->isbytes ? "a bytes-like object" : "str",
+                         Py_TYPE(item)->tp_name);
+            goto error;
+        }
+        if (self->isbytes && !PyBytes_CheckExact(item)) {
+            PyObject *b = PyBytes_FromObject(item);
+            if (b == NULL) {
+                goto error;
+            }
+            PyTuple_SET_ITEM(tuple, i, b);
+            Py_DECREF(item);
+        }
+    }
+    return tuple;
+
+error:
+    Py_DECREF(tuple);
+    return NULL;
+}
+
+static PyObject *
+ms_replace_str(MatcherObject *self, PyObject *string, ms_string *str,
+               PyObject *repls, Py_ssize_t count)
+{
+    Py_ssize_t pos = 0, len, index;
+    PyUnicodeWriter *writer = PyUnicodeWriter_Create(str->length);
+    if (writer == NULL) {
+        return NULL;
+    }
+    while (count != 0) {
+        Py_ssize_t start = ms_search(self, str, pos, str->length,
+                                     &len, &index);
+        if (start < 0) {
+            break;
+        }
+        if (PyUnicodeWriter_WriteSubstring(writer, string, pos, start) < 0
+            || PyUnicodeWriter_WriteStr(writer,
+                                        PyTuple_GET_ITEM(repls, index)) < 0)
+        {
+            goto error;
+        }
+        pos = start + len;
+        count--;
+    }
+    if (PyUnicodeWriter_WriteSubstring(writer, string, pos, str->length) < 0) {
+        goto error;
+    }
+    return PyUnicodeWriter_Finish(writer);
+
+error:
+    PyUnicodeWriter_Discard(writer);
+    return NULL;
+}
+
+static PyObject *
+ms_replace_bytes(MatcherObject *self, ms_string *str,
+                 PyObject *repls, Py_ssize_t count)
+{
+    const char *data = str->data;
+    Py_ssize_t pos = 0, len, index;
+    _PyBytesWriter writer;
+    _PyBytesWriter_Init(&writer);
+    writer.overallocate = 1;
+
+    char *p = _PyBytesWriter_Alloc(&writer, str->length);
+    if (p == NULL) {
+        return NULL;
+    }
+    while (count != 0) {
+        Py_ssize_t start = ms_search(self, str, pos, str->length,
+                                     &len, &index);
+        if (start < 0) {
+            break;
+        }
+        PyObject *r = PyTuple_GET_ITEM(repls, index);
+        p = _PyBytesWriter_WriteBytes(&writer, p, data + pos, start - pos);
+        if (p == NULL) {
+            goto error;
+        }
+        p = _PyBytesWriter_WriteBytes(&writer, p, PyBytes_AS_STRING(r),
+                                      PyBytes_GET_SIZE(r));
+        if (p == NULL) {
+            goto error;
+        }
+        pos = start + len;
+        count--;
+    }
+    p = _PyBytesWriter_WriteBytes(&writer, p, data + pos, str->length - pos);
+    if (p == NULL) {
+        goto error;
+    }
+    return _PyBytesWriter_Finish(&writer, p);
+
+error:
+    _PyBytesWriter_Dealloc(&writer);
+    return NULL;
+}
+
+/*[clinic input]
+_multisearch.Matcher.replace
+
+    string: object
+    repl: object
+    count: Py_ssize_t = -1
+
+Return a copy of string with matches replaced by repl.
+
+repl is either a single replacement for all patterns or a sequence with
+a replacement for each pattern.  If count is given, only the first count
+matches are replaced.  A bytes-like string gives a bytes result.
+[clinic start generated code]*/
+
+static PyObject *
+_multisearch_Matcher_replace_impl(MatcherObject *self, PyObject *string,
+                                  PyObject *repl, Py_ssize_t count)
+/*[clinic end generated code: output=0ce8881dc77de5b3 input=2a10b84130abcded]*/
+{
+    ms_string str;
+    PyObject *result = NULL;
+
+    PyObject *repls = ms_replacements(self, repl);
+    if (repls == NULL) {
+        return NULL;
+    }
+    if (ms_string_init(self, string, &str) < 0) {
+        Py_DECREF(repls);
+        return NULL;
+    }
+    if (!self->isbytes) {
+        result = ms_replace_str(self, string, &str, repls, count);
+    }
+    else {
+        result = ms_replace_bytes(self, &str, repls, count);
+    }
+    ms_string_fini(&str);
+    Py_DECREF(repls);
+    return result;
+}
+
+/*[clinic input]
+_multisearch.Matcher.__reduce__
+
+Return state information for pickling.
+[clinic start generated code]*/
+
+static PyObject *
+_multisearch_Matcher___reduce___impl(MatcherObject *self)
+/*[clinic end generated code: output=fef970b37b2b1cbd input=a31507421da4f696]*/
+{
+    return Py_BuildValue("O(O)", Py_TYPE(self), self->patterns);
+}
+
+static PyObject *
+matcher_repr(PyObject *op)
+{
+    MatcherObject *self = MatcherObject_CAST(op);
+    return PyUnicode_FromFormat("%s(%R)", _PyType_Name(Py_TYPE(self)),
+                                self->patterns);
+}
+
+#include "clinic/multisearch.c.h"
+
+static PyMethodDef matcher_methods[] = {
+    _MULTISEARCH_MATCHER_SEARCH_METHODDEF
+    _MULTISEARCH_MATCHER_FINDALL_METHODDEF
+    _MULTISEARCH_MATCHER_REPLACE_METHODDEF
+    _MULTISEARCH_MATCHER___REDUCE___METHODDEF
+    {NULL, NULL}
+};
+
+static PyMemberDef matcher_members[] = {
+    {"patterns", _Py_T_OBJECT, offsetof(MatcherObject, patterns), Py_READONLY,
+     PyDoc_STR("The tuple of patterns.")},
+    {NULL}
+};
+
+static PyType_Slot matcher_slots[] = {
+    {Py_tp_dealloc, matcher_dealloc},
+    {Py_tp_repr, matcher_repr},
+    {Py_tp_doc, (void *)matcher_new__doc__},
+    {Py_tp_methods, matcher_methods},
+    {Py_tp_members, matcher_members},
+    {Py_tp_new, matcher_new},
+    {0, NULL},
+};
+
+static PyType_Spec matcher_spec = {
+    .name = "string.Matcher",
+    .basicsize = sizeof(MatcherObject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = matcher_slots,
+};
+
+
+/* --- Module -------------------------------------------------------------- */
+
+static int
+multisearch_traverse(PyObject *module, visitproc visit, void *arg)
+{
+    multisearch_state *state = get_multisearch_state(module);
+    Py_VISIT(state->MatcherType);
+    return 0;
+}
+
+static int
+multisearch_clear(PyObject *module)
+{
+    multisearch_state *state = get_multisearch_state(module);
+    Py_CLEAR(state->MatcherType);
+    return 0;
+}
+
+static void
+multisearch_free(void *module)
+{
+    (void)multisearch_clear((PyObject *)module);
+}
+
+static int
+multisearch_exec(PyObject *module)
+{
+    multisearch_state *state = get_multisearch_state(module);
+    state->MatcherType = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &matcher_spec, NULL);
+    if (state->MatcherType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->MatcherType) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static PyModuleDef_Slot multisearch_slots[] = {
+    {Py_mod_exec, multisearch_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
+
+PyDoc_STRVAR(multisearch_doc,
+"Search for many literal strings at once.\n\
+This module is an implementation detail, please use string.Matcher.");
+
+static struct PyModuleDef multisearchmodule = {
+    .m_base = PyModuleDef_HEAD_INIT,
+    .m_name = "_multisearch",
+    .m_doc = multisearch_doc,
+    .m_size = sizeof(multisearch_state),
+    .m_slots = multisearch_slots,
+    .m_traverse = multisearch_traverse,
+    .m_clear = multisearch_clear,
+    .m_free = multisearch_free,
+};
+
+PyMODINIT_FUNC
+PyInit__multisearch(void)
+{
+    return PyModuleDef_Init(&multisearchmodule);
+}
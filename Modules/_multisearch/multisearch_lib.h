@@ -0,0 +1,224 @@
+/*
+ * Multi-pattern search template
+ *
+ * This file is included three times, with MS_CHAR defined to the
+ * character type of the searched string (Py_UCS1, Py_UCS2 or Py_UCS4),
+ * MS_CHARSIZE to its size and MS(F) to a name mangling macro.
+ */
+
+static inline int32_t
+MS(char_class)(const MatcherObject *self, MS_CHAR c)
+{
+#if MS_CHARSIZE == 1
+    return self->lowclass[c];
+#else
+    if (c < 256) {
+        return self->lowclass[c];
+    }
+    return matcher_wide_class(self, c);
+#endif
+}
+
+/* Fill first (and second, for a prefilter on pairs) with the prefixes
+   of the patterns that can occur in a string of this kind, padded to
+   MS_MAX_FIRST entries.  Return 0 if there are too many prefixes for
+   that, -1 if no pattern can match at all. */
+static int
+MS(prepare_prefilter)(const MatcherObject *self,
+                      MS_CHAR *first, MS_CHAR *second)
+{
+    int n = 0;
+    if (self->nfirst == 0) {
+        return 0;
+    }
+    for (int j = 0; j < self->nfirst; j++) {
+        if (self->first[j] <= (MS_CHAR)-1 && self->second[j] <= (MS_CHAR)-1) {
+            first[n] = (MS_CHAR)self->first[j];
+            second[n] = (MS_CHAR)self->second[j];
+            n++;
+        }
+    }
+    if (n == 0) {
+        return -1;
+    }
+    for (int j = n; j < MS_MAX_FIRST; j++) {
+        first[j] = first[0];
+        second[j] = second[0];
+    }
+    return n;
+}
+
+/* Return the position of the first character of s[i:end] that can start
+   a pattern, or end.  The block loops compare a block of characters
+   against all the prefixes with no branches, so compilers vectorize
+   them. */
+static Py_ssize_t
+MS(skip_first)(const MS_CHAR *s, Py_ssize_t i, Py_ssize_t end,
+               const MS_CHAR *first)
+{
+    while (i + MS_BLOCK <= end) {
+        unsigned char hit[MS_BLOCK];
+        int any = 0;
+        for (Py_ssize_t k = 0; k < MS_BLOCK; k++) {
+            MS_CHAR c = s[i + k];
+            int h = 0;
+            for (int j = 0; j < MS_MAX_FIRST; j++) {
+                h |= (c == first[j]);
+            }
+            hit[k] = (unsigned char)h;
+            any |= h;
+        }
+        if (any) {
+            for (Py_ssize_t k = 0; ; k++) {
+                if (hit[k]) {
+                    return i + k;
+                }
+            }
+        }
+        i += MS_BLOCK;
+    }
+    for (; i < end; i++) {
+        for (int j = 0; j < MS_MAX_FIRST; j++) {
+            if (s[i] == first[j]) {
+                return i;
+            }
+        }
+    }
+    return end;
+}
+
+static Py_ssize_t
+MS(skip_pair)(const MS_CHAR *s, Py_ssize_t i, Py_ssize_t end,
+              const MS_CHAR *first, const MS_CHAR *second)
+{
+    /* Every pattern has at least two characters here, so a pattern can
+       only start before end - 1. */
+    end--;
+    while (i + MS_BLOCK <= end) {
+        unsigned char hit[MS_BLOCK];
+        int any = 0;
+        for (Py_ssize_t k = 0; k < MS_BLOCK; k++) {
+            MS_CHAR c = s[i + k], d = s[i + k + 1];
+            int h = 0;
+            for (int j = 0; j < MS_MAX_FIRST; j++) {
+                h |= (c == first[j]) & (d == second[j]);
+            }
+            hit[k] = (unsigned char)h;
+            any |= h;
+        }
+        if (any) {
+            for (Py_ssize_t k = 0; ; k++) {
+                if (hit[k]) {
+                    return i + k;
+                }
+            }
+        }
+        i += MS_BLOCK;
+    }
+    for (; i < end; i++) {
+        for (int j = 0; j < MS_MAX_FIRST; j++) {
+            if (s[i] == first[j] && s[i + 1] == second[j]) {
+                return i;
+            }
+        }
+    }
+    return end + 1;
+}
+
+/* The same for larger sets of patterns, with a bitmap of the hashes of
+   their prefixes. */
+static Py_ssize_t
+MS(skip_bitmap)(const MatcherObject *self, const MS_CHAR *s,
+                Py_ssize_t i, Py_ssize_t end)
+{
+    const unsigned char *bitmap = self->bitmap;
+    if (self->pairs) {
+        end--;
+        for (; i < end; i++) {
+            size_t h = MS_PREFIX_HASH(s[i], s[i + 1]);
+            if (bitmap[h >> 3] & (1 << (h & 7))) {
+                return i;
+            }
+        }
+        return end + 1;
+    }
+    for (; i < end; i++) {
+        size_t h = MS_PREFIX_HASH(s[i], 0);
+        if (bitmap[h >> 3] & (1 << (h & 7))) {
+            return i;
+        }
+    }
+    return end;
+}
+
+/* Find the leftmost-longest match in s[i:end].  Return its start and
+   set *plen and *pindex to its length and pattern index, or return -1
+   if there is no match. */
+static Py_ssize_t
+MS(search)(const MatcherObject *self, const MS_CHAR *s,
+           Py_ssize_t i, Py_ssize_t end,
+           Py_ssize_t *plen, Py_ssize_t *pindex)
+{
+    const int32_t *table = self->table;
+    Py_ssize_t best = -1, bestend = 0;
+    Py_ssize_t skips = 0, skipped = 0;
+    int32_t state = 0;
+    MS_CHAR first[MS_MAX_FIRST], second[MS_MAX_FIRST];
+
+    int prefilter = 1;
+    int nfirst = MS(prepare_prefilter)(self, first, second);
+    if (nfirst < 0) {
+        return -1;
+    }
+    while (i < end) {
+        if (state == 0 && prefilter) {
+            /* No pattern is partially matched and no match is found
+               yet: skip to the next possible start. */
+            Py_ssize_t j;
+            if (nfirst == 0) {
+                j = MS(skip_bitmap)(self, s, i, end);
+            }
+            else if (self->pairs) {
+                j = MS(skip_pair)(s, i, end, first, second);
+            }
+            else {
+                j = MS(skip_first)(s, i, end, first);
+            }
+            if (j == end) {
+                break;
+            }
+            /* Stop using the prefilter when it does not skip enough to
+               pay for itself. */
+            skipped += j - i;
+            if (++skips == MS_SKIP_PROBE) {
+                if (skipped < MS_SKIP_PROBE * MS_SKIP_MIN) {
+                    prefilter = 0;
+                }
+                skips = skipped = 0;
+            }
+            i = j;
+        }
+        state = table[state + MS_ROW_NEXT + MS(char_class)(self, s[i])];
+        i++;
+        if (best >= 0 && i - table[state + MS_ROW_DEPTH] > best) {
+            /* Any further match would start after the best one. */
+            break;
+        }
+        if (table[state + MS_ROW_OUTLEN]) {
+            Py_ssize_t start = i - table[state + MS_ROW_OUTLEN];
+            if (best < 0 || start <= best) {
+                best = start;
+                bestend = i;
+                *pindex = table[state + MS_ROW_OUTINDEX];
+            }
+        }
+    }
+    if (best >= 0) {
+        *plen = bestend - best;
+    }
+    return best;
+}
+
+#undef MS_CHAR
+#undef MS_CHARSIZE
+#undef MS
@@ -549,6 +549,105 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_sre_SRE_Pattern_scan_spans__doc__,
+"scan_spans($self, /, string, pos=0, endpos=sys.maxsize)\n"
+"--\n"
+"\n"
+"Return the spans of all non-overlapping matches of pattern in string.\n"
+"\n"
+"The result is a read-only memoryview of format \'n\', which holds for each\n"
+"match the start and end of the match, then of each group (-1 and -1 for\n"
+"a group that did not participate in the match).");
+
+#define _SRE_SRE_PATTERN_SCAN_SPANS_METHODDEF    \
+    {"scan_spans", _PyCFunction_CAST(_sre_SRE_Pattern_scan_spans), METH_FASTCALL|METH_KEYWORDS, _sre_SRE_Pattern_scan_spans__doc__},
+
+static PyObject *
+_sre_SRE_Pattern_scan_spans_impl(PatternObject *self, PyObject *string,
+                                 Py_ssize_t pos, Py_ssize_t endpos);
+
+static PyObject *
+_sre_SRE_Pattern_scan_spans(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(string), &_Py_ID(pos), &_Py_ID(endpos), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"string", "pos", "endpos", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "scan_spans",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *string;
+    Py_ssize_t pos = 0;
+    Py_ssize_t endpos = PY_SSIZE_T_MAX;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 3, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    string = args[0];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[1]) {
+        {
+            Py_ssize_t ival = -1;
+            PyObject *iobj = _PyNumber_Index(args[1]);
+            if (iobj != NULL) {
+                ival = PyLong_AsSsize_t(iobj);
+                Py_DECREF(iobj);
+            }
+            if (ival == -1 && PyErr_Occurred()) {
+                goto exit;
+            }
+            pos = ival;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        endpos = ival;
+    }
+skip_optional_pos:
+    return_value = _sre_SRE_Pattern_scan_spans_impl((PatternObject *)self, string, pos, endpos);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_sre_SRE_Pattern_finditer__doc__,
 "finditer($self, /, string, pos=0, endpos=sys.maxsize)\n"
 "--\n"
@@ -1016,6 +1115,23 @@ _sre_SRE_Pattern___deepcopy__(PyObject *self, PyObject *memo)
     return return_value;
 }
 
+PyDoc_STRVAR(_sre_SRE_Pattern___sizeof____doc__,
+"__sizeof__($self, /)\n"
+"--\n"
+"\n");
+
+#define _SRE_SRE_PATTERN___SIZEOF___METHODDEF    \
+    {"__sizeof__", (PyCFunction)_sre_SRE_Pattern___sizeof__, METH_NOARGS, _sre_SRE_Pattern___sizeof____doc__},
+
+static PyObject *
+_sre_SRE_Pattern___sizeof___impl(PatternObject *self);
+
+static PyObject *
+_sre_SRE_Pattern___sizeof__(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _sre_SRE_Pattern___sizeof___impl((PatternObject *)self);
+}
+
 #if defined(Py_DEBUG)
 
 PyDoc_STRVAR(_sre_SRE_Pattern__fail_after__doc__,
@@ -1568,4 +1684,4 @@ _sre_SRE_Scanner_search(PyObject *self, PyTypeObject *cls, PyObject *const *args
 #ifndef _SRE_SRE_PATTERN__FAIL_AFTER_METHODDEF
     #define _SRE_SRE_PATTERN__FAIL_AFTER_METHODDEF
 #endif /* !defined(_SRE_SRE_PATTERN__FAIL_AFTER_METHODDEF) */
-/*[clinic end generated code: output=bbf42e1de3bdd3ae input=a9049054013a1b77]*/
+/*[clinic end generated code: output=2690737f0de022de input=a9049054013a1b77]*/
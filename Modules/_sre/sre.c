@@ -41,9 +41,10 @@ static const char copyright[] =
 #include "Python.h"
 #include "pycore_critical_section.h" // Py_BEGIN_CRITICAL_SECTION
 #include "pycore_dict.h"             // _PyDict_Next()
+#include "pycore_lock.h"             // PyMutex_LockFast()
 #include "pycore_long.h"             // _PyLong_GetZero()
 #include "pycore_moduleobject.h"     // _PyModule_GetState()
-#include "pycore_unicodeobject.h"    // _PyUnicode_Copy
+#include "pycore_unicodeobject.h"    // _PyUnicode_Copy, _PyUnicode_FindKind
 #include "pycore_weakref.h"          // FT_CLEAR_WEAKREFS()
 
 #include "sre.h"                     // SRE_CODE
@@ -108,6 +109,9 @@ static unsigned int sre_toupper(unsigned int ch) {
 #define SRE_ERROR_MEMORY -9 /* out of memory */
 #define SRE_ERROR_INTERRUPTED -10 /* signal handler raised exception */
 
+/* longest part of a required literal looked for by search */
+#define SRE_REQUIRED_MAX 32
+
 #if VERBOSE == 0
 #  define INIT_TRACE(state)
 #  define DO_TRACE 0
@@ -348,6 +352,8 @@ repeat_pool_clear(SRE_STATE *state)
     }
 }
 
+#include "sre_dfa.h"
+
 /* generate 8-bit version */
 
 #define SRE_CHAR Py_UCS1
@@ -587,6 +593,7 @@ state_init(SRE_STATE* state, PatternObject* pattern, PyObject* string,
     state->match_all = 0;
     state->must_advance = 0;
     state->debug = ((pattern->flags & SRE_FLAG_DEBUG) != 0);
+    state->dfa = pattern->dfa;
 
     state->beginning = ptr;
 
@@ -739,13 +746,27 @@ pattern_dealloc(PyObject *self)
     PyObject_GC_UnTrack(self);
     FT_CLEAR_WEAKREFS(self, _PatternObject_CAST(self)->weakreflist);
     (void)pattern_clear(self);
+    sre_dfa_free(_PatternObject_CAST(self)->dfa);
     tp->tp_free(self);
     Py_DECREF(tp);
 }
 
+LOCAL(int)
+sre_dfa_match(SRE_STATE* state)
+{
+    if (state->charsize == 1)
+        return sre_ucs1_dfa_match(state);
+    if (state->charsize == 2)
+        return sre_ucs2_dfa_match(state);
+    assert(state->charsize == 4);
+    return sre_ucs4_dfa_match(state);
+}
+
 LOCAL(Py_ssize_t)
 sre_match(SRE_STATE* state, SRE_CODE* pattern)
 {
+    if (state->dfa != NULL && !sre_dfa_match(state))
+        return 0;
     if (state->charsize == 1)
         return sre_ucs1_match(state, pattern, 1);
     if (state->charsize == 2)
@@ -996,6 +1017,112 @@ _sre_SRE_Pattern_findall_impl(PatternObject *self, PyObject *string,
 
 }
 
+/*[clinic input]
+_sre.SRE_Pattern.scan_spans
+
+    string: object
+    pos: Py_ssize_t = 0
+    endpos: Py_ssize_t(c_default="PY_SSIZE_T_MAX") = sys.maxsize
+
+Return the spans of all non-overlapping matches of pattern in string.
+
+The result is a read-only memoryview of format 'n', which holds for each
+match the start and end of the match, then of each group (-1 and -1 for
+a group that did not participate in the match).
+[clinic start generated code]*/
+
+static PyObject *
+_sre_SRE_Pattern_scan_spans_impl(PatternObject *self, PyObject *string,
+                                 Py_ssize_t pos, Py_ssize_t endpos)
+/*[clinic end generated code: output=034c538f800feccb input=7ac4e04d1b13f24b]*/
+{
+    SRE_STATE state;
+    PyObject* bytes;
+    PyObject* view;
+    PyObject* result;
+    Py_ssize_t status;
+    Py_ssize_t i, j, n, count, capacity;
+    Py_ssize_t width = 2 * (self->groups + 1);
+    Py_ssize_t* spans;
+
+    if (!state_init(&state, self, string, pos, endpos))
+        return NULL;
+
+    /* the spans are written directly into the buffer of the result */
+    count = 0;
+    capacity = 16 * width;
+    bytes = PyBytes_FromStringAndSize(NULL, capacity * sizeof(Py_ssize_t));
+    if (!bytes) {
+        state_fini(&state);
+        return NULL;
+    }
+
+    while (state.start <= state.end) {
+
+        state_reset(&state);
+
+        state.ptr = state.start;
+
+        status = sre_search(&state, PatternObject_GetCode(self));
+        if (PyErr_Occurred())
+            goto error;
+
+        if (status <= 0) {
+            if (status == 0)
+                break;
+            pattern_error(status);
+            goto error;
+        }
+
+        if (count + width > capacity) {
+            if (capacity > PY_SSIZE_T_MAX / 2 / (Py_ssize_t)sizeof(Py_ssize_t)) {
+                PyErr_NoMemory();
+                goto error;
+            }
+            capacity *= 2;
+            if (_PyBytes_Resize(&bytes, capacity * sizeof(Py_ssize_t)) < 0) {
+                state_fini(&state);
+                return NULL;
+            }
+        }
+        spans = (Py_ssize_t *)PyBytes_AS_STRING(bytes) + count;
+        spans[0] = STATE_OFFSET(&state, state.start);
+        spans[1] = STATE_OFFSET(&state, state.ptr);
+        for (i = j = 0; i < self->groups; i++, j += 2) {
+            if (j+1 <= state.lastmark && state.mark[j] && state.mark[j+1]) {
+                spans[j+2] = STATE_OFFSET(&state, state.mark[j]);
+                spans[j+3] = STATE_OFFSET(&state, state.mark[j+1]);
+            }
+            else {
+                spans[j+2] = spans[j+3] = -1;
+            }
+        }
+        count += width;
+
+        state.must_advance = (state.ptr == state.start);
+        state.start = state.ptr;
+    }
+
+    state_fini(&state);
+
+    n = count * sizeof(Py_ssize_t);
+    if (n != PyBytes_GET_SIZE(bytes) && _PyBytes_Resize(&bytes, n) < 0)
+        return NULL;
+    view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!view)
+        return NULL;
+    result = PyObject_CallMethod(view, "cast", "s", "n");
+    Py_DECREF(view);
+    return result;
+
+error:
+    Py_DECREF(bytes);
+    state_fini(&state);
+    return NULL;
+
+}
+
 /*[clinic input]
 _sre.SRE_Pattern.finditer
 
@@ -1487,6 +1614,20 @@ _sre_SRE_Pattern___deepcopy___impl(PatternObject *self, PyObject *memo)
     return Py_NewRef(self);
 }
 
+/*[clinic input]
+_sre.SRE_Pattern.__sizeof__
+
+[clinic start generated code]*/
+
+static PyObject *
+_sre_SRE_Pattern___sizeof___impl(PatternObject *self)
+/*[clinic end generated code: output=4776389700db11f8 input=0f0c2ad8ad24c271]*/
+{
+    size_t res = _PyObject_VAR_SIZE(Py_TYPE(self), Py_SIZE(self));
+    res += sre_dfa_sizeof(self->dfa);
+    return PyLong_FromSize_t(res);
+}
+
 #ifdef Py_DEBUG
 /*[clinic input]
 _sre.SRE_Pattern._fail_after
@@ -1638,6 +1779,7 @@ _sre_compile_impl(PyObject *module, PyObject *pattern, int flags,
     self->pattern = NULL;
     self->groupindex = NULL;
     self->indexgroup = NULL;
+    self->dfa = NULL;
 #ifdef Py_DEBUG
     self->fail_after_count = -1;
     self->fail_after_exc = NULL;
@@ -1700,6 +1842,8 @@ _sre_compile_impl(PyObject *module, PyObject *pattern, int flags,
         return NULL;
     }
 
+    self->dfa = sre_dfa_new(self);
+
     return (PyObject*) self;
 }
 
@@ -2008,8 +2152,8 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
             {
                 /* A minimal info field is
                    <INFO> <1=skip> <2=flags> <3=min> <4=max>;
-                   If SRE_INFO_PREFIX or SRE_INFO_CHARSET is in the flags,
-                   more follows. */
+                   If SRE_INFO_REQUIRED, SRE_INFO_PREFIX or
+                   SRE_INFO_CHARSET is in the flags, more follows. */
                 SRE_CODE flags, i;
                 SRE_CODE *newcode;
                 GET_SKIP;
@@ -2020,7 +2164,8 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
                 /* Check that only valid flags are present */
                 if ((flags & ~(SRE_INFO_PREFIX |
                                SRE_INFO_LITERAL |
-                               SRE_INFO_CHARSET)) != 0)
+                               SRE_INFO_CHARSET |
+                               SRE_INFO_REQUIRED)) != 0)
                     FAIL;
                 /* PREFIX and CHARSET are mutually exclusive */
                 if ((flags & SRE_INFO_PREFIX) &&
@@ -2030,6 +2175,23 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
                 if ((flags & SRE_INFO_LITERAL) &&
                     !(flags & SRE_INFO_PREFIX))
                     FAIL;
+                /* PREFIX and REQUIRED are mutually exclusive */
+                if ((flags & SRE_INFO_PREFIX) &&
+                    (flags & SRE_INFO_REQUIRED))
+                    FAIL;
+                /* Validate the required literal */
+                if (flags & SRE_INFO_REQUIRED) {
+                    SRE_CODE required_len, required_lo;
+                    GET_ARG; required_len = arg;
+                    GET_ARG; required_lo = arg;
+                    GET_ARG;
+                    if (required_len == 0 || required_lo > arg)
+                        FAIL;
+                    /* Here comes the literal */
+                    if (required_len > (uintptr_t)(newcode - code))
+                        FAIL;
+                    code += required_len;
+                }
                 /* Validate the prefix */
                 if (flags & SRE_INFO_PREFIX) {
                     SRE_CODE prefix_len;
@@ -3165,11 +3327,13 @@ static PyMethodDef pattern_methods[] = {
     _SRE_SRE_PATTERN_SUB_METHODDEF
     _SRE_SRE_PATTERN_SUBN_METHODDEF
     _SRE_SRE_PATTERN_FINDALL_METHODDEF
+    _SRE_SRE_PATTERN_SCAN_SPANS_METHODDEF
     _SRE_SRE_PATTERN_SPLIT_METHODDEF
     _SRE_SRE_PATTERN_FINDITER_METHODDEF
     _SRE_SRE_PATTERN_SCANNER_METHODDEF
     _SRE_SRE_PATTERN___COPY___METHODDEF
     _SRE_SRE_PATTERN___DEEPCOPY___METHODDEF
+    _SRE_SRE_PATTERN___SIZEOF___METHODDEF
     _SRE_SRE_PATTERN__FAIL_AFTER_METHODDEF
     {"__class_getitem__", Py_GenericAlias, METH_O|METH_CLASS,
      PyDoc_STR("See PEP 585")},
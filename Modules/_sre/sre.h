@@ -24,6 +24,8 @@
 # define SRE_MAXGROUPS ((SRE_CODE)PY_SSIZE_T_MAX / SIZEOF_VOID_P / 2)
 #endif
 
+typedef struct SRE_DFA SRE_DFA; /* see sre_dfa.h */
+
 typedef struct {
     PyObject_VAR_HEAD
     Py_ssize_t groups; /* must be first! */
@@ -39,6 +41,7 @@ typedef struct {
     int fail_after_count;
     PyObject *fail_after_exc;
 #endif
+    SRE_DFA* dfa; /* lazy DFA, or NULL if the pattern can't use one */
     /* pattern code */
     Py_ssize_t codesize;
     SRE_CODE code[1];
@@ -93,6 +96,7 @@ typedef struct {
     int match_all;
     int must_advance;
     int debug;
+    SRE_DFA* dfa; /* the pattern's lazy DFA, or NULL */
     /* marks */
     int lastmark;
     int lastindex;
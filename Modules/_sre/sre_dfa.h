@@ -0,0 +1,935 @@
+/*
+ * Secret Labs' Regular Expression Engine
+ *
+ * lazy DFA for patterns without backtracking constructs
+ *
+ * See the sre.c file for information on usage and redistribution.
+ */
+
+/* A pattern made only of characters, sets, alternatives, repeats and
+   groups matches the same strings as a finite automaton.  For such a
+   pattern, _sre.compile() builds two NFAs from the pattern code: one for
+   the pattern and one for the pattern read backwards.  Their DFA states
+   are created on demand while searching and cached, up to a memory limit.
+
+   A search runs the forward DFA from the start position to find where
+   the match starting at the leftmost possible position ends, then the
+   reverse DFA from there back to where that match starts.  The matcher
+   then runs once, at that position, to find the groups and the end
+   preferred by greedy and lazy repeats.  So finding whether and where a
+   match starts takes linear time, and a search fails without running
+   the matcher at all when nothing matches.
+
+   To know which start position a match comes from, a forward DFA state
+   is an ordered list of sets of NFA states, one set per start position
+   still alive, the leftmost first.  An NFA state appears only in the set
+   of the leftmost position that reaches it, since any match from a later
+   position could also be made from that one.  No new start positions are
+   added once a match is found, and the sets after the first one that
+   contains the final NFA state are dropped.
+
+   The DFA only tells whether there is a match and where, so the cache
+   can be emptied whenever it is full.  If it fills up after too few
+   characters per state, or a character does not fit the table of
+   character classes, the search falls back to the matcher alone.  The
+   caches of all patterns also share a process-wide budget, since the re
+   module keeps hundreds of compiled patterns alive: a search that needs
+   a bigger cache while the budget is spent falls back too. */
+
+#define SRE_DFA_MAX_NFA 2000 /* NFA states, per direction */
+#define SRE_DFA_MAX_PREDICATES 64 /* distinct character tests */
+#define SRE_DFA_MAX_CLASSES 256
+#define SRE_DFA_SPARE_CLASSES 32 /* room for classes of non-Latin-1 chars */
+#define SRE_DFA_CACHE_SIZE 256 /* non-Latin-1 character class cache */
+#define SRE_DFA_MAX_DEPTH 200 /* nesting of groups in the pattern */
+#define SRE_DFA_MAX_MEMORY (64 * 1024) /* cached states, per direction */
+#define SRE_DFA_TOTAL_MEMORY (8 * 1024 * 1024) /* cached states, all patterns */
+#define SRE_DFA_MIN_PROGRESS 10 /* characters scanned per new state */
+#define SRE_DFA_MAX_FAILURES 8
+
+/* NFA node kinds, in place of a predicate index */
+#define SRE_NFA_SPLIT -1
+#define SRE_NFA_MATCH -2
+
+/* DFA state flags, in the first entry of the transition table row */
+#define SRE_DFA_MATCH 1
+#define SRE_DFA_DEAD 2
+
+/* result of a DFA scan that can't tell */
+#define SRE_DFA_FALLBACK -1
+
+typedef struct {
+    int32_t pred; /* character test, or SRE_NFA_SPLIT or SRE_NFA_MATCH */
+    int32_t out1, out2; /* next states (out2 only for SRE_NFA_SPLIT) */
+} SRE_NFA_NODE;
+
+typedef struct {
+    SRE_NFA_NODE* nodes;
+    int32_t nnodes;
+    int32_t start;
+    int32_t match;
+    /* cached DFA states; the transitions of state i are at trans[off]
+       with off = i * rowsize: the state flags, then the offset of the
+       next state for each character class, or -1 if not computed yet */
+    int32_t* trans;
+    int32_t nstates, maxstates;
+    int32_t* kernel_start; /* NFA states of state i, in kernels */
+    int32_t* kernels;
+    Py_ssize_t kernels_len, kernels_cap;
+    int32_t* table; /* hash table of states (index + 1, or 0) */
+    size_t table_size;
+    int32_t start_off[2]; /* unanchored and anchored start, or -1 */
+    size_t memory;
+    unsigned int resets;
+    /* progress of the current scan since the cache was last reset */
+    Py_ssize_t reset_pos;
+    int32_t new_states;
+} SRE_AUTOMATON;
+
+struct SRE_DFA {
+    PyMutex mutex;
+    int disabled;
+    int failures;
+    int isbytes;
+    /* character tests: opcodes in the pattern code */
+    int npreds;
+    const SRE_CODE* preds[SRE_DFA_MAX_PREDICATES];
+    /* character classes: the sets of tests a character passes */
+    int nclasses, maxclasses, rowsize;
+    uint64_t signature[SRE_DFA_MAX_CLASSES];
+    unsigned char lowclass[256];
+    Py_UCS4 cache_char[SRE_DFA_CACHE_SIZE];
+    unsigned char cache_class[SRE_DFA_CACHE_SIZE];
+    SRE_AUTOMATON forward, reverse;
+    /* scratch space for computing states */
+    int32_t* work;
+    int32_t* stack;
+    uint32_t* visited;
+    uint32_t generation;
+};
+
+/* memory used by the cached states of all patterns */
+static Py_ssize_t sre_dfa_total_memory = 0;
+
+LOCAL(int) sre_ucs4_charset(SRE_STATE* state, const SRE_CODE* set,
+                            SRE_CODE ch);
+
+/* -------------------------------------------------------------------- */
+/* character tests */
+
+/* Return the length of a single character opcode, or 0. */
+static Py_ssize_t
+sre_dfa_char_op_len(const SRE_CODE* code)
+{
+    switch (code[0]) {
+    case SRE_OP_LITERAL:
+    case SRE_OP_NOT_LITERAL:
+    case SRE_OP_LITERAL_IGNORE:
+    case SRE_OP_NOT_LITERAL_IGNORE:
+    case SRE_OP_LITERAL_UNI_IGNORE:
+    case SRE_OP_NOT_LITERAL_UNI_IGNORE:
+    case SRE_OP_CATEGORY:
+        return 2;
+    case SRE_OP_ANY:
+    case SRE_OP_ANY_ALL:
+        return 1;
+    case SRE_OP_IN:
+    case SRE_OP_IN_IGNORE:
+    case SRE_OP_IN_UNI_IGNORE:
+        return 1 + code[1];
+    }
+    return 0;
+}
+
+/* Test a character like SRE(match) does. */
+static int
+sre_dfa_test(const SRE_CODE* code, SRE_CODE ch)
+{
+    switch (code[0]) {
+    case SRE_OP_LITERAL:
+        return ch == code[1];
+    case SRE_OP_NOT_LITERAL:
+        return ch != code[1];
+    case SRE_OP_LITERAL_IGNORE:
+        return (SRE_CODE) sre_lower_ascii(ch) == code[1];
+    case SRE_OP_NOT_LITERAL_IGNORE:
+        return (SRE_CODE) sre_lower_ascii(ch) != code[1];
+    case SRE_OP_LITERAL_UNI_IGNORE:
+        return (SRE_CODE) sre_lower_unicode(ch) == code[1];
+    case SRE_OP_NOT_LITERAL_UNI_IGNORE:
+        return (SRE_CODE) sre_lower_unicode(ch) != code[1];
+    case SRE_OP_CATEGORY:
+        return sre_category(code[1], ch);
+    case SRE_OP_ANY:
+        return !SRE_IS_LINEBREAK(ch);
+    case SRE_OP_ANY_ALL:
+        return 1;
+    case SRE_OP_IN:
+        return sre_ucs4_charset(NULL, code + 2, ch);
+    case SRE_OP_IN_IGNORE:
+        return sre_ucs4_charset(NULL, code + 2, sre_lower_ascii(ch));
+    case SRE_OP_IN_UNI_IGNORE:
+        return sre_ucs4_charset(NULL, code + 2, sre_lower_unicode(ch));
+    }
+    return 0;
+}
+
+static uint64_t
+sre_dfa_signature(const SRE_DFA* dfa, SRE_CODE ch)
+{
+    uint64_t sig = 0;
+    for (int i = 0; i < dfa->npreds; i++) {
+        if (sre_dfa_test(dfa->preds[i], ch)) {
+            sig |= (uint64_t)1 << i;
+        }
+    }
+    return sig;
+}
+
+/* Return the class of a character of at least 256, or -1 if there is
+   no room for a new class. */
+static int
+sre_dfa_wide_class(SRE_DFA* dfa, Py_UCS4 ch)
+{
+    size_t h = ch & (SRE_DFA_CACHE_SIZE - 1);
+    uint64_t sig;
+    int cls;
+
+    if (dfa->cache_char[h] == ch) {
+        return dfa->cache_class[h];
+    }
+    sig = sre_dfa_signature(dfa, ch);
+    for (cls = 0; cls < dfa->nclasses; cls++) {
+        if (dfa->signature[cls] == sig) {
+            break;
+        }
+    }
+    if (cls == dfa->nclasses) {
+        if (cls == dfa->maxclasses) {
+            return -1;
+        }
+        dfa->signature[dfa->nclasses++] = sig;
+    }
+    dfa->cache_char[h] = ch;
+    dfa->cache_class[h] = (unsigned char) cls;
+    return cls;
+}
+
+/* -------------------------------------------------------------------- */
+/* NFA construction */
+
+typedef struct {
+    SRE_DFA* dfa;
+    SRE_AUTOMATON* a;
+    int reverse;
+    int depth;
+} SRE_NFA_BUILDER;
+
+static int32_t
+sre_nfa_add(SRE_NFA_BUILDER* b, int32_t pred, int32_t out1, int32_t out2)
+{
+    SRE_AUTOMATON* a = b->a;
+    if (a->nnodes >= SRE_DFA_MAX_NFA) {
+        return -1;
+    }
+    a->nodes[a->nnodes].pred = pred;
+    a->nodes[a->nnodes].out1 = out1;
+    a->nodes[a->nnodes].out2 = out2;
+    return a->nnodes++;
+}
+
+static int32_t
+sre_nfa_predicate(SRE_NFA_BUILDER* b, const SRE_CODE* code)
+{
+    SRE_DFA* dfa = b->dfa;
+    Py_ssize_t len = sre_dfa_char_op_len(code);
+    int i;
+
+    for (i = 0; i < dfa->npreds; i++) {
+        if (sre_dfa_char_op_len(dfa->preds[i]) == len &&
+            memcmp(dfa->preds[i], code, len * sizeof(SRE_CODE)) == 0)
+        {
+            return i;
+        }
+    }
+    if (dfa->npreds == SRE_DFA_MAX_PREDICATES) {
+        return -1;
+    }
+    dfa->preds[dfa->npreds] = code;
+    return dfa->npreds++;
+}
+
+/* Return the length of an item of a sequence, or 0 if the DFA can't
+   match it. */
+static Py_ssize_t
+sre_nfa_item_len(const SRE_CODE* code)
+{
+    Py_ssize_t len = sre_dfa_char_op_len(code);
+    if (len) {
+        return len;
+    }
+    switch (code[0]) {
+    case SRE_OP_MARK:
+        return 2;
+    case SRE_OP_BRANCH:
+    {
+        /* <BRANCH> <skip> code <JUMP> ... <FAILURE> */
+        const SRE_CODE* p = code + 1;
+        while (*p) {
+            p += *p;
+        }
+        return p + 1 - code;
+    }
+    case SRE_OP_REPEAT_ONE:
+    case SRE_OP_MIN_REPEAT_ONE:
+        /* <REPEAT_ONE> <skip> <min> <max> item <SUCCESS> */
+        return 1 + code[1];
+    case SRE_OP_REPEAT:
+        /* <REPEAT> <skip> <min> <max> item <MAX_UNTIL or MIN_UNTIL> */
+        return 2 + code[1];
+    }
+    return 0;
+}
+
+static int32_t sre_nfa_sequence(SRE_NFA_BUILDER* b, const SRE_CODE* code,
+                                const SRE_CODE* end, int32_t next);
+
+/* Build the NFA of body{min,max} followed by next. */
+static int32_t
+sre_nfa_repeat(SRE_NFA_BUILDER* b, const SRE_CODE* body,
+               const SRE_CODE* end, SRE_CODE min, SRE_CODE max,
+               int32_t next)
+{
+    int32_t entry, s;
+    SRE_CODE i;
+
+    if (max == SRE_MAXREPEAT) {
+        /* a loop back to a split */
+        s = sre_nfa_add(b, SRE_NFA_SPLIT, -1, next);
+        if (s < 0) {
+            return -1;
+        }
+        entry = sre_nfa_sequence(b, body, end, s);
+        if (entry < 0) {
+            return -1;
+        }
+        b->a->nodes[s].out1 = entry;
+        entry = s;
+    }
+    else {
+        /* a chain of optional copies */
+        entry = next;
+        for (i = min; i < max; i++) {
+            int32_t body_entry = sre_nfa_sequence(b, body, end, entry);
+            if (body_entry < 0) {
+                return -1;
+            }
+            entry = sre_nfa_add(b, SRE_NFA_SPLIT, body_entry, next);
+            if (entry < 0) {
+                return -1;
+            }
+        }
+    }
+    for (i = 0; i < min; i++) {
+        entry = sre_nfa_sequence(b, body, end, entry);
+        if (entry < 0) {
+            return -1;
+        }
+    }
+    return entry;
+}
+
+/* Build the NFA of an item followed by next. */
+static int32_t
+sre_nfa_item(SRE_NFA_BUILDER* b, const SRE_CODE* code, int32_t next)
+{
+    int32_t entry, pred;
+
+    if (sre_dfa_char_op_len(code)) {
+        pred = sre_nfa_predicate(b, code);
+        if (pred < 0) {
+            return -1;
+        }
+        return sre_nfa_add(b, pred, next, -1);
+    }
+    switch (code[0]) {
+    case SRE_OP_MARK:
+        return next;
+
+    case SRE_OP_BRANCH:
+    {
+        /* splits between the alternatives; their order doesn't matter
+           to the DFA */
+        const SRE_CODE* p = code + 1;
+        entry = -1;
+        for (; *p; p += *p) {
+            int32_t alt = sre_nfa_sequence(b, p + 1, p + *p - 2, next);
+            if (alt < 0) {
+                return -1;
+            }
+            entry = entry < 0 ? alt : sre_nfa_add(b, SRE_NFA_SPLIT,
+                                                   entry, alt);
+            if (entry < 0) {
+                return -1;
+            }
+        }
+        return entry;
+    }
+
+    case SRE_OP_REPEAT_ONE:
+    case SRE_OP_MIN_REPEAT_ONE:
+        return sre_nfa_repeat(b, code + 4, code + code[1], code[2], code[3],
+                              next);
+
+    case SRE_OP_REPEAT:
+        return sre_nfa_repeat(b, code + 4, code + 1 + code[1], code[2],
+                              code[3], next);
+    }
+    return -1;
+}
+
+/* Build the NFA of the sequence of items in [code, end) followed by
+   next, or of the reversed sequence for the reverse NFA. */
+static int32_t
+sre_nfa_sequence(SRE_NFA_BUILDER* b, const SRE_CODE* code,
+                 const SRE_CODE* end, int32_t next)
+{
+    const SRE_CODE** items;
+    const SRE_CODE* p;
+    Py_ssize_t n = 0, i;
+
+    if (++b->depth > SRE_DFA_MAX_DEPTH) {
+        return -1;
+    }
+    for (p = code; p < end; p += sre_nfa_item_len(p)) {
+        if (!sre_nfa_item_len(p)) {
+            return -1;
+        }
+        n++;
+    }
+    if (p != end) {
+        return -1;
+    }
+    if (b->reverse) {
+        for (p = code; p < end && next >= 0; p += sre_nfa_item_len(p)) {
+            next = sre_nfa_item(b, p, next);
+        }
+    }
+    else if (n) {
+        items = PyMem_New(const SRE_CODE*, n);
+        if (items == NULL) {
+            return -1;
+        }
+        for (i = 0, p = code; p < end; p += sre_nfa_item_len(p)) {
+            items[i++] = p;
+        }
+        while (n > 0 && next >= 0) {
+            next = sre_nfa_item(b, items[--n], next);
+        }
+        PyMem_Free(items);
+    }
+    b->depth--;
+    return next;
+}
+
+/* -------------------------------------------------------------------- */
+/* DFA states */
+
+/* Add the NFA states reachable from node without reading a character to
+   the work list at n, skipping those already in it.  Return the new
+   length of the work list. */
+static Py_ssize_t
+sre_dfa_closure(SRE_DFA* dfa, const SRE_AUTOMATON* a, int32_t node,
+                Py_ssize_t n)
+{
+    int32_t* stack = dfa->stack;
+    Py_ssize_t top = 0;
+
+    stack[top++] = node;
+    while (top) {
+        node = stack[--top];
+        if (dfa->visited[node] == dfa->generation) {
+            continue;
+        }
+        dfa->visited[node] = dfa->generation;
+        if (a->nodes[node].pred == SRE_NFA_SPLIT) {
+            stack[top++] = a->nodes[node].out2;
+            stack[top++] = a->nodes[node].out1;
+        }
+        else {
+            dfa->work[n++] = node;
+        }
+    }
+    return n;
+}
+
+static void
+sre_dfa_new_generation(SRE_DFA* dfa)
+{
+    if (++dfa->generation == 0) {
+        memset(dfa->visited, 0,
+               Py_MAX(dfa->forward.nnodes, dfa->reverse.nnodes) *
+               sizeof(uint32_t));
+        dfa->generation = 1;
+    }
+}
+
+static int
+sre_dfa_compare_nodes(const void* x, const void* y)
+{
+    int32_t a = *(const int32_t*) x, b = *(const int32_t*) y;
+    return (a > b) - (a < b);
+}
+
+/* Close the set of NFA states that starts at gstart in the work list.
+   Return the new length of the work list. */
+static Py_ssize_t
+sre_dfa_end_set(SRE_DFA* dfa, Py_ssize_t gstart, Py_ssize_t n)
+{
+    if (n == gstart) {
+        return n;
+    }
+    qsort(dfa->work + gstart, n - gstart, sizeof(int32_t),
+          sre_dfa_compare_nodes);
+    dfa->work[n++] = -1;
+    return n;
+}
+
+static void
+sre_dfa_reset(SRE_AUTOMATON* a)
+{
+    a->resets++;
+    a->new_states = 0;
+    a->nstates = 0;
+    a->kernels_len = 0;
+    a->start_off[0] = a->start_off[1] = -1;
+    if (a->table) {
+        memset(a->table, 0, a->table_size * sizeof(int32_t));
+    }
+}
+
+/* Take size bytes from the shared budget.  Return 0 if it is spent. */
+static int
+sre_dfa_charge(size_t size)
+{
+    Py_ssize_t total = _Py_atomic_add_ssize(&sre_dfa_total_memory,
+                                            (Py_ssize_t) size);
+    if (total + (Py_ssize_t) size > SRE_DFA_TOTAL_MEMORY) {
+        _Py_atomic_add_ssize(&sre_dfa_total_memory, -(Py_ssize_t) size);
+        return 0;
+    }
+    return 1;
+}
+
+static void
+sre_dfa_refund(size_t size)
+{
+    _Py_atomic_add_ssize(&sre_dfa_total_memory, -(Py_ssize_t) size);
+}
+
+static void
+sre_dfa_free_states(SRE_AUTOMATON* a)
+{
+    sre_dfa_refund(a->memory);
+    PyMem_Free(a->trans);
+    PyMem_Free(a->kernel_start);
+    PyMem_Free(a->kernels);
+    PyMem_Free(a->table);
+    a->trans = a->kernel_start = a->kernels = a->table = NULL;
+    a->nstates = a->maxstates = 0;
+    a->kernels_len = a->kernels_cap = 0;
+    a->table_size = 0;
+    a->memory = 0;
+    a->start_off[0] = a->start_off[1] = -1;
+}
+
+static size_t
+sre_dfa_hash(const int32_t* kernel, Py_ssize_t len)
+{
+    size_t h = 0;
+    for (Py_ssize_t i = 0; i < len; i++) {
+        h = (h ^ (uint32_t) kernel[i]) * 1000003;
+    }
+    return h ^ (h >> 17);
+}
+
+/* Make room for one more state with a kernel of len entries.  Return 0
+   if that goes over the memory limit, -1 if memory or the shared budget
+   is exhausted. */
+static int
+sre_dfa_reserve(SRE_DFA* dfa, SRE_AUTOMATON* a, Py_ssize_t len)
+{
+    if (a->nstates == a->maxstates) {
+        int32_t n = a->maxstates ? a->maxstates * 2 : 16;
+        size_t table_size = (size_t) n * 2;
+        size_t memory = (size_t) n * (dfa->rowsize + 1) * sizeof(int32_t)
+                        + table_size * sizeof(int32_t)
+                        + a->kernels_cap * sizeof(int32_t);
+        int32_t *trans, *kernel_start, *table;
+        if (memory > SRE_DFA_MAX_MEMORY) {
+            return 0;
+        }
+        if (!sre_dfa_charge(memory - a->memory)) {
+            return -1;
+        }
+        trans = PyMem_Realloc(a->trans,
+                              (size_t) n * dfa->rowsize * sizeof(int32_t));
+        if (trans == NULL) {
+            sre_dfa_refund(memory - a->memory);
+            return -1;
+        }
+        a->trans = trans;
+        kernel_start = PyMem_Realloc(a->kernel_start,
+                                     ((size_t) n + 1) * sizeof(int32_t));
+        if (kernel_start == NULL) {
+            sre_dfa_refund(memory - a->memory);
+            return -1;
+        }
+        a->kernel_start = kernel_start;
+        table = PyMem_Calloc(table_size, sizeof(int32_t));
+        if (table == NULL) {
+            sre_dfa_refund(memory - a->memory);
+            return -1;
+        }
+        /* rehash the existing states */
+        for (int32_t i = 0; i < a->nstates; i++) {
+            const int32_t* kernel = a->kernels + a->kernel_start[i];
+            size_t h = sre_dfa_hash(kernel, a->kernel_start[i + 1] -
+                                            a->kernel_start[i]);
+            while (table[h & (table_size - 1)]) {
+                h++;
+            }
+            table[h & (table_size - 1)] = i + 1;
+        }
+        PyMem_Free(a->table);
+        a->table = table;
+        a->table_size = table_size;
+        a->maxstates = n;
+        a->memory = memory;
+    }
+    if (a->kernels_len + len > a->kernels_cap) {
+        Py_ssize_t cap = Py_MAX(a->kernels_cap * 2, a->kernels_len + len);
+        size_t memory = a->memory + (cap - a->kernels_cap) * sizeof(int32_t);
+        int32_t* kernels;
+        if (memory > SRE_DFA_MAX_MEMORY) {
+            return 0;
+        }
+        if (!sre_dfa_charge(memory - a->memory)) {
+            return -1;
+        }
+        kernels = PyMem_Realloc(a->kernels, cap * sizeof(int32_t));
+        if (kernels == NULL) {
+            sre_dfa_refund(memory - a->memory);
+            return -1;
+        }
+        a->kernels = kernels;
+        a->kernels_cap = cap;
+        a->memory = memory;
+    }
+    return 1;
+}
+
+/* Return the offset of the state whose kernel is the work list, adding
+   it if it is new, or -1 if it can't be added.  progress is the number
+   of characters scanned so far. */
+static int32_t
+sre_dfa_state(SRE_DFA* dfa, SRE_AUTOMATON* a, Py_ssize_t len, int flags,
+              Py_ssize_t progress)
+{
+    const int32_t* kernel = dfa->work;
+    size_t h = sre_dfa_hash(kernel, len);
+    int32_t i, *row;
+    int r;
+
+    if (a->table_size) {
+        size_t mask = a->table_size - 1;
+        for (;; h++) {
+            i = a->table[h & mask] - 1;
+            if (i < 0) {
+                break;
+            }
+            if (a->kernel_start[i + 1] - a->kernel_start[i] == len &&
+                memcmp(a->kernels + a->kernel_start[i], kernel,
+                       len * sizeof(int32_t)) == 0)
+            {
+                return i * dfa->rowsize;
+            }
+        }
+    }
+
+    r = sre_dfa_reserve(dfa, a, len);
+    if (r == 0) {
+        /* The cache is full.  Start over with an empty one, unless few
+           characters were scanned per state added since the last time:
+           then the matcher alone is likely faster. */
+        if (progress - a->reset_pos <
+            (Py_ssize_t) SRE_DFA_MIN_PROGRESS * a->new_states)
+        {
+            if (++dfa->failures == SRE_DFA_MAX_FAILURES) {
+                dfa->disabled = 1;
+            }
+            return -1;
+        }
+        sre_dfa_reset(a);
+        a->reset_pos = progress;
+        r = sre_dfa_reserve(dfa, a, len);
+    }
+    if (r <= 0) {
+        return -1;
+    }
+
+    i = a->nstates++;
+    a->new_states++;
+    a->kernel_start[i] = (int32_t) a->kernels_len;
+    memcpy(a->kernels + a->kernels_len, kernel, len * sizeof(int32_t));
+    a->kernels_len += len;
+    a->kernel_start[i + 1] = (int32_t) a->kernels_len;
+    row = a->trans + (size_t) i * dfa->rowsize;
+    row[0] = flags;
+    for (int k = 1; k < dfa->rowsize; k++) {
+        row[k] = -1;
+    }
+    h = sre_dfa_hash(kernel, len);
+    while (a->table[h & (a->table_size - 1)]) {
+        h++;
+    }
+    a->table[h & (a->table_size - 1)] = i + 1;
+    return i * dfa->rowsize;
+}
+
+/* Compute the flags of the kernel in the work list, dropping the sets
+   after the first one with a match, and return its state offset. */
+static int32_t
+sre_dfa_finish(SRE_DFA* dfa, SRE_AUTOMATON* a, Py_ssize_t n,
+               Py_ssize_t progress)
+{
+    int32_t* work = dfa->work;
+    Py_ssize_t i;
+    int flags = 0;
+
+    for (i = 1; i < n; i++) {
+        if (work[i] == a->match) {
+            /* drop the later start positions */
+            while (work[i] >= 0) {
+                i++;
+            }
+            n = i + 1;
+            work[0] = 1;
+            flags = SRE_DFA_MATCH;
+            break;
+        }
+    }
+    if (work[0] && n == 1) {
+        flags |= SRE_DFA_DEAD;
+    }
+    return sre_dfa_state(dfa, a, n, flags, progress);
+}
+
+/* Compute the classes of the Latin-1 characters, with room for more if
+   the pattern can search wider strings.  This is done on the first
+   search, not to slow down compiling patterns that are never used. */
+static void
+sre_dfa_prepare(SRE_DFA* dfa)
+{
+    int i, c;
+
+    for (c = 0; c < 256; c++) {
+        uint64_t sig = sre_dfa_signature(dfa, c);
+        for (i = 0; i < dfa->nclasses; i++) {
+            if (dfa->signature[i] == sig) {
+                break;
+            }
+        }
+        if (i == dfa->nclasses) {
+            dfa->signature[dfa->nclasses++] = sig;
+        }
+        dfa->lowclass[c] = (unsigned char) i;
+    }
+    dfa->maxclasses = dfa->nclasses;
+    if (!dfa->isbytes) {
+        dfa->maxclasses = Py_MIN(dfa->nclasses + SRE_DFA_SPARE_CLASSES,
+                                 SRE_DFA_MAX_CLASSES);
+    }
+    dfa->rowsize = 1 + dfa->maxclasses;
+}
+
+/* Start a scan.  Return the offset of the start state, or -1. */
+static int32_t
+sre_dfa_start(SRE_DFA* dfa, SRE_AUTOMATON* a, int anchored)
+{
+    Py_ssize_t n;
+    int32_t off;
+
+    if (dfa->rowsize == 0) {
+        sre_dfa_prepare(dfa);
+    }
+    a->reset_pos = 0;
+    a->new_states = 0;
+    if (a->start_off[anchored] >= 0) {
+        return a->start_off[anchored];
+    }
+    sre_dfa_new_generation(dfa);
+    dfa->work[0] = anchored;
+    n = sre_dfa_closure(dfa, a, a->start, 1);
+    n = sre_dfa_end_set(dfa, 1, n);
+    off = sre_dfa_finish(dfa, a, n, 0);
+    a->start_off[anchored] = off;
+    return off;
+}
+
+/* Compute the transition from the state at offset off on a character of
+   class cls, after scanning progress characters.  Return the offset of
+   the next state, or -1. */
+static int32_t
+sre_dfa_step(SRE_DFA* dfa, SRE_AUTOMATON* a, int32_t off, int cls,
+             Py_ssize_t progress)
+{
+    int32_t state = off / dfa->rowsize;
+    uint64_t sig = dfa->signature[cls];
+    const int32_t* k = a->kernels + a->kernel_start[state];
+    const int32_t* kend = a->kernels + a->kernel_start[state + 1];
+    int stopped = k[0];
+    Py_ssize_t n = 1, gstart;
+    int32_t next;
+    unsigned int resets = a->resets;
+
+    sre_dfa_new_generation(dfa);
+    dfa->work[0] = stopped;
+    for (k++; k < kend; k++) {
+        gstart = n;
+        for (; *k >= 0; k++) {
+            const SRE_NFA_NODE* node = &a->nodes[*k];
+            if (node->pred >= 0 && ((sig >> node->pred) & 1)) {
+                n = sre_dfa_closure(dfa, a, node->out1, n);
+            }
+        }
+        n = sre_dfa_end_set(dfa, gstart, n);
+    }
+    if (!stopped) {
+        /* a match can also start after this character */
+        gstart = n;
+        n = sre_dfa_closure(dfa, a, a->start, n);
+        n = sre_dfa_end_set(dfa, gstart, n);
+    }
+    next = sre_dfa_finish(dfa, a, n, progress);
+    if (next >= 0 && a->resets == resets) {
+        a->trans[off + 1 + cls] = next;
+    }
+    return next;
+}
+
+/* -------------------------------------------------------------------- */
+/* construction */
+
+static void
+sre_dfa_free(SRE_DFA* dfa)
+{
+    if (dfa == NULL) {
+        return;
+    }
+    sre_dfa_free_states(&dfa->forward);
+    sre_dfa_free_states(&dfa->reverse);
+    PyMem_Free(dfa->forward.nodes);
+    PyMem_Free(dfa->reverse.nodes);
+    PyMem_Free(dfa->work);
+    PyMem_Free(dfa->stack);
+    PyMem_Free(dfa->visited);
+    PyMem_Free(dfa);
+}
+
+/* Return the memory used by the DFA, including its cached states. */
+static size_t
+sre_dfa_sizeof(SRE_DFA* dfa)
+{
+    size_t res, nnodes;
+
+    if (dfa == NULL) {
+        return 0;
+    }
+    nnodes = Py_MAX(dfa->forward.nnodes, dfa->reverse.nnodes);
+    res = sizeof(SRE_DFA);
+    res += (dfa->forward.nnodes + dfa->reverse.nnodes) * sizeof(SRE_NFA_NODE);
+    res += (2 * (2 * nnodes + 2)) * sizeof(int32_t) + nnodes * sizeof(uint32_t);
+    PyMutex_Lock(&dfa->mutex);
+    res += dfa->forward.memory + dfa->reverse.memory;
+    PyMutex_Unlock(&dfa->mutex);
+    return res;
+}
+
+static int
+sre_dfa_build_nfa(SRE_DFA* dfa, SRE_AUTOMATON* a, int reverse,
+                  const SRE_CODE* code, const SRE_CODE* end)
+{
+    SRE_NFA_BUILDER b = {dfa, a, reverse, 0};
+    SRE_NFA_NODE* nodes;
+
+    a->nodes = PyMem_New(SRE_NFA_NODE, SRE_DFA_MAX_NFA);
+    if (a->nodes == NULL) {
+        return 0;
+    }
+    a->match = sre_nfa_add(&b, SRE_NFA_MATCH, -1, -1);
+    a->start = sre_nfa_sequence(&b, code, end, a->match);
+    if (a->start < 0) {
+        return 0;
+    }
+    /* give back the unused nodes */
+    nodes = PyMem_Realloc(a->nodes, a->nnodes * sizeof(SRE_NFA_NODE));
+    if (nodes != NULL) {
+        a->nodes = nodes;
+    }
+    a->start_off[0] = a->start_off[1] = -1;
+    return 1;
+}
+
+/* Build the automata for a pattern, or return NULL if the DFA can't run
+   it or wouldn't help. */
+static SRE_DFA*
+sre_dfa_new(PatternObject* pattern)
+{
+    const SRE_CODE* code = pattern->code;
+    const SRE_CODE* end = code + pattern->codesize - 1;
+    SRE_DFA* dfa;
+    Py_ssize_t nnodes;
+
+    if (pattern->flags & SRE_FLAG_LOCALE) {
+        return NULL;
+    }
+    if (pattern->codesize < 2 || *end != SRE_OP_SUCCESS) {
+        return NULL;
+    }
+    if (code[0] == SRE_OP_INFO) {
+        /* A literal prefix is found faster without the DFA, and so is a
+           required literal near the start of the match. */
+        if (code[2] & SRE_INFO_PREFIX) {
+            return NULL;
+        }
+        if ((code[2] & SRE_INFO_REQUIRED) && code[7] != SRE_MAXREPEAT) {
+            return NULL;
+        }
+        code += 1 + code[1];
+    }
+
+    dfa = PyMem_Calloc(1, sizeof(SRE_DFA));
+    if (dfa == NULL) {
+        return NULL;
+    }
+    dfa->isbytes = pattern->isbytes > 0;
+    if (!sre_dfa_build_nfa(dfa, &dfa->forward, 0, code, end) ||
+        !sre_dfa_build_nfa(dfa, &dfa->reverse, 1, code, end))
+    {
+        goto fail;
+    }
+
+    nnodes = Py_MAX(dfa->forward.nnodes, dfa->reverse.nnodes);
+    dfa->work = PyMem_New(int32_t, 2 * nnodes + 2);
+    dfa->stack = PyMem_New(int32_t, 2 * nnodes + 2);
+    dfa->visited = PyMem_Calloc(nnodes, sizeof(uint32_t));
+    if (dfa->work == NULL || dfa->stack == NULL || dfa->visited == NULL) {
+        goto fail;
+    }
+    return dfa;
+
+  fail:
+    sre_dfa_free(dfa);
+    return NULL;
+}
@@ -1688,6 +1688,194 @@ SRE(match)(SRE_STATE* state, const SRE_CODE* pattern, int toplevel)
 #define RESET_CAPTURE_GROUP() \
     do { state->lastmark = state->lastindex = -1; } while (0)
 
+/* Return the first position at or after ptr from which a match can
+   contain the required literal (at an offset between lo and hi from its
+   start), or NULL if there is none.  *found is the last occurrence of
+   the literal found so far, or NULL. */
+LOCAL(SRE_CHAR*)
+SRE(skip_required)(SRE_STATE* state, SRE_CHAR* ptr,
+                   const SRE_CHAR* literal, Py_ssize_t len,
+                   SRE_CODE lo, SRE_CODE hi, SRE_CHAR** found)
+{
+    SRE_CHAR* end = (SRE_CHAR *)state->end;
+
+    if (*found == NULL || *found < ptr || (size_t)(*found - ptr) < lo) {
+        Py_ssize_t i;
+        if ((size_t)(end - ptr) < lo || (end - ptr) - (Py_ssize_t)lo < len)
+            return NULL;
+        i = _PyUnicode_FindKind(SIZEOF_SRE_CHAR, ptr + lo, end - ptr - lo,
+                                literal, len);
+        if (i < 0)
+            return NULL;
+        *found = ptr + lo + i;
+    }
+    if (hi != SRE_MAXREPEAT && (size_t)(*found - ptr) > hi)
+        ptr = *found - hi;
+    return ptr;
+}
+
+LOCAL(int)
+SRE(dfa_class)(SRE_DFA* dfa, SRE_CHAR ch)
+{
+#if SIZEOF_SRE_CHAR == 1
+    return dfa->lowclass[ch];
+#else
+    if (ch < 256)
+        return dfa->lowclass[ch];
+    return sre_dfa_wide_class(dfa, ch);
+#endif
+}
+
+/* Run the forward DFA over [ptr, end), from the start position only if
+   anchored is true.  Set *match to the end of the last match found, or
+   of the first one if first is true, ignoring an empty match at ptr if
+   skip_empty is true.  Return 1 if there is a match, 0 if there is none,
+   or SRE_DFA_FALLBACK if the DFA can't tell. */
+LOCAL(int)
+SRE(dfa_forward)(SRE_DFA* dfa, int anchored, int first, int skip_empty,
+                 const SRE_CHAR* ptr, const SRE_CHAR* end,
+                 const SRE_CHAR** match)
+{
+    SRE_AUTOMATON* a = &dfa->forward;
+    const SRE_CHAR* begin = ptr;
+    const SRE_CHAR* found = NULL;
+    const int32_t* trans;
+    int32_t off;
+
+    off = sre_dfa_start(dfa, a, anchored);
+    if (off < 0)
+        return SRE_DFA_FALLBACK;
+    trans = a->trans;
+    if ((trans[off] & SRE_DFA_MATCH) && !skip_empty) {
+        found = ptr;
+        if (first)
+            goto done;
+    }
+    if (trans[off] & SRE_DFA_DEAD)
+        goto done;
+    while (ptr < end) {
+        int cls = SRE(dfa_class)(dfa, *ptr++);
+        int32_t next;
+        if (cls < 0)
+            return SRE_DFA_FALLBACK;
+        next = trans[off + 1 + cls];
+        if (next < 0) {
+            next = sre_dfa_step(dfa, a, off, cls, ptr - begin);
+            if (next < 0)
+                return SRE_DFA_FALLBACK;
+            trans = a->trans;
+        }
+        off = next;
+        if (trans[off]) {
+            if (trans[off] & SRE_DFA_MATCH) {
+                found = ptr;
+                if (first)
+                    break;
+            }
+            if (trans[off] & SRE_DFA_DEAD)
+                break;
+        }
+    }
+  done:
+    *match = found;
+    return found != NULL;
+}
+
+/* Run the reverse DFA backwards from ptr to begin, and set *match to
+   the leftmost position from which there is a match ending at ptr.
+   Return 1 if there is one, 0 if there is none, or SRE_DFA_FALLBACK. */
+LOCAL(int)
+SRE(dfa_reverse)(SRE_DFA* dfa, const SRE_CHAR* begin, const SRE_CHAR* ptr,
+                 const SRE_CHAR** match)
+{
+    SRE_AUTOMATON* a = &dfa->reverse;
+    const SRE_CHAR* end = ptr;
+    const SRE_CHAR* found = NULL;
+    const int32_t* trans;
+    int32_t off;
+
+    off = sre_dfa_start(dfa, a, 1);
+    if (off < 0)
+        return SRE_DFA_FALLBACK;
+    trans = a->trans;
+    if (trans[off] & SRE_DFA_MATCH)
+        found = ptr;
+    while (ptr > begin && !(trans[off] & SRE_DFA_DEAD)) {
+        int cls = SRE(dfa_class)(dfa, *--ptr);
+        int32_t next;
+        if (cls < 0)
+            return SRE_DFA_FALLBACK;
+        next = trans[off + 1 + cls];
+        if (next < 0) {
+            next = sre_dfa_step(dfa, a, off, cls, end - ptr);
+            if (next < 0)
+                return SRE_DFA_FALLBACK;
+            trans = a->trans;
+        }
+        off = next;
+        if (trans[off] & SRE_DFA_MATCH)
+            found = ptr;
+    }
+    *match = found;
+    return found != NULL;
+}
+
+/* Find where the leftmost match at or after ptr starts.  Return 1 and
+   set *start, return 0 if there is no match, or SRE_DFA_FALLBACK. */
+LOCAL(int)
+SRE(dfa_search)(SRE_STATE* state, const SRE_CHAR* ptr, SRE_CHAR** start)
+{
+    SRE_DFA* dfa = state->dfa;
+    const SRE_CHAR* match_end;
+    const SRE_CHAR* match_start;
+    int status = SRE_DFA_FALLBACK;
+
+    /* The cache can't be shared: if another thread (or a nested search)
+       is using it, do without it. */
+    if (!PyMutex_LockFast(&dfa->mutex))
+        return SRE_DFA_FALLBACK;
+    if (!dfa->disabled) {
+        status = SRE(dfa_forward)(dfa, 0, 0, 0, ptr,
+                                  (const SRE_CHAR *)state->end, &match_end);
+        if (status > 0) {
+            status = SRE(dfa_reverse)(dfa, ptr, match_end, &match_start);
+            assert(status != 0);
+            if (status == 0)
+                status = SRE_DFA_FALLBACK;
+            *start = (SRE_CHAR *)match_start;
+        }
+    }
+    PyMutex_Unlock(&dfa->mutex);
+    return status;
+}
+
+/* Return 0 if the DFA shows that there is no match at state->ptr (or
+   none that ends at the end of the string if state->match_all is set),
+   1 if there may be one. */
+LOCAL(int)
+SRE(dfa_match)(SRE_STATE* state)
+{
+    SRE_DFA* dfa = state->dfa;
+    const SRE_CHAR* ptr = (const SRE_CHAR *)state->ptr;
+    const SRE_CHAR* end = (const SRE_CHAR *)state->end;
+    const SRE_CHAR* match_end = NULL;
+    int status = SRE_DFA_FALLBACK;
+
+    if (!PyMutex_LockFast(&dfa->mutex))
+        return 1;
+    if (!dfa->disabled) {
+        status = SRE(dfa_forward)(dfa, 1, !state->match_all,
+                                  state->must_advance && ptr == state->start,
+                                  ptr, end, &match_end);
+    }
+    PyMutex_Unlock(&dfa->mutex);
+    if (status == 0)
+        return 0;
+    if (status > 0 && state->match_all)
+        return match_end == end;
+    return 1;
+}
+
 LOCAL(Py_ssize_t)
 SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
 {
@@ -1699,6 +1887,11 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
     SRE_CODE* prefix = NULL;
     SRE_CODE* charset = NULL;
     SRE_CODE* overlap = NULL;
+    SRE_CHAR required[SRE_REQUIRED_MAX];
+    Py_ssize_t required_len = 0;
+    SRE_CODE required_lo = 0;
+    SRE_CODE required_hi = 0;
+    SRE_CHAR* required_found = NULL;
     int flags = 0;
     INIT_TRACE(state);
 
@@ -1707,7 +1900,9 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
 
     if (pattern[0] == SRE_OP_INFO) {
         /* optimization info block */
-        /* <INFO> <1=skip> <2=flags> <3=min> <4=max> <5=prefix info>  */
+        /* <INFO> <1=skip> <2=flags> <3=min> <4=max> <5=required literal>
+           <prefix info> */
+        SRE_CODE* info = pattern + 5;
 
         flags = pattern[2];
 
@@ -1724,17 +1919,34 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
                 end = ptr;
         }
 
+        if (flags & SRE_INFO_REQUIRED) {
+            /* every match contains a known literal */
+            /* <length> <min offset> <max offset> <literal data> */
+            Py_ssize_t i;
+            required_len = Py_MIN(info[0], SRE_REQUIRED_MAX);
+            required_lo = info[1];
+            required_hi = info[2];
+            for (i = 0; i < required_len; i++) {
+                required[i] = (SRE_CHAR) info[3 + i];
+#if SIZEOF_SRE_CHAR < 4
+                if ((SRE_CODE) required[i] != info[3 + i])
+                    return 0; /* literal can't match: doesn't fit in char width */
+#endif
+            }
+            info += 3 + info[0];
+        }
+
         if (flags & SRE_INFO_PREFIX) {
             /* pattern starts with a known prefix */
             /* <length> <skip> <prefix data> <overlap data> */
-            prefix_len = pattern[5];
-            prefix_skip = pattern[6];
-            prefix = pattern + 7;
+            prefix_len = info[0];
+            prefix_skip = info[1];
+            prefix = info + 2;
             overlap = prefix + prefix_len - 1;
         } else if (flags & SRE_INFO_CHARSET)
             /* pattern starts with a character from a known set */
             /* <charset> */
-            charset = pattern + 5;
+            charset = info;
 
         pattern += 1 + pattern[1];
     }
@@ -1742,6 +1954,45 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
     TRACE(("prefix = %p %zd %zd\n",
            prefix, prefix_len, prefix_skip));
     TRACE(("charset = %p\n", charset));
+    TRACE(("required = %zd %u %u\n",
+           required_len, required_lo, required_hi));
+
+    if (state->dfa != NULL) {
+        /* the pattern has no backtracking constructs: find the leftmost
+           match with the DFA, then run the matcher only there */
+        SRE_CHAR* start;
+        if (required_len &&
+            SRE(skip_required)(state, ptr, required, required_len,
+                               required_lo, required_hi,
+                               &required_found) == NULL)
+            return 0;
+        if (state->must_advance) {
+            /* the match can't be empty at ptr */
+            state->start = state->ptr = ptr;
+            if (SRE(dfa_match)(state))
+                status = SRE(match)(state, pattern, 1);
+            state->must_advance = 0;
+            if (status != 0)
+                return status;
+            if (ptr >= (SRE_CHAR *)state->end)
+                return 0;
+            ptr++;
+            RESET_CAPTURE_GROUP();
+        }
+        status = SRE(dfa_search)(state, ptr, &start);
+        if (status == 0)
+            return 0;
+        if (status > 0) {
+            TRACE(("|%p|%p|SEARCH DFA\n", pattern, start));
+            state->start = state->ptr = start;
+            status = SRE(match)(state, pattern, 0);
+            assert(status != 0);
+            if (status != 0)
+                return status;
+            RESET_CAPTURE_GROUP();
+        }
+        status = 0;
+    }
 
     if (prefix_len == 1) {
         /* pattern starts with a literal character */
@@ -1831,6 +2082,18 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
                 ptr++;
             if (ptr >= end)
                 return 0;
+            if (required_len) {
+                /* skip to where a match can contain the literal */
+                SRE_CHAR* next = SRE(skip_required)(
+                    state, ptr, required, required_len,
+                    required_lo, required_hi, &required_found);
+                if (next == NULL)
+                    return 0;
+                if (next != ptr) {
+                    ptr = next;
+                    continue;
+                }
+            }
             TRACE(("|%p|%p|SEARCH CHARSET\n", pattern, ptr));
             state->start = ptr;
             state->ptr = ptr;
@@ -1843,6 +2106,19 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
     } else {
         /* general case */
         assert(ptr <= end);
+        if (required_len) {
+            /* skip to where a match can contain the literal */
+            SRE_CHAR* next = SRE(skip_required)(
+                state, ptr, required, required_len,
+                required_lo, required_hi, &required_found);
+            if (next == NULL || next > end)
+                return 0;
+            if (next != ptr) {
+                /* the match cannot be empty at the start position */
+                state->must_advance = 0;
+                ptr = next;
+            }
+        }
         TRACE(("|%p|%p|SEARCH\n", pattern, ptr));
         state->start = state->ptr = ptr;
         status = SRE(match)(state, pattern, 1);
@@ -1856,6 +2132,13 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
         }
         while (status == 0 && ptr < end) {
             ptr++;
+            if (required_len) {
+                ptr = SRE(skip_required)(
+                    state, ptr, required, required_len,
+                    required_lo, required_hi, &required_found);
+                if (ptr == NULL || ptr > end)
+                    return 0;
+            }
             RESET_CAPTURE_GROUP();
             TRACE(("|%p|%p|SEARCH\n", pattern, ptr));
             state->start = state->ptr = ptr;
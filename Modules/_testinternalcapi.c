@@ -2258,6 +2258,27 @@ has_split_table(PyObject *self, PyObject *obj)
     Py_RETURN_FALSE;
 }
 
+// Set the size from which dict tables grow incrementally and return the
+// previous size, as log2 of the number of slots.
+static PyObject *
+set_dict_grow_log_size(PyObject *self, PyObject *arg)
+{
+    int log_size = PyLong_AsInt(arg);
+    if (log_size == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (log_size < DK_GROW_MIN_LOG_SIZE || log_size > UINT8_MAX) {
+        PyErr_Format(PyExc_ValueError,
+                     "log_size must be between %d and %d",
+                     DK_GROW_MIN_LOG_SIZE, UINT8_MAX);
+        return NULL;
+    }
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    int old = interp->dict_state.grow_log_size;
+    interp->dict_state.grow_log_size = (uint8_t)log_size;
+    return PyLong_FromLong(old);
+}
+
 // Circumvents standard version assignment machinery - use with caution and only on
 // short-lived heap types
 static PyObject *
@@ -2428,6 +2449,7 @@ static PyMethodDef module_functions[] = {
     {"reset_rare_event_counters", reset_rare_event_counters, METH_NOARGS},
     {"has_inline_values", has_inline_values, METH_O},
     {"has_split_table", has_split_table, METH_O},
+    {"set_dict_grow_log_size", set_dict_grow_log_size, METH_O},
     {"type_assign_specific_version_unsafe", type_assign_specific_version_unsafe, METH_VARARGS,
      PyDoc_STR("forcefully assign type->tp_version_tag")},
 
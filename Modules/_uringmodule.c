@@ -0,0 +1,1261 @@
+/*
+ * io_uring rings for asyncio.UringEventLoop
+ *
+ * A Ring owns an io_uring instance.  Methods such as recv() or accept()
+ * only fill a submission queue entry; the queued entries are submitted
+ * by the next wait(), in the same io_uring_enter() call that waits for
+ * completions, so an iteration of the event loop costs one system call
+ * however many operations it starts and finishes.
+ *
+ * Every operation is given a token object, which wait() returns with the
+ * result of the operation.  The Ring keeps the token, and the buffer or
+ * bytes object the kernel reads or writes, alive until the operation
+ * completes.  Operations are identified by their slot number, which is
+ * also the user_data of their entries (plus one: user_data 0 is used
+ * for entries whose completion is ignored, such as cancellations).
+ *
+ * A ring of provided buffers is registered when the kernel supports it.
+ * Multishot receives pick one of these buffers for each completion, which
+ * is copied to a bytes object and handed back to the kernel at once.
+ */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_moduleobject.h"  // _PyModule_GetState()
+#include "pycore_time.h"          // _PyTime_FromSecondsObject()
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <poll.h>                 // POLLIN
+#include <signal.h>               // _NSIG
+#include <stddef.h>               // offsetof()
+#include <sys/mman.h>             // mmap()
+#include <sys/socket.h>           // SOCK_NONBLOCK
+#include <sys/syscall.h>          // __NR_io_uring_setup
+#include <unistd.h>               // syscall()
+
+#if !defined(__NR_io_uring_setup) || !defined(IORING_FEAT_EXT_ARG)
+#  error "the _uring module needs io_uring with IORING_FEAT_EXT_ARG"
+#endif
+
+/* Provided buffers for multishot receives. */
+#ifdef IORING_RECV_MULTISHOT
+#  define URING_HAVE_MULTISHOT_RECV 1
+#  define URING_NBUFS 1024        /* must be a power of 2 */
+#  define URING_BUF_SIZE 8192
+#  define URING_BGID 0
+/* Incremental consumption of provided buffers (Linux 6.12), which lets
+   many small receives share a buffer.  Older headers lack the names,
+   and call the flags of struct io_uring_buf_reg "pad". */
+#  ifdef IOU_PBUF_RING_MMAP
+#    define URING_BUF_REG_FLAGS flags
+#  else
+#    define URING_BUF_REG_FLAGS pad
+#  endif
+#  ifndef IOU_PBUF_RING_INC
+#    define IOU_PBUF_RING_INC 2
+#  endif
+#  ifndef IORING_CQE_F_BUF_MORE
+#    define IORING_CQE_F_BUF_MORE (1U << 4)
+#  endif
+#endif
+
+/* Kinds of operations, which tell what to return with the result. */
+#define URING_PLAIN 0           /* the result only */
+#define URING_BYTES 1           /* slot->data, resized to the result */
+#define URING_SELECT 2          /* a copy of the provided buffer */
+
+typedef struct {
+    PyObject *token;            /* NULL if the slot is free */
+    PyObject *data;             /* bytes object being filled, or NULL */
+    Py_buffer view;             /* buffer used by the kernel, if view.obj */
+    int kind;
+    Py_ssize_t next_free;
+} uring_slot;
+
+typedef struct {
+    PyObject_HEAD
+    int fd;                     /* -1 once closed */
+    unsigned features;
+
+    /* Submission queue. */
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_array;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sq_local_tail;     /* entries filled */
+    unsigned sq_submitted;      /* entries passed to the kernel */
+    struct io_uring_sqe *sqes;
+
+    /* Completion queue. */
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *ring_ptr;
+    size_t ring_size;
+    size_t sqes_size;
+
+    uring_slot *slots;
+    Py_ssize_t nslots;
+    Py_ssize_t free_slot;       /* first free slot, or -1 */
+    Py_ssize_t pending;         /* slots in use */
+
+#ifdef URING_HAVE_MULTISHOT_RECV
+    struct io_uring_buf_ring *br;   /* NULL if not registered */
+    char *bufs;
+    uint16_t br_tail;
+    int br_inc;                     /* buffers are consumed incrementally */
+    uint16_t buf_used[URING_NBUFS]; /* bytes consumed of each buffer */
+#endif
+} RingObject;
+
+#define RingObject_CAST(op)  ((RingObject *)(op))
+
+typedef struct {
+    PyTypeObject *RingType;
+} uring_state;
+
+static uring_state *
+get_uring_state(PyObject *module)
+{
+    uring_state *state = _PyModule_GetState(module);
+    assert(state != NULL);
+    return state;
+}
+
+static struct PyModuleDef uringmodule;
+#define get_uring_state_by_type(type) \
+    (get_uring_state(PyType_GetModuleByDef(type, &uringmodule)))
+
+/*[clinic input]
+module _uring
+class _uring.Ring "RingObject *" "get_uring_state_by_type(type)->RingType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=42236a9afbf99420]*/
+
+
+/* --- System calls and rings ---------------------------------------------- */
+
+static int
+uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int
+uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+            unsigned flags, void *arg, size_t argsz)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                        flags, arg, argsz);
+}
+
+static int
+uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static int
+ring_check_open(RingObject *self)
+{
+    if (self->fd < 0) {
+        PyErr_SetString(PyExc_ValueError, "I/O operation on closed ring");
+        return -1;
+    }
+    return 0;
+}
+
+/* Pass the filled entries to the kernel, and wait for min_complete
+   completions if flags contains IORING_ENTER_GETEVENTS.  Return the
+   result of io_uring_enter(), with errno set if it is negative. */
+static int
+ring_enter(RingObject *self, unsigned min_complete, unsigned flags,
+           struct io_uring_getevents_arg *arg)
+{
+    unsigned to_submit = self->sq_local_tail - self->sq_submitted;
+    _Py_atomic_store_uint32_release(self->sq_tail, self->sq_local_tail);
+    int ret;
+    if (flags & IORING_ENTER_GETEVENTS) {
+        Py_BEGIN_ALLOW_THREADS
+        ret = uring_enter(self->fd, to_submit, min_complete, flags,
+                          arg, arg != NULL ? sizeof(*arg) : 0);
+        Py_END_ALLOW_THREADS
+    }
+    else {
+        ret = uring_enter(self->fd, to_submit, 0, flags, NULL, 0);
+    }
+    if (ret > 0) {
+        self->sq_submitted += (unsigned)ret;
+    }
+    return ret;
+}
+
+/* Return a cleared submission queue entry, submitting the queued ones
+   if the queue is full. */
+static struct io_uring_sqe *
+ring_get_sqe(RingObject *self)
+{
+    unsigned head = _Py_atomic_load_uint32_acquire(self->sq_head);
+    if (self->sq_local_tail - head >= self->sq_entries) {
+        if (ring_enter(self, 0, 0, NULL) < 0 && errno != EBUSY &&
+            errno != EAGAIN && errno != EINTR)
+        {
+            PyErr_SetFromErrno(PyExc_OSError);
+            return NULL;
+        }
+        head = _Py_atomic_load_uint32_acquire(self->sq_head);
+        if (self->sq_local_tail - head >= self->sq_entries) {
+            errno = EBUSY;
+            PyErr_SetFromErrno(PyExc_OSError);
+            return NULL;
+        }
+    }
+    unsigned index = self->sq_local_tail & self->sq_mask;
+    struct io_uring_sqe *sqe = &self->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    self->sq_array[index] = index;
+    self->sq_local_tail++;
+    return sqe;
+}
+
+/* Take a free slot for an operation on token.  Return its index, or -1
+   with an exception set. */
+static Py_ssize_t
+ring_alloc_slot(RingObject *self, PyObject *token, int kind)
+{
+    if (self->free_slot < 0) {
+        Py_ssize_t n = self->nslots ? self->nslots * 2 : 64;
+        uring_slot *slots = PyMem_Resize(self->slots, uring_slot, n);
+        if (slots == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (Py_ssize_t i = self->nslots; i < n; i++) {
+            slots[i].token = NULL;
+            slots[i].data = NULL;
+            slots[i].view.obj = NULL;
+            slots[i].next_free = i + 1 < n ? i + 1 : -1;
+        }
+        self->free_slot = self->nslots;
+        self->slots = slots;
+        self->nslots = n;
+    }
+    Py_ssize_t i = self->free_slot;
+    uring_slot *slot = &self->slots[i];
+    self->free_slot = slot->next_free;
+    slot->token = Py_NewRef(token);
+    slot->kind = kind;
+    self->pending++;
+    return i;
+}
+
+static void
+ring_free_slot(RingObject *self, Py_ssize_t i)
+{
+    uring_slot *slot = &self->slots[i];
+    Py_CLEAR(slot->token);
+    Py_CLEAR(slot->data);
+    if (slot->view.obj != NULL) {
+        PyBuffer_Release(&slot->view);
+    }
+    slot->next_free = self->free_slot;
+    self->free_slot = i;
+    self->pending--;
+}
+
+/* Queue an operation on token: return its slot and the entry to fill,
+   whose user_data is set.  Return -1 on error, after releasing view. */
+static Py_ssize_t
+ring_prep(RingObject *self, PyObject *token, int kind, Py_buffer *view,
+          struct io_uring_sqe **psqe)
+{
+    if (ring_check_open(self) < 0) {
+        goto error;
+    }
+    Py_ssize_t i = ring_alloc_slot(self, token, kind);
+    if (i < 0) {
+        goto error;
+    }
+    struct io_uring_sqe *sqe = ring_get_sqe(self);
+    if (sqe == NULL) {
+        ring_free_slot(self, i);
+        goto error;
+    }
+    if (view != NULL) {
+        self->slots[i].view = *view;
+    }
+    sqe->user_data = (uint64_t)i + 1;
+    *psqe = sqe;
+    return i;
+
+error:
+    if (view != NULL) {
+        PyBuffer_Release(view);
+    }
+    return -1;
+}
+
+#ifdef URING_HAVE_MULTISHOT_RECV
+static void
+ring_recycle_buffer(RingObject *self, unsigned bid)
+{
+    struct io_uring_buf *buf = &self->br->bufs[self->br_tail
+                                               & (URING_NBUFS - 1)];
+    buf->addr = (uint64_t)(uintptr_t)(self->bufs + (size_t)bid * URING_BUF_SIZE);
+    buf->len = URING_BUF_SIZE;
+    buf->bid = (uint16_t)bid;
+    self->buf_used[bid] = 0;
+    self->br_tail++;
+    _Py_atomic_store_uint16(&self->br->tail, self->br_tail);
+}
+
+static void
+ring_setup_buffers(RingObject *self)
+{
+    size_t br_size = URING_NBUFS * sizeof(struct io_uring_buf);
+    void *br = mmap(NULL, br_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (br == MAP_FAILED) {
+        return;
+    }
+    void *bufs = mmap(NULL, (size_t)URING_NBUFS * URING_BUF_SIZE,
+                      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+    if (bufs == MAP_FAILED) {
+        munmap(br, br_size);
+        return;
+    }
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)br;
+    reg.ring_entries = URING_NBUFS;
+    reg.bgid = URING_BGID;
+    reg.URING_BUF_REG_FLAGS = IOU_PBUF_RING_INC;
+    self->br_inc = 1;
+    if (uring_register(self->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        reg.URING_BUF_REG_FLAGS = 0;
+        self->br_inc = 0;
+    }
+    if (!self->br_inc
+        && uring_register(self->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+    {
+        /* Provided buffer rings need Linux 5.19. */
+        munmap(bufs, (size_t)URING_NBUFS * URING_BUF_SIZE);
+        munmap(br, br_size);
+        return;
+    }
+    self->br = br;
+    self->bufs = bufs;
+    self->br_tail = 0;
+    for (unsigned bid = 0; bid < URING_NBUFS; bid++) {
+        ring_recycle_buffer(self, bid);
+    }
+}
+#endif
+
+static void
+ring_close(RingObject *self)
+{
+    if (self->fd < 0) {
+        return;
+    }
+    /* The kernel may still use the buffers of pending operations for a
+       while after the ring is closed, so these are leaked. */
+    int leak = self->pending > 0;
+    for (Py_ssize_t i = 0; i < self->nslots; i++) {
+        Py_CLEAR(self->slots[i].token);
+    }
+    if (!leak) {
+        PyMem_Free(self->slots);
+    }
+    self->slots = NULL;
+    self->nslots = 0;
+    self->free_slot = -1;
+    self->pending = 0;
+    close(self->fd);
+    self->fd = -1;
+    munmap(self->sqes, self->sqes_size);
+    munmap(self->ring_ptr, self->ring_size);
+#ifdef URING_HAVE_MULTISHOT_RECV
+    if (self->br != NULL && !leak) {
+        munmap(self->bufs, (size_t)URING_NBUFS * URING_BUF_SIZE);
+        munmap(self->br, URING_NBUFS * sizeof(struct io_uring_buf));
+    }
+    self->br = NULL;
+#endif
+}
+
+
+/* --- Ring ---------------------------------------------------------------- */
+
+/*[clinic input]
+@classmethod
+_uring.Ring.__new__ as ring_new
+
+    entries: unsigned_int(bitwise=False) = 256
+
+Create an io_uring instance with room for entries queued operations.
+
+Raise OSError if the kernel does not support io_uring, or a version of
+it with all the features needed.
+[clinic start generated code]*/
+
+static PyObject *
+ring_new_impl(PyTypeObject *type, unsigned int entries)
+/*[clinic end generated code: output=f848e982461875a8 input=ba916b18b0125b4b]*/
+{
+    if (entries == 0) {
+        PyErr_SetString(PyExc_ValueError, "entries must be positive");
+        return NULL;
+    }
+    RingObject *self = (RingObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->fd = -1;
+    self->free_slot = -1;
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    /* A multishot operation may post many completions before the next
+       wait(), and the kernel ends it when the completion queue overflows:
+       make the queue much larger than the submission queue. */
+    p.flags = IORING_SETUP_CLAMP | IORING_SETUP_CQSIZE;
+    p.cq_entries = entries > UINT_MAX / 16 ? UINT_MAX : entries * 16;
+    int fd = uring_setup(entries, &p);
+    if (fd < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        Py_DECREF(self);
+        return NULL;
+    }
+    /* Since Linux 5.11. */
+    unsigned needed = (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                       IORING_FEAT_EXT_ARG);
+    if ((p.features & needed) != needed) {
+        close(fd);
+        errno = ENOSYS;
+        PyErr_SetFromErrno(PyExc_OSError);
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    size_t sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    size_t ring_size = Py_MAX(sq_size, cq_size);
+    char *ptr = mmap(NULL, ring_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ptr == MAP_FAILED) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        close(fd);
+        Py_DECREF(self);
+        return NULL;
+    }
+    size_t sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        munmap(ptr, ring_size);
+        close(fd);
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    self->fd = fd;
+    self->features = p.features;
+    self->ring_ptr = ptr;
+    self->ring_size = ring_size;
+    self->sqes = sqes;
+    self->sqes_size = sqes_size;
+    self->sq_head = (unsigned *)(ptr + p.sq_off.head);
+    self->sq_tail = (unsigned *)(ptr + p.sq_off.tail);
+    self->sq_array = (unsigned *)(ptr + p.sq_off.array);
+    self->sq_mask = *(unsigned *)(ptr + p.sq_off.ring_mask);
+    self->sq_entries = p.sq_entries;
+    self->sq_local_tail = *self->sq_tail;
+    self->sq_submitted = self->sq_local_tail;
+    self->cq_head = (unsigned *)(ptr + p.cq_off.head);
+    self->cq_tail = (unsigned *)(ptr + p.cq_off.tail);
+    self->cq_mask = *(unsigned *)(ptr + p.cq_off.ring_mask);
+    self->cqes = (struct io_uring_cqe *)(ptr + p.cq_off.cqes);
+#ifdef URING_HAVE_MULTISHOT_RECV
+    ring_setup_buffers(self);
+#endif
+    return (PyObject *)self;
+}
+
+static int
+ring_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    RingObject *self = RingObject_CAST(op);
+    Py_VISIT(Py_TYPE(self));
+    for (Py_ssize_t i = 0; i < self->nslots; i++) {
+        uring_slot *slot = &self->slots[i];
+        Py_VISIT(slot->token);
+        Py_VISIT(slot->data);
+        Py_VISIT(slot->view.obj);
+    }
+    return 0;
+}
+
+static void
+ring_dealloc(PyObject *op)
+{
+    RingObject *self = RingObject_CAST(op);
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    ring_close(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyObject *
+ring_op_buffer(RingObject *self, PyObject *token, int opcode, int fd,
+               PyObject *buffer, int writable, int flags)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(buffer, &view,
+                           writable ? PyBUF_WRITABLE : PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    if (view.len > UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "buffer is too large");
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    struct io_uring_sqe *sqe;
+    Py_ssize_t i = ring_prep(self, token, URING_PLAIN, &view, &sqe);
+    if (i < 0) {
+        return NULL;
+    }
+    sqe->opcode = (uint8_t)opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)self->slots[i].view.buf;
+    sqe->len = (uint32_t)self->slots[i].view.len;
+    if (opcode == IORING_OP_READ || opcode == IORING_OP_WRITE) {
+        sqe->off = (uint64_t)-1;    /* the current position */
+    }
+    else {
+        sqe->msg_flags = (uint32_t)flags;
+    }
+    return PyLong_FromSsize_t(i);
+}
+
+static PyObject *
+ring_op_bytes(RingObject *self, PyObject *token, int opcode, int fd,
+              Py_ssize_t nbytes, int flags)
+{
+    if (nbytes < 0 || nbytes > UINT32_MAX) {
+        PyErr_SetString(PyExc_ValueError, "negative or too large size");
+        return NULL;
+    }
+    PyObject *data = PyBytes_FromStringAndSize(NULL, nbytes);
+    if (data == NULL) {
+        return NULL;
+    }
+    struct io_uring_sqe *sqe;
+    Py_ssize_t i = ring_prep(self, token, URING_BYTES, NULL, &sqe);
+    if (i < 0) {
+        Py_DECREF(data);
+        return NULL;
+    }
+    self->slots[i].data = data;
+    sqe->opcode = (uint8_t)opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)PyBytes_AS_STRING(data);
+    sqe->len = (uint32_t)nbytes;
+    if (opcode == IORING_OP_READ) {
+        sqe->off = (uint64_t)-1;
+    }
+    else {
+        sqe->msg_flags = (uint32_t)flags;
+    }
+    return PyLong_FromSsize_t(i);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.recv
+
+    token: object
+    fd: int
+    nbytes: Py_ssize_t
+    flags: int = 0
+    /
+
+Queue a receive of at most nbytes from the socket fd.
+
+Return the slot of the operation.  Its completion is returned by wait()
+with the received bytes.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_recv_impl(RingObject *self, PyObject *token, int fd,
+                      Py_ssize_t nbytes, int flags)
+/*[clinic end generated code: output=826f1e07c0af79c1 input=281fd7a9e47ec778]*/
+{
+    return ring_op_bytes(self, token, IORING_OP_RECV, fd, nbytes, flags);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.recv_into
+
+    token: object
+    fd: int
+    buffer: object
+    flags: int = 0
+    /
+
+Queue a receive from the socket fd into a writable buffer.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_recv_into_impl(RingObject *self, PyObject *token, int fd,
+                           PyObject *buffer, int flags)
+/*[clinic end generated code: output=b9df2219ac491419 input=9d8702a84a07c6eb]*/
+{
+    return ring_op_buffer(self, token, IORING_OP_RECV, fd, buffer, 1, flags);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.read
+
+    token: object
+    fd: int
+    nbytes: Py_ssize_t
+    /
+
+Queue a read of at most nbytes from fd, such as a pipe.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_read_impl(RingObject *self, PyObject *token, int fd,
+                      Py_ssize_t nbytes)
+/*[clinic end generated code: output=7863a8dfc3aafbe0 input=a148da2a1d99d5ba]*/
+{
+    return ring_op_bytes(self, token, IORING_OP_READ, fd, nbytes, 0);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.read_into
+
+    token: object
+    fd: int
+    buffer: object
+    /
+
+Queue a read from fd into a writable buffer.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_read_into_impl(RingObject *self, PyObject *token, int fd,
+                           PyObject *buffer)
+/*[clinic end generated code: output=854ab3f6ca0c4e86 input=a83230dad08b1ad3]*/
+{
+    return ring_op_buffer(self, token, IORING_OP_READ, fd, buffer, 1, 0);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.send
+
+    token: object
+    fd: int
+    buffer: object
+    flags: int = 0
+    /
+
+Queue a send of a buffer to the socket fd.
+
+The result is the number of bytes sent, which can be less than the
+size of the buffer.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_send_impl(RingObject *self, PyObject *token, int fd,
+                      PyObject *buffer, int flags)
+/*[clinic end generated code: output=ac19f221993fdfb0 input=2154d8f8e341667f]*/
+{
+    return ring_op_buffer(self, token, IORING_OP_SEND, fd, buffer, 0, flags);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.write
+
+    token: object
+    fd: int
+    buffer: object
+    /
+
+Queue a write of a buffer to fd, such as a pipe.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_write_impl(RingObject *self, PyObject *token, int fd,
+                       PyObject *buffer)
+/*[clinic end generated code: output=49ab5487c331485c input=64cb2e46990463c6]*/
+{
+    return ring_op_buffer(self, token, IORING_OP_WRITE, fd, buffer, 0, 0);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.accept
+
+    token: object
+    fd: int
+    multishot: bool = False
+    /
+
+Queue an accept on the listening socket fd.
+
+The result is the file descriptor of the new connection, which is
+non-blocking and close-on-exec.  A multishot accept completes once for
+every connection until it is cancelled or fails; raise
+NotImplementedError if it is not supported.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_accept_impl(RingObject *self, PyObject *token, int fd,
+                        int multishot)
+/*[clinic end generated code: output=71ad166e0491c551 input=2d2fb6e8d75664f4]*/
+{
+#ifndef IORING_ACCEPT_MULTISHOT
+    if (multishot) {
+        PyErr_SetString(PyExc_NotImplementedError,
+                        "multishot accept is not supported");
+        return NULL;
+    }
+#endif
+    struct io_uring_sqe *sqe;
+    Py_ssize_t i = ring_prep(self, token, URING_PLAIN, NULL, &sqe);
+    if (i < 0) {
+        return NULL;
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+#ifdef IORING_ACCEPT_MULTISHOT
+    if (multishot) {
+        sqe->ioprio |= IORING_ACCEPT_MULTISHOT;
+    }
+#endif
+    return PyLong_FromSsize_t(i);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.recv_multishot
+
+    token: object
+    fd: int
+    /
+
+Queue a multishot receive from the socket fd.
+
+It completes with the received bytes every time data arrives, until it
+is cancelled, the peer shuts down the connection (an empty result), or
+it fails.  It fails with ENOBUFS if the data is received faster than
+the completions are waited for.  Raise NotImplementedError if multishot
+receives are not supported.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_recv_multishot_impl(RingObject *self, PyObject *token, int fd)
+/*[clinic end generated code: output=0ee373e78ce8749d input=02dc0373f272ee65]*/
+{
+#ifdef URING_HAVE_MULTISHOT_RECV
+    if (self->br != NULL) {
+        struct io_uring_sqe *sqe;
+        Py_ssize_t i = ring_prep(self, token, URING_SELECT, NULL, &sqe);
+        if (i < 0) {
+            return NULL;
+        }
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = URING_BGID;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        return PyLong_FromSsize_t(i);
+    }
+#endif
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+    PyErr_SetString(PyExc_NotImplementedError,
+                    "multishot receive is not supported");
+    return NULL;
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.poll
+
+    token: object
+    fd: int
+    events: unsigned_int(bitwise=True)
+    /
+
+Queue a wait until fd is ready for the poll() events.
+
+The result is the mask of the events that occurred.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_poll_impl(RingObject *self, PyObject *token, int fd,
+                      unsigned int events)
+/*[clinic end generated code: output=de66467274813f7b input=c358d596d675e709]*/
+{
+    struct io_uring_sqe *sqe;
+    Py_ssize_t i = ring_prep(self, token, URING_PLAIN, NULL, &sqe);
+    if (i < 0) {
+        return NULL;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+#if PY_BIG_ENDIAN
+    events = (events << 16) | (events >> 16);
+#endif
+    sqe->poll32_events = events;
+    return PyLong_FromSsize_t(i);
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.cancel
+
+    slot: Py_ssize_t
+    /
+
+Queue the cancellation of the operation in slot.
+
+The operation still completes, usually with ECANCELED.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_cancel_impl(RingObject *self, Py_ssize_t slot)
+/*[clinic end generated code: output=68e3c961ec92bc7a input=9e995658942479aa]*/
+{
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+    if (slot < 0 || slot >= self->nslots || self->slots[slot].token == NULL) {
+        Py_RETURN_NONE;
+    }
+    struct io_uring_sqe *sqe = ring_get_sqe(self);
+    if (sqe == NULL) {
+        return NULL;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = (uint64_t)slot + 1;
+    sqe->user_data = 0;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.cancel_fd
+
+    fd: int
+    /
+
+Queue the cancellation of all operations on fd.
+
+Raise NotImplementedError if it is not supported.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_cancel_fd_impl(RingObject *self, int fd)
+/*[clinic end generated code: output=9e3d9467a769544a input=51be2f651648ce50]*/
+{
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+#ifdef IORING_ASYNC_CANCEL_FD
+    struct io_uring_sqe *sqe = ring_get_sqe(self);
+    if (sqe == NULL) {
+        return NULL;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = fd;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = 0;
+    Py_RETURN_NONE;
+#else
+    PyErr_SetString(PyExc_NotImplementedError,
+                    "cancelling by file descriptor is not supported");
+    return NULL;
+#endif
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.submit
+
+Submit the queued operations without waiting.
+
+Return the number of operations submitted.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_submit_impl(RingObject *self)
+/*[clinic end generated code: output=f8036e3d35cb13e9 input=22850be3ae61c095]*/
+{
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+    if (self->sq_local_tail == self->sq_submitted) {
+        return PyLong_FromLong(0);
+    }
+    int ret = ring_enter(self, 0, 0, NULL);
+    if (ret < 0) {
+        if (errno != EBUSY && errno != EAGAIN && errno != EINTR) {
+            return PyErr_SetFromErrno(PyExc_OSError);
+        }
+        ret = 0;
+    }
+    return PyLong_FromLong(ret);
+}
+
+/* Return the completion of the operation in slot as a tuple
+   (token, result, more, data), and free the slot if it is the last. */
+static PyObject *
+ring_completion(RingObject *self, Py_ssize_t i, int32_t res, uint32_t flags)
+{
+    uring_slot *slot = &self->slots[i];
+    int more = (flags & IORING_CQE_F_MORE) != 0;
+    PyObject *data = NULL;
+
+#ifdef URING_HAVE_MULTISHOT_RECV
+    if (flags & IORING_CQE_F_BUFFER) {
+        unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+        if (res > 0) {
+            data = PyBytes_FromStringAndSize(
+                self->bufs + (size_t)bid * URING_BUF_SIZE
+                + self->buf_used[bid], res);
+        }
+        if (flags & IORING_CQE_F_BUF_MORE) {
+            /* The kernel puts the next data in the rest of the buffer. */
+            self->buf_used[bid] += (uint16_t)res;
+        }
+        else if (res > 0 || !self->br_inc) {
+            /* An incrementally consumed buffer is only given up by
+               a completion with data. */
+            ring_recycle_buffer(self, bid);
+        }
+        if (res > 0 && data == NULL) {
+            return NULL;
+        }
+    }
+#endif
+    if (slot->kind == URING_BYTES && res >= 0) {
+        assert(!more);
+        data = slot->data;
+        slot->data = NULL;
+        if (res < PyBytes_GET_SIZE(data) && _PyBytes_Resize(&data, res) < 0) {
+            ring_free_slot(self, i);
+            return NULL;
+        }
+    }
+    else if (slot->kind == URING_SELECT && res == 0) {
+        data = Py_GetConstant(Py_CONSTANT_EMPTY_BYTES);
+    }
+    if (data == NULL) {
+        data = Py_None;
+    }
+
+    PyObject *result = Py_BuildValue("(OiOO)", slot->token, (int)res,
+                                     more ? Py_True : Py_False, data);
+    if (data != Py_None) {
+        Py_DECREF(data);
+    }
+    if (!more) {
+        ring_free_slot(self, i);
+    }
+    return result;
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.wait
+
+    timeout: object = None
+    /
+
+Submit the queued operations and wait for completions.
+
+Wait at most timeout seconds, or forever if timeout is None, for at
+least one operation to complete.  Return a list of the completions
+as tuples (token, result, more, data):
+
+- result is the result of the system call, or a negative errno value;
+- more is true if a multishot operation will complete again;
+- data is the received bytes, or None.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_wait_impl(RingObject *self, PyObject *timeout)
+/*[clinic end generated code: output=b86115b821984c32 input=143a001933aab524]*/
+{
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+    struct __kernel_timespec ts = {0, 0};
+    int block = 1;
+    if (timeout != Py_None) {
+        PyTime_t t;
+        if (_PyTime_FromSecondsObject(&t, timeout, _PyTime_ROUND_CEILING) < 0) {
+            return NULL;
+        }
+        if (t < 0) {
+            PyErr_SetString(PyExc_ValueError, "timeout must be non-negative");
+            return NULL;
+        }
+        ts.tv_sec = (long long)(t / 1000000000);
+        ts.tv_nsec = (long long)(t % 1000000000);
+        block = t > 0;
+    }
+
+    unsigned ready = _Py_atomic_load_uint32_acquire(self->cq_tail)
+                     - *self->cq_head;
+    int wait = ready == 0 && block;
+    if (wait || self->sq_local_tail != self->sq_submitted) {
+        struct io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        unsigned flags = 0;
+        if (wait) {
+            flags = IORING_ENTER_GETEVENTS;
+            if (timeout != Py_None) {
+                flags |= IORING_ENTER_EXT_ARG;
+                arg.sigmask_sz = _NSIG / 8;
+                arg.ts = (uint64_t)(uintptr_t)&ts;
+            }
+        }
+        int ret = ring_enter(self, wait, flags,
+                             (flags & IORING_ENTER_EXT_ARG) ? &arg : NULL);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                if (PyErr_CheckSignals() < 0) {
+                    return NULL;
+                }
+            }
+            else if (errno != ETIME && errno != EBUSY && errno != EAGAIN) {
+                return PyErr_SetFromErrno(PyExc_OSError);
+            }
+        }
+    }
+
+    PyObject *list = PyList_New(0);
+    if (list == NULL) {
+        return NULL;
+    }
+    unsigned head = *self->cq_head;
+    while (head != _Py_atomic_load_uint32_acquire(self->cq_tail)) {
+        struct io_uring_cqe *cqe = &self->cqes[head & self->cq_mask];
+        uint64_t user_data = cqe->user_data;
+        int32_t res = cqe->res;
+        uint32_t flags = cqe->flags;
+        head++;
+        _Py_atomic_store_uint32_release(self->cq_head, head);
+        if (user_data == 0) {
+            continue;
+        }
+        Py_ssize_t i = (Py_ssize_t)(user_data - 1);
+        assert(i < self->nslots && self->slots[i].token != NULL);
+        PyObject *item = ring_completion(self, i, res, flags);
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            /* Later completions stay in the queue. */
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return list;
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.close
+
+Close the ring.
+
+The buffers of operations that are still pending are never released,
+since the kernel could still use them.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_close_impl(RingObject *self)
+/*[clinic end generated code: output=447415269da3419f input=25584f9a59da3fc2]*/
+{
+    ring_close(self);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_uring.Ring.fileno
+
+Return the file descriptor of the ring.
+[clinic start generated code]*/
+
+static PyObject *
+_uring_Ring_fileno_impl(RingObject *self)
+/*[clinic end generated code: output=773263c5ad53ca3d input=ececdb4cb6c95cce]*/
+{
+    if (ring_check_open(self) < 0) {
+        return NULL;
+    }
+    return PyLong_FromLong(self->fd);
+}
+
+static PyObject *
+ring_get_pending(PyObject *op, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSsize_t(RingObject_CAST(op)->pending);
+}
+
+static PyObject *
+ring_get_closed(PyObject *op, void *Py_UNUSED(closure))
+{
+    return PyBool_FromLong(RingObject_CAST(op)->fd < 0);
+}
+
+static PyObject *
+ring_get_multishot_recv(PyObject *op, void *Py_UNUSED(closure))
+{
+#ifdef URING_HAVE_MULTISHOT_RECV
+    return PyBool_FromLong(RingObject_CAST(op)->br != NULL);
+#else
+    Py_RETURN_FALSE;
+#endif
+}
+
+#include "clinic/_uringmodule.c.h"
+
+static PyMethodDef ring_methods[] = {
+    _URING_RING_RECV_METHODDEF
+    _URING_RING_RECV_INTO_METHODDEF
+    _URING_RING_READ_METHODDEF
+    _URING_RING_READ_INTO_METHODDEF
+    _URING_RING_SEND_METHODDEF
+    _URING_RING_WRITE_METHODDEF
+    _URING_RING_ACCEPT_METHODDEF
+    _URING_RING_RECV_MULTISHOT_METHODDEF
+    _URING_RING_POLL_METHODDEF
+    _URING_RING_CANCEL_METHODDEF
+    _URING_RING_CANCEL_FD_METHODDEF
+    _URING_RING_SUBMIT_METHODDEF
+    _URING_RING_WAIT_METHODDEF
+    _URING_RING_CLOSE_METHODDEF
+    _URING_RING_FILENO_METHODDEF
+    {NULL, NULL}
+};
+
+static PyGetSetDef ring_getset[] = {
+    {"pending", ring_get_pending, NULL,
+     PyDoc_STR("Number of operations that have not completed.")},
+    {"closed", ring_get_closed, NULL,
+     PyDoc_STR("True if the ring is closed.")},
+    {"multishot_recv", ring_get_multishot_recv, NULL,
+     PyDoc_STR("True if recv_multishot() is supported.")},
+    {NULL}
+};
+
+static PyType_Slot ring_slots[] = {
+    {Py_tp_dealloc, ring_dealloc},
+    {Py_tp_traverse, ring_traverse},
+    {Py_tp_doc, (void *)ring_new__doc__},
+    {Py_tp_methods, ring_methods},
+    {Py_tp_getset, ring_getset},
+    {Py_tp_new, ring_new},
+    {0, NULL},
+};
+
+static PyType_Spec ring_spec = {
+    .name = "_uring.Ring",
+    .basicsize = sizeof(RingObject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE |
+              Py_TPFLAGS_HAVE_GC),
+    .slots = ring_slots,
+};
+
+
+/* --- Module -------------------------------------------------------------- */
+
+static int
+uring_traverse(PyObject *module, visitproc visit, void *arg)
+{
+    uring_state *state = get_uring_state(module);
+    Py_VISIT(state->RingType);
+    return 0;
+}
+
+static int
+uring_clear(PyObject *module)
+{
+    uring_state *state = get_uring_state(module);
+    Py_CLEAR(state->RingType);
+    return 0;
+}
+
+static void
+uring_free(void *module)
+{
+    (void)uring_clear((PyObject *)module);
+}
+
+static int
+uring_exec(PyObject *module)
+{
+    uring_state *state = get_uring_state(module);
+    state->RingType = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &ring_spec, NULL);
+    if (state->RingType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->RingType) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static PyModuleDef_Slot uring_slots[] = {
+    {Py_mod_exec, uring_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
+
+PyDoc_STRVAR(uring_doc,
+"io_uring rings.\n\
+This module is an implementation detail, please use asyncio.UringEventLoop.");
+
+static struct PyModuleDef uringmodule = {
+    .m_base = PyModuleDef_HEAD_INIT,
+    .m_name = "_uring",
+    .m_doc = uring_doc,
+    .m_size = sizeof(uring_state),
+    .m_slots = uring_slots,
+    .m_traverse = uring_traverse,
+    .m_clear = uring_clear,
+    .m_free = uring_free,
+};
+
+PyMODINIT_FUNC
+PyInit__uring(void)
+{
+    return PyModuleDef_Init(&uringmodule);
+}
@@ -8,6 +8,7 @@ preserve
 #endif
 #include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+#include "pycore_tuple.h"         // _PyTuple_FromArray()
 
 PyDoc_STRVAR(_asyncio_Future___init____doc__,
 "Future(*, loop=None)\n"
@@ -1537,6 +1538,762 @@ _asyncio_Task_set_name(PyObject *self, PyObject *value)
     return return_value;
 }
 
+PyDoc_STRVAR(_asyncio_Handle___init____doc__,
+"Handle(callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by callback registration methods.");
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context);
+
+static int
+_asyncio_Handle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 4
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(callback), &_Py_ID(args), &_Py_ID(loop), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "Handle",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[4];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 3;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 3, /*maxpos*/ 4, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    callback = fastargs[0];
+    __clinic_args = fastargs[1];
+    loop = fastargs[2];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[3];
+skip_optional_pos:
+    return_value = _asyncio_Handle___init___impl((HandleObj *)self, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_Handle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", _PyCFunction_CAST(_asyncio_Handle__repr_info), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio_Handle__repr_info__doc__},
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self, PyTypeObject *cls);
+
+static PyObject *
+_asyncio_Handle__repr_info(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "_repr_info() takes no arguments");
+        return NULL;
+    }
+    return _asyncio_Handle__repr_info_impl((HandleObj *)self, cls);
+}
+
+PyDoc_STRVAR(_asyncio_Handle_get_context__doc__,
+"get_context($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_GET_CONTEXT_METHODDEF    \
+    {"get_context", (PyCFunction)_asyncio_Handle_get_context, METH_NOARGS, _asyncio_Handle_get_context__doc__},
+
+static PyObject *
+_asyncio_Handle_get_context_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_get_context(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_get_context_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_Handle_cancel, METH_NOARGS, _asyncio_Handle_cancel__doc__},
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancel(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_cancel_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancelled__doc__,
+"cancelled($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCELLED_METHODDEF    \
+    {"cancelled", (PyCFunction)_asyncio_Handle_cancelled, METH_NOARGS, _asyncio_Handle_cancelled__doc__},
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancelled(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_cancelled_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle__run__doc__,
+"_run($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__RUN_METHODDEF    \
+    {"_run", _PyCFunction_CAST(_asyncio_Handle__run), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio_Handle__run__doc__},
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self, PyTypeObject *cls);
+
+static PyObject *
+_asyncio_Handle__run(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "_run() takes no arguments");
+        return NULL;
+    }
+    return _asyncio_Handle__run_impl((HandleObj *)self, cls);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle___init____doc__,
+"TimerHandle(when, callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by timed callback registration methods.");
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context);
+
+static int
+_asyncio_TimerHandle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 5
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(when), &_Py_ID(callback), &_Py_ID(args), &_Py_ID(loop), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"when", "callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "TimerHandle",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[5];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 4;
+    PyObject *when;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 4, /*maxpos*/ 5, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    when = fastargs[0];
+    callback = fastargs[1];
+    __clinic_args = fastargs[2];
+    loop = fastargs[3];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[4];
+skip_optional_pos:
+    return_value = _asyncio_TimerHandle___init___impl((TimerHandleObj *)self, when, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", _PyCFunction_CAST(_asyncio_TimerHandle__repr_info), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio_TimerHandle__repr_info__doc__},
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self, PyTypeObject *cls);
+
+static PyObject *
+_asyncio_TimerHandle__repr_info(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "_repr_info() takes no arguments");
+        return NULL;
+    }
+    return _asyncio_TimerHandle__repr_info_impl((TimerHandleObj *)self, cls);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_TimerHandle_cancel, METH_NOARGS, _asyncio_TimerHandle_cancel__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_cancel(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle_cancel_impl((TimerHandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_when__doc__,
+"when($self, /)\n"
+"--\n"
+"\n"
+"Return a scheduled callback time.\n"
+"\n"
+"The time is an absolute timestamp, using the same time\n"
+"reference as loop.time().");
+
+#define _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF    \
+    {"when", (PyCFunction)_asyncio_TimerHandle_when, METH_NOARGS, _asyncio_TimerHandle_when__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_when(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle_when_impl((TimerHandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore_get_debug__doc__,
+"get_debug($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO__EVENTLOOPCORE_GET_DEBUG_METHODDEF    \
+    {"get_debug", (PyCFunction)_asyncio__EventLoopCore_get_debug, METH_NOARGS, _asyncio__EventLoopCore_get_debug__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore_get_debug_impl(EventLoopCoreObj *self);
+
+static PyObject *
+_asyncio__EventLoopCore_get_debug(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio__EventLoopCore_get_debug_impl((EventLoopCoreObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore_call_later__doc__,
+"call_later($self, /, delay, callback, *args, context=None)\n"
+"--\n"
+"\n"
+"Arrange for a callback to be called at a given time.\n"
+"\n"
+"Return a Handle: an opaque object with a cancel() method that\n"
+"can be used to cancel the call.\n"
+"\n"
+"The delay can be an int or float, expressed in seconds.  It is\n"
+"always relative to the current time.\n"
+"\n"
+"Each callback will be called exactly once.  If two callbacks\n"
+"are scheduled for exactly the same time, it is undefined which\n"
+"will be called first.\n"
+"\n"
+"Any positional arguments after the callback will be passed to\n"
+"the callback when it is called.");
+
+#define _ASYNCIO__EVENTLOOPCORE_CALL_LATER_METHODDEF    \
+    {"call_later", _PyCFunction_CAST(_asyncio__EventLoopCore_call_later), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore_call_later__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore_call_later_impl(EventLoopCoreObj *self,
+                                        PyTypeObject *cls, PyObject *delay,
+                                        PyObject *callback, PyObject *args,
+                                        PyObject *context);
+
+static PyObject *
+_asyncio__EventLoopCore_call_later(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(delay), &_Py_ID(callback), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"delay", "callback", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "call_later",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    PyObject * const *fastargs;
+    Py_ssize_t noptargs = Py_MIN(nargs, 2) + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 2;
+    PyObject *delay;
+    PyObject *callback;
+    PyObject *__clinic_args = NULL;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 2, /*maxpos*/ 2, /*minkw*/ 0, /*varpos*/ 1, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    delay = fastargs[0];
+    callback = fastargs[1];
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    context = fastargs[2];
+skip_optional_kwonly:
+    __clinic_args = nargs > 2
+        ? _PyTuple_FromArray(args + 2, nargs - 2)
+        : PyTuple_New(0);
+    if (__clinic_args == NULL) {
+        goto exit;
+    }
+    return_value = _asyncio__EventLoopCore_call_later_impl((EventLoopCoreObj *)self, cls, delay, callback, __clinic_args, context);
+
+exit:
+    /* Cleanup for args */
+    Py_XDECREF(__clinic_args);
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore_call_at__doc__,
+"call_at($self, /, when, callback, *args, context=None)\n"
+"--\n"
+"\n"
+"Like call_later(), but uses an absolute time.\n"
+"\n"
+"Absolute time corresponds to the event loop\'s time() method.");
+
+#define _ASYNCIO__EVENTLOOPCORE_CALL_AT_METHODDEF    \
+    {"call_at", _PyCFunction_CAST(_asyncio__EventLoopCore_call_at), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore_call_at__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore_call_at_impl(EventLoopCoreObj *self,
+                                     PyTypeObject *cls, PyObject *when,
+                                     PyObject *callback, PyObject *args,
+                                     PyObject *context);
+
+static PyObject *
+_asyncio__EventLoopCore_call_at(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(when), &_Py_ID(callback), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"when", "callback", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "call_at",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    PyObject * const *fastargs;
+    Py_ssize_t noptargs = Py_MIN(nargs, 2) + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 2;
+    PyObject *when;
+    PyObject *callback;
+    PyObject *__clinic_args = NULL;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 2, /*maxpos*/ 2, /*minkw*/ 0, /*varpos*/ 1, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    when = fastargs[0];
+    callback = fastargs[1];
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    context = fastargs[2];
+skip_optional_kwonly:
+    __clinic_args = nargs > 2
+        ? _PyTuple_FromArray(args + 2, nargs - 2)
+        : PyTuple_New(0);
+    if (__clinic_args == NULL) {
+        goto exit;
+    }
+    return_value = _asyncio__EventLoopCore_call_at_impl((EventLoopCoreObj *)self, cls, when, callback, __clinic_args, context);
+
+exit:
+    /* Cleanup for args */
+    Py_XDECREF(__clinic_args);
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore_call_soon__doc__,
+"call_soon($self, /, callback, *args, context=None)\n"
+"--\n"
+"\n"
+"Arrange for a callback to be called as soon as possible.\n"
+"\n"
+"This operates as a FIFO queue: callbacks are called in the\n"
+"order in which they are registered.  Each callback will be\n"
+"called exactly once.\n"
+"\n"
+"Any positional arguments after the callback will be passed to\n"
+"the callback when it is called.");
+
+#define _ASYNCIO__EVENTLOOPCORE_CALL_SOON_METHODDEF    \
+    {"call_soon", _PyCFunction_CAST(_asyncio__EventLoopCore_call_soon), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore_call_soon__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore_call_soon_impl(EventLoopCoreObj *self,
+                                       PyTypeObject *cls, PyObject *callback,
+                                       PyObject *args, PyObject *context);
+
+static PyObject *
+_asyncio__EventLoopCore_call_soon(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(callback), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"callback", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "call_soon",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    PyObject * const *fastargs;
+    Py_ssize_t noptargs = Py_MIN(nargs, 1) + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
+    PyObject *callback;
+    PyObject *__clinic_args = NULL;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 1, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    callback = fastargs[0];
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    context = fastargs[1];
+skip_optional_kwonly:
+    __clinic_args = nargs > 1
+        ? _PyTuple_FromArray(args + 1, nargs - 1)
+        : PyTuple_New(0);
+    if (__clinic_args == NULL) {
+        goto exit;
+    }
+    return_value = _asyncio__EventLoopCore_call_soon_impl((EventLoopCoreObj *)self, cls, callback, __clinic_args, context);
+
+exit:
+    /* Cleanup for args */
+    Py_XDECREF(__clinic_args);
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore__call_soon__doc__,
+"_call_soon($self, /, callback, args, context)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO__EVENTLOOPCORE__CALL_SOON_METHODDEF    \
+    {"_call_soon", _PyCFunction_CAST(_asyncio__EventLoopCore__call_soon), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore__call_soon__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore__call_soon_impl(EventLoopCoreObj *self,
+                                        PyTypeObject *cls,
+                                        PyObject *callback, PyObject *args,
+                                        PyObject *context);
+
+static PyObject *
+_asyncio__EventLoopCore__call_soon(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 3
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(callback), &_Py_ID(args), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"callback", "args", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "_call_soon",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[3];
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *context;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 3, /*maxpos*/ 3, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    callback = args[0];
+    __clinic_args = args[1];
+    context = args[2];
+    return_value = _asyncio__EventLoopCore__call_soon_impl((EventLoopCoreObj *)self, cls, callback, __clinic_args, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore__add_callback__doc__,
+"_add_callback($self, handle, /)\n"
+"--\n"
+"\n"
+"Add a Handle to _ready.");
+
+#define _ASYNCIO__EVENTLOOPCORE__ADD_CALLBACK_METHODDEF    \
+    {"_add_callback", _PyCFunction_CAST(_asyncio__EventLoopCore__add_callback), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore__add_callback__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore__add_callback_impl(EventLoopCoreObj *self,
+                                           PyTypeObject *cls,
+                                           PyObject *handle);
+
+static PyObject *
+_asyncio__EventLoopCore__add_callback(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+    #  define KWTUPLE (PyObject *)&_Py_SINGLETON(tuple_empty)
+    #else
+    #  define KWTUPLE NULL
+    #endif
+
+    static const char * const _keywords[] = {"", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "_add_callback",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject *handle;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    handle = args[0];
+    return_value = _asyncio__EventLoopCore__add_callback_impl((EventLoopCoreObj *)self, cls, handle);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore__timer_handle_cancelled__doc__,
+"_timer_handle_cancelled($self, handle, /)\n"
+"--\n"
+"\n"
+"Notification that a TimerHandle has been cancelled.");
+
+#define _ASYNCIO__EVENTLOOPCORE__TIMER_HANDLE_CANCELLED_METHODDEF    \
+    {"_timer_handle_cancelled", _PyCFunction_CAST(_asyncio__EventLoopCore__timer_handle_cancelled), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore__timer_handle_cancelled__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore__timer_handle_cancelled_impl(EventLoopCoreObj *self,
+                                                     PyTypeObject *cls,
+                                                     PyObject *handle);
+
+static PyObject *
+_asyncio__EventLoopCore__timer_handle_cancelled(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+    #  define KWTUPLE (PyObject *)&_Py_SINGLETON(tuple_empty)
+    #else
+    #  define KWTUPLE NULL
+    #endif
+
+    static const char * const _keywords[] = {"", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "_timer_handle_cancelled",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject *handle;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 1, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    handle = args[0];
+    return_value = _asyncio__EventLoopCore__timer_handle_cancelled_impl((EventLoopCoreObj *)self, cls, handle);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__EventLoopCore__run_once__doc__,
+"_run_once($self, /)\n"
+"--\n"
+"\n"
+"Run one full iteration of the event loop.\n"
+"\n"
+"This calls all currently ready callbacks, polls for I/O,\n"
+"schedules the resulting callbacks, and finally schedules\n"
+"\'call_later\' callbacks.");
+
+#define _ASYNCIO__EVENTLOOPCORE__RUN_ONCE_METHODDEF    \
+    {"_run_once", _PyCFunction_CAST(_asyncio__EventLoopCore__run_once), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _asyncio__EventLoopCore__run_once__doc__},
+
+static PyObject *
+_asyncio__EventLoopCore__run_once_impl(EventLoopCoreObj *self,
+                                       PyTypeObject *cls);
+
+static PyObject *
+_asyncio__EventLoopCore__run_once(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "_run_once() takes no arguments");
+        return NULL;
+    }
+    return _asyncio__EventLoopCore__run_once_impl((EventLoopCoreObj *)self, cls);
+}
+
 PyDoc_STRVAR(_asyncio__get_running_loop__doc__,
 "_get_running_loop($module, /)\n"
 "--\n"
@@ -2232,4 +2989,4 @@ _asyncio_future_discard_from_awaited_by(PyObject *module, PyObject *const *args,
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=b69948ed810591d9 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=c381f71315247b9b input=a9049054013a1b77]*/
@@ -565,6 +565,356 @@ deque___reversed__(PyObject *deque, PyObject *Py_UNUSED(ignored))
     return deque___reversed___impl((dequeobject *)deque);
 }
 
+PyDoc_STRVAR(sdict_new__doc__,
+"ScalarDict(typecode, mapping_or_iterable=(), /)\n"
+"--\n"
+"\n"
+"Mapping from keys to numbers stored as C values.\n"
+"\n"
+"The typecode is \'q\' for 64-bit signed integers or \'d\' for floats.\n"
+"Values are converted to Python objects when they are read.");
+
+static PyObject *
+sdict_new_impl(PyTypeObject *type, int typecode, PyObject *arg);
+
+static PyObject *
+sdict_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    PyTypeObject *base_tp = find_module_state_by_def(type)->sdict_type;
+    int typecode;
+    PyObject *arg = NULL;
+
+    if ((type == base_tp || type->tp_init == base_tp->tp_init) &&
+        !_PyArg_NoKeywords("ScalarDict", kwargs)) {
+        goto exit;
+    }
+    if (!_PyArg_CheckPositional("ScalarDict", PyTuple_GET_SIZE(args), 1, 2)) {
+        goto exit;
+    }
+    if (!PyUnicode_Check(PyTuple_GET_ITEM(args, 0))) {
+        _PyArg_BadArgument("ScalarDict", "argument 1", "a unicode character", PyTuple_GET_ITEM(args, 0));
+        goto exit;
+    }
+    if (PyUnicode_GET_LENGTH(PyTuple_GET_ITEM(args, 0)) != 1) {
+        PyErr_Format(PyExc_TypeError,
+            "ScalarDict(): argument 1 must be a unicode character, "
+            "not a string of length %zd",
+            PyUnicode_GET_LENGTH(PyTuple_GET_ITEM(args, 0)));
+        goto exit;
+    }
+    typecode = PyUnicode_READ_CHAR(PyTuple_GET_ITEM(args, 0), 0);
+    if (PyTuple_GET_SIZE(args) < 2) {
+        goto skip_optional;
+    }
+    arg = PyTuple_GET_ITEM(args, 1);
+skip_optional:
+    return_value = sdict_new_impl(type, typecode, arg);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_get__doc__,
+"get($self, key, default=None, /)\n"
+"--\n"
+"\n"
+"Return the value for key if key is in the dictionary, else default.");
+
+#define _COLLECTIONS_SCALARDICT_GET_METHODDEF    \
+    {"get", _PyCFunction_CAST(_collections_ScalarDict_get), METH_FASTCALL, _collections_ScalarDict_get__doc__},
+
+static PyObject *
+_collections_ScalarDict_get_impl(sdictobject *self, PyObject *key,
+                                 PyObject *default_value);
+
+static PyObject *
+_collections_ScalarDict_get(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *key;
+    PyObject *default_value = Py_None;
+
+    if (!_PyArg_CheckPositional("get", nargs, 1, 2)) {
+        goto exit;
+    }
+    key = args[0];
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    default_value = args[1];
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_get_impl((sdictobject *)self, key, default_value);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_pop__doc__,
+"pop($self, key, default=<unrepresentable>, /)\n"
+"--\n"
+"\n"
+"Remove the key and return its value.\n"
+"\n"
+"If the key is not found, return the default if given; otherwise,\n"
+"raise a KeyError.");
+
+#define _COLLECTIONS_SCALARDICT_POP_METHODDEF    \
+    {"pop", _PyCFunction_CAST(_collections_ScalarDict_pop), METH_FASTCALL, _collections_ScalarDict_pop__doc__},
+
+static PyObject *
+_collections_ScalarDict_pop_impl(sdictobject *self, PyObject *key,
+                                 PyObject *default_value);
+
+static PyObject *
+_collections_ScalarDict_pop(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *key;
+    PyObject *default_value = NULL;
+
+    if (!_PyArg_CheckPositional("pop", nargs, 1, 2)) {
+        goto exit;
+    }
+    key = args[0];
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    default_value = args[1];
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_pop_impl((sdictobject *)self, key, default_value);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_add__doc__,
+"add($self, key, amount, /)\n"
+"--\n"
+"\n"
+"Add amount to the value for key.\n"
+"\n"
+"A missing key is inserted with a value of amount.");
+
+#define _COLLECTIONS_SCALARDICT_ADD_METHODDEF    \
+    {"add", _PyCFunction_CAST(_collections_ScalarDict_add), METH_FASTCALL, _collections_ScalarDict_add__doc__},
+
+static PyObject *
+_collections_ScalarDict_add_impl(sdictobject *self, PyObject *key,
+                                 PyObject *amount);
+
+static PyObject *
+_collections_ScalarDict_add(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *key;
+    PyObject *amount;
+
+    if (!_PyArg_CheckPositional("add", nargs, 2, 2)) {
+        goto exit;
+    }
+    key = args[0];
+    amount = args[1];
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_add_impl((sdictobject *)self, key, amount);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_count__doc__,
+"count($self, iterable, /)\n"
+"--\n"
+"\n"
+"Add 1 to the value for each element of iterable.\n"
+"\n"
+"Elements that are not keys yet are inserted with a value of 1.");
+
+#define _COLLECTIONS_SCALARDICT_COUNT_METHODDEF    \
+    {"count", (PyCFunction)_collections_ScalarDict_count, METH_O, _collections_ScalarDict_count__doc__},
+
+static PyObject *
+_collections_ScalarDict_count_impl(sdictobject *self, PyObject *iterable);
+
+static PyObject *
+_collections_ScalarDict_count(PyObject *self, PyObject *iterable)
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_count_impl((sdictobject *)self, iterable);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_update__doc__,
+"update($self, mapping_or_iterable, /)\n"
+"--\n"
+"\n"
+"Set the values for the items of a mapping or an iterable of pairs.");
+
+#define _COLLECTIONS_SCALARDICT_UPDATE_METHODDEF    \
+    {"update", (PyCFunction)_collections_ScalarDict_update, METH_O, _collections_ScalarDict_update__doc__},
+
+static PyObject *
+_collections_ScalarDict_update_impl(sdictobject *self, PyObject *arg);
+
+static PyObject *
+_collections_ScalarDict_update(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_update_impl((sdictobject *)self, arg);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_clear__doc__,
+"clear($self, /)\n"
+"--\n"
+"\n"
+"Remove all items.");
+
+#define _COLLECTIONS_SCALARDICT_CLEAR_METHODDEF    \
+    {"clear", (PyCFunction)_collections_ScalarDict_clear, METH_NOARGS, _collections_ScalarDict_clear__doc__},
+
+static PyObject *
+_collections_ScalarDict_clear_impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_clear_impl((sdictobject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_keys__doc__,
+"keys($self, /)\n"
+"--\n"
+"\n"
+"Return a list of the keys.");
+
+#define _COLLECTIONS_SCALARDICT_KEYS_METHODDEF    \
+    {"keys", (PyCFunction)_collections_ScalarDict_keys, METH_NOARGS, _collections_ScalarDict_keys__doc__},
+
+static PyObject *
+_collections_ScalarDict_keys_impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict_keys(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_keys_impl((sdictobject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_values__doc__,
+"values($self, /)\n"
+"--\n"
+"\n"
+"Return a list of the values.");
+
+#define _COLLECTIONS_SCALARDICT_VALUES_METHODDEF    \
+    {"values", (PyCFunction)_collections_ScalarDict_values, METH_NOARGS, _collections_ScalarDict_values__doc__},
+
+static PyObject *
+_collections_ScalarDict_values_impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict_values(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_values_impl((sdictobject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict_items__doc__,
+"items($self, /)\n"
+"--\n"
+"\n"
+"Return a list of the (key, value) pairs.");
+
+#define _COLLECTIONS_SCALARDICT_ITEMS_METHODDEF    \
+    {"items", (PyCFunction)_collections_ScalarDict_items, METH_NOARGS, _collections_ScalarDict_items__doc__},
+
+static PyObject *
+_collections_ScalarDict_items_impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict_items(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict_items_impl((sdictobject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_collections_ScalarDict___reduce____doc__,
+"__reduce__($self, /)\n"
+"--\n"
+"\n"
+"Return state information for pickling.");
+
+#define _COLLECTIONS_SCALARDICT___REDUCE___METHODDEF    \
+    {"__reduce__", (PyCFunction)_collections_ScalarDict___reduce__, METH_NOARGS, _collections_ScalarDict___reduce____doc__},
+
+static PyObject *
+_collections_ScalarDict___reduce___impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict___reduce__(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _collections_ScalarDict___reduce___impl((sdictobject *)self);
+}
+
+PyDoc_STRVAR(_collections_ScalarDict___sizeof____doc__,
+"__sizeof__($self, /)\n"
+"--\n"
+"\n"
+"Return the size in memory, in bytes.");
+
+#define _COLLECTIONS_SCALARDICT___SIZEOF___METHODDEF    \
+    {"__sizeof__", (PyCFunction)_collections_ScalarDict___sizeof__, METH_NOARGS, _collections_ScalarDict___sizeof____doc__},
+
+static PyObject *
+_collections_ScalarDict___sizeof___impl(sdictobject *self);
+
+static PyObject *
+_collections_ScalarDict___sizeof__(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _collections_ScalarDict___sizeof___impl((sdictobject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
 PyDoc_STRVAR(_collections__count_elements__doc__,
 "_count_elements($module, mapping, iterable, /)\n"
 "--\n"
@@ -632,4 +982,4 @@ tuplegetter_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=b9d4d647c221cb9f input=a9049054013a1b77]*/
+/*[clinic end generated code: output=2a3ea44bdccc0d31 input=a9049054013a1b77]*/
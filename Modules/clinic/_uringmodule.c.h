@@ -0,0 +1,700 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+#if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+#  include "pycore_gc.h"          // PyGC_Head
+#  include "pycore_runtime.h"     // _Py_ID()
+#endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
+#include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
+#include "pycore_long.h"          // _PyLong_UnsignedInt_Converter()
+#include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
+
+PyDoc_STRVAR(ring_new__doc__,
+"Ring(entries=256)\n"
+"--\n"
+"\n"
+"Create an io_uring instance with room for entries queued operations.\n"
+"\n"
+"Raise OSError if the kernel does not support io_uring, or a version of\n"
+"it with all the features needed.");
+
+static PyObject *
+ring_new_impl(PyTypeObject *type, unsigned int entries);
+
+static PyObject *
+ring_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        Py_hash_t ob_hash;
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_hash = -1,
+        .ob_item = { &_Py_ID(entries), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"entries", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "Ring",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 0;
+    unsigned int entries = 256;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 0, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (!_PyLong_UnsignedInt_Converter(fastargs[0], &entries)) {
+        goto exit;
+    }
+skip_optional_pos:
+    return_value = ring_new_impl(type, entries);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_recv__doc__,
+"recv($self, token, fd, nbytes, flags=0, /)\n"
+"--\n"
+"\n"
+"Queue a receive of at most nbytes from the socket fd.\n"
+"\n"
+"Return the slot of the operation.  Its completion is returned by wait()\n"
+"with the received bytes.");
+
+#define _URING_RING_RECV_METHODDEF    \
+    {"recv", _PyCFunction_CAST(_uring_Ring_recv), METH_FASTCALL, _uring_Ring_recv__doc__},
+
+static PyObject *
+_uring_Ring_recv_impl(RingObject *self, PyObject *token, int fd,
+                      Py_ssize_t nbytes, int flags);
+
+static PyObject *
+_uring_Ring_recv(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    Py_ssize_t nbytes;
+    int flags = 0;
+
+    if (!_PyArg_CheckPositional("recv", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        nbytes = ival;
+    }
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    flags = PyLong_AsInt(args[3]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_recv_impl((RingObject *)self, token, fd, nbytes, flags);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_recv_into__doc__,
+"recv_into($self, token, fd, buffer, flags=0, /)\n"
+"--\n"
+"\n"
+"Queue a receive from the socket fd into a writable buffer.");
+
+#define _URING_RING_RECV_INTO_METHODDEF    \
+    {"recv_into", _PyCFunction_CAST(_uring_Ring_recv_into), METH_FASTCALL, _uring_Ring_recv_into__doc__},
+
+static PyObject *
+_uring_Ring_recv_into_impl(RingObject *self, PyObject *token, int fd,
+                           PyObject *buffer, int flags);
+
+static PyObject *
+_uring_Ring_recv_into(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *buffer;
+    int flags = 0;
+
+    if (!_PyArg_CheckPositional("recv_into", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    buffer = args[2];
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    flags = PyLong_AsInt(args[3]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_recv_into_impl((RingObject *)self, token, fd, buffer, flags);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_read__doc__,
+"read($self, token, fd, nbytes, /)\n"
+"--\n"
+"\n"
+"Queue a read of at most nbytes from fd, such as a pipe.");
+
+#define _URING_RING_READ_METHODDEF    \
+    {"read", _PyCFunction_CAST(_uring_Ring_read), METH_FASTCALL, _uring_Ring_read__doc__},
+
+static PyObject *
+_uring_Ring_read_impl(RingObject *self, PyObject *token, int fd,
+                      Py_ssize_t nbytes);
+
+static PyObject *
+_uring_Ring_read(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    Py_ssize_t nbytes;
+
+    if (!_PyArg_CheckPositional("read", nargs, 3, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        nbytes = ival;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_read_impl((RingObject *)self, token, fd, nbytes);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_read_into__doc__,
+"read_into($self, token, fd, buffer, /)\n"
+"--\n"
+"\n"
+"Queue a read from fd into a writable buffer.");
+
+#define _URING_RING_READ_INTO_METHODDEF    \
+    {"read_into", _PyCFunction_CAST(_uring_Ring_read_into), METH_FASTCALL, _uring_Ring_read_into__doc__},
+
+static PyObject *
+_uring_Ring_read_into_impl(RingObject *self, PyObject *token, int fd,
+                           PyObject *buffer);
+
+static PyObject *
+_uring_Ring_read_into(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *buffer;
+
+    if (!_PyArg_CheckPositional("read_into", nargs, 3, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    buffer = args[2];
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_read_into_impl((RingObject *)self, token, fd, buffer);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_send__doc__,
+"send($self, token, fd, buffer, flags=0, /)\n"
+"--\n"
+"\n"
+"Queue a send of a buffer to the socket fd.\n"
+"\n"
+"The result is the number of bytes sent, which can be less than the\n"
+"size of the buffer.");
+
+#define _URING_RING_SEND_METHODDEF    \
+    {"send", _PyCFunction_CAST(_uring_Ring_send), METH_FASTCALL, _uring_Ring_send__doc__},
+
+static PyObject *
+_uring_Ring_send_impl(RingObject *self, PyObject *token, int fd,
+                      PyObject *buffer, int flags);
+
+static PyObject *
+_uring_Ring_send(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *buffer;
+    int flags = 0;
+
+    if (!_PyArg_CheckPositional("send", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    buffer = args[2];
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    flags = PyLong_AsInt(args[3]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_send_impl((RingObject *)self, token, fd, buffer, flags);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_write__doc__,
+"write($self, token, fd, buffer, /)\n"
+"--\n"
+"\n"
+"Queue a write of a buffer to fd, such as a pipe.");
+
+#define _URING_RING_WRITE_METHODDEF    \
+    {"write", _PyCFunction_CAST(_uring_Ring_write), METH_FASTCALL, _uring_Ring_write__doc__},
+
+static PyObject *
+_uring_Ring_write_impl(RingObject *self, PyObject *token, int fd,
+                       PyObject *buffer);
+
+static PyObject *
+_uring_Ring_write(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *buffer;
+
+    if (!_PyArg_CheckPositional("write", nargs, 3, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    buffer = args[2];
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_write_impl((RingObject *)self, token, fd, buffer);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_accept__doc__,
+"accept($self, token, fd, multishot=False, /)\n"
+"--\n"
+"\n"
+"Queue an accept on the listening socket fd.\n"
+"\n"
+"The result is the file descriptor of the new connection, which is\n"
+"non-blocking and close-on-exec.  A multishot accept completes once for\n"
+"every connection until it is cancelled or fails; raise\n"
+"NotImplementedError if it is not supported.");
+
+#define _URING_RING_ACCEPT_METHODDEF    \
+    {"accept", _PyCFunction_CAST(_uring_Ring_accept), METH_FASTCALL, _uring_Ring_accept__doc__},
+
+static PyObject *
+_uring_Ring_accept_impl(RingObject *self, PyObject *token, int fd,
+                        int multishot);
+
+static PyObject *
+_uring_Ring_accept(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    int multishot = 0;
+
+    if (!_PyArg_CheckPositional("accept", nargs, 2, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    if (nargs < 3) {
+        goto skip_optional;
+    }
+    multishot = PyObject_IsTrue(args[2]);
+    if (multishot < 0) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_accept_impl((RingObject *)self, token, fd, multishot);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_recv_multishot__doc__,
+"recv_multishot($self, token, fd, /)\n"
+"--\n"
+"\n"
+"Queue a multishot receive from the socket fd.\n"
+"\n"
+"It completes with the received bytes every time data arrives, until it\n"
+"is cancelled, the peer shuts down the connection (an empty result), or\n"
+"it fails.  It fails with ENOBUFS if the data is received faster than\n"
+"the completions are waited for.  Raise NotImplementedError if multishot\n"
+"receives are not supported.");
+
+#define _URING_RING_RECV_MULTISHOT_METHODDEF    \
+    {"recv_multishot", _PyCFunction_CAST(_uring_Ring_recv_multishot), METH_FASTCALL, _uring_Ring_recv_multishot__doc__},
+
+static PyObject *
+_uring_Ring_recv_multishot_impl(RingObject *self, PyObject *token, int fd);
+
+static PyObject *
+_uring_Ring_recv_multishot(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+
+    if (!_PyArg_CheckPositional("recv_multishot", nargs, 2, 2)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_recv_multishot_impl((RingObject *)self, token, fd);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_poll__doc__,
+"poll($self, token, fd, events, /)\n"
+"--\n"
+"\n"
+"Queue a wait until fd is ready for the poll() events.\n"
+"\n"
+"The result is the mask of the events that occurred.");
+
+#define _URING_RING_POLL_METHODDEF    \
+    {"poll", _PyCFunction_CAST(_uring_Ring_poll), METH_FASTCALL, _uring_Ring_poll__doc__},
+
+static PyObject *
+_uring_Ring_poll_impl(RingObject *self, PyObject *token, int fd,
+                      unsigned int events);
+
+static PyObject *
+_uring_Ring_poll(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    unsigned int events;
+
+    if (!_PyArg_CheckPositional("poll", nargs, 3, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    {
+        Py_ssize_t _bytes = PyLong_AsNativeBytes(args[2], &events, sizeof(unsigned int),
+                Py_ASNATIVEBYTES_NATIVE_ENDIAN |
+                Py_ASNATIVEBYTES_ALLOW_INDEX |
+                Py_ASNATIVEBYTES_UNSIGNED_BUFFER);
+        if (_bytes < 0) {
+            goto exit;
+        }
+        if ((size_t)_bytes > sizeof(unsigned int)) {
+            if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                "integer value out of range", 1) < 0)
+            {
+                goto exit;
+            }
+        }
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_poll_impl((RingObject *)self, token, fd, events);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_cancel__doc__,
+"cancel($self, slot, /)\n"
+"--\n"
+"\n"
+"Queue the cancellation of the operation in slot.\n"
+"\n"
+"The operation still completes, usually with ECANCELED.");
+
+#define _URING_RING_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_uring_Ring_cancel, METH_O, _uring_Ring_cancel__doc__},
+
+static PyObject *
+_uring_Ring_cancel_impl(RingObject *self, Py_ssize_t slot);
+
+static PyObject *
+_uring_Ring_cancel(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t slot;
+
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(arg);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        slot = ival;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_cancel_impl((RingObject *)self, slot);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_cancel_fd__doc__,
+"cancel_fd($self, fd, /)\n"
+"--\n"
+"\n"
+"Queue the cancellation of all operations on fd.\n"
+"\n"
+"Raise NotImplementedError if it is not supported.");
+
+#define _URING_RING_CANCEL_FD_METHODDEF    \
+    {"cancel_fd", (PyCFunction)_uring_Ring_cancel_fd, METH_O, _uring_Ring_cancel_fd__doc__},
+
+static PyObject *
+_uring_Ring_cancel_fd_impl(RingObject *self, int fd);
+
+static PyObject *
+_uring_Ring_cancel_fd(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int fd;
+
+    fd = PyLong_AsInt(arg);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_cancel_fd_impl((RingObject *)self, fd);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_submit__doc__,
+"submit($self, /)\n"
+"--\n"
+"\n"
+"Submit the queued operations without waiting.\n"
+"\n"
+"Return the number of operations submitted.");
+
+#define _URING_RING_SUBMIT_METHODDEF    \
+    {"submit", (PyCFunction)_uring_Ring_submit, METH_NOARGS, _uring_Ring_submit__doc__},
+
+static PyObject *
+_uring_Ring_submit_impl(RingObject *self);
+
+static PyObject *
+_uring_Ring_submit(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_submit_impl((RingObject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_wait__doc__,
+"wait($self, timeout=None, /)\n"
+"--\n"
+"\n"
+"Submit the queued operations and wait for completions.\n"
+"\n"
+"Wait at most timeout seconds, or forever if timeout is None, for at\n"
+"least one operation to complete.  Return a list of the completions\n"
+"as tuples (token, result, more, data):\n"
+"\n"
+"- result is the result of the system call, or a negative errno value;\n"
+"- more is true if a multishot operation will complete again;\n"
+"- data is the received bytes, or None.");
+
+#define _URING_RING_WAIT_METHODDEF    \
+    {"wait", _PyCFunction_CAST(_uring_Ring_wait), METH_FASTCALL, _uring_Ring_wait__doc__},
+
+static PyObject *
+_uring_Ring_wait_impl(RingObject *self, PyObject *timeout);
+
+static PyObject *
+_uring_Ring_wait(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *timeout = Py_None;
+
+    if (!_PyArg_CheckPositional("wait", nargs, 0, 1)) {
+        goto exit;
+    }
+    if (nargs < 1) {
+        goto skip_optional;
+    }
+    timeout = args[0];
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_wait_impl((RingObject *)self, timeout);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_close__doc__,
+"close($self, /)\n"
+"--\n"
+"\n"
+"Close the ring.\n"
+"\n"
+"The buffers of operations that are still pending are never released,\n"
+"since the kernel could still use them.");
+
+#define _URING_RING_CLOSE_METHODDEF    \
+    {"close", (PyCFunction)_uring_Ring_close, METH_NOARGS, _uring_Ring_close__doc__},
+
+static PyObject *
+_uring_Ring_close_impl(RingObject *self);
+
+static PyObject *
+_uring_Ring_close(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_close_impl((RingObject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_uring_Ring_fileno__doc__,
+"fileno($self, /)\n"
+"--\n"
+"\n"
+"Return the file descriptor of the ring.");
+
+#define _URING_RING_FILENO_METHODDEF    \
+    {"fileno", (PyCFunction)_uring_Ring_fileno, METH_NOARGS, _uring_Ring_fileno__doc__},
+
+static PyObject *
+_uring_Ring_fileno_impl(RingObject *self);
+
+static PyObject *
+_uring_Ring_fileno(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _uring_Ring_fileno_impl((RingObject *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+/*[clinic end generated code: output=643eb011d787d4bb input=a9049054013a1b77]*/
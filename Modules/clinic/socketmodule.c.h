@@ -29,6 +29,88 @@ _socket_socket_close(PyObject *s, PyObject *Py_UNUSED(ignored))
     return _socket_socket_close_impl((PySocketSockObject *)s);
 }
 
+#if defined(HAVE_RECVMMSG)
+
+PyDoc_STRVAR(_socket_socket_recvmmsg_into__doc__,
+"recvmmsg_into($self, buffers, flags=0, /)\n"
+"--\n"
+"\n"
+"Receive several datagrams with a single system call.\n"
+"\n"
+"Each datagram is received into one of the buffers, which must be an\n"
+"iterable of objects that export writable buffers (e.g. bytearray\n"
+"objects): the first datagram into the first buffer, and so on.  A\n"
+"datagram which does not fit into its buffer is truncated.  Wait for\n"
+"the first datagram as recvfrom_into() does, then only receive the\n"
+"datagrams which are already queued.  The flags argument defaults to 0\n"
+"and has the same meaning as for recv().\n"
+"\n"
+"Return a list of (nbytes, address) tuples, one for each datagram\n"
+"received, in the order of the buffers.");
+
+#define _SOCKET_SOCKET_RECVMMSG_INTO_METHODDEF    \
+    {"recvmmsg_into", _PyCFunction_CAST(_socket_socket_recvmmsg_into), METH_FASTCALL, _socket_socket_recvmmsg_into__doc__},
+
+static PyObject *
+_socket_socket_recvmmsg_into_impl(PySocketSockObject *s,
+                                  PyObject *buffers_arg, int flags);
+
+static PyObject *
+_socket_socket_recvmmsg_into(PyObject *s, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *buffers_arg;
+    int flags = 0;
+
+    if (!_PyArg_CheckPositional("recvmmsg_into", nargs, 1, 2)) {
+        goto exit;
+    }
+    buffers_arg = args[0];
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    flags = PyLong_AsInt(args[1]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    return_value = _socket_socket_recvmmsg_into_impl((PySocketSockObject *)s, buffers_arg, flags);
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_RECVMMSG) */
+
+#if defined(SO_EE_ORIGIN_ZEROCOPY)
+
+PyDoc_STRVAR(_socket_socket_recv_zerocopy_completions__doc__,
+"recv_zerocopy_completions($self, /)\n"
+"--\n"
+"\n"
+"Read the completion notifications of MSG_ZEROCOPY sends.\n"
+"\n"
+"Drain the socket error queue without blocking and return a list of\n"
+"(first, last, copied) tuples.  Each tuple reports that the sends with\n"
+"sequence numbers first to last inclusive have completed, so their\n"
+"buffers may be reused; the first MSG_ZEROCOPY send on a socket has the\n"
+"sequence number 0.  copied is true if the kernel fell back to copying\n"
+"the data.  Other messages in the error queue are discarded.");
+
+#define _SOCKET_SOCKET_RECV_ZEROCOPY_COMPLETIONS_METHODDEF    \
+    {"recv_zerocopy_completions", (PyCFunction)_socket_socket_recv_zerocopy_completions, METH_NOARGS, _socket_socket_recv_zerocopy_completions__doc__},
+
+static PyObject *
+_socket_socket_recv_zerocopy_completions_impl(PySocketSockObject *s);
+
+static PyObject *
+_socket_socket_recv_zerocopy_completions(PyObject *s, PyObject *Py_UNUSED(ignored))
+{
+    return _socket_socket_recv_zerocopy_completions_impl((PySocketSockObject *)s);
+}
+
+#endif /* defined(SO_EE_ORIGIN_ZEROCOPY) */
+
 PyDoc_STRVAR(_socket_socket_send__doc__,
 "send($self, data, flags=0, /)\n"
 "--\n"
@@ -125,6 +207,57 @@ exit:
     return return_value;
 }
 
+#if defined(HAVE_SENDMMSG)
+
+PyDoc_STRVAR(_socket_socket_sendmmsg__doc__,
+"sendmmsg($self, messages, flags=0, /)\n"
+"--\n"
+"\n"
+"Send several datagrams with a single system call.\n"
+"\n"
+"The messages argument is an iterable of (data, address) pairs, where\n"
+"data is a bytes-like object and address is the destination address,\n"
+"or None to send to the address the socket is connected to.  The flags\n"
+"argument defaults to 0 and has the same meaning as for send().\n"
+"\n"
+"Return the number of datagrams sent, which may be less than the\n"
+"number of messages.  An exception is only raised if the first\n"
+"datagram cannot be sent.");
+
+#define _SOCKET_SOCKET_SENDMMSG_METHODDEF    \
+    {"sendmmsg", _PyCFunction_CAST(_socket_socket_sendmmsg), METH_FASTCALL, _socket_socket_sendmmsg__doc__},
+
+static PyObject *
+_socket_socket_sendmmsg_impl(PySocketSockObject *s, PyObject *messages_arg,
+                             int flags);
+
+static PyObject *
+_socket_socket_sendmmsg(PyObject *s, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *messages_arg;
+    int flags = 0;
+
+    if (!_PyArg_CheckPositional("sendmmsg", nargs, 1, 2)) {
+        goto exit;
+    }
+    messages_arg = args[0];
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    flags = PyLong_AsInt(args[1]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    return_value = _socket_socket_sendmmsg_impl((PySocketSockObject *)s, messages_arg, flags);
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_SENDMMSG) */
+
 #if defined(CMSG_LEN)
 
 PyDoc_STRVAR(_socket_socket_sendmsg__doc__,
@@ -523,6 +656,18 @@ exit:
 
 #endif /* (defined(HAVE_IF_NAMEINDEX) || defined(MS_WINDOWS)) */
 
+#ifndef _SOCKET_SOCKET_RECVMMSG_INTO_METHODDEF
+    #define _SOCKET_SOCKET_RECVMMSG_INTO_METHODDEF
+#endif /* !defined(_SOCKET_SOCKET_RECVMMSG_INTO_METHODDEF) */
+
+#ifndef _SOCKET_SOCKET_RECV_ZEROCOPY_COMPLETIONS_METHODDEF
+    #define _SOCKET_SOCKET_RECV_ZEROCOPY_COMPLETIONS_METHODDEF
+#endif /* !defined(_SOCKET_SOCKET_RECV_ZEROCOPY_COMPLETIONS_METHODDEF) */
+
+#ifndef _SOCKET_SOCKET_SENDMMSG_METHODDEF
+    #define _SOCKET_SOCKET_SENDMMSG_METHODDEF
+#endif /* !defined(_SOCKET_SOCKET_SENDMMSG_METHODDEF) */
+
 #ifndef _SOCKET_SOCKET_SENDMSG_METHODDEF
     #define _SOCKET_SOCKET_SENDMSG_METHODDEF
 #endif /* !defined(_SOCKET_SOCKET_SENDMSG_METHODDEF) */
@@ -538,4 +683,4 @@ exit:
 #ifndef _SOCKET_IF_INDEXTONAME_METHODDEF
     #define _SOCKET_IF_INDEXTONAME_METHODDEF
 #endif /* !defined(_SOCKET_IF_INDEXTONAME_METHODDEF) */
-/*[clinic end generated code: output=0376c46b76ae2bce input=a9049054013a1b77]*/
+/*[clinic end generated code: output=e2ceda8c295e8288 input=a9049054013a1b77]*/
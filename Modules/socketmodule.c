@@ -4239,6 +4239,150 @@ PyDoc_STRVAR(recvfrom_into_doc,
 Like recv_into(buffer[, nbytes[, flags]]) but also return the sender's address info.");
 #endif
 
+#ifdef HAVE_RECVMMSG
+struct sock_recvmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_recvmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_recvmmsg *ctx = data;
+
+    ctx->result = recvmmsg(get_sock_fd(s), ctx->msgvec, ctx->vlen,
+                           ctx->flags, NULL);
+    return (ctx->result >= 0);
+}
+
+/*[clinic input]
+_socket.socket.recvmmsg_into
+    self as s: self(type="PySocketSockObject *")
+    buffers as buffers_arg: object
+    flags: int = 0
+    /
+
+Receive several datagrams with a single system call.
+
+Each datagram is received into one of the buffers, which must be an
+iterable of objects that export writable buffers (e.g. bytearray
+objects): the first datagram into the first buffer, and so on.  A
+datagram which does not fit into its buffer is truncated.  Wait for
+the first datagram as recvfrom_into() does, then only receive the
+datagrams which are already queued.  The flags argument defaults to 0
+and has the same meaning as for recv().
+
+Return a list of (nbytes, address) tuples, one for each datagram
+received, in the order of the buffers.
+[clinic start generated code]*/
+
+static PyObject *
+_socket_socket_recvmmsg_into_impl(PySocketSockObject *s,
+                                  PyObject *buffers_arg, int flags)
+/*[clinic end generated code: output=020b90ce0091b16f input=24d2466257b994a1]*/
+{
+    Py_ssize_t i, nitems, nbufs = 0;
+    struct mmsghdr *msgvec = NULL;
+    struct iovec *iovs = NULL;
+    sock_addr_t *addrbufs = NULL;
+    Py_buffer *bufs = NULL;
+    socklen_t addrbuflen;
+    PyObject *fast, *retval = NULL;
+    struct sock_recvmmsg ctx;
+
+    if (!getsockaddrlen(s, &addrbuflen))
+        return NULL;
+
+    if ((fast = PySequence_Fast(buffers_arg,
+                                "recvmmsg_into() argument 1 must be an "
+                                "iterable")) == NULL)
+        return NULL;
+    nitems = PySequence_Fast_GET_SIZE(fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError,
+                        "recvmmsg_into() argument 1 is too long");
+        goto finally;
+    }
+    if (nitems == 0) {
+        retval = PyList_New(0);
+        goto finally;
+    }
+
+    /* Fill in a message header with one iovec and an address buffer for
+       each item, and save the Py_buffer structs to release afterwards. */
+    if ((msgvec = PyMem_New(struct mmsghdr, nitems)) == NULL ||
+        (iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+        (addrbufs = PyMem_New(sock_addr_t, nitems)) == NULL ||
+        (bufs = PyMem_New(Py_buffer, nitems)) == NULL)
+    {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    memset(msgvec, 0, nitems * sizeof(struct mmsghdr));
+    for (; nbufs < nitems; nbufs++) {
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, nbufs),
+                         "w*;recvmmsg_into() argument 1 must be an iterable "
+                         "of single-segment read-write buffers",
+                         &bufs[nbufs]))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+        memset(&addrbufs[nbufs], 0, addrbuflen);
+        SAS2SA(&addrbufs[nbufs])->sa_family = AF_UNSPEC;
+        msgvec[nbufs].msg_hdr.msg_name = SAS2SA(&addrbufs[nbufs]);
+        msgvec[nbufs].msg_hdr.msg_namelen = addrbuflen;
+        msgvec[nbufs].msg_hdr.msg_iov = &iovs[nbufs];
+        msgvec[nbufs].msg_hdr.msg_iovlen = 1;
+    }
+
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+#ifdef MSG_WAITFORONE
+    /* Only block until the first datagram is received. */
+    ctx.flags |= MSG_WAITFORONE;
+#endif
+    if (sock_call(s, 0, sock_recvmmsg_impl, &ctx) < 0)
+        goto finally;
+
+    if ((retval = PyList_New(ctx.result)) == NULL)
+        goto finally;
+    for (i = 0; i < ctx.result; i++) {
+        PyObject *addr, *item;
+
+        addr = makesockaddr(get_sock_fd(s), SAS2SA(&addrbufs[i]),
+                            msgvec[i].msg_hdr.msg_namelen, s->sock_proto);
+        if (addr == NULL) {
+            Py_CLEAR(retval);
+            goto finally;
+        }
+        item = Py_BuildValue("IN", msgvec[i].msg_len, addr);
+        if (item == NULL) {
+            Py_CLEAR(retval);
+            goto finally;
+        }
+        PyList_SET_ITEM(retval, i, item);
+    }
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(addrbufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    Py_DECREF(fast);
+    return retval;
+}
+#endif    /* HAVE_RECVMMSG */
+
 /* The sendmsg() and recvmsg[_into]() methods require a working
    CMSG_LEN().  See the comment near get_CMSG_LEN(). */
 #ifdef CMSG_LEN
@@ -4569,6 +4713,92 @@ it will first attempt to close any file descriptors received via the\n\
 SCM_RIGHTS mechanism.");
 #endif    /* CMSG_LEN */
 
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+/*[clinic input]
+_socket.socket.recv_zerocopy_completions
+    self as s: self(type="PySocketSockObject *")
+
+Read the completion notifications of MSG_ZEROCOPY sends.
+
+Drain the socket error queue without blocking and return a list of
+(first, last, copied) tuples.  Each tuple reports that the sends with
+sequence numbers first to last inclusive have completed, so their
+buffers may be reused; the first MSG_ZEROCOPY send on a socket has the
+sequence number 0.  copied is true if the kernel fell back to copying
+the data.  Other messages in the error queue are discarded.
+[clinic start generated code]*/
+
+static PyObject *
+_socket_socket_recv_zerocopy_completions_impl(PySocketSockObject *s)
+/*[clinic end generated code: output=24e603d2f54f047b input=ecbe768182b68135]*/
+{
+    PyObject *retval, *item;
+    struct msghdr msg;
+    struct cmsghdr *cmsgh;
+    struct sock_extended_err ee;
+    ssize_t n;
+    /* The IP_RECVERR and IPV6_RECVERR control messages hold a struct
+       sock_extended_err followed by the address of the offender. */
+    union {
+        char buf[CMSG_SPACE(sizeof(struct sock_extended_err) +
+                            sizeof(sock_addr_t))];
+        struct cmsghdr align;
+    } control;
+
+    if ((retval = PyList_New(0)) == NULL)
+        return NULL;
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        Py_BEGIN_ALLOW_THREADS
+        n = recvmsg(get_sock_fd(s), &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        Py_END_ALLOW_THREADS
+        if (n < 0) {
+            if (errno == EINTR) {
+                if (PyErr_CheckSignals())
+                    goto error;
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            s->errorhandler();
+            goto error;
+        }
+        for (cmsgh = CMSG_FIRSTHDR(&msg); cmsgh != NULL;
+             cmsgh = CMSG_NXTHDR(&msg, cmsgh)) {
+            if (!((cmsgh->cmsg_level == SOL_IP &&
+                   cmsgh->cmsg_type == IP_RECVERR)
+#ifdef IPV6_RECVERR
+                  || (cmsgh->cmsg_level == SOL_IPV6 &&
+                      cmsgh->cmsg_type == IPV6_RECVERR)
+#endif
+                  ) ||
+                cmsgh->cmsg_len < CMSG_LEN(sizeof(ee)))
+                continue;
+            memcpy(&ee, CMSG_DATA(cmsgh), sizeof(ee));
+            if (ee.ee_origin != SO_EE_ORIGIN_ZEROCOPY || ee.ee_errno != 0)
+                continue;
+            item = Py_BuildValue("IIO", ee.ee_info, ee.ee_data,
+                                 (ee.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) ?
+                                 Py_True : Py_False);
+            if (item == NULL)
+                goto error;
+            if (PyList_Append(retval, item) < 0) {
+                Py_DECREF(item);
+                goto error;
+            }
+            Py_DECREF(item);
+        }
+    }
+    return retval;
+
+error:
+    Py_DECREF(retval);
+    return NULL;
+}
+#endif    /* SO_EE_ORIGIN_ZEROCOPY */
+
 
 struct sock_send {
     char *buf;
@@ -4801,6 +5031,133 @@ Like send(data, flags) but allows specifying the destination address.\n\
 For IP sockets, the address is a pair (hostaddr, port).");
 #endif
 
+#ifdef HAVE_SENDMMSG
+struct sock_sendmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_sendmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_sendmmsg *ctx = data;
+
+    ctx->result = sendmmsg(get_sock_fd(s), ctx->msgvec, ctx->vlen,
+                           ctx->flags);
+    return (ctx->result >= 0);
+}
+
+/*[clinic input]
+_socket.socket.sendmmsg
+    self as s: self(type="PySocketSockObject *")
+    messages as messages_arg: object
+    flags: int = 0
+    /
+
+Send several datagrams with a single system call.
+
+The messages argument is an iterable of (data, address) pairs, where
+data is a bytes-like object and address is the destination address,
+or None to send to the address the socket is connected to.  The flags
+argument defaults to 0 and has the same meaning as for send().
+
+Return the number of datagrams sent, which may be less than the
+number of messages.  An exception is only raised if the first
+datagram cannot be sent.
+[clinic start generated code]*/
+
+static PyObject *
+_socket_socket_sendmmsg_impl(PySocketSockObject *s, PyObject *messages_arg,
+                             int flags)
+/*[clinic end generated code: output=6f175d2898d4d3d3 input=0284122bb12bb21d]*/
+{
+    Py_ssize_t i, nitems, nbufs = 0;
+    struct mmsghdr *msgvec = NULL;
+    struct iovec *iovs = NULL;
+    sock_addr_t *addrbufs = NULL;
+    Py_buffer *bufs = NULL;
+    PyObject *fast, *retval = NULL;
+    struct sock_sendmmsg ctx;
+
+    if ((fast = PySequence_Fast(messages_arg,
+                                "sendmmsg() argument 1 must be an "
+                                "iterable")) == NULL)
+        return NULL;
+    nitems = PySequence_Fast_GET_SIZE(fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError, "sendmmsg() argument 1 is too long");
+        goto finally;
+    }
+    if (nitems == 0) {
+        retval = PyLong_FromLong(0);
+        goto finally;
+    }
+
+    if ((msgvec = PyMem_New(struct mmsghdr, nitems)) == NULL ||
+        (iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+        (addrbufs = PyMem_New(sock_addr_t, nitems)) == NULL ||
+        (bufs = PyMem_New(Py_buffer, nitems)) == NULL)
+    {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    memset(msgvec, 0, nitems * sizeof(struct mmsghdr));
+    for (; nbufs < nitems; nbufs++) {
+        PyObject *addr_arg;
+
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, nbufs),
+                         "(y*O):[sendmmsg() messages]",
+                         &bufs[nbufs], &addr_arg))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+        msgvec[nbufs].msg_hdr.msg_iov = &iovs[nbufs];
+        msgvec[nbufs].msg_hdr.msg_iovlen = 1;
+        if (addr_arg != Py_None) {
+            int addrlen;
+
+            if (!getsockaddrarg(s, addr_arg, &addrbufs[nbufs], &addrlen,
+                                "sendmmsg"))
+            {
+                nbufs++;
+                goto finally;
+            }
+            msgvec[nbufs].msg_hdr.msg_name = SAS2SA(&addrbufs[nbufs]);
+            msgvec[nbufs].msg_hdr.msg_namelen = addrlen;
+        }
+        if (PySys_Audit("socket.sendmsg", "OO", s, addr_arg) < 0) {
+            nbufs++;
+            goto finally;
+        }
+    }
+
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+    if (sock_call(s, 1, sock_sendmmsg_impl, &ctx) < 0)
+        goto finally;
+
+    retval = PyLong_FromLong(ctx.result);
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(addrbufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    Py_DECREF(fast);
+    return retval;
+}
+#endif    /* HAVE_SENDMMSG */
+
 
 /* The sendmsg() and recvmsg[_into]() methods require a working
    CMSG_LEN().  See the comment near get_CMSG_LEN(). */
@@ -5424,6 +5781,12 @@ static PyMethodDef sock_methods[] = {
     _SOCKET_SOCKET_SENDALL_METHODDEF
 #ifdef HAVE_SENDTO
     {"sendto", sock_sendto, METH_VARARGS, sendto_doc},
+#endif
+#ifdef HAVE_RECVMMSG
+    _SOCKET_SOCKET_RECVMMSG_INTO_METHODDEF
+#endif
+#ifdef HAVE_SENDMMSG
+    _SOCKET_SOCKET_SENDMMSG_METHODDEF
 #endif
     {"setblocking", sock_setblocking, METH_O, setblocking_doc},
     {"getblocking", sock_getblocking, METH_NOARGS, getblocking_doc},
@@ -5443,6 +5806,9 @@ static PyMethodDef sock_methods[] = {
     {"recvmsg_into", sock_recvmsg_into, METH_VARARGS, recvmsg_into_doc},
     _SOCKET_SOCKET_SENDMSG_METHODDEF
 #endif
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+    _SOCKET_SOCKET_RECV_ZEROCOPY_COMPLETIONS_METHODDEF
+#endif
 #ifdef HAVE_SOCKADDR_ALG
     {
         "sendmsg_afalg",
@@ -8274,6 +8640,13 @@ socket_exec(PyObject *m)
 #ifdef SO_PROTOCOL
     ADD_INT_MACRO(m, SO_PROTOCOL);
 #endif
+#ifdef SO_ZEROCOPY
+    ADD_INT_MACRO(m, SO_ZEROCOPY);
+#endif
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+    ADD_INT_MACRO(m, SO_EE_ORIGIN_ZEROCOPY);
+    ADD_INT_MACRO(m, SO_EE_CODE_ZEROCOPY_COPIED);
+#endif
 #ifdef LOCAL_CREDS
     ADD_INT_MACRO(m, LOCAL_CREDS);
 #endif
@@ -8367,6 +8740,9 @@ socket_exec(PyObject *m)
 #ifdef MSG_FASTOPEN
     ADD_INT_MACRO(m, MSG_FASTOPEN);
 #endif
+#ifdef MSG_ZEROCOPY
+    ADD_INT_MACRO(m, MSG_ZEROCOPY);
+#endif
 
     /* Protocol level and numbers, usable for [gs]etsockopt */
 #ifdef  SOL_SOCKET
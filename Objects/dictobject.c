@@ -47,6 +47,30 @@ PyDictUnicodeEntry otherwise. Its length is USABLE_FRACTION(dk_size).
 NOTE: Since negative value is used for DKIX_EMPTY and DKIX_DUMMY, type of
 dk_indices entry is signed integer and int16 is used for table which
 dk_size == 256.
+
+Tables with 2**16 <= dk_size <= 2**24 use int32 indices, but an index in
+entries never needs more than 24 bits.  For these tables the 7 bits above
+the index hold a tag: the top 7 bits of the key's hash (see DK_HASH_TAG).
+Lookups compare the tag before reading the entry, so a probe that hits an
+active slot of a different key usually costs no access to dk_entries,
+which is the cache miss that dominates lookups in large tables.
+dictkeys_get_index() strips the tag; only do_lookup() looks at it.
+
+Tables with dk_size >= 2**DK_GROW_MIN_LOG_SIZE are allocated with calloc(),
+so that the zeroed entries are mapped lazily, and are preceded by a
+dictkeys_growth.  Rebuilding such a table in one go when it is full stalls
+the insertion that triggers the resize for hundreds of milliseconds once
+it holds millions of entries.  Instead, when a table of at least
+2**interp->dict_state.grow_log_size slots with few deleted entries is
+nearly full, the next table is allocated and each of the following
+insertions initializes part of its indices, then copies some entries and
+indexes them (see dictkeys_grow_step()).  Entries keep their index in the
+next table, and replacing the value of an entry or deleting it updates its
+copy (see dictkeys_grow_update()), so when the table is full dictresize()
+only has to index the entries added by the last insertions and switch the
+tables.  The next table is only seen by the thread holding the dict's
+lock, so lookups are not affected.  STORE_ATTR_WITH_HINT does not
+specialize for these tables, since it modifies entries in place.
 */
 
 
@@ -495,11 +519,54 @@ dictkeys_get_index(const PyDictKeysObject *keys, Py_ssize_t i)
 #endif
     else {
         ix = LOAD_INDEX(keys, 32, i);
+        if (ix > 0) {
+            /* Strip the tag, if any. */
+            ix &= ((Py_ssize_t)1 << log2size) - 1;
+        }
     }
     assert(ix >= DKIX_DUMMY);
     return ix;
 }
 
+/* Tagged indices (see the comment at the top of this file). */
+#define DK_TAG_MIN_LOG_SIZE 16
+#define DK_TAG_MAX_LOG_SIZE 24
+#define DK_TAG_SHIFT 24
+#define DK_TAG_MASK ((int32_t)0x7f << DK_TAG_SHIFT)
+#define DK_HASH_TAG(hash) \
+    ((int32_t)((size_t)(hash) >> (8 * SIZEOF_SIZE_T - 7)) << DK_TAG_SHIFT)
+
+static inline int
+dictkeys_is_tagged(const PyDictKeysObject *keys)
+{
+    return (DK_TAG_MIN_LOG_SIZE <= DK_LOG_SIZE(keys) &&
+            DK_LOG_SIZE(keys) <= DK_TAG_MAX_LOG_SIZE);
+}
+
+/* Incremental growth of large tables (see the comment at the top of this
+   file).  The next table is allocated when at most 1/DK_GROW_START of the
+   usable entries are left, and each insertion then initializes
+   DK_GROW_INDEX_BYTES bytes of its indices or copies DK_GROW_STEP entries.
+   That is done well before the table is full. */
+#define DK_GROW_START 4
+#define DK_GROW_INDEX_BYTES 1024
+#define DK_GROW_STEP 8
+
+typedef struct {
+    PyDictKeysObject *dg_keys;  /* the next table, or NULL */
+    size_t dg_index_bytes;      /* bytes of dg_keys indices initialized */
+    Py_ssize_t dg_nentries;     /* entries copied to dg_keys */
+} dictkeys_growth;
+
+static inline int
+dictkeys_can_grow(const PyDictKeysObject *keys)
+{
+    return DK_LOG_SIZE(keys) >= DK_GROW_MIN_LOG_SIZE;
+}
+
+#define DK_GROWTH(keys) (assert(dictkeys_can_grow(keys)), \
+                         (dictkeys_growth *)(keys) - 1)
+
 /* write to indices. */
 static inline void
 dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
@@ -528,6 +595,22 @@ dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
     }
 }
 
+/* write an active slot for a key with the given hash to indices. */
+static inline void
+dictkeys_set_hashed_index(PyDictKeysObject *keys, Py_ssize_t i,
+                          Py_ssize_t ix, Py_hash_t hash)
+{
+    assert(ix >= 0);
+    if (dictkeys_is_tagged(keys)) {
+        assert(keys->dk_version == 0);
+        assert(ix < ((Py_ssize_t)1 << DK_TAG_SHIFT));
+        STORE_INDEX(keys, 32, i, (int32_t)ix | DK_HASH_TAG(hash));
+    }
+    else {
+        dictkeys_set_index(keys, i, ix);
+    }
+}
+
 
 /* USABLE_FRACTION is the maximum dictionary load.
  * Increasing this ratio makes dictionaries more dense resulting in more
@@ -692,6 +775,13 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
         for (Py_ssize_t i=0; i < DK_SIZE(keys); i++) {
             Py_ssize_t ix = dictkeys_get_index(keys, i);
             CHECK(DKIX_DUMMY <= ix && ix <= usable);
+            if (ix >= 0 && dictkeys_is_tagged(keys)) {
+                Py_hash_t hash = DK_IS_UNICODE(keys)
+                    ? unicode_get_hash(DK_UNICODE_ENTRIES(keys)[ix].me_key)
+                    : DK_ENTRIES(keys)[ix].me_hash;
+                int32_t tagged = LOAD_INDEX(keys, 32, i);
+                CHECK((tagged & DK_TAG_MASK) == DK_HASH_TAG(hash));
+            }
         }
 
         if (keys->dk_kind == DICT_KEYS_GENERAL) {
@@ -752,8 +842,26 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
 }
 
 
+/* Allocate a keys object of size bytes, with room for a dictkeys_growth
+   before it if it is a large table. */
+static PyDictKeysObject *
+alloc_keys_memory(uint8_t log2_size, size_t size, bool zero)
+{
+    if (log2_size < DK_GROW_MIN_LOG_SIZE) {
+        return zero ? PyMem_Calloc(1, size) : PyMem_Malloc(size);
+    }
+    size += sizeof(dictkeys_growth);
+    dictkeys_growth *growth = zero ? PyMem_Calloc(1, size) : PyMem_Malloc(size);
+    if (growth == NULL) {
+        return NULL;
+    }
+    growth->dg_keys = NULL;
+    return (PyDictKeysObject *)(growth + 1);
+}
+
+/* Create a keys object whose indices are not initialized. */
 static PyDictKeysObject*
-new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
+alloc_keys_object(uint8_t log2_size, bool unicode)
 {
     Py_ssize_t usable;
     int log2_bytes;
@@ -782,14 +890,21 @@ new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
         dk = _Py_FREELIST_POP_MEM(dictkeys);
     }
     if (dk == NULL) {
-        dk = PyMem_Malloc(sizeof(PyDictKeysObject)
-                          + ((size_t)1 << log2_bytes)
-                          + entry_size * usable);
+        /* Large tables are zeroed by calloc(), which can map zeroed pages
+           on demand instead of clearing them all now. */
+        dk = alloc_keys_memory(log2_size,
+                               sizeof(PyDictKeysObject)
+                               + ((size_t)1 << log2_bytes)
+                               + entry_size * usable,
+                               log2_size >= DK_GROW_MIN_LOG_SIZE);
         if (dk == NULL) {
             PyErr_NoMemory();
             return NULL;
         }
     }
+    if (log2_size < DK_GROW_MIN_LOG_SIZE) {
+        memset(&dk->dk_indices[(size_t)1 << log2_bytes], 0, entry_size * usable);
+    }
 #ifdef Py_REF_DEBUG
     _Py_IncRefTotal(_PyThreadState_GET());
 #endif
@@ -803,17 +918,48 @@ new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
     dk->dk_nentries = 0;
     dk->dk_usable = usable;
     dk->dk_version = 0;
-    memset(&dk->dk_indices[0], 0xff, ((size_t)1 << log2_bytes));
-    memset(&dk->dk_indices[(size_t)1 << log2_bytes], 0, entry_size * usable);
     return dk;
 }
 
+static PyDictKeysObject*
+new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
+{
+    PyDictKeysObject *dk = alloc_keys_object(log2_size, unicode);
+    if (dk == NULL) {
+        return NULL;
+    }
+    memset(&dk->dk_indices[0], 0xff, ((size_t)1 << dk->dk_log2_index_bytes));
+    return dk;
+}
+
+/* Free the next table of keys, if any. */
+static void
+dictkeys_drop_growth(PyDictKeysObject *keys)
+{
+    dictkeys_growth *growth = DK_GROWTH(keys);
+    if (growth->dg_keys != NULL) {
+        /* The next table was never visible to other threads and its
+           entries do not own references. */
+#ifdef Py_REF_DEBUG
+        _Py_DecRefTotal(_PyThreadState_GET());
+#endif
+        free_keys_object(growth->dg_keys, false);
+        growth->dg_keys = NULL;
+    }
+}
+
 static void
 free_keys_object(PyDictKeysObject *keys, bool use_qsbr)
 {
+    void *mem = keys;
+    if (dictkeys_can_grow(keys)) {
+        dictkeys_drop_growth(keys);
+        mem = DK_GROWTH(keys);
+    }
 #ifdef Py_GIL_DISABLED
     if (use_qsbr) {
-        _PyMem_FreeDelayed(keys, _PyDict_KeysSize(keys));
+        size_t size = _PyDict_KeysSize(keys) + ((char *)keys - (char *)mem);
+        _PyMem_FreeDelayed(mem, size);
         return;
     }
 #endif
@@ -821,7 +967,7 @@ free_keys_object(PyDictKeysObject *keys, bool use_qsbr)
         _Py_FREELIST_FREE(dictkeys, keys, PyMem_Free);
     }
     else {
-        PyMem_Free(keys);
+        PyMem_Free(mem);
     }
 }
 
@@ -921,7 +1067,8 @@ clone_combined_dict_keys(PyDictObject *orig)
     ASSERT_DICT_LOCKED(orig);
 
     size_t keys_size = _PyDict_KeysSize(orig->ma_keys);
-    PyDictKeysObject *keys = PyMem_Malloc(keys_size);
+    PyDictKeysObject *keys = alloc_keys_memory(DK_LOG_SIZE(orig->ma_keys),
+                                               keys_size, false);
     if (keys == NULL) {
         PyErr_NoMemory();
         return NULL;
@@ -998,10 +1145,45 @@ lookdict_index(PyDictKeysObject *k, Py_hash_t hash, Py_ssize_t index)
     Py_UNREACHABLE();
 }
 
+/* Lookup in a table with tagged indices: slots whose tag differs from the
+   key's are skipped without reading their entry. */
+static inline Py_ALWAYS_INLINE Py_ssize_t
+do_lookup_tagged(PyDictObject *mp, PyDictKeysObject *dk, PyObject *key, Py_hash_t hash,
+                 int (*check_lookup)(PyDictObject *, PyDictKeysObject *, void *, Py_ssize_t ix, PyObject *key, Py_hash_t))
+{
+    void *ep0 = _DK_ENTRIES(dk);
+    size_t mask = DK_MASK(dk);
+    size_t perturb = hash;
+    size_t i = (size_t)hash & mask;
+    int32_t tag = DK_HASH_TAG(hash);
+    for (;;) {
+        int32_t ix = LOAD_INDEX(dk, 32, i);
+        if (ix >= 0) {
+            if ((ix & DK_TAG_MASK) == tag) {
+                int cmp = check_lookup(mp, dk, ep0, ix & ~DK_TAG_MASK, key, hash);
+                if (cmp < 0) {
+                    return cmp;
+                } else if (cmp) {
+                    return ix & ~DK_TAG_MASK;
+                }
+            }
+        }
+        else if (ix == DKIX_EMPTY) {
+            return DKIX_EMPTY;
+        }
+        perturb >>= PERTURB_SHIFT;
+        i = mask & (i*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 static inline Py_ALWAYS_INLINE Py_ssize_t
 do_lookup(PyDictObject *mp, PyDictKeysObject *dk, PyObject *key, Py_hash_t hash,
           int (*check_lookup)(PyDictObject *, PyDictKeysObject *, void *, Py_ssize_t ix, PyObject *key, Py_hash_t))
 {
+    if (dictkeys_is_tagged(dk)) {
+        return do_lookup_tagged(mp, dk, key, hash, check_lookup);
+    }
     void *ep0 = _DK_ENTRIES(dk);
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
@@ -1713,6 +1895,116 @@ find_empty_slot(PyDictKeysObject *keys, Py_hash_t hash)
     return i;
 }
 
+/* Copy entries [growth->dg_nentries, end) of keys to the next table and
+   index them. */
+static void
+dictkeys_grow_entries(PyDictKeysObject *keys, Py_ssize_t end)
+{
+    dictkeys_growth *growth = DK_GROWTH(keys);
+    PyDictKeysObject *next = growth->dg_keys;
+    for (Py_ssize_t ix = growth->dg_nentries; ix < end; ix++) {
+        Py_hash_t hash;
+        if (DK_IS_UNICODE(keys)) {
+            PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(keys)[ix];
+            if (ep->me_key == NULL) {
+                continue;
+            }
+            DK_UNICODE_ENTRIES(next)[ix] = *ep;
+            hash = unicode_get_hash(ep->me_key);
+        }
+        else {
+            PyDictKeyEntry *ep = &DK_ENTRIES(keys)[ix];
+            if (ep->me_key == NULL) {
+                continue;
+            }
+            DK_ENTRIES(next)[ix] = *ep;
+            hash = ep->me_hash;
+        }
+        Py_ssize_t hashpos = find_empty_slot(next, hash);
+        dictkeys_set_hashed_index(next, hashpos, ix, hash);
+    }
+    growth->dg_nentries = end;
+}
+
+/* Do a bounded part of the work of building the next table of a large
+   combined table, starting it when the table is nearly full. */
+static void
+dictkeys_grow_step(PyInterpreterState *interp, PyDictObject *mp)
+{
+    PyDictKeysObject *keys = mp->ma_keys;
+    assert(dictkeys_can_grow(keys) && mp->ma_values == NULL);
+    dictkeys_growth *growth = DK_GROWTH(keys);
+    PyDictKeysObject *next = growth->dg_keys;
+    if (next == NULL) {
+        /* Tables with many deleted entries are compacted by dictresize(),
+           the others keep them in the next table. */
+        if (DK_LOG_SIZE(keys) < interp->dict_state.grow_log_size ||
+            keys->dk_usable > USABLE_FRACTION(DK_SIZE(keys)) / DK_GROW_START ||
+            keys->dk_nentries - mp->ma_used > keys->dk_nentries / 8 ||
+            DK_LOG_SIZE(keys) + 1 >= SIZEOF_SIZE_T*8)
+        {
+            return;
+        }
+        next = alloc_keys_object(DK_LOG_SIZE(keys) + 1, DK_IS_UNICODE(keys));
+        if (next == NULL) {
+            /* dictresize() will try again when the table is full. */
+            PyErr_Clear();
+            return;
+        }
+        growth->dg_keys = next;
+        growth->dg_index_bytes = 0;
+        growth->dg_nentries = 0;
+    }
+
+    size_t index_bytes = (size_t)1 << next->dk_log2_index_bytes;
+    if (growth->dg_index_bytes < index_bytes) {
+        size_t n = Py_MIN(index_bytes - growth->dg_index_bytes,
+                          DK_GROW_INDEX_BYTES);
+        memset(&next->dk_indices[growth->dg_index_bytes], 0xff, n);
+        growth->dg_index_bytes += n;
+        return;
+    }
+    dictkeys_grow_entries(keys, Py_MIN(keys->dk_nentries,
+                                       growth->dg_nentries + DK_GROW_STEP));
+}
+
+/* Store the new value of the entry ix in the next table if it was already
+   copied there.  If value is NULL, the entry is being deleted, and is
+   removed from the next table. */
+static inline void
+dictkeys_grow_update(PyDictKeysObject *keys, Py_hash_t hash, Py_ssize_t ix,
+                     PyObject *value)
+{
+    if (!dictkeys_can_grow(keys)) {
+        return;
+    }
+    dictkeys_growth *growth = DK_GROWTH(keys);
+    PyDictKeysObject *next = growth->dg_keys;
+    if (next == NULL || ix >= growth->dg_nentries) {
+        return;
+    }
+    if (value == NULL) {
+        Py_ssize_t hashpos = lookdict_index(next, hash, ix);
+        assert(hashpos >= 0);
+        dictkeys_set_index(next, hashpos, DKIX_DUMMY);
+    }
+    if (DK_IS_UNICODE(keys)) {
+        PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(next)[ix];
+        if (value == NULL) {
+            ep->me_key = NULL;
+        }
+        ep->me_value = value;
+    }
+    else {
+        PyDictKeyEntry *ep = &DK_ENTRIES(next)[ix];
+        if (value == NULL) {
+            ep->me_key = NULL;
+            ep->me_hash = 0;
+        }
+        ep->me_value = value;
+    }
+}
+
 static int
 insertion_resize(PyInterpreterState *interp, PyDictObject *mp, int unicode)
 {
@@ -1723,6 +2015,9 @@ static inline int
 insert_combined_dict(PyInterpreterState *interp, PyDictObject *mp,
                      Py_hash_t hash, PyObject *key, PyObject *value)
 {
+    if (dictkeys_can_grow(mp->ma_keys)) {
+        dictkeys_grow_step(interp, mp);
+    }
     if (mp->ma_keys->dk_usable <= 0) {
         /* Need to resize. */
         if (insertion_resize(interp, mp, 1) < 0) {
@@ -1734,7 +2029,8 @@ insert_combined_dict(PyInterpreterState *interp, PyDictObject *mp,
     FT_ATOMIC_STORE_UINT32_RELAXED(mp->ma_keys->dk_version, 0);
 
     Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
-    dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
+    dictkeys_set_hashed_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries,
+                              hash);
 
     if (DK_IS_UNICODE(mp->ma_keys)) {
         PyDictUnicodeEntry *ep;
@@ -1776,7 +2072,7 @@ insert_split_key(PyDictKeysObject *keys, PyObject *key, Py_hash_t hash)
         FT_ATOMIC_STORE_UINT32_RELAXED(keys->dk_version, 0);
         Py_ssize_t hashpos = find_empty_slot(keys, hash);
         ix = keys->dk_nentries;
-        dictkeys_set_index(keys, hashpos, ix);
+        dictkeys_set_hashed_index(keys, hashpos, ix, hash);
         PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(keys)[ix];
         STORE_SHARED_KEY(ep->me_key, Py_NewRef(key));
         split_keys_entry_added(keys);
@@ -1871,6 +2167,7 @@ insertdict(PyInterpreterState *interp, PyDictObject *mp,
             PyDictKeyEntry *ep = &DK_ENTRIES(mp->ma_keys)[ix];
             STORE_VALUE(ep, value);
         }
+        dictkeys_grow_update(mp->ma_keys, hash, ix, value);
     }
     Py_XDECREF(old_value); /* which **CAN** re-enter (see issue #22653) */
     ASSERT_CONSISTENT(mp);
@@ -1944,7 +2241,7 @@ build_indices_generic(PyDictKeysObject *keys, PyDictKeyEntry *ep, Py_ssize_t n)
             perturb >>= PERTURB_SHIFT;
             i = mask & (i*5 + perturb + 1);
         }
-        dictkeys_set_index(keys, i, ix);
+        dictkeys_set_hashed_index(keys, i, ix, hash);
     }
 }
 
@@ -1960,7 +2257,7 @@ build_indices_unicode(PyDictKeysObject *keys, PyDictUnicodeEntry *ep, Py_ssize_t
             perturb >>= PERTURB_SHIFT;
             i = mask & (i*5 + perturb + 1);
         }
-        dictkeys_set_index(keys, i, ix);
+        dictkeys_set_hashed_index(keys, i, ix, hash);
     }
 }
 
@@ -1974,6 +2271,37 @@ invalidate_and_clear_inline_values(PyDictValues *values)
     }
 }
 
+/* Replace the keys of mp with the next table built by
+   dictkeys_grow_step().  The steps are usually done by then, and only
+   the last entries are left to copy. */
+static void
+dictkeys_grow_finish(PyDictObject *mp)
+{
+    PyDictKeysObject *oldkeys = mp->ma_keys;
+    dictkeys_growth *growth = DK_GROWTH(oldkeys);
+    PyDictKeysObject *newkeys = growth->dg_keys;
+    Py_ssize_t nentries = oldkeys->dk_nentries;
+
+    size_t index_bytes = (size_t)1 << newkeys->dk_log2_index_bytes;
+    memset(&newkeys->dk_indices[growth->dg_index_bytes], 0xff,
+           index_bytes - growth->dg_index_bytes);
+    growth->dg_index_bytes = index_bytes;
+    /* The references of the entries are moved to the new table. */
+    dictkeys_grow_entries(oldkeys, nentries);
+    growth->dg_keys = NULL;
+
+    set_keys(mp, newkeys);
+#ifdef Py_REF_DEBUG
+    _Py_DecRefTotal(_PyThreadState_GET());
+#endif
+    assert(oldkeys->dk_refcnt == 1);
+    free_keys_object(oldkeys, IS_DICT_SHARED(mp));
+
+    STORE_KEYS_USABLE(newkeys, newkeys->dk_usable - nentries);
+    STORE_KEYS_NENTRIES(newkeys, nentries);
+    ASSERT_CONSISTENT(mp);
+}
+
 /*
 Restructure the table by allocating a new table and reinserting all
 items again.  When entries have been deleted, the new table may
@@ -2016,6 +2344,17 @@ dictresize(PyInterpreterState *interp, PyDictObject *mp,
      * TODO: Try reusing oldkeys when reimplement odict.
      */
 
+    if (oldvalues == NULL && dictkeys_can_grow(oldkeys)) {
+        newkeys = DK_GROWTH(oldkeys)->dg_keys;
+        if (newkeys != NULL && DK_LOG_SIZE(newkeys) == log2_newsize &&
+            DK_IS_UNICODE(newkeys) == (unicode != 0))
+        {
+            dictkeys_grow_finish(mp);
+            return 0;
+        }
+        dictkeys_drop_growth(oldkeys);
+    }
+
     /* Allocate a new table. */
     newkeys = new_keys_object(interp, log2_newsize, unicode);
     if (newkeys == NULL) {
@@ -2737,6 +3076,7 @@ delitem_common(PyDictObject *mp, Py_hash_t hash, Py_ssize_t ix,
     else {
         FT_ATOMIC_STORE_UINT32_RELAXED(mp->ma_keys->dk_version, 0);
         dictkeys_set_index(mp->ma_keys, hashpos, DKIX_DUMMY);
+        dictkeys_grow_update(mp->ma_keys, hash, ix, NULL);
         if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[ix];
             old_key = ep->me_key;
@@ -4601,11 +4941,17 @@ dict_popitem_impl(PyDictObject *self)
     assert(j >= 0);
     assert(dictkeys_get_index(self->ma_keys, j) == i);
     dictkeys_set_index(self->ma_keys, j, DKIX_DUMMY);
+    dictkeys_grow_update(self->ma_keys, hash, i, NULL);
 
     PyTuple_SET_ITEM(res, 0, key);
     PyTuple_SET_ITEM(res, 1, value);
     /* We can't dk_usable++ since there is DKIX_DUMMY in indices */
     STORE_KEYS_NENTRIES(self->ma_keys, i);
+    if (dictkeys_can_grow(self->ma_keys)) {
+        /* The entry i will be reused by the next insertion. */
+        dictkeys_growth *growth = DK_GROWTH(self->ma_keys);
+        growth->dg_nentries = Py_MIN(growth->dg_nentries, i);
+    }
     STORE_USED(self, self->ma_used - 1);
     ASSERT_CONSISTENT(self);
     return res;
@@ -4665,6 +5011,13 @@ sizeof_lock_held(PyDictObject *mp)
        in the type object. */
     if (mp->ma_keys->dk_refcnt == 1) {
         res += _PyDict_KeysSize(mp->ma_keys);
+        if (dictkeys_can_grow(mp->ma_keys)) {
+            res += sizeof(dictkeys_growth);
+            PyDictKeysObject *next = DK_GROWTH(mp->ma_keys)->dg_keys;
+            if (next != NULL) {
+                res += sizeof(dictkeys_growth) + _PyDict_KeysSize(next);
+            }
+        }
     }
     assert(res <= (size_t)PY_SSIZE_T_MAX);
     return (Py_ssize_t)res;
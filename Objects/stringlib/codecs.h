@@ -97,6 +97,36 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
         if (ch < 0xE0) {
             /* \xC2\x80-\xDF\xBF -- 0080-07FF */
             Py_UCS4 ch2;
+#if STRINGLIB_MAX_CHAR >= 0x07FF && PY_LITTLE_ENDIAN
+            /* Fast path for runs of 2-byte sequences, as in Cyrillic,
+               Greek, Hebrew or Arabic text: check and decode four of them
+               at a time.  Each 16-bit lane of the word holds a lead byte
+               110xxxxx in its low half and a continuation byte 10xxxxxx in
+               its high half; lead bytes \xC0 and \xC1 are overlong. */
+            if (end - s >= 8) {
+                const char *_s = s;
+                while (end - _s >= 8) {
+                    uint64_t v;
+                    memcpy(&v, _s, 8);
+                    if ((v & 0xC0E0C0E0C0E0C0E0ULL) != 0x80C080C080C080C0ULL ||
+                        (((v & 0x001E001E001E001EULL) + 0x007E007E007E007EULL)
+                         & 0x0080008000800080ULL) != 0x0080008000800080ULL)
+                    {
+                        break;
+                    }
+                    p[0] = (STRINGLIB_CHAR)(((v & 0x1F) << 6) | ((v >> 8) & 0x3F));
+                    p[1] = (STRINGLIB_CHAR)(((v >> 10) & 0x7C0) | ((v >> 24) & 0x3F));
+                    p[2] = (STRINGLIB_CHAR)(((v >> 26) & 0x7C0) | ((v >> 40) & 0x3F));
+                    p[3] = (STRINGLIB_CHAR)(((v >> 42) & 0x7C0) | ((v >> 56) & 0x3F));
+                    _s += 8;
+                    p += 4;
+                }
+                if (_s != s) {
+                    s = _s;
+                    continue;
+                }
+            }
+#endif
             if (ch < 0xC2) {
                 /* invalid sequence
                 \x80-\xBF -- continuation byte
@@ -254,6 +284,117 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
 #undef ASCII_CHAR_MASK
 
 
+/* Return the size of the UTF-8 encoding of a string, or -1 if the string
+   contains surrogates, which are left to the error handler of
+   utf8_encoder(), or is too long.  The inner loop has no branches and
+   counts in 16-bit integers, so that the compiler can vectorize it. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(utf8_encoded_size)(const STRINGLIB_CHAR *data, Py_ssize_t size)
+{
+    /* At most 3 extra bytes per character fit in the block counter. */
+    const Py_ssize_t block_size = 0x4000;
+    Py_ssize_t extra = 0;       /* bytes beyond the first of each char */
+#if STRINGLIB_SIZEOF_CHAR > 1
+    STRINGLIB_CHAR surrogates = 0;
+#endif
+
+    if (size > PY_SSIZE_T_MAX / 4) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < size; i += block_size) {
+        const STRINGLIB_CHAR *block = data + i;
+        Py_ssize_t n = Py_MIN(size - i, block_size);
+        uint16_t count = 0;
+        for (Py_ssize_t j = 0; j < n; j++) {
+            STRINGLIB_CHAR ch = block[j];
+            count += (uint16_t)(ch >= 0x80);
+#if STRINGLIB_SIZEOF_CHAR > 1
+            count += (uint16_t)(ch >= 0x800);
+            surrogates |= (STRINGLIB_CHAR)((STRINGLIB_CHAR)(ch - 0xD800) < 0x800);
+#endif
+#if STRINGLIB_SIZEOF_CHAR > 2
+            count += (uint16_t)(ch >= 0x10000);
+#endif
+        }
+        extra += count;
+    }
+#if STRINGLIB_SIZEOF_CHAR > 1
+    if (surrogates) {
+        return -1;
+    }
+#endif
+    return size + extra;
+}
+
+/* Encode a character which is not a surrogate to UTF-8. */
+Py_LOCAL_INLINE(char *)
+STRINGLIB(utf8_encode_char)(Py_UCS4 ch, char *p)
+{
+    if (ch < 0x80) {
+        *p++ = (char)ch;
+    }
+    else
+#if STRINGLIB_SIZEOF_CHAR > 1
+    if (ch < 0x0800)
+#endif
+    {
+        *p++ = (char)(0xc0 | (ch >> 6));
+        *p++ = (char)(0x80 | (ch & 0x3f));
+    }
+#if STRINGLIB_SIZEOF_CHAR > 1
+    else
+# if STRINGLIB_SIZEOF_CHAR > 2
+    if (ch < 0x10000)
+# endif
+    {
+        assert(!Py_UNICODE_IS_SURROGATE(ch));
+        *p++ = (char)(0xe0 | (ch >> 12));
+        *p++ = (char)(0x80 | ((ch >> 6) & 0x3f));
+        *p++ = (char)(0x80 | (ch & 0x3f));
+    }
+# if STRINGLIB_SIZEOF_CHAR > 2
+    else {
+        assert(ch <= MAX_UNICODE);
+        *p++ = (char)(0xf0 | (ch >> 18));
+        *p++ = (char)(0x80 | ((ch >> 12) & 0x3f));
+        *p++ = (char)(0x80 | ((ch >> 6) & 0x3f));
+        *p++ = (char)(0x80 | (ch & 0x3f));
+    }
+# endif
+#endif
+    return p;
+}
+
+/* Encode a string without surrogates to UTF-8 into a buffer of the size
+   computed by utf8_encoded_size().  Return the end of the output. */
+Py_LOCAL_INLINE(char *)
+STRINGLIB(utf8_encode_nosurrogates)(const STRINGLIB_CHAR *data,
+                                    Py_ssize_t size, char *p)
+{
+    Py_ssize_t i = 0;
+
+    /* Work on blocks of eight characters, copying the all-ASCII ones
+       directly. */
+    for (; size - i >= 8; i += 8) {
+        const STRINGLIB_CHAR *d = data + i;
+        if ((d[0] | d[1] | d[2] | d[3] | d[4] | d[5] | d[6] | d[7]) < 0x80) {
+            for (int k = 0; k < 8; k++) {
+                p[k] = (char)d[k];
+            }
+            p += 8;
+            continue;
+        }
+        for (int k = 0; k < 8; k++) {
+            p = STRINGLIB(utf8_encode_char)(d[k], p);
+        }
+    }
+    for (; i < size; i++) {
+        p = STRINGLIB(utf8_encode_char)(data[i], p);
+    }
+    return p;
+}
+
+
 /* UTF-8 encoder specialized for a Unicode kind to avoid the slow
    PyUnicode_READ() macro. Delete some parts of the code depending on the kind:
    UCS-1 strings don't need to handle surrogates for example. */
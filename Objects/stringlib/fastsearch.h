@@ -686,6 +686,109 @@ STRINGLIB(adaptive_find)(const STRINGLIB_CHAR* s, Py_ssize_t n,
 }
 
 
+/* Filter kernel for short needles on long haystacks.  Compare the
+   first and the last character of the needle against a whole block of
+   candidate positions, and only verify the middle of the needle where
+   both ends match.  The block loop has no branches and no loop-carried
+   dependency other than an OR, so compilers turn it into vector
+   compares (SSE2, NEON, ...) without intrinsics or runtime dispatch.
+   Unlike the bloom skip of default_find, its speed does not depend on
+   the characters of the needle appearing rarely in the haystack. */
+
+#define FILTER_MAX_NEEDLE 16
+#define FILTER_MIN_HAYSTACK 64
+#define FILTER_BLOCK 32
+
+#if STRINGLIB_SIZEOF_CHAR == 1
+#  define FILTER_UCHAR uint8_t
+#elif STRINGLIB_SIZEOF_CHAR == 2
+#  define FILTER_UCHAR uint16_t
+#else
+#  define FILTER_UCHAR uint32_t
+#endif
+
+static Py_ssize_t
+STRINGLIB(filter_find)(const STRINGLIB_CHAR* s, Py_ssize_t n,
+                       const STRINGLIB_CHAR* p, Py_ssize_t m,
+                       Py_ssize_t maxcount, int mode)
+{
+    assert(2 <= m && m <= FILTER_MAX_NEEDLE && m <= n);
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    const size_t middle = (size_t)(m - 2) * sizeof(STRINGLIB_CHAR);
+    /* Compare unsigned: STRINGLIB_CHAR is a plain char for bytes. */
+    const FILTER_UCHAR first = (FILTER_UCHAR)p[0];
+    const FILTER_UCHAR last = (FILTER_UCHAR)p[mlast];
+    Py_ssize_t count = 0, misses = 0;
+    Py_ssize_t i = 0;
+
+    /* Positions i .. i+FILTER_BLOCK-1 are all valid starts, so every
+       read below stays within s[0:n]. */
+    while (i + FILTER_BLOCK - 1 <= w) {
+        const STRINGLIB_CHAR *ss = s + i;
+        int any = 0;
+        for (Py_ssize_t k = 0; k < FILTER_BLOCK; k++) {
+            any |= ((FILTER_UCHAR)ss[k] == first)
+                   & ((FILTER_UCHAR)ss[k + mlast] == last);
+        }
+        if (!any) {
+            i += FILTER_BLOCK;
+            continue;
+        }
+        Py_ssize_t k;
+        for (k = 0; k < FILTER_BLOCK; k++) {
+            if ((FILTER_UCHAR)ss[k] == first
+                && (FILTER_UCHAR)ss[k + mlast] == last)
+            {
+                if (memcmp(ss + k + 1, p + 1, middle) == 0) {
+                    break;
+                }
+                misses++;
+            }
+        }
+        if (k == FILTER_BLOCK) {
+            i += FILTER_BLOCK;
+            if (misses > (i >> 3) + FILTER_BLOCK) {
+                /* Too many false candidates, as in searching "aaaba"
+                   in "aaaa...": switch to the adaptive algorithm, which
+                   has a linear worst case. */
+                Py_ssize_t res = STRINGLIB(adaptive_find)(
+                    s + i, n - i, p, m, maxcount - count, mode);
+                if (mode != FAST_COUNT) {
+                    return res == -1 ? -1 : i + res;
+                }
+                return count + res;
+            }
+            continue;
+        }
+        /* got a match! */
+        if (mode != FAST_COUNT) {
+            return i + k;
+        }
+        count++;
+        if (count == maxcount) {
+            return maxcount;
+        }
+        i += k + m;
+    }
+    for (; i <= w; i++) {
+        if ((FILTER_UCHAR)s[i] == first && (FILTER_UCHAR)s[i + mlast] == last
+            && memcmp(s + i + 1, p + 1, middle) == 0)
+        {
+            if (mode != FAST_COUNT) {
+                return i;
+            }
+            count++;
+            if (count == maxcount) {
+                return maxcount;
+            }
+            i += mlast;
+        }
+    }
+    return mode == FAST_COUNT ? count : -1;
+}
+
+
 static Py_ssize_t
 STRINGLIB(default_rfind)(const STRINGLIB_CHAR* s, Py_ssize_t n,
                          const STRINGLIB_CHAR* p, Py_ssize_t m,
@@ -797,6 +900,9 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
     }
 
     if (mode != FAST_RSEARCH) {
+        if (m <= FILTER_MAX_NEEDLE && n >= FILTER_MIN_HAYSTACK) {
+            return STRINGLIB(filter_find)(s, n, p, m, maxcount, mode);
+        }
         if (n < 2500 || (m < 100 && n < 30000) || m < 6) {
             return STRINGLIB(default_find)(s, n, p, m, maxcount, mode);
         }
@@ -828,3 +934,7 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
     }
 }
 
+#undef FILTER_MAX_NEEDLE
+#undef FILTER_MIN_HAYSTACK
+#undef FILTER_BLOCK
+#undef FILTER_UCHAR
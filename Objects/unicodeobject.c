@@ -41,7 +41,7 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include "Python.h"
 #include "pycore_abstract.h"      // _PyIndex_Check()
 #include "pycore_bytes_methods.h" // _Py_bytes_lower()
-#include "pycore_bytesobject.h"   // _PyBytes_Repeat()
+#include "pycore_bytesobject.h"   // _PyBytes_Find(), _PyBytes_Repeat()
 #include "pycore_ceval.h"         // _PyEval_GetBuiltin()
 #include "pycore_codecs.h"        // _PyCodec_Lookup()
 #include "pycore_critical_section.h" // Py_*_CRITICAL_SECTION_SEQUENCE_FAST
@@ -5196,17 +5196,51 @@ vector_utf8_start_chars(size_t v)
 }
 
 
-// Count the number of UTF-8 code points in a given byte sequence.
+// Classify the lead bytes of multibyte sequences: bytes 0xF0-0xFF start
+// non-BMP code points, bytes 0xC4-0xEF start BMP code points above U+00FF.
+static inline int
+scalar_utf8_wide_lead(unsigned int ch)
+{
+    return ch >= 0xF0 ? 2 : ch >= 0xC4;
+}
+
+// Set the high bit of every byte of v which is 0xF0 or above.
+static inline size_t
+vector_utf8_ucs4_leads(size_t v)
+{
+    // Shifting may carry bits in from the lower byte, but only into bits
+    // below the high bit which is then tested.
+    return v & (v << 1) & (v << 2) & (v << 3);
+}
+
+// Set the high bit of every byte of v which is 0xC4 or above.
+static inline size_t
+vector_utf8_ucs2_leads(size_t v)
+{
+    // 11xxxxxx with any of the bits 0x3C set.  Adding 0x7C to the masked
+    // bits cannot carry out of the byte.
+    return v & (v << 1) & ((v & (VECTOR_0101 * 0x3C)) + VECTOR_0101 * 0x7C);
+}
+
+// Count the number of UTF-8 code points in a given byte sequence and
+// compute the maximum character of the decoded string in the same pass,
+// rounded up to the largest character of its kind (0xFF, 0xFFFF or
+// 0x10FFFF).  The maximum is only exact if the sequence is valid UTF-8
+// with at least one non-ASCII character.
 static Py_ssize_t
-utf8_count_codepoints(const unsigned char *s, const unsigned char *end)
+utf8_count_codepoints(const unsigned char *s, const unsigned char *end,
+                      Py_UCS4 *maxchar)
 {
     Py_ssize_t len = 0;
+    int wide = 0;
 
     if (end - s >= SIZEOF_SIZE_T) {
         while (!_Py_IS_ALIGNED(s, ALIGNOF_SIZE_T)) {
+            wide |= scalar_utf8_wide_lead(*s);
             len += scalar_utf8_start_char(*s++);
         }
 
+        size_t ucs2 = 0, ucs4 = 0;
         while (s + SIZEOF_SIZE_T <= end) {
             const unsigned char *e = end;
             if (e - s > SIZEOF_SIZE_T * 255) {
@@ -5217,6 +5251,8 @@ utf8_count_codepoints(const unsigned char *s, const unsigned char *end)
                 size_t v = *(size_t*)s;
                 size_t vs = vector_utf8_start_chars(v);
                 vstart += vs;
+                ucs2 |= vector_utf8_ucs2_leads(v);
+                ucs4 |= vector_utf8_ucs4_leads(v);
                 s += SIZEOF_SIZE_T;
             }
             vstart = (vstart & VECTOR_00FF) + ((vstart >> 8) & VECTOR_00FF);
@@ -5226,10 +5262,18 @@ utf8_count_codepoints(const unsigned char *s, const unsigned char *end)
 #endif
             len += vstart & 0x7ff;
         }
+        if (ucs4 & ASCII_CHAR_MASK) {
+            wide |= 2;
+        }
+        else if (ucs2 & ASCII_CHAR_MASK) {
+            wide |= 1;
+        }
     }
     while (s < end) {
+        wide |= scalar_utf8_wide_lead(*s);
         len += scalar_utf8_start_char(*s++);
     }
+    *maxchar = (wide & 2) ? MAX_UNICODE : wide ? 0xffff : 0xff;
     return len;
 }
 
@@ -5442,21 +5486,17 @@ unicode_decode_utf8(const char *s, Py_ssize_t size,
     // otherwise: check the input and decide the maxchr and maxsize to reduce
     // reallocation and copy.
     if (error_handler == _Py_ERROR_STRICT && !consumed && ch >= 0xc2) {
-        // we only calculate the number of codepoints and don't determine the exact maxchr.
-        // This is because writing fast and portable SIMD code to find maxchr is difficult.
-        // If reallocation occurs for a larger maxchar, knowing the exact number of codepoints
-        // means that it is no longer necessary to allocate several times the required amount
-        // of memory.
-        maxsize = utf8_count_codepoints((const unsigned char *)s, (const unsigned char *)end);
-        if (ch < 0xc4) { // latin1
-            maxchr = 0xff;
-        }
-        else if (ch < 0xf0) { // ucs2
-            maxchr = 0xffff;
-        }
-        else { // ucs4
-            maxchr = 0x10ffff;
-        }
+        // Count the codepoints and find the kind of the result in one pass,
+        // so that the string is allocated once with its final size and kind
+        // and never widened while decoding.  The lead bytes of the
+        // multibyte sequences determine the kind; invalid input raises
+        // an error anyway.
+        Py_UCS4 maxchar;
+        maxsize = utf8_count_codepoints((const unsigned char *)s + pos,
+                                        (const unsigned char *)end,
+                                        &maxchar);
+        maxsize += pos;
+        maxchr = maxchar;
     }
     PyObject *u = PyUnicode_New(maxsize, maxchr);
     if (!u) {
@@ -5813,12 +5853,61 @@ _Py_EncodeUTF8Ex(const wchar_t *text, char **str, size_t *error_pos,
 }
 
 
+/* Strings up to this length fit in the small buffer of _PyBytesWriter
+   once encoded to UTF-8. */
+#define UTF8_EXACT_SIZE_MIN_LENGTH 128
+
+/* Return the exact size of the UTF-8 encoding of a non-ASCII string, or -1
+   if it has to go through the error handlers of the encoder. */
+static Py_ssize_t
+unicode_utf8_size(PyObject *unicode)
+{
+    const void *data = PyUnicode_DATA(unicode);
+    Py_ssize_t size = PyUnicode_GET_LENGTH(unicode);
+
+    switch (PyUnicode_KIND(unicode)) {
+    case PyUnicode_1BYTE_KIND:
+        return ucs1lib_utf8_encoded_size(data, size);
+    case PyUnicode_2BYTE_KIND:
+        return ucs2lib_utf8_encoded_size(data, size);
+    default:
+        assert(PyUnicode_KIND(unicode) == PyUnicode_4BYTE_KIND);
+        return ucs4lib_utf8_encoded_size(data, size);
+    }
+}
+
+/* Write the UTF-8 encoding of a string for which unicode_utf8_size()
+   succeeded into p. */
+static void
+unicode_utf8_write(PyObject *unicode, char *p, Py_ssize_t len)
+{
+    const void *data = PyUnicode_DATA(unicode);
+    Py_ssize_t size = PyUnicode_GET_LENGTH(unicode);
+    char *end;
+
+    switch (PyUnicode_KIND(unicode)) {
+    case PyUnicode_1BYTE_KIND:
+        end = ucs1lib_utf8_encode_nosurrogates(data, size, p);
+        break;
+    case PyUnicode_2BYTE_KIND:
+        end = ucs2lib_utf8_encode_nosurrogates(data, size, p);
+        break;
+    default:
+        assert(PyUnicode_KIND(unicode) == PyUnicode_4BYTE_KIND);
+        end = ucs4lib_utf8_encode_nosurrogates(data, size, p);
+        break;
+    }
+    assert(end == p + len);
+    (void)end;
+}
+
 /* Primary internal function which creates utf8 encoded bytes objects.
 
    Allocation strategy:  if the string is short, convert into a stack buffer
-   and allocate exactly as much space needed at the end.  Else allocate the
-   maximum possible needed (4 result bytes per Unicode character), and return
-   the excess memory at the end.
+   and allocate exactly as much space needed at the end.  Else, unless the
+   string contains surrogates, compute the exact size of the result first
+   and encode into it.  Else allocate the maximum possible needed (4 result
+   bytes per Unicode character), and return the excess memory at the end.
 */
 static PyObject *
 unicode_encode_utf8(PyObject *unicode, _Py_error_handler error_handler,
@@ -5833,6 +5922,21 @@ unicode_encode_utf8(PyObject *unicode, _Py_error_handler error_handler,
         return PyBytes_FromStringAndSize(PyUnicode_UTF8(unicode),
                                          PyUnicode_UTF8_LENGTH(unicode));
 
+    /* Short strings are encoded into the stack buffer of the writer.
+       Longer strings without surrogates are allocated once with their
+       exact size instead of the maximum possible size. */
+    Py_ssize_t len = -1;
+    if (PyUnicode_GET_LENGTH(unicode) > UTF8_EXACT_SIZE_MIN_LENGTH) {
+        len = unicode_utf8_size(unicode);
+    }
+    if (len >= 0) {
+        PyObject *bytes = PyBytes_FromStringAndSize(NULL, len);
+        if (bytes != NULL) {
+            unicode_utf8_write(unicode, PyBytes_AS_STRING(bytes), len);
+        }
+        return bytes;
+    }
+
     int kind = PyUnicode_KIND(unicode);
     const void *data = PyUnicode_DATA(unicode);
     Py_ssize_t size = PyUnicode_GET_LENGTH(unicode);
@@ -5870,6 +5974,21 @@ unicode_fill_utf8(PyObject *unicode)
     /* the string cannot be ASCII, or PyUnicode_UTF8() would be set */
     assert(!PyUnicode_IS_ASCII(unicode));
 
+    Py_ssize_t len = unicode_utf8_size(unicode);
+    if (len >= 0) {
+        char *cache = PyMem_Malloc(len + 1);
+        if (cache == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        unicode_utf8_write(unicode, cache, len);
+        cache[len] = '\0';
+        PyUnicode_SET_UTF8_LENGTH(unicode, len);
+        PyUnicode_SET_UTF8(unicode, cache);
+        return 0;
+    }
+
+    /* Strings with surrogates or too long for the size computation. */
     int kind = PyUnicode_KIND(unicode);
     const void *data = PyUnicode_DATA(unicode);
     Py_ssize_t size = PyUnicode_GET_LENGTH(unicode);
@@ -5900,7 +6019,7 @@ unicode_fill_utf8(PyObject *unicode)
 
     const char *start = writer.use_small_buffer ? writer.small_buffer :
                     PyBytes_AS_STRING(writer.buffer);
-    Py_ssize_t len = end - start;
+    len = end - start;
 
     char *cache = PyMem_Malloc(len + 1);
     if (cache == NULL) {
@@ -10737,6 +10856,22 @@ anylib_find(int kind, PyObject *str1, const void *buf1, Py_ssize_t len1,
     Py_UNREACHABLE();
 }
 
+Py_ssize_t
+_PyUnicode_FindKind(int kind, const void *haystack, Py_ssize_t len_haystack,
+                    const void *needle, Py_ssize_t len_needle)
+{
+    switch (kind) {
+    case PyUnicode_1BYTE_KIND:
+        /* Byte buffers have no terminator to read past the end. */
+        return _PyBytes_Find(haystack, len_haystack, needle, len_needle, 0);
+    case PyUnicode_2BYTE_KIND:
+        return ucs2lib_find(haystack, len_haystack, needle, len_needle, 0);
+    case PyUnicode_4BYTE_KIND:
+        return ucs4lib_find(haystack, len_haystack, needle, len_needle, 0);
+    }
+    Py_UNREACHABLE();
+}
+
 static Py_ssize_t
 anylib_count(int kind, PyObject *sstr, const void* sbuf, Py_ssize_t slen,
              PyObject *str1, const void *buf1, Py_ssize_t len1, Py_ssize_t maxcount)
@@ -73,6 +73,7 @@ extern PyObject* PyInit__codecs_kr(void);
 extern PyObject* PyInit__codecs_tw(void);
 extern PyObject* PyInit__winapi(void);
 extern PyObject* PyInit__lsprof(void);
+extern PyObject* PyInit__multisearch(void);
 extern PyObject* PyInit__ast(void);
 extern PyObject* PyInit__io(void);
 extern PyObject* PyInit__pickle(void);
@@ -135,6 +136,7 @@ struct _inittab _PyImport_Inittab[] = {
     {"_bisect", PyInit__bisect},
     {"_heapq", PyInit__heapq},
     {"_lsprof", PyInit__lsprof},
+    {"_multisearch", PyInit__multisearch},
     {"itertools", PyInit_itertools},
     {"_collections", PyInit__collections},
     {"_symtable", PyInit__symtable},
@@ -11067,7 +11067,8 @@
                 assert(PyDict_CheckExact((PyObject *)dict));
                 PyObject *name = GETITEM(FRAME_CO_NAMES, oparg);
                 if (hint >= (size_t)dict->ma_keys->dk_nentries ||
-                    !DK_IS_UNICODE(dict->ma_keys)) {
+                    !DK_IS_UNICODE(dict->ma_keys) ||
+                    DK_LOG_SIZE(dict->ma_keys) >= DK_GROW_MIN_LOG_SIZE) {
                     UNLOCK_OBJECT(dict);
                     if (true) {
                         UPDATE_MISS_STATS(STORE_ATTR);
@@ -54,6 +54,7 @@ static const char* _Py_stdlib_module_names[] = {
 "_md5",
 "_multibytecodec",
 "_multiprocessing",
+"_multisearch",
 "_opcode",
 "_opcode_metadata",
 "_operator",
@@ -97,6 +98,7 @@ static const char* _Py_stdlib_module_names[] = {
 "_tracemalloc",
 "_types",
 "_typing",
+"_uring",
 "_uuid",
 "_warnings",
 "_weakref",
@@ -0,0 +1,300 @@
+# Micro-benchmarks for the asyncio event loop.
+#
+#   call_soon   callbacks scheduled with call_soon(), run in batches
+#   sleep0      two tasks which take turns with await asyncio.sleep(0)
+#   futures     two tasks which wake each other with futures
+#   timers      many call_later() timers with random delays, some of them
+#               cancelled, run until all have fired
+#   streams     requests of 100 bytes and responses of 1000 bytes over a
+#               pair of connected sockets, read with StreamReader
+#   datagrams   datagrams of 100 bytes received by a datagram endpoint,
+#               sent by a plain socket in batches of 32
+#   relay       data relayed between two TCP connections over loopback
+#               by loop.sock_relay(), as by a proxy
+#   relay_copy  the same, copied through a StreamReader and a StreamWriter
+#
+# Each benchmark reports the best time of several runs in nanoseconds per
+# operation: per callback, per switch between the tasks, per timer, per
+# request, per datagram, or per KiB relayed.
+# With --pure-python, asyncio is imported without its C accelerator.
+#
+# Usage: python Tools/asynciobench/asynciobench.py [-r REPEAT] [-n COUNT]
+#                                                  [--pure-python]
+#                                                  [BENCHMARK ...]
+
+import argparse
+import random
+import socket
+import sys
+import tempfile
+import threading
+import time
+
+ALL_BENCHMARKS = {}
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+@register_benchmark
+def call_soon(loop, count):
+    """callbacks scheduled with call_soon()"""
+    done = loop.create_future()
+    remaining = count
+
+    def callback():
+        nonlocal remaining
+        remaining -= 1
+        if not remaining:
+            done.set_result(None)
+
+    def schedule(n):
+        for _ in range(n):
+            loop.call_soon(callback)
+
+    # Callbacks are scheduled in batches of 1000, as by many
+    # transports or futures at once.
+    for start in range(0, count, 1000):
+        loop.call_soon(schedule, min(1000, count - start))
+    loop.run_until_complete(done)
+
+
+@register_benchmark
+def sleep0(loop, count):
+    """switches between two tasks with sleep(0)"""
+    asyncio = sys.modules["asyncio"]
+
+    async def player(n):
+        for _ in range(n):
+            await asyncio.sleep(0)
+
+    async def main():
+        await asyncio.gather(player(count // 2), player(count // 2))
+
+    loop.run_until_complete(main())
+
+
+@register_benchmark
+def futures(loop, count):
+    """switches between two tasks waiting for futures"""
+    asyncio = sys.modules["asyncio"]
+    waiter = None
+
+    async def player(n):
+        # Wake the other player, then wait to be woken.
+        nonlocal waiter
+        for _ in range(n):
+            if waiter is not None:
+                waiter.set_result(None)
+            waiter = fut = loop.create_future()
+            await fut
+        if not waiter.done():
+            waiter.set_result(None)
+
+    async def main():
+        await asyncio.gather(player(count // 2), player(count // 2))
+
+    loop.run_until_complete(main())
+
+
+@register_benchmark
+def timers(loop, count):
+    """call_later() timers, a tenth of them cancelled"""
+    rnd = random.Random(0)
+    delays = [rnd.random() * 0.01 for _ in range(count)]
+    done = loop.create_future()
+    remaining = count - count // 10
+
+    def callback():
+        nonlocal remaining
+        remaining -= 1
+        if not remaining:
+            done.set_result(None)
+
+    handles = [loop.call_later(delay, callback) for delay in delays]
+    for handle in handles[::10]:
+        handle.cancel()
+    loop.run_until_complete(done)
+
+
+@register_benchmark
+def streams(loop, count):
+    """requests and responses read with StreamReader"""
+    asyncio = sys.modules["asyncio"]
+    request = b"q" * 100
+    response = b"r" * 1000
+
+    async def server(reader, writer):
+        while True:
+            await reader.readexactly(len(request))
+            writer.write(response)
+
+    async def main():
+        csock, ssock = socket.socketpair()
+        server_streams = await asyncio.open_connection(sock=ssock)
+        server_task = asyncio.create_task(server(*server_streams))
+        reader, writer = await asyncio.open_connection(sock=csock)
+        for _ in range(count):
+            writer.write(request)
+            await reader.readexactly(len(response))
+        server_task.cancel()
+        writer.close()
+        server_streams[1].close()
+        await writer.wait_closed()
+
+    loop.run_until_complete(main())
+
+
+@register_benchmark
+def datagrams(loop, count):
+    """datagrams received by a datagram endpoint"""
+    asyncio = sys.modules["asyncio"]
+    payload = b"d" * 100
+    batch = 32
+
+    class Receiver(asyncio.DatagramProtocol):
+        remaining = 0
+        waiter = None
+
+        def datagram_received(self, data, addr):
+            self.remaining -= 1
+            if not self.remaining:
+                self.waiter.set_result(None)
+
+    async def main():
+        transport, protocol = await loop.create_datagram_endpoint(
+            Receiver, local_addr=("127.0.0.1", 0))
+        addr = transport.get_extra_info("sockname")
+        with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+            # Send a batch at a time, so that none is dropped.
+            for start in range(0, count, batch):
+                n = min(batch, count - start)
+                protocol.remaining = n
+                protocol.waiter = loop.create_future()
+                for _ in range(n):
+                    sock.sendto(payload, addr)
+                await protocol.waiter
+        transport.close()
+
+    loop.run_until_complete(main())
+
+
+def _relay_benchmark(loop, count, relay):
+    # A thread sends count KiB over a loopback TCP connection, which the
+    # event loop relays to a second connection, read by another thread
+    # until the relay shuts it down.  Both threads let the kernel do the
+    # work, so that the relay dominates the time taken.
+    block = 1024 * 1024
+
+    def connect():
+        with socket.create_server(("127.0.0.1", 0)) as server:
+            client = socket.create_connection(server.getsockname())
+            conn, _ = server.accept()
+        return client, conn
+
+    def produce(sock):
+        with sock, tempfile.TemporaryFile() as file:
+            file.write(b"r" * block)
+            remaining = count * 1024
+            while remaining:
+                remaining -= sock.sendfile(file, 0, min(block, remaining))
+
+    def consume(sock):
+        with sock:
+            # MSG_TRUNC discards the data of a TCP socket without
+            # copying it.
+            while sock.recv(block, socket.MSG_TRUNC):
+                pass
+
+    src_client, src = connect()
+    dst, dst_server = connect()
+    src.setblocking(False)
+    dst.setblocking(False)
+    threads = [threading.Thread(target=produce, args=(src_client,)),
+               threading.Thread(target=consume, args=(dst_server,))]
+    for thread in threads:
+        thread.start()
+    try:
+        loop.run_until_complete(relay(src, dst))
+    finally:
+        for thread in threads:
+            thread.join()
+        src.close()
+        dst.close()
+
+
+@register_benchmark
+def relay(loop, count):
+    """KiB relayed between TCP sockets by sock_relay()"""
+
+    async def relay(src, dst):
+        await loop.sock_relay(src, dst)
+        dst.shutdown(socket.SHUT_WR)
+
+    _relay_benchmark(loop, count, relay)
+
+
+@register_benchmark
+def relay_copy(loop, count):
+    """KiB relayed between TCP sockets by streams"""
+    asyncio = sys.modules["asyncio"]
+
+    async def relay(src, dst):
+        reader, src_writer = await asyncio.open_connection(sock=src)
+        _, writer = await asyncio.open_connection(sock=dst)
+        while data := await reader.read(256 * 1024):
+            writer.write(data)
+            await writer.drain()
+        src_writer.close()
+        writer.close()
+        await writer.wait_closed()
+
+    _relay_benchmark(loop, count, relay)
+
+
+def run(asyncio, name, count, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        loop = asyncio.new_event_loop()
+        try:
+            t0 = time.perf_counter()
+            ALL_BENCHMARKS[name](loop, count)
+            best = min(best, time.perf_counter() - t0)
+        finally:
+            loop.close()
+    return best / count * 1e9
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Micro-benchmarks for the asyncio event loop.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: 5)")
+    parser.add_argument("-n", "--count", type=int, default=200_000,
+                        help="operations per run (default: 200000)")
+    parser.add_argument("--pure-python", action="store_true",
+                        help="import asyncio without its C accelerator")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    if args.pure_python:
+        sys.modules["_asyncio"] = None
+    import asyncio
+
+    print(f"{'Benchmark':<12}{'ns/op':>10}  description")
+    for name in names:
+        ns = run(asyncio, name, args.count, args.repeat)
+        print(f"{name:<12}{ns:>10.1f}  {ALL_BENCHMARKS[name].__doc__}")
+
+
+if __name__ == "__main__":
+    main()
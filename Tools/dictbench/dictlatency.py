@@ -0,0 +1,95 @@
+# Benchmark for the latency of dict insertions.
+#
+# Each benchmark inserts keys one at a time into an empty dict until it
+# holds millions of entries, timing every insertion.  Most insertions
+# take tens of nanoseconds, but the ones that make the dict resize its
+# table take time proportional to its size, so the benchmark reports
+# percentiles of the insertion times and the slowest insertion along
+# with the total time, in nanoseconds per insertion.
+#
+# Usage: python Tools/dictbench/dictlatency.py [-r REPEAT] [-n SIZE]
+#                                              [BENCHMARK ...]
+
+import argparse
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+SIZE = 10_000_000
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+@register_benchmark
+def str_keys(n):
+    """short strings"""
+    return [f"key:{i}" for i in range(n)]
+
+
+@register_benchmark
+def int_keys(n):
+    """64-bit integers, such as ids"""
+    mult = 0x9E3779B97F4A7C15
+    return [(i * mult) & (2**62 - 1) for i in range(n)]
+
+
+def insert_all(keys):
+    d = {}
+    clock = time.perf_counter_ns
+    times = [0] * len(keys)
+    i = 0
+    for key in keys:
+        t0 = clock()
+        d[key] = None
+        times[i] = clock() - t0
+        i += 1
+    return times
+
+
+def run(name, size, repeat):
+    keys = ALL_BENCHMARKS[name](size)
+    best = None
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        times = insert_all(keys)
+        total = time.perf_counter() - t0
+        if best is None or total < best[0]:
+            best = (total, times)
+    total, times = best
+    times.sort()
+    n = len(times)
+    results = [times[n // 2], times[n * 99 // 100], times[n * 999 // 1000],
+               times[-1], total / n * 1e9]
+    print(f"{name:<12}{size:>12,}" +
+          "".join(f"{r:>12,.0f} ns" for r in results))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the latency of dict insertions.")
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+                        help="number of runs per benchmark (default: 3)")
+    parser.add_argument("-n", "--size", type=int, default=SIZE,
+                        help=f"number of keys to insert (default: {SIZE:,})")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    print(f"{'Benchmark':<12}{'size':>12}" +
+          "".join(f"{col:>15}"
+                  for col in ("p50", "p99", "p99.9", "max", "mean")))
+    for name in names:
+        run(name, args.size, args.repeat)
+
+
+if __name__ == "__main__":
+    main()
@@ -21,12 +21,14 @@
 # > echo "0" | sudo tee /sys/devices/system/cpu/cpufreq/boost
 #
 
+import json
 import math
 import os
 import queue
 import sys
 import threading
 import time
+from collections import ConcurrentDict
 from operator import methodcaller
 
 # The iterations in individual benchmarks are scaled by this factor.
@@ -176,6 +178,14 @@ def create_dict():
             "key": "value",
         }
 
+json_records = [{"id": i, "name": "record %d" % i, "score": i * 0.5,
+                 "tags": ["a", "b"], "parent": None} for i in range(1000)]
+
+@register_benchmark
+def json_dumps():
+    for i in range(WORK_SCALE):
+        json.dumps(json_records, workers=4)
+
 thread_local = threading.local()
 
 @register_benchmark
@@ -189,6 +199,64 @@ def thread_local_read():
         _ = tmp.x
         _ = tmp.x
 
+concurrent_dict = ConcurrentDict((i, i) for i in range(1024))
+concurrent_cache = ConcurrentDict()
+
+@register_benchmark
+def concurrent_dict_read():
+    d = concurrent_dict
+    for i in range(1000 * WORK_SCALE):
+        d[i & 1023]
+
+@register_benchmark
+def concurrent_dict_write():
+    d = concurrent_dict
+    for i in range(1000 * WORK_SCALE):
+        d[i & 1023] = i
+
+@register_benchmark
+def concurrent_dict_cache():
+    # Mostly misses: each lookup is followed by an insert, and old entries
+    # are evicted.
+    d = concurrent_cache
+    for i in range(500 * WORK_SCALE):
+        key = i & 4095
+        if d.get(key) is None:
+            d[key] = i
+        d.pop(key ^ 2048, None)
+
+# The same operations on a dict protected by a lock, for comparison.
+locked_dict = {i: i for i in range(1024)}
+locked_cache = {}
+locked_dict_lock = threading.Lock()
+
+@register_benchmark
+def locked_dict_read():
+    d = locked_dict
+    lock = locked_dict_lock
+    for i in range(1000 * WORK_SCALE):
+        with lock:
+            d[i & 1023]
+
+@register_benchmark
+def locked_dict_write():
+    d = locked_dict
+    lock = locked_dict_lock
+    for i in range(1000 * WORK_SCALE):
+        with lock:
+            d[i & 1023] = i
+
+@register_benchmark
+def locked_dict_cache():
+    d = locked_cache
+    lock = locked_dict_lock
+    for i in range(500 * WORK_SCALE):
+        key = i & 4095
+        with lock:
+            if d.get(key) is None:
+                d[key] = i
+            d.pop(key ^ 2048, None)
+
 class MyClass:
     __slots__ = ()
 
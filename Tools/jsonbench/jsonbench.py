@@ -0,0 +1,112 @@
+# Micro-benchmarks for json.loads() and json.dumps() on large documents.
+#
+# The payloads are generated deterministically so that results are
+# comparable between builds.  Each benchmark reports the best time of
+# several runs together with the throughput in MB/s of JSON text.
+#
+# Usage: python Tools/jsonbench/jsonbench.py [-r REPEAT] [BENCHMARK ...]
+
+import argparse
+import json
+import random
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+def make_records(n, seed=0):
+    rng = random.Random(seed)
+    words = ["alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta",
+             "theta", "request completed", "connection reset by peer",
+             'quoted "value"', "path\\to\\file", "café", "naïve"]
+    return [
+        {
+            "id": i,
+            "name": rng.choice(words) * rng.randint(1, 8),
+            "score": rng.random() * 1000,
+            "active": rng.random() < 0.5,
+            "tags": [rng.choice(words) for _ in range(rng.randint(0, 5))],
+            "parent": None,
+        }
+        for i in range(n)
+    ]
+
+
+@register_benchmark
+def loads_large_document():
+    """MB-sized array of records with mixed strings and numbers"""
+    return json.dumps(make_records(20_000))
+
+
+@register_benchmark
+def loads_same_shape():
+    """Many small objects with the same keys"""
+    rows = [{"id": i, "x": i * 0.5, "y": -i, "label": "p", "ok": True}
+            for i in range(100_000)]
+    return json.dumps(rows)
+
+
+@register_benchmark
+def loads_long_strings():
+    """Few very long strings with rare escapes"""
+    text = "lorem ipsum dolor sit amet, consectetur adipiscing elit " * 2000
+    return json.dumps([text, text + "\n", '"' + text + '"'] * 10)
+
+
+@register_benchmark
+def loads_deeply_nested():
+    """Deeply nested objects"""
+    doc = {"leaf": [1, 2, 3]}
+    for i in range(500):
+        doc = {"level": i, "name": "node%d" % i, "child": doc}
+    return json.dumps([doc] * 20)
+
+
+@register_benchmark
+def loads_number_array():
+    """Array of large integers and floats"""
+    rng = random.Random(0)
+    nums = [rng.randrange(10**15, 10**18) for _ in range(100_000)]
+    nums += [rng.random() * 10**rng.randint(-10, 10) for _ in range(100_000)]
+    return json.dumps(nums)
+
+
+def run(name, repeat):
+    payload = ALL_BENCHMARKS[name]()
+    size = len(payload.encode("utf-8")) / 1e6
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        json.loads(payload)
+        best = min(best, time.perf_counter() - t0)
+    print(f"{name:<24}{size:>8.2f} MB{best * 1e3:>12.2f} ms"
+          f"{size / best:>12.1f} MB/s")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark json.loads() on large documents.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    print(f"{'Benchmark':<24}{'Size':>11}{'Time':>15}{'Throughput':>12}")
+    for name in names:
+        run(name, args.repeat)
+
+
+if __name__ == "__main__":
+    main()
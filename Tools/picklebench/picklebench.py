@@ -0,0 +1,124 @@
+# Micro-benchmarks for pickle.dumps() and pickle.loads() on large object
+# graphs.
+#
+# Pickling a graph of many objects is dominated by the lookups in the
+# pickler memo, which records every object already written.  The graphs
+# are generated deterministically so that results are comparable between
+# builds.  Each benchmark reports the best time of several runs together
+# with the number of objects pickled per second.  With --loads, unpickling
+# of the same graphs is timed instead, using --workers helper threads.
+#
+# Usage: python Tools/picklebench/picklebench.py [-r REPEAT] [-p PROTOCOL]
+#                                                [--loads [-w WORKERS]]
+#                                                [BENCHMARK ...]
+
+import argparse
+import pickle
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+class Point:
+    def __init__(self, x, y, label):
+        self.x = x
+        self.y = y
+        self.label = label
+
+
+@register_benchmark
+def dict_of_tuples():
+    """Dict mapping ints to small tuples of strings and floats"""
+    return {i: ("key%d" % i, i * 0.5, (i, str(i))) for i in range(300_000)}
+
+
+@register_benchmark
+def instances():
+    """List of class instances, each with its own __dict__"""
+    return [Point(i, -i, "p%d" % i) for i in range(200_000)]
+
+
+@register_benchmark
+def shared_references():
+    """Objects referenced many times from several containers"""
+    leaves = [[i] for i in range(200_000)]
+    return [leaves, leaves[::-1], {str(i): leaves[i] for i in range(0, 200_000, 3)}]
+
+
+@register_benchmark
+def text_records():
+    """Records holding non-ASCII text and binary blobs"""
+    return [("r\xe9cord %d " % i * (i % 50), b"\x00\xff" * (i % 200), i)
+            for i in range(50_000)]
+
+
+def count_objects(obj):
+    # Number of distinct memoized objects, i.e. containers and strings.
+    seen = set()
+    stack = [obj]
+    while stack:
+        o = stack.pop()
+        if id(o) in seen or isinstance(o, (int, float, bytes)):
+            continue
+        seen.add(id(o))
+        if isinstance(o, dict):
+            stack.extend(o.keys())
+            stack.extend(o.values())
+        elif isinstance(o, (list, tuple)):
+            stack.extend(o)
+        elif isinstance(o, Point):
+            stack.append(o.__dict__)
+    return len(seen)
+
+
+def run(name, repeat, protocol, loads, workers):
+    obj = ALL_BENCHMARKS[name]()
+    nobjects = count_objects(obj)
+    data = pickle.dumps(obj, protocol)
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        if loads:
+            pickle.loads(data, workers=workers)
+        else:
+            pickle.dumps(obj, protocol)
+        best = min(best, time.perf_counter() - t0)
+    print(f"{name:<24}{nobjects:>12,}{best * 1e3:>12.2f} ms"
+          f"{nobjects / best / 1e6:>12.2f} M/s")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark pickle.dumps() and pickle.loads() on large "
+                    "object graphs.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("-p", "--protocol", type=int,
+                        default=pickle.HIGHEST_PROTOCOL,
+                        help="pickle protocol (default: highest)")
+    parser.add_argument("--loads", action="store_true",
+                        help="time pickle.loads() instead of pickle.dumps()")
+    parser.add_argument("-w", "--workers", type=int, default=None,
+                        help="workers argument of pickle.loads()")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    print(f"{'Benchmark':<24}{'Objects':>12}{'Time':>15}{'Objects/s':>12}")
+    for name in names:
+        run(name, args.repeat, args.protocol, args.loads, args.workers)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+# Micro-benchmarks for regular expression search over log lines.
+#
+# Each benchmark compiles a pattern of the kind used to filter or parse
+# log files and runs it over about 1 MB of generated log lines, once with
+# findall() over the whole text and once with search() on every line.
+# Most lines do not match.  Each benchmark reports the best time of
+# several runs as throughput in MB of text per second.
+#
+# Usage: python Tools/rebench/rebench.py [-r REPEAT] [--bytes]
+#                                        [BENCHMARK ...]
+
+import argparse
+import random
+import re
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+SIZE = 1_000_000
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+def make_log(seed=0):
+    rnd = random.Random(seed)
+    levels = ["INFO"] * 20 + ["DEBUG"] * 10 + ["WARNING"] * 3 + ["ERROR"]
+    paths = ["/api/v1/users", "/api/v1/orders", "/static/app.js",
+             "/login", "/api/v2/search"]
+    users = ["alice", "bob", "carol", "dave", "eve"]
+    lines = []
+    size = 0
+    while size < SIZE:
+        level = rnd.choice(levels)
+        line = (f"2024-01-{rnd.randrange(1, 29):02d} "
+                f"{rnd.randrange(24):02d}:{rnd.randrange(60):02d}:"
+                f"{rnd.randrange(60):02d} {level} [worker-{rnd.randrange(8)}] "
+                f"GET {rnd.choice(paths)}/{rnd.randrange(10**5)} "
+                f"status={rnd.choice([200, 200, 200, 304, 404, 500])} "
+                f"duration={rnd.randrange(1000)}ms "
+                f"user={rnd.choice(users)}@example.org "
+                f"ip=10.{rnd.randrange(256)}.{rnd.randrange(256)}."
+                f"{rnd.randrange(256)}")
+        if level == "ERROR" and rnd.random() < 0.2:
+            line += f" upstream timeout for {rnd.choice(users)}@example.com"
+        lines.append(line)
+        size += len(line) + 1
+    return "\n".join(lines)
+
+
+@register_benchmark
+def email():
+    """a word before a domain"""
+    return r"\w+@example\.com"
+
+
+@register_benchmark
+def error_timeout():
+    """two words on a line"""
+    return r".*ERROR.*timeout"
+
+
+@register_benchmark
+def timestamp_level():
+    """a literal at a fixed offset"""
+    return r"\d\d:\d\d:\d\d ERROR"
+
+
+@register_benchmark
+def word():
+    """a word between boundaries"""
+    return r"\bupstream\b"
+
+
+@register_benchmark
+def duration():
+    """a literal after digits"""
+    return r"\d{3}ms user=eve"
+
+
+@register_benchmark
+def status_5xx():
+    """a literal prefix"""
+    return r"status=5\d\d"
+
+
+@register_benchmark
+def ip_address():
+    """no literal longer than a character"""
+    return r"\d+\.\d+\.\d+\.\d+ upstream"
+
+
+@register_benchmark
+def key_values():
+    """a repeated group before a literal"""
+    return r"(?:\w+=\S+ )+upstream"
+
+
+def timeit(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def run(name, text, repeat):
+    pattern = ALL_BENCHMARKS[name]()
+    if isinstance(text, bytes):
+        pattern = pattern.encode("ascii")
+    p = re.compile(pattern)
+    lines = text.splitlines()
+    search = p.search
+
+    def search_lines():
+        for line in lines:
+            search(line)
+
+    size = len(text) / 1e6
+    results = [
+        size / timeit(lambda: p.findall(text), repeat),
+        size / timeit(search_lines, repeat),
+    ]
+    print(f"{name:<16}" + "".join(f"{r:>11.1f} MB/s" for r in results))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark regular expression search over log lines.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("--bytes", action="store_true",
+                        help="search bytes instead of str")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    text = make_log()
+    if args.bytes:
+        text = text.encode("ascii")
+    print(f"{'Benchmark':<16}" + "".join(f"{op:>16}" for op in
+                                         ("findall", "search lines")))
+    for name in names:
+        run(name, text, args.repeat)
+
+
+if __name__ == "__main__":
+    main()
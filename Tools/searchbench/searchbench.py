@@ -0,0 +1,183 @@
+# Micro-benchmarks for substring search with short needles.
+#
+# Each benchmark builds a log-like text of about 1 MB in one string kind
+# (or bytes) and searches it for needles of 2 to 16 characters with
+# find(), count(), split() and replace(), the way log processing code
+# does.  The needle of find() does not occur in the text, so the whole
+# text is scanned.  Each benchmark reports the best time of several runs
+# as throughput in MB of text per second.
+#
+# With --multi, the text is instead searched for sets of 4 to 64 keywords,
+# once with a str.find() or str.replace() call per keyword and once with
+# a string.Matcher.
+#
+# Usage: python Tools/searchbench/searchbench.py [-r REPEAT] [--multi]
+#                                                [BENCHMARK ...]
+
+import argparse
+import random
+import string
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+SIZE = 1_000_000
+
+NEEDLES = ["id", "GET", "user=", "timeout", "status=5", "connection re",
+           "session expired!"]
+MISSING = ["zq", "zqx", "zqxw!", "zqxwvut", "zqxwvuts", "zqxwvutsrqp",
+           "zqxwvutsrqponmlk"]
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+def make_log(seed=0):
+    rnd = random.Random(seed)
+    words = ("error warning info debug request response user session "
+             "timeout connection reset expired GET POST status").split()
+    lines = []
+    size = 0
+    while size < SIZE:
+        line = (f"2024-01-{rnd.randrange(1, 29):02d} "
+                f"{rnd.choice(words)} id={rnd.randrange(10**6)} "
+                f"user={rnd.randrange(1000)} status={rnd.randrange(200, 600)} "
+                + " ".join(rnd.choices(words, k=6)))
+        lines.append(line)
+        size += len(line) + 1
+    return "\n".join(lines)
+
+
+@register_benchmark
+def str_ascii():
+    """1-byte kind, ASCII only"""
+    return make_log()
+
+
+@register_benchmark
+def str_latin1():
+    """1-byte kind with non-ASCII characters"""
+    return make_log().replace("o", "\xf6")
+
+
+@register_benchmark
+def str_ucs2():
+    """2-byte kind (Cyrillic letters)"""
+    return make_log().replace("o", "о")
+
+
+@register_benchmark
+def str_ucs4():
+    """4-byte kind (an emoji per line)"""
+    return make_log().replace("\n", "\U0001f600\n")
+
+
+@register_benchmark
+def bytes_ascii():
+    """bytes, ASCII only"""
+    return make_log().encode("ascii")
+
+
+def run(name, repeat):
+    text = ALL_BENCHMARKS[name]()
+    conv = (lambda s: s.encode("ascii")) if isinstance(text, bytes) else str
+    needles = [conv(s) for s in NEEDLES]
+    missing = [conv(s) for s in MISSING]
+    empty = conv("")
+    ops = {
+        "find": lambda: [text.find(s) for s in missing],
+        "count": lambda: [text.count(s) for s in needles],
+        "split": lambda: [text.split(s) for s in needles],
+        "replace": lambda: [text.replace(s, empty) for s in needles],
+    }
+    size = len(text) / 1e6
+    results = []
+    for op, func in ops.items():
+        best = float("inf")
+        for _ in range(repeat):
+            t0 = time.perf_counter()
+            func()
+            best = min(best, time.perf_counter() - t0)
+        results.append(size * len(NEEDLES) / best)
+    print(f"{name:<12}" + "".join(f"{r:>11.1f} MB/s" for r in results))
+
+
+def make_keywords(n, seed=1):
+    rnd = random.Random(seed)
+    return ["".join(rnd.choices(string.ascii_lowercase, k=rnd.randint(4, 10)))
+            for _ in range(n)]
+
+
+def timeit(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def run_multi(name, repeat):
+    text = ALL_BENCHMARKS[name]()
+    conv = (lambda s: s.encode("ascii")) if isinstance(text, bytes) else str
+    size = len(text) / 1e6
+    results = []
+    for n in (4, 8, 16, 64):
+        keywords = [conv(k) for k in make_keywords(n)]
+        # Make some of the keywords occur in the text.
+        text = text.replace(conv("timeout"), keywords[0])
+        matcher = string.Matcher(keywords)
+        empty = conv("")
+
+        def replace_each():
+            s = text
+            for k in keywords:
+                s = s.replace(k, empty)
+            return s
+
+        results += [
+            size / timeit(lambda: [text.find(k) for k in keywords], repeat),
+            size / timeit(lambda: matcher.findall(text), repeat),
+            size / timeit(replace_each, repeat),
+            size / timeit(lambda: matcher.replace(text, empty), repeat),
+        ]
+    print(f"{name:<12}" + "".join(f"{r:>9.0f}" for r in results))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark substring search with short needles.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("--multi", action="store_true",
+                        help="search for sets of keywords at once")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    if args.multi:
+        print(f"{'MB/s':<12}" + "".join(
+            f"{n:>9}{'keywords':<27}" for n in (4, 8, 16, 64)))
+        print(f"{'Benchmark':<12}" + "".join(
+            f"{'find':>9}{'Matcher':>9}{'replace':>9}{'Matcher':>9}"
+            for n in (4, 8, 16, 64)))
+        for name in names:
+            run_multi(name, args.repeat)
+        return
+    print(f"{'Benchmark':<12}" + "".join(f"{op:>16}" for op in
+                                         ("find", "count", "split",
+                                          "replace")))
+    for name in names:
+        run(name, args.repeat)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+# Micro-benchmarks for building sets and testing membership.
+#
+# Each benchmark makes a list of keys in random order, in which every key
+# appears twice, as when removing duplicates, and builds a set from it.
+# It then tests membership of keys that are in the set (hits) and keys
+# that are not (misses), in random order.  Sizes go from sets that fit in
+# a cache to tens of millions of keys.  Each benchmark reports the best
+# time of several runs in nanoseconds per item of the list or per test.
+#
+# Usage: python Tools/setbench/setbench.py [-r REPEAT] [-s SIZES]
+#                                          [BENCHMARK ...]
+
+import argparse
+import random
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+SIZES = [1_000, 100_000, 1_000_000, 10_000_000]
+
+# Number of membership tests per run.
+LOOKUPS = 1_000_000
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+@register_benchmark
+def str_keys():
+    """short strings"""
+    return lambda i: f"key:{i}"
+
+
+@register_benchmark
+def int_keys():
+    """64-bit integers, such as ids"""
+    mult = 0x9E3779B97F4A7C15
+    return lambda i: (i * mult) & (2**62 - 1)
+
+
+def timeit(func, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - t0)
+    return best
+
+
+def run(name, size, repeat):
+    make_key = ALL_BENCHMARKS[name]()
+    rnd = random.Random(0)
+    keys = [make_key(i) for i in range(size)]
+    items = keys * 2
+    rnd.shuffle(items)
+    s = set(items)
+    n = min(size, LOOKUPS)
+    hits = [keys[rnd.randrange(size)] for _ in range(n)]
+    misses = [make_key(size + rnd.randrange(size * 4)) for _ in range(n)]
+    # Repeat the keys of small sets to do about the same number of
+    # tests for every size.
+    hits *= LOOKUPS // n
+    misses *= LOOKUPS // n
+    contains = s.__contains__
+
+    results = [timeit(lambda: set(items), repeat) / len(items) * 1e9]
+    for keys in (hits, misses):
+        t = timeit(lambda: sum(map(contains, keys)), repeat)
+        results.append(t / len(keys) * 1e9)
+    print(f"{name:<12}{size:>12,}" +
+          "".join(f"{r:>13.1f} ns" for r in results))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark building sets and membership tests.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("-s", "--sizes", default=",".join(map(str, SIZES)),
+                        help="comma-separated set sizes (default: "
+                             f"{','.join(map(str, SIZES))})")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    sizes = [int(s) for s in args.sizes.split(",")]
+    print(f"{'Benchmark':<12}{'size':>12}" +
+          "".join(f"{op:>16}" for op in ("build", "hit", "miss")))
+    for name in names:
+        for size in sizes:
+            run(name, size, args.repeat)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,144 @@
+# Micro-benchmarks for UTF-8 decoding and encoding of text in various
+# scripts.
+#
+# Each benchmark builds a text of about 1 MB of UTF-8 from a sample
+# sentence in one script, or from a mix of scripts.  The text is decoded,
+# or encoded with --encode, both as a whole and line by line, which
+# exercises the set-up cost of short strings.  Each benchmark reports the
+# best time of several runs together with the throughput in MB of UTF-8
+# per second.
+#
+# Usage: python Tools/unicodebench/unicodebench.py [-r REPEAT] [--encode]
+#                                                  [BENCHMARK ...]
+
+import argparse
+import sys
+import time
+
+ALL_BENCHMARKS = {}
+
+SIZE = 1_000_000
+
+
+def register_benchmark(func):
+    ALL_BENCHMARKS[func.__name__] = func
+    return func
+
+
+def make_text(*sentences):
+    # Lines of about 80 characters cycling through the sentences.
+    lines = []
+    size = 0
+    i = 0
+    while size < SIZE:
+        line = sentences[i % len(sentences)]
+        lines.append(line)
+        size += len(line.encode("utf-8")) + 1
+        i += 1
+    return "\n".join(lines)
+
+
+@register_benchmark
+def english():
+    """ASCII only"""
+    return make_text("The quick brown fox jumps over the lazy dog, "
+                     "again and again, until the dog finally wakes up.")
+
+
+@register_benchmark
+def french():
+    """Latin-1 range, mostly ASCII"""
+    return make_text("Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva de "
+                     "crapaüter en canoë au delà des îles.".replace("œ", "oe"))
+
+
+@register_benchmark
+def russian():
+    """Cyrillic, two bytes per letter"""
+    return make_text("Съешь же ещё этих мягких французских булок, "
+                     "да выпей чаю, а потом снова съешь ещё булок.")
+
+
+@register_benchmark
+def greek():
+    """Greek, two bytes per letter"""
+    return make_text("Ξεσκεπάζω την ψυχοφθόρα βδελυγμία, "
+                     "και ξανά ξεσκεπάζω την ψυχοφθόρα βδελυγμία.")
+
+
+@register_benchmark
+def chinese():
+    """CJK ideographs, three bytes per character"""
+    return make_text("我能吞下玻璃而不伤身体。天地玄黄，宇宙洪荒，"
+                     "日月盈昃，辰宿列张。寒来暑往，秋收冬藏。")
+
+
+@register_benchmark
+def japanese():
+    """Kana and kanji mixed with ASCII"""
+    return make_text("いろはにほへと ちりぬるを Python 3 わかよたれそ "
+                     "つねならむ、私はガラスを食べられます。")
+
+
+@register_benchmark
+def emoji():
+    """Emoji mixed with ASCII, four bytes per emoji"""
+    return make_text("Deploy done \U0001f680 tests green ✅ "
+                     "coffee ☕ \U0001f600\U0001f389\U0001f44d all good")
+
+
+@register_benchmark
+def mixed_widening():
+    """Text whose widest character comes last"""
+    return make_text(*["caf\xe9 cr\xe8me br\xfbl\xe9e " * 3] * 9,
+                     "мир 世界 \U0001f30d")
+
+
+def run(name, repeat, encode):
+    text = ALL_BENCHMARKS[name]()
+    data = text.encode("utf-8")
+    lines = text.split("\n")
+    size = len(data) / 1e6
+    if encode:
+        whole, op = text, str.encode
+    else:
+        whole, op = data, bytes.decode
+        lines = [line.encode("utf-8") for line in lines]
+    best_whole = best_lines = float("inf")
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        op(whole, "utf-8")
+        t1 = time.perf_counter()
+        for line in lines:
+            op(line, "utf-8")
+        t2 = time.perf_counter()
+        best_whole = min(best_whole, t1 - t0)
+        best_lines = min(best_lines, t2 - t1)
+    print(f"{name:<24}{size:>8.2f} MB{size / best_whole:>12.1f} MB/s"
+          f"{size / best_lines:>12.1f} MB/s")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark UTF-8 decoding and encoding of text in "
+                    "various scripts.")
+    parser.add_argument("-r", "--repeat", type=int, default=5,
+                        help="number of runs per benchmark (default: 5)")
+    parser.add_argument("--encode", action="store_true",
+                        help="time str.encode() instead of bytes.decode()")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    print(f"{'Benchmark':<24}{'Size':>11}{'Whole':>17}{'Lines':>17}")
+    for name in names:
+        run(name, args.repeat, args.encode)
+
+
+if __name__ == "__main__":
+    main()
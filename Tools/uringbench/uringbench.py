@@ -0,0 +1,195 @@
+# Benchmarks for asyncio servers on the io_uring and selector event loops.
+#
+# A server runs in this process on the event loop being measured.  Client
+# processes, which use the default event loop, open many connections to it
+# and send requests on every connection in turn, waiting for each response,
+# for a fixed duration.  The benchmarks report the requests per second, the
+# latency percentiles seen by the clients, and the CPU time of the server
+# process per request.
+#
+#   echo    the server sends back the SIZE bytes it receives
+#   http    HTTP/1.1 keep-alive requests with a small fixed response
+#
+# On a machine with few CPUs, clients and server compete for them, and the
+# CPU time per request is the most stable figure: compare loops with the
+# same options rather than absolute numbers.
+#
+# Usage: python Tools/uringbench/uringbench.py [-c CONNECTIONS] [-d DURATION]
+#                                              [-p PROCESSES] [-s SIZE]
+#                                              [-l LOOP] [BENCHMARK ...]
+
+import argparse
+import asyncio
+import multiprocessing
+import resource
+import sys
+import time
+
+ALL_BENCHMARKS = ("echo", "http")
+
+LOOPS = {
+    "selector": asyncio.SelectorEventLoop,
+    "uring": getattr(asyncio, "UringEventLoop", None),
+}
+
+HTTP_REQUEST = (b"GET /plaintext HTTP/1.1\r\n"
+                b"Host: localhost\r\n"
+                b"User-Agent: uringbench\r\n"
+                b"Accept: */*\r\n\r\n")
+HTTP_BODY = b"Hello, World!"
+HTTP_RESPONSE = (b"HTTP/1.1 200 OK\r\n"
+                 b"Content-Type: text/plain\r\n"
+                 b"Content-Length: %d\r\n\r\n" % len(HTTP_BODY) + HTTP_BODY)
+
+
+class EchoServer(asyncio.Protocol):
+
+    def connection_made(self, transport):
+        self.transport = transport
+
+    def data_received(self, data):
+        self.transport.write(data)
+
+
+class HttpServer(asyncio.Protocol):
+
+    def connection_made(self, transport):
+        self.transport = transport
+        self.buffer = b""
+
+    def data_received(self, data):
+        buffer = self.buffer + data
+        count = buffer.count(b"\r\n\r\n")
+        if count:
+            self.transport.write(HTTP_RESPONSE * count)
+            buffer = buffer[buffer.rindex(b"\r\n\r\n") + 4:]
+        self.buffer = buffer
+
+
+def raise_fd_limit(needed):
+    soft, hard = resource.getrlimit(resource.RLIMIT_NOFILE)
+    if soft < needed:
+        if hard != resource.RLIM_INFINITY and hard < needed:
+            sys.exit(f"need {needed} file descriptors, the limit is {hard}")
+        resource.setrlimit(resource.RLIMIT_NOFILE, (needed, hard))
+
+
+async def client_main(port, name, connections, size, start, duration):
+    if name == "echo":
+        request = b"x" * size
+        response_size = size
+    else:
+        request = HTTP_REQUEST
+        response_size = len(HTTP_RESPONSE)
+    streams = []
+    for _ in range(connections):
+        streams.append(await asyncio.open_connection("127.0.0.1", port))
+    latencies = []
+
+    async def run(reader, writer):
+        await asyncio.sleep(start - time.time())
+        end = time.perf_counter() + duration
+        while (t0 := time.perf_counter()) < end:
+            writer.write(request)
+            await reader.readexactly(response_size)
+            latencies.append(time.perf_counter() - t0)
+
+    await asyncio.gather(*(run(r, w) for r, w in streams))
+    for reader, writer in streams:
+        writer.close()
+    return latencies
+
+
+def client_process(port, name, connections, size, start, duration, queue):
+    raise_fd_limit(connections + 100)
+    queue.put(asyncio.run(client_main(port, name, connections, size,
+                                      start, duration)))
+
+
+def run(loop_name, name, args):
+    loop = LOOPS[loop_name]()
+    protocol = EchoServer if name == "echo" else HttpServer
+    server = loop.run_until_complete(loop.create_server(
+        protocol, "127.0.0.1", 0, backlog=4096))
+    port = server.sockets[0].getsockname()[1]
+
+    ctx = multiprocessing.get_context("spawn")
+    queue = ctx.Queue()
+    per_process = -(-args.connections // args.processes)
+    # Give the clients time to connect before they start sending.
+    start = time.time() + 2 + args.connections / 2000
+    procs = []
+    remaining = args.connections
+    for _ in range(args.processes):
+        n = min(per_process, remaining)
+        remaining -= n
+        procs.append(ctx.Process(
+            target=client_process,
+            args=(port, name, n, args.size, start, args.duration, queue)))
+    for p in procs:
+        p.start()
+
+    async def serve():
+        await asyncio.sleep(start - time.time())
+        cpu_start = time.process_time()
+        await asyncio.sleep(args.duration)
+        cpu = time.process_time() - cpu_start
+        latencies = []
+        while len(latencies) < len(procs):
+            latencies.append(await loop.run_in_executor(None, queue.get))
+        return cpu, latencies
+
+    cpu, results = loop.run_until_complete(serve())
+    for p in procs:
+        p.join()
+    server.close()
+    loop.run_until_complete(server.wait_closed())
+    loop.close()
+
+    latencies = sorted(t for result in results for t in result)
+    count = len(latencies)
+    p50 = latencies[count // 2] * 1e6
+    p99 = latencies[count * 99 // 100] * 1e6
+    print(f"{name:<6}{loop_name:<10}{args.connections:>8,}"
+          f"{count / args.duration:>14,.0f}{p50:>12,.0f}{p99:>12,.0f}"
+          f"{cpu / count * 1e6:>12.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark asyncio servers on several event loops.")
+    parser.add_argument("-c", "--connections", type=int, default=10_000,
+                        help="number of connections (default: 10000)")
+    parser.add_argument("-d", "--duration", type=float, default=10.0,
+                        help="seconds of requests per benchmark "
+                             "(default: 10)")
+    parser.add_argument("-p", "--processes", type=int, default=2,
+                        help="number of client processes (default: 2)")
+    parser.add_argument("-s", "--size", type=int, default=100,
+                        help="size of echo messages in bytes (default: 100)")
+    parser.add_argument("-l", "--loop", action="append", choices=LOOPS,
+                        help="event loop to measure, can be repeated "
+                             "(default: all)")
+    parser.add_argument("benchmarks", nargs="*", metavar="BENCHMARK",
+                        help=f"benchmarks to run (default: all of "
+                             f"{', '.join(ALL_BENCHMARKS)})")
+    args = parser.parse_args()
+
+    names = args.benchmarks or list(ALL_BENCHMARKS)
+    for name in names:
+        if name not in ALL_BENCHMARKS:
+            sys.exit(f"unknown benchmark: {name}")
+    loops = args.loop or list(LOOPS)
+    if LOOPS["uring"] is None and "uring" in loops:
+        sys.exit("asyncio.UringEventLoop is not available")
+    raise_fd_limit(args.connections + 100)
+    print(f"{'Bench':<6}{'loop':<10}{'conns':>8}"
+          f"{'requests/s':>14}{'p50 us':>12}{'p99 us':>12}"
+          f"{'cpu us/req':>12}")
+    for name in names:
+        for loop_name in loops:
+            run(loop_name, name, args)
+
+
+if __name__ == "__main__":
+    main()